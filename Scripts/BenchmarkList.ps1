@@ -0,0 +1,28 @@
+# Measures the startup time of D3d12info --List, which e.g. game launchers call on every start.
+# The lean listing is compared with --ListVendorData, which also initializes vendor-specific APIs like before.
+# The first run of each is reported separately, as it is the closest to a cold start.
+param(
+    [string]$Exe = "$PSScriptRoot/../build/Release/D3d12info.exe",
+    [ValidateRange(2, 1000)]
+    [int]$Runs = 20
+)
+
+function Measure-Args([string[]]$Arguments)
+{
+    $times = for($i = 0; $i -lt $Runs; ++$i)
+    {
+        (Measure-Command { & $Exe @Arguments | Out-Null }).TotalMilliseconds
+    }
+    $sorted = $times | Select-Object -Skip 1 | Sort-Object
+    [PSCustomObject]@{
+        Arguments = $Arguments -join ' '
+        'First [ms]' = [math]::Round($times[0], 1)
+        'Median [ms]' = [math]::Round($sorted[[int]($sorted.Count / 2)], 1)
+        'Max [ms]' = [math]::Round(($sorted | Measure-Object -Maximum).Maximum, 1)
+    }
+}
+
+@(
+    Measure-Args @('--List')
+    Measure-Args @('--List', '--ListVendorData', '--NoCache')
+) | Format-Table -AutoSize
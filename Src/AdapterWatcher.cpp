@@ -0,0 +1,120 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "AdapterWatcher.hpp"
+
+#include "Json.hpp"
+#include "Printer.hpp"
+#include "Utils.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static const wchar_t* const CHANGE_TYPE_NAMES[] = { L"Added", L"Removed", L"Changed" };
+
+static bool IsSameAdapter(const WatchedAdapter& lhs, const WatchedAdapter& rhs)
+{
+    return lhs.m_VendorId == rhs.m_VendorId && lhs.m_DeviceId == rhs.m_DeviceId &&
+           lhs.m_SubSysId == rhs.m_SubSysId && lhs.m_Revision == rhs.m_Revision &&
+           lhs.m_UMDVersion == rhs.m_UMDVersion && lhs.m_Description == rhs.m_Description;
+}
+
+static const WatchedAdapter* FindAdapter(const std::vector<WatchedAdapter>& adapters, uint64_t luid)
+{
+    for(const WatchedAdapter& adapter : adapters)
+    {
+        if(adapter.m_Luid == luid)
+            return &adapter;
+    }
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+std::vector<AdapterChange> FindAdapterChanges(
+    const std::vector<WatchedAdapter>& prevAdapters, const std::vector<WatchedAdapter>& currAdapters)
+{
+    std::vector<AdapterChange> changes;
+    for(size_t i = 0; i < prevAdapters.size(); ++i)
+    {
+        if(!FindAdapter(currAdapters, prevAdapters[i].m_Luid))
+            changes.push_back({ AdapterChangeType::Removed, i });
+    }
+    for(size_t i = 0; i < currAdapters.size(); ++i)
+    {
+        const WatchedAdapter* const prevAdapter = FindAdapter(prevAdapters, currAdapters[i].m_Luid);
+        if(!prevAdapter)
+            changes.push_back({ AdapterChangeType::Added, i });
+        else if(!IsSameAdapter(*prevAdapter, currAdapters[i]))
+            changes.push_back({ AdapterChangeType::Changed, i });
+    }
+    return changes;
+}
+
+AdapterWatcher::AdapterWatcher(Source& source, ReportFunc reportFunc)
+    : m_Source(source)
+    , m_ReportFunc(std::move(reportFunc))
+{
+}
+
+void AdapterWatcher::Run()
+{
+    do
+        Update();
+    while(m_Source.WaitForChange());
+}
+
+size_t AdapterWatcher::Update()
+{
+    std::vector<WatchedAdapter> adapters = m_Source.GetAdapters();
+    const std::vector<AdapterChange> changes = FindAdapterChanges(m_Adapters, adapters);
+    for(const AdapterChange& change : changes)
+    {
+        if(change.m_Type == AdapterChangeType::Removed)
+            PrintChange(change.m_Type, m_Adapters[change.m_Index], UINT32_MAX);
+        else
+            PrintChange(change.m_Type, adapters[change.m_Index], uint32_t(change.m_Index));
+    }
+    m_Adapters = std::move(adapters);
+    return changes.size();
+}
+
+void AdapterWatcher::PrintChange(AdapterChangeType type, const WatchedAdapter& adapter, uint32_t adapterIndex)
+{
+    const std::chrono::sys_time<std::chrono::milliseconds> time =
+        std::chrono::floor<std::chrono::milliseconds>(std::chrono::system_clock::now());
+    m_Line = std::format(L"{{\"Time\":\"{:%FT%TZ}\",\"Change\":\"{}\"", time, CHANGE_TYPE_NAMES[size_t(type)]);
+    if(adapterIndex != UINT32_MAX)
+        m_Line += std::format(L",\"Adapter\":{}", adapterIndex);
+    m_Line += std::format(L",\"AdapterLuid\":\"{:08X}-{:08X}\",\"Description\":\"{}\",\"VendorId\":{},"
+                          L"\"DeviceId\":{},\"SubSysId\":{},\"Revision\":{},\"UMDVersion\":{}",
+        uint32_t(adapter.m_Luid >> 32), uint32_t(adapter.m_Luid), EscapeJsonString(adapter.m_Description),
+        adapter.m_VendorId, adapter.m_DeviceId, adapter.m_SubSysId, adapter.m_Revision, adapter.m_UMDVersion);
+
+    // Removed adapters can't be inspected anymore. A failure to inspect one is reported, and watching goes on.
+    if(type != AdapterChangeType::Removed)
+    {
+        try
+        {
+            const std::wstring report = m_ReportFunc(adapterIndex, adapter);
+            m_Line += L",\"Report\":";
+            m_Line += report;
+        }
+        catch(const std::exception& ex)
+        {
+            m_Line += std::format(L",\"Error\":\"{}\"", EscapeJsonString(StrToWstr(ex.what(), CP_ACP)));
+        }
+    }
+    m_Line += L'}';
+
+    // New line flushes the output, so each change can be read as it comes.
+    Printer::PrintString(m_Line);
+    Printer::PrintNewLine();
+}
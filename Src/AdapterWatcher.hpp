@@ -0,0 +1,79 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// What identifies an adapter and its driver, for --Watch.
+// Deliberately made of plain types only, so changes can also be found in adapters that are made up.
+struct WatchedAdapter
+{
+    uint64_t m_Luid = 0;
+    uint32_t m_VendorId = 0;
+    uint32_t m_DeviceId = 0;
+    uint32_t m_SubSysId = 0;
+    uint32_t m_Revision = 0;
+    // From IDXGIAdapter::CheckInterfaceSupport. 0 if unknown.
+    uint64_t m_UMDVersion = 0;
+    std::wstring m_Description;
+};
+
+enum class AdapterChangeType
+{
+    Added,
+    Removed,
+    Changed
+};
+
+struct AdapterChange
+{
+    AdapterChangeType m_Type;
+    // Into the current adapters, or into the previous ones for AdapterChangeType::Removed.
+    size_t m_Index;
+};
+
+// Adapters are matched by their LUID, so one that only moved to another index is not a change.
+// Removed adapters come first, then added and changed ones in their current order.
+std::vector<AdapterChange> FindAdapterChanges(
+    const std::vector<WatchedAdapter>& prevAdapters, const std::vector<WatchedAdapter>& currAdapters);
+
+// Prints one line of NDJSON for each adapter added, removed or changed, with the report of the adapter for those
+// added or changed, so only those are inspected again. Between the changes, it only waits for the source.
+class AdapterWatcher
+{
+public:
+    // Where the adapters come from, implemented with DXGI by the program.
+    class Source
+    {
+    public:
+        virtual ~Source() = default;
+        // In the order of their indices.
+        virtual std::vector<WatchedAdapter> GetAdapters() = 0;
+        // Blocks until the adapters may have changed. Returns false when watching should stop.
+        virtual bool WaitForChange() = 0;
+    };
+
+    // Returns the report of the adapter at the index as JSON. Throws on failure.
+    using ReportFunc = std::function<std::wstring(uint32_t adapterIndex, const WatchedAdapter& adapter)>;
+
+    AdapterWatcher(Source& source, ReportFunc reportFunc);
+
+    // Prints all adapters as added, then the changes, until the source stops. The output must be open.
+    void Run();
+    // Gets the adapters from the source again and prints changes since the previous call.
+    // Returns the number of changes. Run calls it after each change.
+    size_t Update();
+
+private:
+    Source& m_Source;
+    const ReportFunc m_ReportFunc;
+    std::vector<WatchedAdapter> m_Adapters;
+    std::wstring m_Line;
+
+    void PrintChange(AdapterChangeType type, const WatchedAdapter& adapter, uint32_t adapterIndex);
+};
@@ -10,13 +10,16 @@ For more information, see files README.md, LICENSE.txt.
 #include "AgsData.hpp"
 
 #include "Enums.hpp"
+#include "ProbeTimings.hpp"
 #include "ReportFormatter/ReportFormatter.hpp"
+#include "Trace.hpp"
 #include "Utils.hpp"
 
 // Macro set by Cmake.
 #if USE_AGS
 
 #include <amd_ags.h>
+#include <delayimp.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 // PRIVATE
@@ -68,15 +71,25 @@ void AGS_Initialize_RAII::PrintStaticParams()
 {
     ReportFormatter::GetInstance().AddFieldString(L"AMD_AGS_VERSION",
         std::format(L"{}.{}.{}", AMD_AGS_VERSION_MAJOR, AMD_AGS_VERSION_MINOR, AMD_AGS_VERSION_PATCH).c_str());
+}
 
-    const uint32_t version = (uint32_t)agsGetVersionNumber();
+void AGS_Initialize_RAII::PrintLibraryVersion()
+{
+    // The DLL is delay-loaded, so calling into it without checking it's there would raise an exception.
+    if(FAILED(__HrLoadAllImportsForDll("amd_ags_x64.dll")))
+        return;
+    const uint32_t version = (uint32_t)PROBE_CALL(agsGetVersionNumber);
     ReportFormatter::GetInstance().AddFieldAMDVersion(L"agsGetVersionNumber", version);
 }
 
 AGS_Initialize_RAII::AGS_Initialize_RAII()
 {
+    TraceSpan traceSpan(L"AGS_Initialize_RAII");
+    // The DLL is delay-loaded, so it is loaded only here. If it's missing, AGS is not available.
+    if(FAILED(__HrLoadAllImportsForDll("amd_ags_x64.dll")))
+        return;
     AGSConfiguration config = {};
-    if(agsInitialize(AGS_CURRENT_VERSION,
+    if(PROBE_CALL(agsInitialize, AGS_CURRENT_VERSION,
            nullptr, // config
            &g_AgsContext, &g_GpuInfo) == AGS_SUCCESS)
     {
@@ -87,7 +100,7 @@ AGS_Initialize_RAII::AGS_Initialize_RAII()
 AGS_Initialize_RAII::~AGS_Initialize_RAII()
 {
     if(m_Initialized)
-        agsDeInitialize(g_AgsContext);
+        PROBE_CALL(agsDeInitialize, g_AgsContext);
 }
 
 void AGS_Initialize_RAII::PrintData()
@@ -113,7 +126,7 @@ void AGS_Initialize_RAII::PrintAgsDeviceData(const DeviceId& id)
     const AGSDeviceInfo& device = g_GpuInfo.devices[deviceIndex];
 
     ReportScopeObject region(L"AGSDeviceInfo");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    ReportSink& formatter = ReportFormatter::GetInstance();
     formatter.AddFieldString(L"adapterString", StrToWstr(device.adapterString, CP_ACP).c_str());
     formatter.AddFieldEnum(L"asicFamily", device.asicFamily, Enum_AGSAsicFamily);
     formatter.AddFieldBool(L"isAPU", device.isAPU);
@@ -146,14 +159,14 @@ ComPtr<ID3D12Device> AGS_Initialize_RAII::CreateDeviceAndPrintData(
         .engineVersion = PROGRAM_VERSION_NUMBER,
         .uavSlot = 0 };
     AGSDX12ReturnedParams returnedParams = {};
-    if(agsDriverExtensionsDX12_CreateDevice(g_AgsContext, &creationParams, &extensionParams, &returnedParams) ==
-        AGS_SUCCESS)
+    if(PROBE_CALL(agsDriverExtensionsDX12_CreateDevice, g_AgsContext, &creationParams, &extensionParams,
+           &returnedParams) == AGS_SUCCESS)
     {
         ComPtr<ID3D12Device> device{ returnedParams.pDevice };
         g_DeviceCreatedWithAgs = true;
 
         ReportScopeObject region(L"AGSDX12ExtensionsSupported");
-        ReportFormatter& formatter = ReportFormatter::GetInstance();
+        ReportSink& formatter = ReportFormatter::GetInstance();
         formatter.AddFieldBool(L"intrinsics16", returnedParams.extensionsSupported.intrinsics16);
         formatter.AddFieldBool(L"intrinsics17", returnedParams.extensionsSupported.intrinsics17);
         formatter.AddFieldBool(L"userMarkers", returnedParams.extensionsSupported.userMarkers);
@@ -179,7 +192,7 @@ void AGS_Initialize_RAII::DestroyDevice(ComPtr<ID3D12Device>&& device)
     if(IsInitialized() && g_DeviceCreatedWithAgs)
     {
         ID3D12Device* rawDevice = device.Detach();
-        agsDriverExtensionsDX12_DestroyDevice(g_AgsContext, rawDevice, nullptr);
+        PROBE_CALL(agsDriverExtensionsDX12_DestroyDevice, g_AgsContext, rawDevice, nullptr);
     }
 }
 
@@ -17,6 +17,8 @@ class AGS_Initialize_RAII
 public:
     // Prints parameters related to NVAPI itself, regardless of whether intialization succeeded.
     static void PrintStaticParams();
+    // Prints the version of amd_ags_x64.dll. Loads it, so call it only if an adapter needs AGS.
+    static void PrintLibraryVersion();
 
     AGS_Initialize_RAII();
     ~AGS_Initialize_RAII();
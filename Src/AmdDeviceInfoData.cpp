@@ -11,6 +11,7 @@ For more information, see files README.md, LICENSE.txt.
 
 #include "Enums.hpp"
 #include "ReportFormatter/ReportFormatter.hpp"
+#include "Trace.hpp"
 #include "Utils.hpp"
 
 // Macro set by Cmake.
@@ -141,13 +142,19 @@ void AmdDeviceInfo_Initialize_RAII::PrintStaticParams()
         L"AMD device_info compiled version", AMD_DEVICE_INFO_COMPILED_VERSION);
 }
 
+AmdDeviceInfo_Initialize_RAII::AmdDeviceInfo_Initialize_RAII()
+{
+    // There is nothing to initialize, but the span shows when the first AMD adapter needed it, like the other APIs.
+    TraceSpan traceSpan(L"AmdDeviceInfo_Initialize_RAII");
+}
+
 void AmdDeviceInfo_Initialize_RAII::PrintDeviceData(const DeviceId& id)
 {
     const GDT_GfxCardInfo* const cardInfo = FindCardInfo(id);
     if(!cardInfo)
         return;
 
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    ReportSink& formatter = ReportFormatter::GetInstance();
 
     {
         ReportScopeObject region{ L"AMD GDT_GfxCardInfo" };
@@ -18,6 +18,8 @@ public:
     // Prints parameters related to AMD's library itself, regardless of selected adapter.
     static void PrintStaticParams();
 
+    AmdDeviceInfo_Initialize_RAII();
+
     struct DeviceId
     {
         uint32_t deviceId, revisionId;
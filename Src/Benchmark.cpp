@@ -0,0 +1,178 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Benchmark.hpp"
+
+#include "ReportFormatter/ReportFormatter.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+struct Slot
+{
+    // Path of names of the measurements it is nested in, like "Adapter 0 / Formats / DXGI_FORMAT_R8_UNORM".
+    std::wstring m_Name;
+    Benchmark::Kind m_Kind;
+};
+
+struct OpenMeasurement
+{
+    size_t m_SlotIndex;
+    Benchmark::Clock::time_point m_BeginTime;
+};
+
+static const wchar_t* const KIND_NAMES[] = { L"DeviceCreation", L"ProbeGroups", L"Formats", L"Rendering" };
+static_assert(std::size(KIND_NAMES) == size_t(Benchmark::Kind::Count));
+static const wchar_t* const PATH_SEPARATOR = L" / ";
+// Deeper nesting than any in the report, so opening a measurement doesn't allocate.
+static const size_t MAX_OPEN_MEASUREMENT_COUNT = 64;
+
+static std::vector<Slot> g_Slots;
+// Samples of slot i are at [i * g_RunCount, (i + 1) * g_RunCount).
+static std::vector<Benchmark::Clock::duration> g_Samples;
+static std::vector<OpenMeasurement> g_OpenMeasurements;
+static size_t g_RunCount = 0;
+static size_t g_RunIndex = 0;
+static size_t g_NextSlotIndex = 0;
+static bool g_WarmUp = false;
+// Set when a measured run doesn't follow the slots, reported at the end of the run.
+static bool g_Mismatch = false;
+
+static float ToMilliseconds(Benchmark::Clock::duration duration)
+{
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+// Nearest-rank percentile of sorted samples.
+static Benchmark::Clock::duration GetPercentile(
+    const Benchmark::Clock::duration* sortedSamples, size_t count, size_t percent)
+{
+    return sortedSamples[(count * percent + 99) / 100 - 1];
+}
+
+static std::wstring MakeSlotName(std::wstring_view name)
+{
+    std::wstring slotName;
+    if(!g_OpenMeasurements.empty())
+    {
+        slotName = g_Slots[g_OpenMeasurements.back().m_SlotIndex].m_Name;
+        slotName += PATH_SEPARATOR;
+    }
+    slotName += name;
+
+    // Names are members of a JSON object, so one measured again in the same run gets a number.
+    const auto isTaken = [](const std::wstring& candidate) {
+        return std::any_of(
+            g_Slots.begin(), g_Slots.end(), [&candidate](const Slot& slot) { return slot.m_Name == candidate; });
+    };
+    if(!isTaken(slotName))
+        return slotName;
+    for(uint32_t number = 2;; ++number)
+    {
+        std::wstring numberedName = std::format(L"{} #{}", slotName, number);
+        if(!isTaken(numberedName))
+            return numberedName;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+thread_local bool Benchmark::s_Running = false;
+
+void Benchmark::Start(size_t runCount)
+{
+    assert(runCount > 0);
+    g_Slots.clear();
+    g_Samples.clear();
+    g_OpenMeasurements.clear();
+    g_OpenMeasurements.reserve(MAX_OPEN_MEASUREMENT_COUNT);
+    g_RunCount = runCount;
+    g_RunIndex = 0;
+}
+
+void Benchmark::BeginRun(bool warmUp)
+{
+    assert(!s_Running && g_OpenMeasurements.empty());
+    if(warmUp)
+    {
+        assert(g_Samples.empty());
+        g_Slots.clear();
+    }
+    else if(g_Samples.empty())
+        g_Samples.resize(g_Slots.size() * g_RunCount);
+    g_WarmUp = warmUp;
+    g_NextSlotIndex = 0;
+    g_Mismatch = false;
+    s_Running = true;
+}
+
+void Benchmark::EndRun()
+{
+    assert(s_Running && g_OpenMeasurements.empty());
+    s_Running = false;
+    if(g_WarmUp)
+        return;
+    if(g_Mismatch || g_NextSlotIndex != g_Slots.size())
+        throw std::runtime_error("Runs of the benchmark made different queries, e.g. because the adapters changed.");
+    ++g_RunIndex;
+}
+
+void Benchmark::BeginMeasurement(std::wstring_view name, Kind kind)
+{
+    const size_t slotIndex = g_NextSlotIndex++;
+    if(g_WarmUp)
+    {
+        assert(slotIndex == g_Slots.size());
+        std::wstring slotName = MakeSlotName(name);
+        g_Slots.push_back({ std::move(slotName), kind });
+    }
+    else if(slotIndex >= g_Slots.size() || g_Slots[slotIndex].m_Kind != kind)
+        g_Mismatch = true;
+    g_OpenMeasurements.push_back({ slotIndex, Clock::now() });
+}
+
+void Benchmark::EndMeasurement()
+{
+    const Clock::time_point endTime = Clock::now();
+    assert(!g_OpenMeasurements.empty());
+    const OpenMeasurement measurement = g_OpenMeasurements.back();
+    g_OpenMeasurements.pop_back();
+    if(!g_WarmUp && !g_Mismatch)
+        g_Samples[measurement.m_SlotIndex * g_RunCount + g_RunIndex] = endTime - measurement.m_BeginTime;
+}
+
+void Benchmark::PrintReport(size_t warmUpRunCount)
+{
+    assert(g_RunIndex == g_RunCount);
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    ReportScopeObject scope(L"Benchmark");
+    formatter.AddFieldUint64(L"RunCount", g_RunCount);
+    formatter.AddFieldUint64(L"WarmUpRunCount", warmUpRunCount);
+
+    for(size_t kindIndex = 0; kindIndex < size_t(Kind::Count); ++kindIndex)
+    {
+        ReportScopeObjectConditional kindScope(KIND_NAMES[kindIndex]);
+        for(size_t slotIndex = 0; slotIndex < g_Slots.size(); ++slotIndex)
+        {
+            if(g_Slots[slotIndex].m_Kind != Kind(kindIndex))
+                continue;
+            kindScope.Enable();
+
+            Clock::duration* const samples = g_Samples.data() + slotIndex * g_RunCount;
+            std::sort(samples, samples + g_RunCount);
+            ReportScopeObject slotScope(g_Slots[slotIndex].m_Name);
+            formatter.AddFieldFloat(L"Min", ToMilliseconds(samples[0]), L"ms");
+            formatter.AddFieldFloat(L"Median", ToMilliseconds(GetPercentile(samples, g_RunCount, 50)), L"ms");
+            formatter.AddFieldFloat(L"P95", ToMilliseconds(GetPercentile(samples, g_RunCount, 95)), L"ms");
+            formatter.AddFieldFloat(L"P99", ToMilliseconds(GetPercentile(samples, g_RunCount, 99)), L"ms");
+            formatter.AddFieldFloat(L"Max", ToMilliseconds(samples[g_RunCount - 1]), L"ms");
+        }
+    }
+}
@@ -0,0 +1,70 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Latencies of parts of the report printed again and again by --Benchmark.
+// Every run makes the same measurements in the same order, so the n-th measurement of a run always goes to the same
+// slot. Slots are named during the warm-up runs, which are not measured, and then the samples of all slots and runs
+// are allocated at once, so a measurement only writes its duration to a place known in advance.
+// Only the thread that runs the benchmark is measured.
+class Benchmark
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Kind
+    {
+        DeviceCreation,
+        ProbeGroup,
+        Format,
+        Rendering,
+        Count
+    };
+
+    static bool IsRunning()
+    {
+        return s_Running;
+    }
+
+    // Forgets all slots and samples and prepares for runCount runs after the warm-up.
+    static void Start(size_t runCount);
+    // The slots are named by the last warm-up run. Throws if a measured run made other measurements.
+    static void BeginRun(bool warmUp);
+    static void EndRun();
+
+    static void BeginMeasurement(std::wstring_view name, Kind kind);
+    static void EndMeasurement();
+
+    // Prints min, median, 95th, 99th percentile and max of each slot, grouped by kind.
+    static void PrintReport(size_t warmUpRunCount);
+
+private:
+    static thread_local bool s_Running;
+};
+
+// Measures the time from construction to destruction on the thread running the benchmark, if any.
+class BenchmarkScope
+{
+public:
+    BenchmarkScope(std::wstring_view name, Benchmark::Kind kind)
+        : m_Enabled(Benchmark::IsRunning())
+    {
+        if(m_Enabled)
+            Benchmark::BeginMeasurement(name, kind);
+    }
+    ~BenchmarkScope()
+    {
+        if(m_Enabled)
+            Benchmark::EndMeasurement();
+    }
+
+private:
+    const bool m_Enabled;
+};
@@ -0,0 +1,296 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "CapabilityArchive.hpp"
+
+#include "DeviceCapture.hpp"
+#include "Utils.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+namespace CapabilityArchive
+{
+
+    static const char ARCHIVE_FILE_MAGIC[8] = { 'D', '3', 'D', '1', '2', 'A', 'R', 'C' };
+    static const uint32_t ARCHIVE_FILE_VERSION = 1;
+    static const uint64_t ALIGNMENT = 8;
+
+    // FNV-1a
+    static uint64_t HashBytes(std::string_view bytes)
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for(char ch : bytes)
+        {
+            hash ^= uint64_t(uint8_t(ch));
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    static uint64_t AlignUp(uint64_t value)
+    {
+        return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    static std::string ToUtf8(std::wstring_view str)
+    {
+        return WstrToStr(std::wstring(str).c_str(), CP_UTF8);
+    }
+
+    template<typename T>
+    static void AppendValue(std::vector<char>& dst, const T& value)
+    {
+        const char* const bytes = reinterpret_cast<const char*>(&value);
+        dst.insert(dst.end(), bytes, bytes + sizeof(T));
+    }
+
+    static void AppendPadded(std::vector<char>& dst, const void* data, size_t size)
+    {
+        const char* const bytes = static_cast<const char*>(data);
+        dst.insert(dst.end(), bytes, bytes + size);
+        dst.resize(size_t(AlignUp(dst.size())));
+    }
+
+    static void CreateArchiveFile(const std::filesystem::path& path)
+    {
+        // Too big for the stack.
+        std::unique_ptr<Header> header = std::make_unique<Header>();
+        std::copy(std::begin(ARCHIVE_FILE_MAGIC), std::end(ARCHIVE_FILE_MAGIC), header->m_Magic);
+        header->m_Version = ARCHIVE_FILE_VERSION;
+        header->m_BucketCount = BUCKET_COUNT;
+
+        std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(header.get()), sizeof(Header));
+        if(!file.good())
+            throw std::runtime_error("Could not create the archive file.");
+    }
+
+    static bool IsHeaderValid(const Header& header)
+    {
+        return std::equal(std::begin(ARCHIVE_FILE_MAGIC), std::end(ARCHIVE_FILE_MAGIC), header.m_Magic) &&
+            header.m_Version == ARCHIVE_FILE_VERSION && header.m_BucketCount == BUCKET_COUNT;
+    }
+
+    [[noreturn]] static void ThrowDamaged()
+    {
+        throw std::runtime_error("Damaged archive file.");
+    }
+
+    static std::wstring GetMachineName()
+    {
+#ifdef _WIN32
+        wchar_t computerName[MAX_COMPUTERNAME_LENGTH + 1] = {};
+        DWORD computerNameLength = _countof(computerName);
+        if(!GetComputerNameW(computerName, &computerNameLength))
+            computerNameLength = 0;
+        return std::wstring(computerName, computerNameLength);
+#else
+        char hostName[256] = {};
+        if(gethostname(hostName, sizeof(hostName) - 1) != 0)
+            return {};
+        return StrToWstr(hostName, CP_UTF8);
+#endif
+    }
+
+} // namespace CapabilityArchive
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+namespace CapabilityArchive
+{
+
+    std::wstring MakeKey(std::wstring_view adapterName)
+    {
+        return std::format(L"{}/{}", GetMachineName(), adapterName);
+    }
+
+    void Append(const std::wstring& filePath, std::wstring_view key, const std::vector<CapturedCall>& calls)
+    {
+        const std::filesystem::path path(filePath);
+        if(!std::filesystem::exists(path))
+            CreateArchiveFile(path);
+
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        std::unique_ptr<Header> header = std::make_unique<Header>();
+        file.read(reinterpret_cast<char*>(header.get()), sizeof(Header));
+        if(!file.good() || !IsHeaderValid(*header))
+            throw std::runtime_error("Invalid archive file.");
+
+        const std::string keyUtf8 = ToUtf8(key);
+        const uint64_t keyHash = HashBytes(keyUtf8);
+        const size_t bucketIndex = size_t(keyHash % BUCKET_COUNT);
+
+        std::vector<char> record(sizeof(RecordHeader));
+        AppendPadded(record, keyUtf8.data(), keyUtf8.size());
+        for(const CapturedCall& call : calls)
+        {
+            const std::string nameUtf8 = ToUtf8(call.m_Name);
+            const CallHeader callHeader = { .m_NameSize = uint32_t(nameUtf8.size()),
+                .m_Result = int32_t(call.m_Result),
+                .m_OutputSize = uint32_t(call.m_Output.size()),
+                .m_Reserved = 0 };
+            AppendValue(record, callHeader);
+            AppendPadded(record, nameUtf8.data(), nameUtf8.size());
+            AppendPadded(record, call.m_Output.data(), call.m_Output.size());
+        }
+        const RecordHeader recordHeader = { .m_NextRecordOffset = header->m_BucketRecordOffsets[bucketIndex],
+            .m_KeyHash = keyHash,
+            .m_RecordSize = record.size(),
+            .m_KeySize = uint32_t(keyUtf8.size()),
+            .m_CallCount = uint32_t(calls.size()) };
+        memcpy(record.data(), &recordHeader, sizeof(recordHeader));
+
+        file.seekp(0, std::ios::end);
+        const uint64_t recordOffset = uint64_t(file.tellp());
+        file.write(record.data(), std::streamsize(record.size()));
+        // The record becomes reachable only after it is completely written.
+        file.seekp(std::streamoff(offsetof(Header, m_BucketRecordOffsets) + bucketIndex * sizeof(uint64_t)));
+        file.write(reinterpret_cast<const char*>(&recordOffset), sizeof(recordOffset));
+        if(!file.good())
+            throw std::runtime_error("Could not write the archive file.");
+    }
+
+    Reader::Reader(const std::wstring& filePath)
+    {
+#ifdef _WIN32
+        m_File = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, NULL);
+        if(m_File == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Could not open the archive file.");
+
+        LARGE_INTEGER size = {};
+        if(GetFileSizeEx(m_File, &size) && uint64_t(size.QuadPart) >= sizeof(Header))
+        {
+            m_Size = uint64_t(size.QuadPart);
+            m_Mapping = CreateFileMappingW(m_File, NULL, PAGE_READONLY, 0, 0, NULL);
+            if(m_Mapping != NULL)
+                m_Data = static_cast<const char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+#else
+        m_File = open(std::filesystem::path(filePath).c_str(), O_RDONLY | O_CLOEXEC);
+        if(m_File == -1)
+            throw std::runtime_error("Could not open the archive file.");
+
+        struct stat fileStat = {};
+        if(fstat(m_File, &fileStat) == 0 && uint64_t(fileStat.st_size) >= sizeof(Header))
+        {
+            m_Size = uint64_t(fileStat.st_size);
+            void* const data = mmap(nullptr, size_t(m_Size), PROT_READ, MAP_SHARED, m_File, 0);
+            if(data != MAP_FAILED)
+                m_Data = static_cast<const char*>(data);
+        }
+#endif
+        if(m_Data == nullptr || !IsHeaderValid(*reinterpret_cast<const Header*>(m_Data)))
+        {
+            Close();
+            throw std::runtime_error("Invalid archive file.");
+        }
+    }
+
+    Reader::~Reader()
+    {
+        Close();
+    }
+
+    void Reader::Close()
+    {
+#ifdef _WIN32
+        if(m_Data != nullptr)
+            UnmapViewOfFile(m_Data);
+        if(m_Mapping != NULL)
+            CloseHandle(m_Mapping);
+        if(m_File != INVALID_HANDLE_VALUE)
+            CloseHandle(m_File);
+        m_Mapping = NULL;
+        m_File = INVALID_HANDLE_VALUE;
+#else
+        if(m_Data != nullptr)
+            munmap(const_cast<char*>(m_Data), size_t(m_Size));
+        if(m_File != -1)
+            close(m_File);
+        m_File = -1;
+#endif
+        m_Data = nullptr;
+    }
+
+    const RecordHeader* Reader::FindRecord(std::string_view key) const
+    {
+        const uint64_t keyHash = HashBytes(key);
+        const Header* const header = reinterpret_cast<const Header*>(m_Data);
+        uint64_t recordOffset = header->m_BucketRecordOffsets[keyHash % BUCKET_COUNT];
+        while(recordOffset != 0)
+        {
+            if(recordOffset < sizeof(Header) || recordOffset % ALIGNMENT != 0 ||
+                recordOffset > m_Size - sizeof(RecordHeader))
+                ThrowDamaged();
+            const RecordHeader* const record = reinterpret_cast<const RecordHeader*>(m_Data + recordOffset);
+            // Records only point to older ones, so the chain can't loop.
+            // The key must fit in the record, which must fit in the file.
+            if(record->m_RecordSize > m_Size - recordOffset || record->m_NextRecordOffset >= recordOffset ||
+                sizeof(RecordHeader) + AlignUp(record->m_KeySize) > record->m_RecordSize)
+                ThrowDamaged();
+            if(record->m_KeyHash == keyHash && GetRecordKey(record) == key)
+                return record;
+            recordOffset = record->m_NextRecordOffset;
+        }
+        return nullptr;
+    }
+
+    bool Reader::FindCall(const RecordHeader* record, std::string_view callName, Call& outCall) const
+    {
+        uint64_t callOffset = GetFirstCallOffset(record);
+        for(uint32_t i = 0; i < record->m_CallCount; ++i)
+        {
+            callOffset = ReadCall(record, callOffset, outCall);
+            if(outCall.m_Name == callName)
+                return true;
+        }
+        return false;
+    }
+
+    std::string_view Reader::GetRecordKey(const RecordHeader* record) const
+    {
+        return std::string_view(reinterpret_cast<const char*>(record + 1), record->m_KeySize);
+    }
+
+    uint64_t Reader::GetFirstCallOffset(const RecordHeader* record) const
+    {
+        const uint64_t recordOffset = uint64_t(reinterpret_cast<const char*>(record) - m_Data);
+        return recordOffset + sizeof(RecordHeader) + AlignUp(record->m_KeySize);
+    }
+
+    uint64_t Reader::ReadCall(const RecordHeader* record, uint64_t callOffset, Call& outCall) const
+    {
+        // Sizes are 32-bit, so these sums can't overflow.
+        const uint64_t recordEnd = uint64_t(reinterpret_cast<const char*>(record) - m_Data) + record->m_RecordSize;
+        if(callOffset + sizeof(CallHeader) > recordEnd)
+            ThrowDamaged();
+        const CallHeader* const callHeader = reinterpret_cast<const CallHeader*>(m_Data + callOffset);
+        const uint64_t nameOffset = callOffset + sizeof(CallHeader);
+        const uint64_t outputOffset = nameOffset + AlignUp(callHeader->m_NameSize);
+        const uint64_t nextCallOffset = outputOffset + AlignUp(callHeader->m_OutputSize);
+        if(nextCallOffset > recordEnd)
+            ThrowDamaged();
+        outCall.m_Name = std::string_view(m_Data + nameOffset, callHeader->m_NameSize);
+        outCall.m_Result = HRESULT(callHeader->m_Result);
+        outCall.m_Output = m_Data + outputOffset;
+        outCall.m_OutputSize = callHeader->m_OutputSize;
+        return nextCallOffset;
+    }
+
+} // namespace CapabilityArchive
@@ -0,0 +1,121 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+struct CapturedCall;
+
+// Append-only binary file holding raw results of device queries recorded by DeviceCapture,
+// one record per machine and adapter, so it can be searched without parsing any report.
+//
+// Layout, all little-endian and 8-byte aligned:
+// - Header with a hash table of buckets, each holding the offset of the newest record
+//   whose key hashes into it.
+// - Records appended one after another. Each starts with RecordHeader, followed by the key
+//   and then each call as CallHeader, its name and its output bytes.
+// Keys and names are UTF-8, so the file reads the same on every platform.
+// Reading checks every size and offset against the record and the file, so a damaged file only makes it throw.
+namespace CapabilityArchive
+{
+
+    static const uint32_t BUCKET_COUNT = 65536;
+
+    struct Header
+    {
+        char m_Magic[8];
+        uint32_t m_Version;
+        uint32_t m_BucketCount;
+        // 0 means empty bucket.
+        uint64_t m_BucketRecordOffsets[BUCKET_COUNT];
+    };
+
+    struct RecordHeader
+    {
+        // Older record in the same bucket, 0 if none.
+        uint64_t m_NextRecordOffset;
+        uint64_t m_KeyHash;
+        // Including all calls and padding.
+        uint64_t m_RecordSize;
+        uint32_t m_KeySize;
+        uint32_t m_CallCount;
+    };
+
+    struct CallHeader
+    {
+        uint32_t m_NameSize;
+        int32_t m_Result;
+        uint32_t m_OutputSize;
+        uint32_t m_Reserved;
+    };
+
+    // View of one call inside the mapped file.
+    struct Call
+    {
+        std::string_view m_Name;
+        HRESULT m_Result;
+        const void* m_Output;
+        size_t m_OutputSize;
+    };
+
+    // Key of the current machine and the given adapter, e.g. "MY-PC/Adapter 0".
+    std::wstring MakeKey(std::wstring_view adapterName);
+
+    // Appends a record, creating the file if it doesn't exist. Throws on failure.
+    void Append(const std::wstring& filePath, std::wstring_view key, const std::vector<CapturedCall>& calls);
+
+    // Maps an archive into memory for reading. No data is copied or converted.
+    // Works on other platforms than Windows too, through mmap.
+    class Reader
+    {
+    public:
+        // Throws on failure.
+        Reader(const std::wstring& filePath);
+        ~Reader();
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        // Returns the newest record with the key, or null if there is none.
+        const RecordHeader* FindRecord(std::string_view key) const;
+        // Returns false if the record has no such call.
+        bool FindCall(const RecordHeader* record, std::string_view callName, Call& outCall) const;
+        // Calls func(const Call&) for each call of the record, in the order of their names.
+        template<typename Func>
+        void ForEachCall(const RecordHeader* record, Func&& func) const;
+
+    private:
+#ifdef _WIN32
+        HANDLE m_File = INVALID_HANDLE_VALUE;
+        HANDLE m_Mapping = NULL;
+#else
+        int m_File = -1;
+#endif
+        const char* m_Data = nullptr;
+        uint64_t m_Size = 0;
+
+        void Close();
+        std::string_view GetRecordKey(const RecordHeader* record) const;
+        // Returns offset of the first call header of the record.
+        uint64_t GetFirstCallOffset(const RecordHeader* record) const;
+        // Fills outCall and returns the offset of the next call. Throws if the call doesn't fit in the record.
+        uint64_t ReadCall(const RecordHeader* record, uint64_t callOffset, Call& outCall) const;
+    };
+
+    template<typename Func>
+    void Reader::ForEachCall(const RecordHeader* record, Func&& func) const
+    {
+        uint64_t callOffset = GetFirstCallOffset(record);
+        for(uint32_t i = 0; i < record->m_CallCount; ++i)
+        {
+            Call call;
+            callOffset = ReadCall(record, callOffset, call);
+            func(call);
+        }
+    }
+
+} // namespace CapabilityArchive
@@ -0,0 +1,81 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// C API of D3d12infoLib, the static library the D3d12info executable is built from, for programs that want
+// the capabilities without launching the executable and parsing its output.
+// Functions are not thread-safe. Call them from one thread at a time.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <wchar.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define D3D12INFO_API_VERSION 1
+
+typedef enum D3d12infoResult
+{
+    D3D12INFO_SUCCESS = 0,
+    // There were more items than space for them.
+    D3D12INFO_INCOMPLETE = 1,
+    D3D12INFO_ERROR_INVALID_ARGUMENT = -1,
+    D3D12INFO_ERROR_NOT_FOUND = -2,
+    D3D12INFO_ERROR_FAILED = -3,
+} D3d12infoResult;
+
+// Members of DXGI_ADAPTER_DESC1.
+typedef struct D3d12infoAdapter
+{
+    wchar_t Description[128];
+    uint32_t VendorId;
+    uint32_t DeviceId;
+    uint32_t SubSysId;
+    uint32_t Revision;
+    uint64_t DedicatedVideoMemory;
+    uint64_t DedicatedSystemMemory;
+    uint64_t SharedSystemMemory;
+    uint32_t AdapterLuidLowPart;
+    int32_t AdapterLuidHighPart;
+    uint32_t Flags;
+} D3d12infoAdapter;
+
+// Report created by D3d12info_CreateReport. It owns all the memory returned for it.
+typedef struct D3d12infoReport D3d12infoReport;
+
+// Lists adapters in the order of their indices, using only DXGI.
+// If adapters is null, *count receives the number of adapters. Otherwise, *count is the capacity of adapters
+// and receives the number of adapters written. D3D12INFO_INCOMPLETE is returned if it was too small.
+D3d12infoResult D3d12info_GetAdapters(D3d12infoAdapter* adapters, uint32_t* count);
+
+// options are given like on the command line, e.g. L"-a 0 --Formats", or null. The report is always JSON.
+// Options that choose where the report goes or another mode of the program, like -o or --Batch, are invalid.
+// Libraries, D3D12 devices and vendor APIs are kept for the following reports until D3d12info_Shutdown.
+D3d12infoResult D3d12info_CreateReport(const wchar_t* options, D3d12infoReport** outReport);
+void D3d12info_DestroyReport(D3d12infoReport* report);
+
+// Minimized JSON, UTF-8, null-terminated, written on the first call. Null on failure.
+const char* D3d12info_GetReportJson(const D3d12infoReport* report);
+// path is names of members and indices of array items separated by '/',
+// e.g. "Adapters/0/D3D12_FEATURE_DATA_D3D12_OPTIONS5/RaytracingTier".
+// Booleans are returned as 0 or 1. Numbers that are negative or not integers are D3D12INFO_ERROR_INVALID_ARGUMENT.
+// 64-bit numbers, like sizes, are strings in the JSON, but numbers here.
+D3d12infoResult D3d12info_GetReportUint64(const D3d12infoReport* report, const char* path, uint64_t* outValue);
+// outValue receives UTF-8, null-terminated string, valid until the report is destroyed.
+D3d12infoResult D3d12info_GetReportString(const D3d12infoReport* report, const char* path, const char** outValue);
+
+// Releases the libraries, D3D12 devices and vendor APIs kept by D3d12info_CreateReport.
+void D3d12info_Shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,258 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "DeviceCapture.hpp"
+
+#include "Printer.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+struct CallResult
+{
+    HRESULT m_Result = E_FAIL;
+    std::vector<char> m_Output;
+};
+
+static const char CAPTURE_FILE_MAGIC[8] = { 'D', '3', 'D', '1', '2', 'C', 'A', 'P' };
+static const uint32_t CAPTURE_FILE_VERSION = 2;
+
+static std::wstring g_AdapterName;
+// Keys are made by MakeCallKey.
+static std::unordered_map<std::wstring, CallResult> g_Calls;
+
+static void AppendHex(std::wstring& str, const void* data, size_t size)
+{
+    const uint8_t* const bytes = static_cast<const uint8_t*>(data);
+    for(size_t i = 0; i < size; ++i)
+        str += std::format(L"{:02X}", bytes[i]);
+}
+
+// Zeroes pointer members, so they don't end up in keys or in the capture file.
+static void ClearPointers(std::vector<char>& data, const std::vector<CapturePointer>& pointers)
+{
+    for(const CapturePointer& pointer : pointers)
+    {
+        assert(pointer.m_Offset + sizeof(void*) <= data.size());
+        memset(data.data() + pointer.m_Offset, 0, sizeof(void*));
+    }
+}
+
+static std::wstring MakeCallKey(
+    std::wstring_view callName, const void* input, size_t inputSize, const std::vector<CapturePointer>& pointers)
+{
+    std::wstring key = std::format(L"{}/{}/", g_AdapterName, callName);
+    const char* const inputBytes = static_cast<const char*>(input);
+    std::vector<char> inputWithoutPointers(inputBytes, inputBytes + inputSize);
+    ClearPointers(inputWithoutPointers, pointers);
+    AppendHex(key, inputWithoutPointers.data(), inputWithoutPointers.size());
+    for(const CapturePointer& pointer : pointers)
+    {
+        key += L'/';
+        AppendHex(key, pointer.m_Input, pointer.m_InputSize);
+    }
+    return key;
+}
+
+template<typename T>
+static void WriteValue(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool ReadValue(std::ifstream& file, T& outValue)
+{
+    file.read(reinterpret_cast<char*>(&outValue), sizeof(T));
+    return file.good();
+}
+
+static void WriteBytes(std::ofstream& file, const void* data, size_t size)
+{
+    WriteValue(file, uint64_t(size));
+    file.write(static_cast<const char*>(data), std::streamsize(size));
+}
+
+static bool ReadBytes(std::ifstream& file, void* data, uint64_t size)
+{
+    file.read(static_cast<char*>(data), std::streamsize(size));
+    return file.good();
+}
+
+static bool ReadString(std::ifstream& file, std::wstring& outStr)
+{
+    uint64_t byteCount = 0;
+    // Protect against garbage in a damaged file.
+    if(!ReadValue(file, byteCount) || byteCount > (uint64_t(1) << 30) || byteCount % sizeof(wchar_t) != 0)
+        return false;
+    outStr.resize(size_t(byteCount / sizeof(wchar_t)));
+    return ReadBytes(file, outStr.data(), byteCount);
+}
+
+static bool ReadCall(std::ifstream& file, std::wstring& outKey, CallResult& outCall)
+{
+    uint64_t outputSize = 0;
+    if(!ReadString(file, outKey) || !ReadValue(file, outCall.m_Result) || !ReadValue(file, outputSize) ||
+        outputSize > (uint64_t(1) << 30))
+        return false;
+    outCall.m_Output.resize(size_t(outputSize));
+    return ReadBytes(file, outCall.m_Output.data(), outputSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+bool DeviceCapture::s_Recording = false;
+bool DeviceCapture::s_Replaying = false;
+
+void DeviceCapture::StartRecording()
+{
+    assert(!s_Recording && !s_Replaying);
+    s_Recording = true;
+}
+
+void DeviceCapture::Stop()
+{
+    s_Recording = false;
+    s_Replaying = false;
+    g_AdapterName.clear();
+    g_Calls.clear();
+}
+
+void DeviceCapture::SaveFile(const std::wstring& filePath)
+{
+    assert(s_Recording);
+    std::ofstream file(std::filesystem::path(filePath), std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(CAPTURE_FILE_MAGIC, sizeof(CAPTURE_FILE_MAGIC));
+    WriteValue(file, CAPTURE_FILE_VERSION);
+    WriteValue(file, uint64_t(g_Calls.size()));
+    for(const auto& [key, call] : g_Calls)
+    {
+        WriteBytes(file, key.data(), key.length() * sizeof(wchar_t));
+        WriteValue(file, call.m_Result);
+        WriteBytes(file, call.m_Output.data(), call.m_Output.size());
+    }
+    if(!file.good())
+        throw std::runtime_error("Could not write the capture file.");
+}
+
+void DeviceCapture::LoadFile(const std::wstring& filePath)
+{
+    assert(!s_Recording && !s_Replaying);
+    std::ifstream file(std::filesystem::path(filePath), std::ios::in | std::ios::binary);
+    if(!file.is_open())
+        throw std::runtime_error("Could not open the capture file.");
+
+    char magic[sizeof(CAPTURE_FILE_MAGIC)];
+    file.read(magic, sizeof(magic));
+    uint32_t version = 0;
+    uint64_t callCount = 0;
+    if(!file.good() || !std::equal(magic, magic + sizeof(magic), CAPTURE_FILE_MAGIC) || !ReadValue(file, version) ||
+        version != CAPTURE_FILE_VERSION || !ReadValue(file, callCount))
+        throw std::runtime_error("Invalid capture file.");
+
+    for(uint64_t i = 0; i < callCount; ++i)
+    {
+        std::wstring key;
+        CallResult call;
+        if(!ReadCall(file, key, call))
+            throw std::runtime_error("Invalid capture file.");
+        g_Calls.insert_or_assign(std::move(key), std::move(call));
+    }
+    s_Replaying = true;
+}
+
+void DeviceCapture::SetAdapter(std::wstring_view adapterName)
+{
+    g_AdapterName = adapterName;
+}
+
+void DeviceCapture::RecordCall(std::wstring_view callName, const std::vector<char>& input,
+    const std::vector<CapturePointer>& pointers, const void* output, size_t outputSize, HRESULT result)
+{
+    CallResult& call = g_Calls[MakeCallKey(callName, input.data(), input.size(), pointers)];
+    call.m_Result = result;
+    const char* const outputBytes = static_cast<const char*>(output);
+    call.m_Output.assign(outputBytes, outputBytes + outputSize);
+    ClearPointers(call.m_Output, pointers);
+}
+
+std::vector<CapturedCall> DeviceCapture::GetAdapterCalls(std::wstring_view adapterName)
+{
+    const std::wstring prefix = std::format(L"{}/", adapterName);
+    std::vector<CapturedCall> calls;
+    for(const auto& [key, call] : g_Calls)
+    {
+        if(key.starts_with(prefix))
+        {
+            calls.push_back(
+                { .m_Name = key.substr(prefix.length()), .m_Result = call.m_Result, .m_Output = call.m_Output });
+        }
+    }
+    std::sort(calls.begin(), calls.end(),
+        [](const CapturedCall& lhs, const CapturedCall& rhs) { return lhs.m_Name < rhs.m_Name; });
+    return calls;
+}
+
+std::vector<std::wstring> DeviceCapture::GetAdapterNames()
+{
+    std::vector<std::wstring> names;
+    for(const auto& [key, call] : g_Calls)
+    {
+        const std::wstring name = key.substr(0, key.find(L'/'));
+        if(std::find(names.begin(), names.end(), name) == names.end())
+            names.push_back(name);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+HRESULT DeviceCapture::ReplayCall(
+    std::wstring_view callName, void* data, size_t dataSize, const std::vector<CapturePointer>& pointers)
+{
+    const auto it = g_Calls.find(MakeCallKey(callName, data, dataSize, pointers));
+    if(it == g_Calls.end() || it->second.m_Output.size() != dataSize)
+        return E_FAIL;
+    // Copy everything except the pointers, which keep the values set by the caller.
+    char* const dataBytes = static_cast<char*>(data);
+    std::vector<void*> pointerValues(pointers.size());
+    for(size_t i = 0; i < pointers.size(); ++i)
+        memcpy(&pointerValues[i], dataBytes + pointers[i].m_Offset, sizeof(void*));
+    memcpy(data, it->second.m_Output.data(), dataSize);
+    for(size_t i = 0; i < pointers.size(); ++i)
+        memcpy(dataBytes + pointers[i].m_Offset, &pointerValues[i], sizeof(void*));
+    return it->second.m_Result;
+}
+
+DeviceCaptureScope::DeviceCaptureScope(
+    const std::wstring& recordFilePath, const std::wstring& replayFilePath, bool recordInMemory)
+    : m_RecordFilePath(recordFilePath)
+{
+    if(!replayFilePath.empty())
+        DeviceCapture::LoadFile(replayFilePath);
+    else if(!m_RecordFilePath.empty() || recordInMemory)
+        DeviceCapture::StartRecording();
+}
+
+DeviceCaptureScope::~DeviceCaptureScope()
+{
+    if(!m_RecordFilePath.empty())
+    {
+        try
+        {
+            DeviceCapture::SaveFile(m_RecordFilePath);
+        }
+        catch(const std::exception& ex)
+        {
+            const char* errorMessage = ex.what();
+            ErrorPrinter::PrintFormat("ERROR: {}\n", std::make_format_args(errorMessage));
+        }
+    }
+    DeviceCapture::Stop();
+}
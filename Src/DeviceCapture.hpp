@@ -0,0 +1,108 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+struct CapturedCall
+{
+    // Name of the call followed by its input bytes in hexadecimal.
+    std::wstring m_Name;
+    HRESULT m_Result = E_FAIL;
+    std::vector<char> m_Output;
+};
+
+// Pointer member of an input structure passed to CaptureCall.
+// Its value differs between runs, so the call is identified by the bytes it points to instead.
+struct CapturePointer
+{
+    // Offset of the pointer within the structure.
+    size_t m_Offset = 0;
+    const void* m_Input = nullptr;
+    size_t m_InputSize = 0;
+};
+
+// Records raw results of queries to the device into a capture file, or answers them from a capture recorded
+// earlier instead of asking the device, so a report can be regenerated after the program changes.
+// A call is identified by the adapter, its name, the bytes of its input structure except pointers,
+// and the bytes those pointers point to.
+// Calls are expected to be made only from the main thread.
+class DeviceCapture
+{
+public:
+    static bool IsRecording()
+    {
+        return s_Recording;
+    }
+    static bool IsReplaying()
+    {
+        return s_Replaying;
+    }
+    static bool IsEnabled()
+    {
+        return s_Recording || s_Replaying;
+    }
+    static void StartRecording();
+    // Stops recording or replaying and forgets all the calls.
+    static void Stop();
+    // Throws on failure.
+    static void SaveFile(const std::wstring& filePath);
+    // Starts replaying calls from the file. Throws on failure.
+    static void LoadFile(const std::wstring& filePath);
+
+    // Calls made from now on belong to this adapter.
+    static void SetAdapter(std::wstring_view adapterName);
+
+    static void RecordCall(std::wstring_view callName, const std::vector<char>& input,
+        const std::vector<CapturePointer>& pointers, const void* output, size_t outputSize, HRESULT result);
+    // Returns calls recorded or loaded for the adapter, sorted by name.
+    static std::vector<CapturedCall> GetAdapterCalls(std::wstring_view adapterName);
+
+    // Returns names of the adapters having calls recorded or loaded, sorted.
+    static std::vector<std::wstring> GetAdapterNames();
+
+    // Calls missing from the capture fail with E_FAIL, so they are left out of the report like unsupported features.
+    // Pointer members of data keep their values.
+    static HRESULT ReplayCall(std::wstring_view callName, void* data, size_t dataSize,
+        const std::vector<CapturePointer>& pointers = {});
+
+private:
+    static bool s_Recording;
+    static bool s_Replaying;
+};
+
+// Makes a call that fills data of dataSize bytes, passing it through the capture.
+// pointers describe pointer members of data.
+template<typename Func>
+HRESULT CaptureCall(std::wstring_view callName, void* data, size_t dataSize, Func&& func,
+    const std::vector<CapturePointer>& pointers = {})
+{
+    if(DeviceCapture::IsReplaying())
+        return DeviceCapture::ReplayCall(callName, data, dataSize, pointers);
+    if(!DeviceCapture::IsRecording())
+        return func();
+
+    const char* const dataBytes = static_cast<const char*>(data);
+    const std::vector<char> input(dataBytes, dataBytes + dataSize);
+    const HRESULT result = func();
+    DeviceCapture::RecordCall(callName, input, pointers, data, dataSize, result);
+    return result;
+}
+
+// Records calls if recordFilePath is not empty and writes them to that file when destroyed,
+// or replays calls from replayFilePath if it is not empty.
+// If recordInMemory is true, calls are recorded even without a file to write them to.
+class DeviceCaptureScope
+{
+public:
+    DeviceCaptureScope(const std::wstring& recordFilePath, const std::wstring& replayFilePath, bool recordInMemory);
+    ~DeviceCaptureScope();
+
+private:
+    const std::wstring m_RecordFilePath;
+};
@@ -0,0 +1,1481 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "DeviceProbes.hpp"
+
+#include "Benchmark.hpp"
+#include "DeviceCapture.hpp"
+#include "DriverQuirks.hpp"
+#include "Enums.hpp"
+#include "NvApiData.hpp"
+#include "Printer.hpp"
+#include "ProbeTimings.hpp"
+#include "ReplayDevice.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+#include "ReportSelection.hpp"
+#include "Utils.hpp"
+#include "VendorApis.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+constexpr D3D12_COMMAND_LIST_TYPE COMMAND_LIST_TYPES[] = {
+    D3D12_COMMAND_LIST_TYPE_DIRECT,
+    D3D12_COMMAND_LIST_TYPE_COMPUTE,
+    D3D12_COMMAND_LIST_TYPE_COPY,
+    D3D12_COMMAND_LIST_TYPE_VIDEO_DECODE,
+    D3D12_COMMAND_LIST_TYPE_VIDEO_PROCESS,
+    D3D12_COMMAND_LIST_TYPE_VIDEO_ENCODE,
+};
+constexpr size_t COMMAND_LIST_TYPES_COUNT = _countof(COMMAND_LIST_TYPES);
+
+constexpr D3D12_COMMAND_QUEUE_PRIORITY COMMAND_QUEUE_PRIORITIES[] = { D3D12_COMMAND_QUEUE_PRIORITY_NORMAL,
+    D3D12_COMMAND_QUEUE_PRIORITY_HIGH, D3D12_COMMAND_QUEUE_PRIORITY_GLOBAL_REALTIME };
+constexpr size_t COMMAND_QUEUE_PRIORITIES_COUNT = _countof(COMMAND_QUEUE_PRIORITIES);
+
+constexpr D3D12_BARRIER_LAYOUT BARRIER_LAYOUTS[] = { D3D12_BARRIER_LAYOUT_COMMON, D3D12_BARRIER_LAYOUT_GENERIC_READ,
+    D3D12_BARRIER_LAYOUT_RENDER_TARGET, D3D12_BARRIER_LAYOUT_UNORDERED_ACCESS, D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_WRITE,
+    D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ, D3D12_BARRIER_LAYOUT_SHADER_RESOURCE, D3D12_BARRIER_LAYOUT_COPY_SOURCE,
+    D3D12_BARRIER_LAYOUT_COPY_DEST, D3D12_BARRIER_LAYOUT_RESOLVE_SOURCE, D3D12_BARRIER_LAYOUT_RESOLVE_DEST,
+    D3D12_BARRIER_LAYOUT_SHADING_RATE_SOURCE, D3D12_BARRIER_LAYOUT_VIDEO_DECODE_READ,
+    D3D12_BARRIER_LAYOUT_VIDEO_DECODE_WRITE, D3D12_BARRIER_LAYOUT_VIDEO_PROCESS_READ,
+    D3D12_BARRIER_LAYOUT_VIDEO_PROCESS_WRITE, D3D12_BARRIER_LAYOUT_VIDEO_ENCODE_READ,
+    D3D12_BARRIER_LAYOUT_VIDEO_ENCODE_WRITE, D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_COMMON,
+    D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_GENERIC_READ, D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_UNORDERED_ACCESS,
+    D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_SHADER_RESOURCE, D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_COPY_SOURCE,
+    D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_COPY_DEST, D3D12_BARRIER_LAYOUT_COMPUTE_QUEUE_COMMON,
+    D3D12_BARRIER_LAYOUT_COMPUTE_QUEUE_GENERIC_READ, D3D12_BARRIER_LAYOUT_COMPUTE_QUEUE_UNORDERED_ACCESS,
+    D3D12_BARRIER_LAYOUT_COMPUTE_QUEUE_SHADER_RESOURCE, D3D12_BARRIER_LAYOUT_COMPUTE_QUEUE_COPY_SOURCE,
+    D3D12_BARRIER_LAYOUT_COMPUTE_QUEUE_COPY_DEST,
+    D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_GENERIC_READ_COMPUTE_QUEUE_ACCESSIBLE };
+constexpr size_t BARRIER_LAYOUTS_COUNT = _countof(BARRIER_LAYOUTS);
+
+static const D3D_ROOT_SIGNATURE_VERSION HIGHEST_ROOT_SIGNATURE_VERSION = D3D_ROOT_SIGNATURE_VERSION_1_2;
+static const D3D_FEATURE_LEVEL FEATURE_LEVELS_ARRAY[] = {
+    D3D_FEATURE_LEVEL_12_2,
+    D3D_FEATURE_LEVEL_12_1,
+    D3D_FEATURE_LEVEL_12_0,
+    D3D_FEATURE_LEVEL_11_1,
+    D3D_FEATURE_LEVEL_11_0,
+};
+static const D3D_FEATURE_LEVEL MAX_FEATURE_LEVEL = D3D_FEATURE_LEVEL_12_2;
+
+// # From vkd3d-proton project, see:
+// https://github.com/HansKristian-Work/vkd3d-proton/issues/2459
+// https://github.com/HansKristian-Work/vkd3d-proton/blob/master/include/vkd3d_device_vkd3d_ext.idl
+DEFINE_GUID(IID_ID3D12DXVKInteropDevice, 0x39da4e09, 0xbd1c, 0x4198, 0x9f, 0xae, 0x86, 0xbb, 0xe3, 0xbe, 0x41, 0xfd);
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS(const D3D12_FEATURE_DATA_D3D12_OPTIONS& options)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"DoublePrecisionFloatShaderOps", options.DoublePrecisionFloatShaderOps);
+    formatter.AddFieldBool(L"OutputMergerLogicOp", options.OutputMergerLogicOp);
+    formatter.AddFieldEnum(
+        L"MinPrecisionSupport", options.MinPrecisionSupport, Enum_D3D12_SHADER_MIN_PRECISION_SUPPORT);
+    formatter.AddFieldEnum(L"TiledResourcesTier", options.TiledResourcesTier, Enum_D3D12_TILED_RESOURCES_TIER);
+    formatter.AddFieldEnum(L"ResourceBindingTier", options.ResourceBindingTier, Enum_D3D12_RESOURCE_BINDING_TIER);
+    formatter.AddFieldBool(L"PSSpecifiedStencilRefSupported", options.PSSpecifiedStencilRefSupported);
+    formatter.AddFieldBool(L"TypedUAVLoadAdditionalFormats", options.TypedUAVLoadAdditionalFormats);
+    formatter.AddFieldBool(L"ROVsSupported", options.ROVsSupported);
+    formatter.AddFieldEnum(L"ConservativeRasterizationTier", options.ConservativeRasterizationTier,
+        Enum_D3D12_CONSERVATIVE_RASTERIZATION_TIER);
+    formatter.AddFieldUint32(L"MaxGPUVirtualAddressBitsPerResource", options.MaxGPUVirtualAddressBitsPerResource);
+    formatter.AddFieldBool(L"StandardSwizzle64KBSupported", options.StandardSwizzle64KBSupported);
+    formatter.AddFieldEnum(L"CrossNodeSharingTier", options.CrossNodeSharingTier, Enum_D3D12_CROSS_NODE_SHARING_TIER);
+    formatter.AddFieldBool(L"CrossAdapterRowMajorTextureSupported", options.CrossAdapterRowMajorTextureSupported);
+    formatter.AddFieldBool(L"VPAndRTArrayIndexFromAnyShaderFeedingRasterizerSupportedWithoutGSEmulation",
+        options.VPAndRTArrayIndexFromAnyShaderFeedingRasterizerSupportedWithoutGSEmulation);
+    formatter.AddFieldEnum(L"ResourceHeapTier", options.ResourceHeapTier, Enum_D3D12_RESOURCE_HEAP_TIER);
+}
+
+static void Print_D3D12_FEATURE_DATA_ARCHITECTURE(const D3D12_FEATURE_DATA_ARCHITECTURE& architecture)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_ARCHITECTURE");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldUint32(L"NodeIndex", architecture.NodeIndex);
+    formatter.AddFieldBool(L"TileBasedRenderer", architecture.TileBasedRenderer);
+    formatter.AddFieldBool(L"UMA", architecture.UMA);
+    formatter.AddFieldBool(L"CacheCoherentUMA", architecture.CacheCoherentUMA);
+}
+
+static void Print_D3D12_FEATURE_DATA_ARCHITECTURE1(const D3D12_FEATURE_DATA_ARCHITECTURE1& architecture1)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_ARCHITECTURE1");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldUint32(L"NodeIndex", architecture1.NodeIndex);
+    formatter.AddFieldBool(L"TileBasedRenderer", architecture1.TileBasedRenderer);
+    formatter.AddFieldBool(L"UMA", architecture1.UMA);
+    formatter.AddFieldBool(L"CacheCoherentUMA", architecture1.CacheCoherentUMA);
+    formatter.AddFieldBool(L"IsolatedMMU", architecture1.IsolatedMMU);
+}
+
+static void Print_D3D12_FEATURE_DATA_FEATURE_LEVELS(const D3D12_FEATURE_DATA_FEATURE_LEVELS& featureLevels)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_FEATURE_LEVELS");
+
+    // NumFeatureLevels and pFeatureLevelsRequested are IN parameters
+    // They let the app to specify what enum values does the app expect
+    // So same API can be used when new feature levels are added in the future
+    // No need to print those IN parameters here
+    ReportFormatter::GetInstance().AddFieldEnum(
+        L"MaxSupportedFeatureLevel", featureLevels.MaxSupportedFeatureLevel, Enum_D3D_FEATURE_LEVEL);
+}
+
+static void Print_D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT(
+    const D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT& virtualAddressSupport)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT");
+    ReportFormatter::GetInstance().AddFieldUint32(
+        L"MaxGPUVirtualAddressBitsPerResource", virtualAddressSupport.MaxGPUVirtualAddressBitsPerResource);
+    ReportFormatter::GetInstance().AddFieldUint32(
+        L"MaxGPUVirtualAddressBitsPerProcess", virtualAddressSupport.MaxGPUVirtualAddressBitsPerProcess);
+}
+
+static void Print_D3D12_FEATURE_DATA_SHADER_MODEL(const D3D12_FEATURE_DATA_SHADER_MODEL& shaderModel)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SHADER_MODEL");
+    ReportFormatter::GetInstance().AddFieldEnum(
+        L"HighestShaderModel", shaderModel.HighestShaderModel, Enum_D3D_SHADER_MODEL);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS1(const D3D12_FEATURE_DATA_D3D12_OPTIONS1& options1)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS1");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"WaveOps", options1.WaveOps);
+    formatter.AddFieldUint32(L"WaveLaneCountMin", options1.WaveLaneCountMin);
+    formatter.AddFieldUint32(L"WaveLaneCountMax", options1.WaveLaneCountMax);
+    formatter.AddFieldUint32(L"TotalLaneCount", options1.TotalLaneCount);
+    formatter.AddFieldBool(L"ExpandedComputeResourceStates", options1.ExpandedComputeResourceStates);
+    formatter.AddFieldBool(L"Int64ShaderOps", options1.Int64ShaderOps);
+}
+
+static void Print_D3D12_FEATURE_DATA_ROOT_SIGNATURE(const D3D12_FEATURE_DATA_ROOT_SIGNATURE& rootSignature)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_ROOT_SIGNATURE");
+    ReportFormatter::GetInstance().AddFieldEnum(
+        L"HighestVersion", rootSignature.HighestVersion, Enum_D3D_ROOT_SIGNATURE_VERSION);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS2(const D3D12_FEATURE_DATA_D3D12_OPTIONS2& options2)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS2");
+    ReportFormatter::GetInstance().AddFieldBool(L"DepthBoundsTestSupported", options2.DepthBoundsTestSupported);
+    ReportFormatter::GetInstance().AddFieldEnum(L"ProgrammableSamplePositionsTier",
+        options2.ProgrammableSamplePositionsTier, Enum_D3D12_PROGRAMMABLE_SAMPLE_POSITIONS_TIER);
+}
+
+static void Print_D3D12_FEATURE_DATA_SHADER_CACHE(const D3D12_FEATURE_DATA_SHADER_CACHE& shaderCache)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SHADER_CACHE");
+    ReportFormatter::GetInstance().AddFieldFlags(
+        L"SupportFlags", shaderCache.SupportFlags, Enum_D3D12_SHADER_CACHE_SUPPORT_FLAGS);
+}
+
+static void Print_D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY(
+    const std::array<std::array<bool, COMMAND_QUEUE_PRIORITIES_COUNT>, COMMAND_LIST_TYPES_COUNT>& commandQueuePriority)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+
+    const wchar_t* commandListTypeNames[] = { L"TYPE_DIRECT", L"TYPE_COMPUTE", L"TYPE_COPY", L"TYPE_VIDEO_DECODE",
+        L"TYPE_VIDEO_PROCESS", L"TYPE_VIDEO_ENCODE" };
+
+    const wchar_t* commandQueuePriorityNames[] = { L"PRIORITY_NORMAL", L"PRIORITY_HIGH", L"PRIORITY_GLOBAL_REALTIME" };
+
+    for(size_t i = 0; i < COMMAND_LIST_TYPES_COUNT; ++i)
+    {
+        for(size_t j = 0; j < COMMAND_QUEUE_PRIORITIES_COUNT; ++j)
+        {
+            std::wstring fieldName = std::wstring(commandListTypeNames[i]) + L"." + commandQueuePriorityNames[j] +
+                                     L".PriorityForTypeIsSupported";
+            formatter.AddFieldBool(fieldName, commandQueuePriority[i][j]);
+        }
+    }
+}
+
+static void Print_D3D12_FEATURE_DATA_BARRIER_LAYOUT(
+    const std::array<std::array<bool, BARRIER_LAYOUTS_COUNT>, COMMAND_LIST_TYPES_COUNT>& barrierLayout)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_BARRIER_LAYOUT");
+
+    for(size_t i = 0; i < barrierLayout.size(); i++)
+    {
+        const wchar_t* commandListName = FindEnumItemName(COMMAND_LIST_TYPES[i], Enum_D3D12_COMMAND_LIST_TYPE);
+        assert(commandListName);
+
+        ReportScopeObject scopeCmdListType(commandListName);
+
+        for(size_t j = 0; j < barrierLayout[i].size(); j++)
+        {
+            const wchar_t* resourceStateName = FindEnumItemName(BARRIER_LAYOUTS[j], Enum_D3D12_BARRIER_LAYOUT);
+            assert(resourceStateName);
+            if(IsJsonOutput() || barrierLayout[i][j])
+            {
+                ReportFormatter::GetInstance().AddFieldBool(resourceStateName, barrierLayout[i][j]);
+            }
+        }
+    }
+}
+
+#ifdef USE_PREVIEW_AGILITY_SDK
+static void Print_D3D12_FEATURE_DATA_FENCE_BARRIERS(
+    const std::array<D3D12_FENCE_BARRIERS_TIER, COMMAND_LIST_TYPES_COUNT>& fenceBarriers)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_FENCE_BARRIERS");
+
+    for(size_t i = 0; i < fenceBarriers.size(); i++)
+    {
+        const wchar_t* commandListName = FindEnumItemName(COMMAND_LIST_TYPES[i], Enum_D3D12_COMMAND_LIST_TYPE);
+        assert(commandListName);
+
+        ReportFormatter::GetInstance().AddFieldEnum(commandListName, fenceBarriers[i], Enum_D3D12_FENCE_BARRIERS_TIER);
+    }
+}
+#endif
+
+static void Print_D3D12_FEATURE_DATA_SERIALIZATION(const D3D12_FEATURE_DATA_SERIALIZATION& serialization)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SERIALIZATION");
+    ReportFormatter::GetInstance().AddFieldEnum(
+        L"HeapSerializationTier", serialization.HeapSerializationTier, Enum_D3D12_HEAP_SERIALIZATION_TIER);
+}
+
+static void Print_D3D12_FEATURE_CROSS_NODE(const D3D12_FEATURE_DATA_CROSS_NODE& crossNode)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_CROSS_NODE");
+    ReportFormatter::GetInstance().AddFieldEnum(
+        L"SharingTier", crossNode.SharingTier, Enum_D3D12_CROSS_NODE_SHARING_TIER);
+    ReportFormatter::GetInstance().AddFieldBool(L"AtomicShaderInstructions", crossNode.AtomicShaderInstructions);
+}
+
+static void Print_D3D12_FEATURE_PREDICATION(const D3D12_FEATURE_DATA_PREDICATION& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_PREDICATION");
+    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
+}
+
+static void Print_D3D12_FEATURE_HARDWARE_COPY(const D3D12_FEATURE_DATA_HARDWARE_COPY& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_HARDWARE_COPY");
+    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
+}
+
+#ifdef USE_PREVIEW_AGILITY_SDK
+static void Print_D3D12_FEATURE_DATA_ASYNC_COMMANDS(const D3D12_FEATURE_DATA_ASYNC_COMMANDS& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_ASYNC_COMMANDS");
+    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
+}
+#endif
+
+static void Print_D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE(
+    const D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE");
+    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS3(const D3D12_FEATURE_DATA_D3D12_OPTIONS3& options3)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS3");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"CopyQueueTimestampQueriesSupported", options3.CopyQueueTimestampQueriesSupported);
+    formatter.AddFieldBool(L"CastingFullyTypedFormatSupported", options3.CastingFullyTypedFormatSupported);
+    formatter.AddFieldFlags(L"WriteBufferImmediateSupportFlags", options3.WriteBufferImmediateSupportFlags,
+        Enum_D3D12_COMMAND_LIST_SUPPORT_FLAGS);
+    formatter.AddFieldEnum(L"ViewInstancingTier", options3.ViewInstancingTier, Enum_D3D12_VIEW_INSTANCING_TIER);
+    formatter.AddFieldBool(L"BarycentricsSupported", options3.BarycentricsSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS4(const D3D12_FEATURE_DATA_D3D12_OPTIONS4& options4)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS4");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"MSAA64KBAlignedTextureSupported", options4.MSAA64KBAlignedTextureSupported);
+    formatter.AddFieldEnum(L"SharedResourceCompatibilityTier", options4.SharedResourceCompatibilityTier,
+        Enum_D3D12_SHARED_RESOURCE_COMPATIBILITY_TIER);
+    formatter.AddFieldBool(L"Native16BitShaderOpsSupported", options4.Native16BitShaderOpsSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS5(const D3D12_FEATURE_DATA_D3D12_OPTIONS5& options5)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS5");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"SRVOnlyTiledResourceTier3", options5.SRVOnlyTiledResourceTier3);
+    formatter.AddFieldEnum(L"RenderPassesTier", options5.RenderPassesTier, Enum_D3D12_RENDER_PASS_TIER);
+    formatter.AddFieldEnum(L"RaytracingTier", options5.RaytracingTier, Enum_D3D12_RAYTRACING_TIER);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS6(const D3D12_FEATURE_DATA_D3D12_OPTIONS6& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS6");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"AdditionalShadingRatesSupported", o.AdditionalShadingRatesSupported);
+    formatter.AddFieldBool(L"PerPrimitiveShadingRateSupportedWithViewportIndexing",
+        o.PerPrimitiveShadingRateSupportedWithViewportIndexing);
+    formatter.AddFieldEnum(
+        L"VariableShadingRateTier", o.VariableShadingRateTier, Enum_D3D12_VARIABLE_SHADING_RATE_TIER);
+    formatter.AddFieldUint32(L"ShadingRateImageTileSize", o.ShadingRateImageTileSize);
+    formatter.AddFieldBool(L"BackgroundProcessingSupported", o.BackgroundProcessingSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS7(const D3D12_FEATURE_DATA_D3D12_OPTIONS7& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS7");
+    ReportFormatter::GetInstance().AddFieldEnum(L"MeshShaderTier", o.MeshShaderTier, Enum_D3D12_MESH_SHADER_TIER);
+    ReportFormatter::GetInstance().AddFieldEnum(
+        L"SamplerFeedbackTier", o.SamplerFeedbackTier, Enum_D3D12_SAMPLER_FEEDBACK_TIER);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS8(const D3D12_FEATURE_DATA_D3D12_OPTIONS8& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS8");
+    ReportFormatter::GetInstance().AddFieldBool(L"UnalignedBlockTexturesSupported", o.UnalignedBlockTexturesSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS9(const D3D12_FEATURE_DATA_D3D12_OPTIONS9& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS9");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"MeshShaderPipelineStatsSupported", o.MeshShaderPipelineStatsSupported);
+    formatter.AddFieldBool(
+        L"MeshShaderSupportsFullRangeRenderTargetArrayIndex", o.MeshShaderSupportsFullRangeRenderTargetArrayIndex);
+    formatter.AddFieldBool(L"AtomicInt64OnTypedResourceSupported", o.AtomicInt64OnTypedResourceSupported);
+    formatter.AddFieldBool(L"AtomicInt64OnGroupSharedSupported", o.AtomicInt64OnGroupSharedSupported);
+    formatter.AddFieldBool(
+        L"DerivativesInMeshAndAmplificationShadersSupported", o.DerivativesInMeshAndAmplificationShadersSupported);
+    formatter.AddFieldEnum(L"WaveMMATier", o.WaveMMATier, Enum_D3D12_WAVE_MMA_TIER);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS10(const D3D12_FEATURE_DATA_D3D12_OPTIONS10& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS10");
+    ReportFormatter::GetInstance().AddFieldBool(
+        L"VariableRateShadingSumCombinerSupported", o.VariableRateShadingSumCombinerSupported);
+    ReportFormatter::GetInstance().AddFieldBool(
+        L"MeshShaderPerPrimitiveShadingRateSupported", o.MeshShaderPerPrimitiveShadingRateSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS11(const D3D12_FEATURE_DATA_D3D12_OPTIONS11& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS11");
+    ReportFormatter::GetInstance().AddFieldBool(
+        L"AtomicInt64OnDescriptorHeapResourceSupported", o.AtomicInt64OnDescriptorHeapResourceSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS12(const D3D12_FEATURE_DATA_D3D12_OPTIONS12& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS12");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldEnumSigned(L"MSPrimitivesPipelineStatisticIncludesCulledPrimitives",
+        o.MSPrimitivesPipelineStatisticIncludesCulledPrimitives, Enum_D3D12_TRI_STATE);
+    formatter.AddFieldBool(L"EnhancedBarriersSupported", o.EnhancedBarriersSupported);
+    formatter.AddFieldBool(L"RelaxedFormatCastingSupported", o.RelaxedFormatCastingSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS13(const D3D12_FEATURE_DATA_D3D12_OPTIONS13& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS13");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(
+        L"UnrestrictedBufferTextureCopyPitchSupported", o.UnrestrictedBufferTextureCopyPitchSupported);
+    formatter.AddFieldBool(
+        L"UnrestrictedVertexElementAlignmentSupported", o.UnrestrictedVertexElementAlignmentSupported);
+    formatter.AddFieldBool(L"InvertedViewportHeightFlipsYSupported", o.InvertedViewportHeightFlipsYSupported);
+    formatter.AddFieldBool(L"InvertedViewportDepthFlipsZSupported", o.InvertedViewportDepthFlipsZSupported);
+    formatter.AddFieldBool(L"TextureCopyBetweenDimensionsSupported", o.TextureCopyBetweenDimensionsSupported);
+    formatter.AddFieldBool(L"AlphaBlendFactorSupported", o.AlphaBlendFactorSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS14(const D3D12_FEATURE_DATA_D3D12_OPTIONS14& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS14");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"AdvancedTextureOpsSupported", o.AdvancedTextureOpsSupported);
+    formatter.AddFieldBool(L"WriteableMSAATexturesSupported", o.WriteableMSAATexturesSupported);
+    formatter.AddFieldBool(
+        L"IndependentFrontAndBackStencilRefMaskSupported", o.IndependentFrontAndBackStencilRefMaskSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS15(const D3D12_FEATURE_DATA_D3D12_OPTIONS15& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS15");
+    ReportFormatter::GetInstance().AddFieldBool(L"TriangleFanSupported", o.TriangleFanSupported);
+    ReportFormatter::GetInstance().AddFieldBool(
+        L"DynamicIndexBufferStripCutSupported", o.DynamicIndexBufferStripCutSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS16(const D3D12_FEATURE_DATA_D3D12_OPTIONS16& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS16");
+    ReportFormatter::GetInstance().AddFieldBool(L"DynamicDepthBiasSupported", o.DynamicDepthBiasSupported);
+    ReportFormatter::GetInstance().AddFieldBool(L"GPUUploadHeapSupported", o.GPUUploadHeapSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS17(const D3D12_FEATURE_DATA_D3D12_OPTIONS17& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS17");
+    ReportFormatter::GetInstance().AddFieldBool(
+        L"NonNormalizedCoordinateSamplersSupported", o.NonNormalizedCoordinateSamplersSupported);
+    ReportFormatter::GetInstance().AddFieldBool(
+        L"ManualWriteTrackingResourceSupported", o.ManualWriteTrackingResourceSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS18(const D3D12_FEATURE_DATA_D3D12_OPTIONS18& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS18");
+    ReportFormatter::GetInstance().AddFieldBool(L"RenderPassesValid", o.RenderPassesValid);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS19(const D3D12_FEATURE_DATA_D3D12_OPTIONS19& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS19");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"MismatchingOutputDimensionsSupported", o.MismatchingOutputDimensionsSupported);
+    formatter.AddFieldUint32(L"SupportedSampleCountsWithNoOutputs", o.SupportedSampleCountsWithNoOutputs);
+    formatter.AddFieldBool(L"PointSamplingAddressesNeverRoundUp", o.PointSamplingAddressesNeverRoundUp);
+    formatter.AddFieldBool(L"RasterizerDesc2Supported", o.RasterizerDesc2Supported);
+    formatter.AddFieldBool(L"NarrowQuadrilateralLinesSupported", o.NarrowQuadrilateralLinesSupported);
+    formatter.AddFieldBool(L"AnisoFilterWithPointMipSupported", o.AnisoFilterWithPointMipSupported);
+    formatter.AddFieldUint32(L"MaxSamplerDescriptorHeapSize", o.MaxSamplerDescriptorHeapSize);
+    formatter.AddFieldUint32(
+        L"MaxSamplerDescriptorHeapSizeWithStaticSamplers", o.MaxSamplerDescriptorHeapSizeWithStaticSamplers);
+    formatter.AddFieldUint32(L"MaxViewDescriptorHeapSize", o.MaxViewDescriptorHeapSize);
+    formatter.AddFieldBool(L"ComputeOnlyCustomHeapSupported", o.ComputeOnlyCustomHeapSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS20(const D3D12_FEATURE_DATA_D3D12_OPTIONS20& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS20");
+    ReportFormatter::GetInstance().AddFieldBool(L"ComputeOnlyWriteWatchSupported", o.ComputeOnlyWriteWatchSupported);
+    ReportFormatter::GetInstance().AddFieldEnum(L"RecreateAtTier", o.RecreateAtTier, Enum_D3D12_RECREATE_AT_TIER);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS21(const D3D12_FEATURE_DATA_D3D12_OPTIONS21& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS21");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldEnum(L"WorkGraphsTier", o.WorkGraphsTier, Enum_D3D12_WORK_GRAPHS_TIER);
+    formatter.AddFieldEnum(L"ExecuteIndirectTier", o.ExecuteIndirectTier, Enum_D3D12_EXECUTE_INDIRECT_TIER);
+    formatter.AddFieldBool(L"SampleCmpGradientAndBiasSupported", o.SampleCmpGradientAndBiasSupported);
+    formatter.AddFieldBool(L"ExtendedCommandInfoSupported", o.ExtendedCommandInfoSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS22(const D3D12_FEATURE_DATA_D3D12_OPTIONS22& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS22");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"ShaderExecutionReorderingActuallyReorders", o.ShaderExecutionReorderingActuallyReorders);
+    formatter.AddFieldBool(L"CreateByteOffsetViewsSupported", o.CreateByteOffsetViewsSupported);
+    formatter.AddFieldUint32(L"Max1DDispatchSize", o.Max1DDispatchSize);
+    formatter.AddFieldUint32(L"Max1DDispatchMeshSize", o.Max1DDispatchMeshSize);
+}
+
+static void Print_D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED(
+    const D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED");
+    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
+}
+
+static void Print_D3D12_FEATURE_DATA_TIGHT_ALIGNMENT(const D3D12_FEATURE_DATA_TIGHT_ALIGNMENT& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_TIGHT_ALIGNMENT");
+    ReportFormatter::GetInstance().AddFieldEnum(L"SupportTier", o.SupportTier, Enum_D3D12_TIGHT_ALIGNMENT_TIER);
+}
+
+#ifndef USE_PREVIEW_AGILITY_SDK
+static void Print_D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT(
+    const D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT& shaderCacheABISupport)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT");
+    ReportFormatter::GetInstance().AddFieldString(L"szAdapterFamily", shaderCacheABISupport.szAdapterFamily);
+    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
+        L"MinimumABISupportVersion", shaderCacheABISupport.MinimumABISupportVersion);
+    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
+        L"MaximumABISupportVersion", shaderCacheABISupport.MaximumABISupportVersion);
+    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
+        L"CompilerVersion", shaderCacheABISupport.CompilerVersion.Version);
+    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
+        L"ApplicationProfileVersion", shaderCacheABISupport.ApplicationProfileVersion.Version);
+}
+#endif
+
+#ifdef USE_PREVIEW_AGILITY_SDK
+static void Print_D3D12_FEATURE_DATA_PARTIAL_GRAPHICS_PROGRAMS(
+    const D3D12_FEATURE_DATA_PARTIAL_GRAPHICS_PROGRAMS& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_PARTIAL_GRAPHICS_PROGRAMS");
+    ReportFormatter::GetInstance().AddFieldEnum(
+        L"PartialGraphicsProgramsTier", o.PartialGraphicsProgramsTier, Enum_D3D12_PARTIAL_GRAPHICS_PROGRAMS_TIER);
+}
+
+static void Print_D3D12_FEATURE_DATA_DUMP_FILE(const D3D12_FEATURE_DATA_DUMP_FILE& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_DUMP_FILE");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"Supported", o.Supported);
+    formatter.AddFieldEnum(L"DumpFileDriverTier", o.DumpFileDriverTier, Enum_D3D12_DUMP_FILE_DRIVER_TIER);
+    formatter.AddFieldFlags(L"DumpFileDriverOptionsMask", o.DumpFileDriverOptionsMask, Enum_D3D12_DUMP_FILE_DRIVER_OPTIONS);
+}
+
+static void Print_D3D12_FEATURE_DATA_USER_DEFINED_ANNOTATION(const D3D12_FEATURE_DATA_USER_DEFINED_ANNOTATION& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_USER_DEFINED_ANNOTATION");
+    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
+}
+
+static void Print_D3D12_FEATURE_DATA_DEBUG_BREAK(const D3D12_FEATURE_DATA_DEBUG_BREAK& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_DEBUG_BREAK");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldBool(L"HaltSupported", o.HaltSupported);
+    formatter.AddFieldBool(L"LiveDebuggingSupported", o.LiveDebuggingSupported);
+    formatter.AddFieldBool(L"CpuSupported", o.CpuSupported);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_MLIR(const D3D12_FEATURE_DATA_D3D12_OPTIONS_MLIR& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS_MLIR");
+    ReportFormatter::GetInstance().AddFieldEnum(L"MlirProgramsTier", o.MlirProgramsTier, Enum_D3D12_MLIR_PROGRAMS_TIER);
+}
+
+static void Print_D3D12_FEATURE_DATA_LINEAR_ALGEBRA_SUPPORT(const D3D12_FEATURE_DATA_LINEAR_ALGEBRA_SUPPORT& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_LINEAR_ALGEBRA_SUPPORT");
+    ReportFormatter::GetInstance().AddFieldEnum(
+        L"LinearAlgebraTier", o.LinearAlgebraTier, Enum_D3D12_LINEAR_ALGEBRA_TIER);
+}
+
+static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_PREVIEW(const D3D12_FEATURE_DATA_D3D12_OPTIONS_PREVIEW& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS_PREVIEW");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+
+    formatter.AddFieldUint32(L"MaxGroupSharedMemoryPerGroupCS", o.MaxGroupSharedMemoryPerGroupCS);
+    formatter.AddFieldUint32(L"MaxGroupSharedMemoryPerGroupAS", o.MaxGroupSharedMemoryPerGroupAS);
+    formatter.AddFieldUint32(L"MaxGroupSharedMemoryPerGroupMS", o.MaxGroupSharedMemoryPerGroupMS);
+    formatter.AddFieldBool(L"UAVOfDepthStencilSupported", o.UAVOfDepthStencilSupported);
+    formatter.AddFieldBool(L"D32S8Interleaved", o.D32S8Interleaved);
+}
+
+static void Print_D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS(
+    const D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS& o)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldUint32(L"ComputeQueuesPer3DQueue", o.ComputeQueuesPer3DQueue);
+}
+#endif // #ifdef USE_PREVIEW_AGILITY_SDK
+
+static void Print_D3D12_FEATURE_DATA_EXISTING_HEAPS(const D3D12_FEATURE_DATA_EXISTING_HEAPS& existingHeaps)
+{
+    ReportScopeObject scope(L"D3D12_FEATURE_DATA_EXISTING_HEAPS");
+    ReportFormatter::GetInstance().AddFieldBool(L"Supported", existingHeaps.Supported);
+}
+
+static void Print_DXGI_QUERY_VIDEO_MEMORY_INFO(const DXGI_QUERY_VIDEO_MEMORY_INFO& videoMemoryInfo)
+{
+    // Not printing videoMemoryInfo.CurrentUsage, videoMemoryInfo.CurrentReservation.
+    ReportFormatter::GetInstance().AddFieldSize(L"Budget", videoMemoryInfo.Budget);
+    ReportFormatter::GetInstance().AddFieldSize(L"AvailableForReservation", videoMemoryInfo.AvailableForReservation);
+}
+
+static void PrintAdapterDescMembers(const DXGI_ADAPTER_DESC& desc)
+{
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldString(L"Description", desc.Description);
+    formatter.AddFieldVendorId(L"VendorId", desc.VendorId);
+    formatter.AddFieldHex32(L"DeviceId", desc.DeviceId);
+    formatter.AddFieldSubsystemId(L"SubSysId", desc.SubSysId);
+    formatter.AddFieldHex32(L"Revision", desc.Revision);
+    formatter.AddFieldSize(L"DedicatedVideoMemory", desc.DedicatedVideoMemory);
+    formatter.AddFieldSize(L"DedicatedSystemMemory", desc.DedicatedSystemMemory);
+    formatter.AddFieldSize(L"SharedSystemMemory", desc.SharedSystemMemory);
+    formatter.AddFieldString(L"AdapterLuid", LuidToStr(desc.AdapterLuid).c_str());
+}
+
+static void PrintAdapterDesc1Members(const DXGI_ADAPTER_DESC1& desc1)
+{
+    PrintAdapterDescMembers((const DXGI_ADAPTER_DESC&)desc1);
+    ReportFormatter::GetInstance().AddFieldFlags(L"Flags", desc1.Flags, Enum_DXGI_ADAPTER_FLAG);
+}
+
+static void PrintAdapterDesc2Members(const DXGI_ADAPTER_DESC2& desc2)
+{
+    PrintAdapterDesc1Members((const DXGI_ADAPTER_DESC1&)desc2);
+    ReportFormatter::GetInstance().AddFieldEnum(L"GraphicsPreemptionGranularity", desc2.GraphicsPreemptionGranularity,
+        Enum_DXGI_GRAPHICS_PREEMPTION_GRANULARITY);
+    ReportFormatter::GetInstance().AddFieldEnum(
+        L"ComputePreemptionGranularity", desc2.ComputePreemptionGranularity, Enum_DXGI_COMPUTE_PREEMPTION_GRANULARITY);
+}
+
+static void PrintAdapterDesc(const DXGI_ADAPTER_DESC& desc)
+{
+    ReportScopeObject scope(L"DXGI_ADAPTER_DESC");
+    PrintAdapterDescMembers(desc);
+}
+
+static void PrintAdapterDesc2(const DXGI_ADAPTER_DESC2& desc2)
+{
+    ReportScopeObject scope(L"DXGI_ADAPTER_DESC2");
+    PrintAdapterDesc2Members(desc2);
+}
+
+static void PrintAdapterDesc3(const DXGI_ADAPTER_DESC3& desc3)
+{
+    ReportScopeObject scope(L"DXGI_ADAPTER_DESC3");
+    // Same members as DESC2. They only added new items to Flags.
+    PrintAdapterDesc2Members((const DXGI_ADAPTER_DESC2&)desc3);
+}
+
+
+static bool IsFeatureDataSelected(D3D12_FEATURE feature);
+
+// Returned by CheckFeatureSupportSafe when the driver crashed.
+static const HRESULT HRESULT_CRASHED = HRESULT_FROM_WIN32(ERROR_UNHANDLED_EXCEPTION);
+
+// For queries of format support and the ones that driver quirks route through the safe path.
+// It can't have objects with destructors.
+static HRESULT CheckFeatureSupportSafe(ID3D12Device* device, D3D12_FEATURE feature, void* featureSupportData,
+    UINT featureSupportDataSize)
+{
+    __try
+    {
+        return device->CheckFeatureSupport(feature, featureSupportData, featureSupportDataSize);
+    }
+    __except(EXCEPTION_EXECUTE_HANDLER)
+    {
+        return HRESULT_CRASHED;
+    }
+}
+
+// Name of the feature as a probe, also used to find driver quirks. Features unknown to this program are named by their
+// number. Probe names must be static strings, so those are kept until the program ends.
+static const wchar_t* GetFeatureProbeName(D3D12_FEATURE feature)
+{
+    if(const wchar_t* name = FindEnumItemName(feature, Enum_D3D12_FEATURE))
+        return name;
+    static std::mutex mutex;
+    static std::unordered_map<uint32_t, std::wstring> numericNames;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto [it, inserted] = numericNames.try_emplace(uint32_t(feature));
+    if(inserted)
+        it->second = std::format(L"D3D12_FEATURE {}", uint32_t(feature));
+    return it->second.c_str();
+}
+
+// Every query of ID3D12Device::CheckFeatureSupport goes through here, so it can be measured as a probe,
+// recorded or replayed, and skipped or made safe by driver quirks.
+// Quirks of the feature apply, unless the caller passes quirkAction found for a more specific probe.
+// Features that are not selected fail without being queried.
+static HRESULT CheckFeatureSupport(ID3D12Device* device, D3D12_FEATURE feature, void* featureSupportData,
+    UINT featureSupportDataSize, std::optional<QuirkAction> quirkAction = std::nullopt)
+{
+    if(ReportSelection::IsEnabled() && !IsFeatureDataSelected(feature))
+        return E_NOTIMPL;
+    if(!quirkAction)
+    {
+        quirkAction =
+            DriverQuirks::IsAnyActive() ? DriverQuirks::Find(GetFeatureProbeName(feature)) : QuirkAction::Query;
+    }
+    if(*quirkAction == QuirkAction::Skip)
+        return E_NOTIMPL;
+
+    ProbeTimer timer(AreProbesObserved() ? GetFeatureProbeName(feature) : nullptr);
+    auto call = [&]() {
+        if(*quirkAction == QuirkAction::Safe)
+            return CheckFeatureSupportSafe(device, feature, featureSupportData, featureSupportDataSize);
+        return device->CheckFeatureSupport(feature, featureSupportData, featureSupportDataSize);
+    };
+    if(!DeviceCapture::IsEnabled())
+        return call();
+    return CaptureCall(GetCheckFeatureSupportCallName(feature), featureSupportData, featureSupportDataSize, call,
+        GetFeatureDataCapturePointers(feature, featureSupportData));
+}
+
+// Decodes a structure returned by CheckFeatureSupport into the report,
+// or with --Raw, only stores its bytes, to be decoded later by PrintRawFeatureDataReport.
+template<typename T>
+static void PrintFeatureData(D3D12_FEATURE feature, const T& data, void (*print)(const T&))
+{
+    if(RawFeatureData::IsRecording())
+        RawFeatureData::AddRecord(uint32_t(feature), &data, sizeof(data));
+    else
+        print(data);
+}
+
+struct RawRecordDecoder
+{
+    uint32_t m_Id;
+    size_t m_DataSize;
+    // Name of the section of the report printed by m_Decode.
+    const wchar_t* m_Name;
+    void (*m_Decode)(const void* data);
+};
+
+template<typename T, void (*Print)(const T&)>
+static void DecodeRawRecord(const void* data)
+{
+    // Data of a record is not necessarily aligned.
+    T value;
+    memcpy(&value, data, sizeof(value));
+    Print(value);
+}
+
+#define RAW_RECORD_DECODER(id, type, print) { uint32_t(id), sizeof(type), L"" #type, DecodeRawRecord<type, print> },
+
+// Every structure passed to PrintFeatureData must be listed here.
+static const RawRecordDecoder RAW_RECORD_DECODERS[] = {
+    // clang-format off
+    RAW_RECORD_DECODER(RawFeatureData::ADAPTER_RECORD_ID, DXGI_ADAPTER_DESC1, PrintAdapterDesc1)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS, D3D12_FEATURE_DATA_D3D12_OPTIONS, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS)
+    RAW_RECORD_DECODER(D3D12_FEATURE_ARCHITECTURE, D3D12_FEATURE_DATA_ARCHITECTURE, Print_D3D12_FEATURE_DATA_ARCHITECTURE)
+    RAW_RECORD_DECODER(D3D12_FEATURE_ARCHITECTURE1, D3D12_FEATURE_DATA_ARCHITECTURE1, Print_D3D12_FEATURE_DATA_ARCHITECTURE1)
+    RAW_RECORD_DECODER(D3D12_FEATURE_FEATURE_LEVELS, D3D12_FEATURE_DATA_FEATURE_LEVELS, Print_D3D12_FEATURE_DATA_FEATURE_LEVELS)
+    RAW_RECORD_DECODER(D3D12_FEATURE_GPU_VIRTUAL_ADDRESS_SUPPORT, D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT, Print_D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT)
+    RAW_RECORD_DECODER(D3D12_FEATURE_SHADER_MODEL, D3D12_FEATURE_DATA_SHADER_MODEL, Print_D3D12_FEATURE_DATA_SHADER_MODEL)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS1, D3D12_FEATURE_DATA_D3D12_OPTIONS1, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS1)
+    RAW_RECORD_DECODER(D3D12_FEATURE_ROOT_SIGNATURE, D3D12_FEATURE_DATA_ROOT_SIGNATURE, Print_D3D12_FEATURE_DATA_ROOT_SIGNATURE)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS2, D3D12_FEATURE_DATA_D3D12_OPTIONS2, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS2)
+    RAW_RECORD_DECODER(D3D12_FEATURE_SHADER_CACHE, D3D12_FEATURE_DATA_SHADER_CACHE, Print_D3D12_FEATURE_DATA_SHADER_CACHE)
+    RAW_RECORD_DECODER(D3D12_FEATURE_SERIALIZATION, D3D12_FEATURE_DATA_SERIALIZATION, Print_D3D12_FEATURE_DATA_SERIALIZATION)
+    RAW_RECORD_DECODER(D3D12_FEATURE_CROSS_NODE, D3D12_FEATURE_DATA_CROSS_NODE, Print_D3D12_FEATURE_CROSS_NODE)
+    RAW_RECORD_DECODER(D3D12_FEATURE_PREDICATION, D3D12_FEATURE_DATA_PREDICATION, Print_D3D12_FEATURE_PREDICATION)
+    RAW_RECORD_DECODER(D3D12_FEATURE_HARDWARE_COPY, D3D12_FEATURE_DATA_HARDWARE_COPY, Print_D3D12_FEATURE_HARDWARE_COPY)
+    RAW_RECORD_DECODER(D3D12_FEATURE_APPLICATION_SPECIFIC_DRIVER_STATE, D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE, Print_D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS3, D3D12_FEATURE_DATA_D3D12_OPTIONS3, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS3)
+    RAW_RECORD_DECODER(D3D12_FEATURE_EXISTING_HEAPS, D3D12_FEATURE_DATA_EXISTING_HEAPS, Print_D3D12_FEATURE_DATA_EXISTING_HEAPS)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS4, D3D12_FEATURE_DATA_D3D12_OPTIONS4, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS4)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS5, D3D12_FEATURE_DATA_D3D12_OPTIONS5, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS5)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS6, D3D12_FEATURE_DATA_D3D12_OPTIONS6, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS6)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS7, D3D12_FEATURE_DATA_D3D12_OPTIONS7, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS7)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS8, D3D12_FEATURE_DATA_D3D12_OPTIONS8, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS8)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS9, D3D12_FEATURE_DATA_D3D12_OPTIONS9, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS9)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS10, D3D12_FEATURE_DATA_D3D12_OPTIONS10, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS10)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS11, D3D12_FEATURE_DATA_D3D12_OPTIONS11, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS11)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS12, D3D12_FEATURE_DATA_D3D12_OPTIONS12, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS12)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS13, D3D12_FEATURE_DATA_D3D12_OPTIONS13, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS13)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS14, D3D12_FEATURE_DATA_D3D12_OPTIONS14, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS14)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS15, D3D12_FEATURE_DATA_D3D12_OPTIONS15, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS15)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS16, D3D12_FEATURE_DATA_D3D12_OPTIONS16, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS16)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS17, D3D12_FEATURE_DATA_D3D12_OPTIONS17, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS17)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS18, D3D12_FEATURE_DATA_D3D12_OPTIONS18, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS18)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS19, D3D12_FEATURE_DATA_D3D12_OPTIONS19, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS19)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS20, D3D12_FEATURE_DATA_D3D12_OPTIONS20, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS20)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS21, D3D12_FEATURE_DATA_D3D12_OPTIONS21, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS21)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS22, D3D12_FEATURE_DATA_D3D12_OPTIONS22, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS22)
+    RAW_RECORD_DECODER(D3D12_FEATURE_BYTECODE_BYPASS_HASH_SUPPORTED, D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED, Print_D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_TIGHT_ALIGNMENT, D3D12_FEATURE_DATA_TIGHT_ALIGNMENT, Print_D3D12_FEATURE_DATA_TIGHT_ALIGNMENT)
+#ifndef USE_PREVIEW_AGILITY_SDK
+    RAW_RECORD_DECODER(D3D12_FEATURE_SHADER_CACHE_ABI_SUPPORT, D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT, Print_D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT)
+#endif
+#ifdef USE_PREVIEW_AGILITY_SDK
+    RAW_RECORD_DECODER(D3D12_FEATURE_ASYNC_COMMANDS, D3D12_FEATURE_DATA_ASYNC_COMMANDS, Print_D3D12_FEATURE_DATA_ASYNC_COMMANDS)
+    RAW_RECORD_DECODER(D3D12_FEATURE_HARDWARE_SCHEDULING_QUEUE_GROUPINGS, D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS, Print_D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS_MLIR, D3D12_FEATURE_DATA_D3D12_OPTIONS_MLIR, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_MLIR)
+    RAW_RECORD_DECODER(D3D12_FEATURE_LINEAR_ALGEBRA_SUPPORT, D3D12_FEATURE_DATA_LINEAR_ALGEBRA_SUPPORT, Print_D3D12_FEATURE_DATA_LINEAR_ALGEBRA_SUPPORT)
+    RAW_RECORD_DECODER(D3D12_FEATURE_D3D12_OPTIONS_PREVIEW, D3D12_FEATURE_DATA_D3D12_OPTIONS_PREVIEW, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_PREVIEW)
+    RAW_RECORD_DECODER(D3D12_FEATURE_PARTIAL_GRAPHICS_PROGRAMS, D3D12_FEATURE_DATA_PARTIAL_GRAPHICS_PROGRAMS, Print_D3D12_FEATURE_DATA_PARTIAL_GRAPHICS_PROGRAMS)
+    RAW_RECORD_DECODER(D3D12_FEATURE_DUMP_FILE, D3D12_FEATURE_DATA_DUMP_FILE, Print_D3D12_FEATURE_DATA_DUMP_FILE)
+    RAW_RECORD_DECODER(D3D12_FEATURE_USER_DEFINED_ANNOTATION, D3D12_FEATURE_DATA_USER_DEFINED_ANNOTATION, Print_D3D12_FEATURE_DATA_USER_DEFINED_ANNOTATION)
+    RAW_RECORD_DECODER(D3D12_FEATURE_DEBUG_BREAK, D3D12_FEATURE_DATA_DEBUG_BREAK, Print_D3D12_FEATURE_DATA_DEBUG_BREAK)
+#endif
+    // clang-format on
+};
+
+#undef RAW_RECORD_DECODER
+
+// Features printed as a section of their own are queried only if the section is selected.
+// Others, like D3D12_FEATURE_FORMAT_SUPPORT, are queried as a part of a bigger section, which decides for them.
+static bool IsFeatureDataSelected(D3D12_FEATURE feature)
+{
+    for(const RawRecordDecoder& decoder : RAW_RECORD_DECODERS)
+    {
+        if(decoder.m_Id == uint32_t(feature))
+            return ReportSelection::IsSelected(decoder.m_Name);
+    }
+    return true;
+}
+
+enum class FormatSupportResult
+{
+    Ok,
+    Failed,
+    Crashed
+};
+
+// Drivers crash on formats no quirk knows about yet, like AMD did on DXGI_FORMAT_A4B4G4R4_UNORM (as of November 2023),
+// so these queries are always made under a structured exception handler, unless a quirk skips them.
+static FormatSupportResult CheckFormatSupport(
+    ID3D12Device* device, D3D12_FEATURE_DATA_FORMAT_SUPPORT& formatSupport, QuirkAction quirkAction)
+{
+    if(quirkAction == QuirkAction::Query)
+        quirkAction = QuirkAction::Safe;
+    const HRESULT hr = CheckFeatureSupport(
+        device, D3D12_FEATURE_FORMAT_SUPPORT, &formatSupport, UINT(sizeof formatSupport), quirkAction);
+    if(hr == HRESULT_CRASHED)
+        return FormatSupportResult::Crashed;
+    return SUCCEEDED(hr) ? FormatSupportResult::Ok : FormatSupportResult::Failed;
+}
+
+static void PrintFormatInformation(ID3D12Device* device)
+{
+    ReportScopeObject scope(L"Formats");
+    ProbeScope probeScope(L"Formats");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+
+    D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = {};
+    D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS msQualityLevels = {};
+    D3D12_FEATURE_DATA_FORMAT_INFO formatInfo = {};
+    for(size_t formatIndex = 0; Enum_DXGI_FORMAT[formatIndex].m_Name != nullptr; ++formatIndex)
+    {
+        const DXGI_FORMAT format = (DXGI_FORMAT)Enum_DXGI_FORMAT[formatIndex].m_Value;
+        const wchar_t* name = Enum_DXGI_FORMAT[formatIndex].m_Name;
+
+        // JSON names formats by value, but they can be selected by name too, e.g. "DXGI_FORMAT_BC*".
+        const std::wstring scopeName = IsJsonOutput() ? std::format(L"{}", (size_t)format) : std::wstring(name);
+        if(!ReportSelection::IsSelected(scopeName, name))
+            continue;
+
+        // Quirks can skip formats that crash or hang in specific drivers.
+        const QuirkAction quirkAction = DriverQuirks::Find(name);
+        if(quirkAction == QuirkAction::Skip)
+            continue;
+
+        BenchmarkScope benchmarkScope(name, Benchmark::Kind::Format);
+        formatSupport.Format = format;
+
+        const FormatSupportResult formatSupportResult = CheckFormatSupport(device, formatSupport, quirkAction);
+        if(formatSupportResult == FormatSupportResult::Crashed)
+        {
+            ErrorPrinter::PrintFormat(
+                L"ERROR: ID3D12Device::CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, {}) crashed.\n",
+                std::make_wformat_args(name));
+            continue;
+        }
+
+        ReportSelection::AliasScope aliasScope(name);
+        ReportScopeObjectConditional scope2(scopeName);
+
+        if(formatSupportResult == FormatSupportResult::Ok)
+        {
+            scope2.Enable();
+            formatter.AddFieldFlags(L"Support1", formatSupport.Support1, Enum_D3D12_FORMAT_SUPPORT1);
+            formatter.AddFieldFlags(L"Support2", formatSupport.Support2, Enum_D3D12_FORMAT_SUPPORT2);
+
+            ReportScopeObjectConditional scope3(IsJsonOutput(), L"MultisampleQualityLevels");
+            msQualityLevels.Format = format;
+            for(msQualityLevels.SampleCount = 1;; msQualityLevels.SampleCount *= 2)
+            {
+                if(SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS, &msQualityLevels,
+                       UINT(sizeof msQualityLevels))) &&
+                    msQualityLevels.NumQualityLevels > 0)
+                {
+                    if(IsJsonOutput())
+                    {
+                        ReportScopeObject scope4(std::format(L"{}", msQualityLevels.SampleCount));
+                        formatter.AddFieldUint32(L"NumQualityLevels", msQualityLevels.NumQualityLevels);
+                        formatter.AddFieldUint32(L"Flags", uint32_t(msQualityLevels.Flags));
+                    }
+                    else
+                    {
+                        bool multisampleTiled =
+                            (msQualityLevels.Flags & D3D12_MULTISAMPLE_QUALITY_LEVELS_FLAG_TILED_RESOURCE) != 0;
+                        formatter.AddFieldString(L"SampleCount",
+                            std::format(L"{}: NumQualityLevels = {}{}", msQualityLevels.SampleCount,
+                                msQualityLevels.NumQualityLevels,
+                                multisampleTiled ? L"  D3D12_MULTISAMPLE_QUALITY_LEVELS_FLAG_TILED_RESOURCE" : L""));
+                    }
+                }
+                else
+                    break;
+            }
+        }
+
+        formatInfo.Format = format;
+        if(SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_FORMAT_INFO, &formatInfo, UINT(sizeof formatInfo))))
+        {
+            scope2.Enable();
+            formatter.AddFieldUint32(L"PlaneCount", formatInfo.PlaneCount);
+        }
+    }
+}
+
+static void DetectTranslationLayersDevice(ID3D12Device* device)
+{
+    ReportScopeObjectConditional scope(L"TranslationLayerDetection");
+
+    // WARNING for Game Developers!
+    // If you are looking at this code as a reference to implement something in a game engine
+    // You likely should NOT try to detect vkd3d-proton
+    // You really shouldn't make any assumptions based on whether you are running under vkd3d-proton
+    // If there's some features that are not available under vkd3d-proton, you should just query support for those
+    // features from normal d3d12 interfaces (or vendor extension interfaces if you use those)
+    // No engine logic should depend on such detection
+    ComPtr<IUnknown> vkd3dInteropDevice;
+    HRESULT hr = device->QueryInterface(IID_ID3D12DXVKInteropDevice, &vkd3dInteropDevice);
+
+    if(SUCCEEDED(hr) && vkd3dInteropDevice)
+    {
+        scope.Enable();
+        ReportFormatter::GetInstance().AddFieldBool(L"ID3D12DXVKInteropDevice", true);
+    }
+}
+
+static void PrintDeviceOptions(ID3D12Device* device)
+{
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS1, options1, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS1);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS2 options2 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS2, &options2, sizeof(options2))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS2, options2, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS2);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS3 options3 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS3, &options3, sizeof(options3))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS3, options3, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS3);
+
+    if(D3D12_FEATURE_DATA_EXISTING_HEAPS existingHeaps = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_EXISTING_HEAPS, &existingHeaps, sizeof(existingHeaps))))
+        PrintFeatureData(D3D12_FEATURE_EXISTING_HEAPS, existingHeaps, Print_D3D12_FEATURE_DATA_EXISTING_HEAPS);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS4 options4 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS4, &options4, sizeof(options4))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS4, options4, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS4);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS5 options5 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS5, &options5, sizeof(options5))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS5, options5, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS5);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS6 options6 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS6, &options6, sizeof(options6))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS6, options6, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS6);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS7 options7 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS7, &options7, sizeof(options7))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS7, options7, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS7);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS8 options8 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS8, &options8, sizeof(options8))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS8, options8, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS8);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS9 options9 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS9, &options9, sizeof(options9))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS9, options9, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS9);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS10 options10 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS10, &options10, sizeof(options10))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS10, options10, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS10);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS11 options11 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS11, &options11, sizeof(options11))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS11, options11, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS11);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS12 options12 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS12, &options12, sizeof(options12))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS12, options12, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS12);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS13 options13 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS13, &options13, sizeof(options13))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS13, options13, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS13);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS14 options14 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS14, &options14, sizeof(options14))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS14, options14, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS14);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS15 options15 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS15, &options15, sizeof(options15))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS15, options15, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS15);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS16 options16 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS16, &options16, sizeof(options16))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS16, options16, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS16);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS17 options17 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS17, &options17, sizeof(options17))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS17, options17, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS17);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS18 options18 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS18, &options18, sizeof(options18))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS18, options18, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS18);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS19 options19 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS19, &options19, sizeof(options19))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS19, options19, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS19);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS20 options20 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS20, &options20, sizeof(options20))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS20, options20, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS20);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS21 options21 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS21, &options21, sizeof(options21))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS21, options21, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS21);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS22 options22 = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS22, &options22, sizeof(options22))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS22, options22, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS22);
+
+    if(D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED bytecodeBypassHashSupported = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_BYTECODE_BYPASS_HASH_SUPPORTED,
+            &bytecodeBypassHashSupported, sizeof(bytecodeBypassHashSupported))))
+        PrintFeatureData(D3D12_FEATURE_BYTECODE_BYPASS_HASH_SUPPORTED, bytecodeBypassHashSupported,
+            Print_D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED);
+
+    if(D3D12_FEATURE_DATA_TIGHT_ALIGNMENT tightAlignment = {}; SUCCEEDED(
+           CheckFeatureSupport(device, D3D12_FEATURE_D3D12_TIGHT_ALIGNMENT, &tightAlignment, sizeof(tightAlignment))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_TIGHT_ALIGNMENT, tightAlignment, Print_D3D12_FEATURE_DATA_TIGHT_ALIGNMENT);
+
+#ifndef USE_PREVIEW_AGILITY_SDK
+    if(D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT shaderCacheABISupport = {}; SUCCEEDED(CheckFeatureSupport(
+           device, D3D12_FEATURE_SHADER_CACHE_ABI_SUPPORT, &shaderCacheABISupport, sizeof(shaderCacheABISupport))))
+        PrintFeatureData(D3D12_FEATURE_SHADER_CACHE_ABI_SUPPORT, shaderCacheABISupport,
+            Print_D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT);
+#endif
+
+#ifdef USE_PREVIEW_AGILITY_SDK
+    if(D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS groupings = {}; SUCCEEDED(CheckFeatureSupport(
+           device, D3D12_FEATURE_HARDWARE_SCHEDULING_QUEUE_GROUPINGS, &groupings, sizeof(groupings))))
+        PrintFeatureData(D3D12_FEATURE_HARDWARE_SCHEDULING_QUEUE_GROUPINGS, groupings,
+            Print_D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS_MLIR optionsMlir = {}; SUCCEEDED(
+           CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS_MLIR, &optionsMlir, sizeof(optionsMlir))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS_MLIR, optionsMlir, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_MLIR);
+
+    if(D3D12_FEATURE_DATA_LINEAR_ALGEBRA_SUPPORT linearAlgebraSupport = {}; SUCCEEDED(
+           CheckFeatureSupport(device, D3D12_FEATURE_LINEAR_ALGEBRA_SUPPORT, &linearAlgebraSupport,
+               sizeof(linearAlgebraSupport))))
+        PrintFeatureData(D3D12_FEATURE_LINEAR_ALGEBRA_SUPPORT, linearAlgebraSupport,
+            Print_D3D12_FEATURE_DATA_LINEAR_ALGEBRA_SUPPORT);
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS_PREVIEW optionsPreview = {}; SUCCEEDED(
+           CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS_PREVIEW, &optionsPreview, sizeof(optionsPreview))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS_PREVIEW, optionsPreview,
+            Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_PREVIEW);
+
+    if(D3D12_FEATURE_DATA_PARTIAL_GRAPHICS_PROGRAMS partialGraphicsPrograms = {}; SUCCEEDED(CheckFeatureSupport(
+           device, D3D12_FEATURE_PARTIAL_GRAPHICS_PROGRAMS, &partialGraphicsPrograms, sizeof(partialGraphicsPrograms))))
+        PrintFeatureData(D3D12_FEATURE_PARTIAL_GRAPHICS_PROGRAMS, partialGraphicsPrograms,
+            Print_D3D12_FEATURE_DATA_PARTIAL_GRAPHICS_PROGRAMS);
+
+    if(D3D12_FEATURE_DATA_DUMP_FILE dumpFile = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_DUMP_FILE, &dumpFile, sizeof(dumpFile))))
+        PrintFeatureData(D3D12_FEATURE_DUMP_FILE, dumpFile, Print_D3D12_FEATURE_DATA_DUMP_FILE);
+
+    if(D3D12_FEATURE_DATA_USER_DEFINED_ANNOTATION userDefinedAnnotation = {}; SUCCEEDED(CheckFeatureSupport(
+           device, D3D12_FEATURE_USER_DEFINED_ANNOTATION, &userDefinedAnnotation, sizeof(userDefinedAnnotation))))
+        PrintFeatureData(D3D12_FEATURE_USER_DEFINED_ANNOTATION, userDefinedAnnotation,
+            Print_D3D12_FEATURE_DATA_USER_DEFINED_ANNOTATION);
+
+    if(D3D12_FEATURE_DATA_DEBUG_BREAK debugBreak = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_DEBUG_BREAK, &debugBreak, sizeof(debugBreak))))
+        PrintFeatureData(D3D12_FEATURE_DEBUG_BREAK, debugBreak, Print_D3D12_FEATURE_DATA_DEBUG_BREAK);
+#endif
+}
+
+// Recorded or replayed like CheckFeatureSupport, with the heap type as the input.
+static UINT GetDescriptorHandleIncrementSize(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE heapType)
+{
+    DescriptorHandleIncrementSizeCall data = { heapType, 0 };
+    CaptureCall(L"GetDescriptorHandleIncrementSize", &data, sizeof(data), [&]() {
+        data.m_Size = device->GetDescriptorHandleIncrementSize(heapType);
+        return S_OK;
+    });
+    return data.m_Size;
+}
+
+static void PrintDescriptorSizes(ID3D12Device* device)
+{
+    ReportScopeObject scope(L"GetDescriptorHandleIncrementSize");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldUint32(L"D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV",
+        GetDescriptorHandleIncrementSize(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV));
+    formatter.AddFieldUint32(L"D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER",
+        GetDescriptorHandleIncrementSize(device, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER));
+    formatter.AddFieldUint32(
+        L"D3D12_DESCRIPTOR_HEAP_TYPE_RTV", GetDescriptorHandleIncrementSize(device, D3D12_DESCRIPTOR_HEAP_TYPE_RTV));
+    formatter.AddFieldUint32(
+        L"D3D12_DESCRIPTOR_HEAP_TYPE_DSV", GetDescriptorHandleIncrementSize(device, D3D12_DESCRIPTOR_HEAP_TYPE_DSV));
+}
+
+static void PrintMetaCommand(ID3D12Device5* device5, UINT index, const D3D12_META_COMMAND_DESC& desc)
+{
+    ReportScopeArrayItem scope;
+    ReportSink& formatter = ReportFormatter::GetInstance();
+
+    formatter.AddFieldString(L"Id", GuidToStr(desc.Id).c_str());
+    formatter.AddFieldString(L"Name", desc.Name);
+    formatter.AddFieldFlags(L"InitializationDirtyState", desc.InitializationDirtyState, Enum_D3D12_GRAPHICS_STATES);
+    formatter.AddFieldFlags(L"ExecutionDirtyState", desc.ExecutionDirtyState, Enum_D3D12_GRAPHICS_STATES);
+
+    for(UINT stageIndex = 0; stageIndex < 3; ++stageIndex)
+    {
+        UINT totalStructureSizeInBytes = 0;
+        UINT paramCount = 0;
+        HRESULT hr = ProbeCall(L"EnumerateMetaCommandParameters", [&]() {
+            return device5->EnumerateMetaCommandParameters(desc.Id, (D3D12_META_COMMAND_PARAMETER_STAGE)stageIndex,
+                &totalStructureSizeInBytes, &paramCount, nullptr);
+        });
+        if(FAILED(hr))
+            continue;
+
+        ReportScopeObject scope2(Enum_D3D12_META_COMMAND_PARAMETER_STAGE[stageIndex].m_Name);
+        formatter.AddFieldUint32(L"TotalStructureSizeInBytes", totalStructureSizeInBytes);
+
+        if(paramCount > 0)
+        {
+            std::vector<D3D12_META_COMMAND_PARAMETER_DESC> paramDescs(paramCount);
+            hr = ProbeCall(L"EnumerateMetaCommandParameters", [&]() {
+                return device5->EnumerateMetaCommandParameters(desc.Id,
+                    (D3D12_META_COMMAND_PARAMETER_STAGE)stageIndex, nullptr, &paramCount, paramDescs.data());
+            });
+            if(SUCCEEDED(hr))
+            {
+                ReportScopeArray scope3(L"Parameters");
+
+                for(UINT paramIndex = 0; paramIndex < paramCount; ++paramIndex)
+                {
+                    const auto& paramDesc = paramDescs[paramIndex];
+
+                    ReportScopeArrayItem scope4;
+
+                    formatter.AddFieldString(L"Name", paramDesc.Name);
+                    formatter.AddFieldEnum(L"Type", paramDesc.Type, Enum_D3D12_META_COMMAND_PARAMETER_TYPE);
+                    formatter.AddFieldFlags(L"Flags", paramDesc.Flags, Enum_D3D12_META_COMMAND_PARAMETER_FLAGS);
+                    formatter.AddFieldFlags(
+                        L"RequiredResourceState", paramDesc.RequiredResourceState, Enum_D3D12_RESOURCE_STATES);
+                    formatter.AddFieldUint32(L"StructureOffset", paramDesc.StructureOffset);
+                }
+            }
+        }
+    }
+}
+
+static void PrintMetaCommands(ID3D12Device5* device5)
+{
+    ProbeScope probeScope(L"MetaCommands");
+
+    UINT num = 0;
+    auto enumerateMetaCommands = [&](D3D12_META_COMMAND_DESC* descs) {
+        return ProbeCall(L"EnumerateMetaCommands", [&]() { return device5->EnumerateMetaCommands(&num, descs); });
+    };
+    if(FAILED(enumerateMetaCommands(nullptr)))
+        return;
+    if(num == 0)
+        return;
+    std::vector<D3D12_META_COMMAND_DESC> descs(num);
+    if(FAILED(enumerateMetaCommands(descs.data())))
+        return;
+
+    ReportScopeArray scope(L"EnumerateMetaCommands");
+
+    for(UINT i = 0; i < num; ++i)
+        PrintMetaCommand(device5, i, descs[i]);
+}
+
+static void PrintCommandQueuePriorities(ID3D12Device* device)
+{
+    if(!ReportSelection::IsSelected(L"D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY"))
+        return;
+
+    D3D12_COMMAND_QUEUE_PRIORITY cmdQueuePriorities[] = { D3D12_COMMAND_QUEUE_PRIORITY_NORMAL,
+        D3D12_COMMAND_QUEUE_PRIORITY_HIGH, D3D12_COMMAND_QUEUE_PRIORITY_GLOBAL_REALTIME };
+
+    std::array<std::array<bool, COMMAND_QUEUE_PRIORITIES_COUNT>, COMMAND_LIST_TYPES_COUNT> queuePrioritySupport = {};
+
+    for(size_t i = 0; i < COMMAND_LIST_TYPES_COUNT; ++i)
+    {
+        for(size_t j = 0; j < COMMAND_QUEUE_PRIORITIES_COUNT; ++j)
+        {
+            D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY commandQueuePriority = {};
+            commandQueuePriority.CommandListType = COMMAND_LIST_TYPES[i];
+            commandQueuePriority.Priority = COMMAND_QUEUE_PRIORITIES[j];
+            if(FAILED(CheckFeatureSupport(
+                   device, D3D12_FEATURE_COMMAND_QUEUE_PRIORITY, &commandQueuePriority, sizeof(commandQueuePriority))))
+                return;
+
+            queuePrioritySupport[i][j] = commandQueuePriority.PriorityForTypeIsSupported;
+        }
+    }
+
+    Print_D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY(queuePrioritySupport);
+}
+
+static void PrintBarrierLayouts(ID3D12Device* device)
+{
+    if(!ReportSelection::IsSelected(L"D3D12_FEATURE_DATA_BARRIER_LAYOUT"))
+        return;
+
+    std::array<std::array<bool, BARRIER_LAYOUTS_COUNT>, COMMAND_LIST_TYPES_COUNT> barrierLayoutSupport = {};
+
+    for(size_t i = 0; i < COMMAND_LIST_TYPES_COUNT; ++i)
+    {
+        for(size_t j = 0; j < BARRIER_LAYOUTS_COUNT; ++j)
+        {
+            D3D12_FEATURE_DATA_BARRIER_LAYOUT barrierLayout = {};
+            barrierLayout.CommandListType = COMMAND_LIST_TYPES[i];
+            barrierLayout.Layout = D3D12_BARRIER_LAYOUT(BARRIER_LAYOUTS[j]);
+            if(FAILED(CheckFeatureSupport(device, D3D12_FEATURE_BARRIER_LAYOUT, &barrierLayout, sizeof(barrierLayout))))
+                return;
+            barrierLayoutSupport[i][j] = barrierLayout.Supported;
+        }
+    }
+
+    Print_D3D12_FEATURE_DATA_BARRIER_LAYOUT(barrierLayoutSupport);
+}
+
+#ifdef USE_PREVIEW_AGILITY_SDK
+static void PrintFenceBarriers(ID3D12Device* device)
+{
+    if(!ReportSelection::IsSelected(L"D3D12_FEATURE_DATA_FENCE_BARRIERS"))
+        return;
+
+    std::array<D3D12_FENCE_BARRIERS_TIER, COMMAND_LIST_TYPES_COUNT> fenceBarriersSupport = {};
+
+    for(size_t i = 0; i < COMMAND_LIST_TYPES_COUNT; ++i)
+    {
+        D3D12_FEATURE_DATA_FENCE_BARRIERS fenceBarriers = {};
+        fenceBarriers.CommandListType = COMMAND_LIST_TYPES[i];
+        if(FAILED(CheckFeatureSupport(device, D3D12_FEATURE_FENCE_BARRIERS, &fenceBarriers, sizeof(fenceBarriers))))
+            return;
+        fenceBarriersSupport[i] = fenceBarriers.FenceBarriersTier;
+    }
+
+    Print_D3D12_FEATURE_DATA_FENCE_BARRIERS(fenceBarriersSupport);
+}
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+void PrintAdapterDesc1(const DXGI_ADAPTER_DESC1& desc1)
+{
+    ReportScopeObject scope(L"DXGI_ADAPTER_DESC1");
+    PrintAdapterDesc1Members(desc1);
+}
+
+void PrintAdapterDesc(IDXGIAdapter* adapter)
+{
+    if(ComPtr<IDXGIAdapter4> adapter4; SUCCEEDED(adapter->QueryInterface(IID_PPV_ARGS(&adapter4))))
+    {
+        if(DXGI_ADAPTER_DESC3 desc3; SUCCEEDED(adapter4->GetDesc3(&desc3)))
+            PrintAdapterDesc3(desc3);
+    }
+    else if(ComPtr<IDXGIAdapter2> adapter2; SUCCEEDED(adapter->QueryInterface(IID_PPV_ARGS(&adapter2))))
+    {
+        if(DXGI_ADAPTER_DESC2 desc2; SUCCEEDED(adapter2->GetDesc2(&desc2)))
+            PrintAdapterDesc2(desc2);
+    }
+    else if(ComPtr<IDXGIAdapter1> adapter1; SUCCEEDED(adapter->QueryInterface(IID_PPV_ARGS(&adapter1))))
+    {
+        if(DXGI_ADAPTER_DESC1 desc1; SUCCEEDED(adapter1->GetDesc1(&desc1)))
+            PrintAdapterDesc1(desc1);
+    }
+    else if(DXGI_ADAPTER_DESC desc; SUCCEEDED(adapter->GetDesc(&desc)))
+    {
+        PrintAdapterDesc(desc);
+    }
+}
+
+void PrintAdapterMemoryInfo(IDXGIAdapter* adapter)
+{
+    ComPtr<IDXGIAdapter3> adapter3;
+    if(SUCCEEDED(adapter->QueryInterface<IDXGIAdapter3>(&adapter3)))
+    {
+        for(uint32_t memorySegmentGroup = 0; memorySegmentGroup < 2; ++memorySegmentGroup)
+        {
+            DXGI_QUERY_VIDEO_MEMORY_INFO videoMemoryInfo = {};
+            if(SUCCEEDED(
+                   adapter3->QueryVideoMemoryInfo(0, (DXGI_MEMORY_SEGMENT_GROUP)memorySegmentGroup, &videoMemoryInfo)))
+            {
+                const wchar_t* structName = nullptr;
+                switch(memorySegmentGroup)
+                {
+                case 0:
+                    structName = L"DXGI_QUERY_VIDEO_MEMORY_INFO[DXGI_MEMORY_SEGMENT_GROUP_LOCAL]";
+                    break;
+                case 1:
+                    structName = L"DXGI_QUERY_VIDEO_MEMORY_INFO[DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL]";
+                    break;
+                default:
+                    assert(0);
+                }
+                {
+                    ReportScopeObject scope(structName);
+                    Print_DXGI_QUERY_VIDEO_MEMORY_INFO(videoMemoryInfo);
+                }
+            }
+        }
+    }
+}
+
+void PrintDeviceCapabilities(ID3D12Device* device, const DXGI_ADAPTER_DESC1& desc, VendorApis& vendorApis,
+    bool printFormats, bool printMetaCommands)
+{
+    const bool softwareAdapter = (desc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) != 0;
+
+    if(D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options))))
+        PrintFeatureData(D3D12_FEATURE_D3D12_OPTIONS, options, Print_D3D12_FEATURE_DATA_D3D12_OPTIONS);
+
+    if(D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT gpuVirtualAddressSupport = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_GPU_VIRTUAL_ADDRESS_SUPPORT,
+            &gpuVirtualAddressSupport, sizeof(gpuVirtualAddressSupport))))
+        PrintFeatureData(D3D12_FEATURE_GPU_VIRTUAL_ADDRESS_SUPPORT, gpuVirtualAddressSupport,
+            Print_D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT);
+
+    /*
+    Microsoft documentation says:
+
+    ID3D12Device::CheckFeatureSupport returns E_INVALIDARG if HighestShaderModel
+    isn't known by the current runtime. For that reason, we recommend that you call
+    this in a loop with decreasing shader models to determine the highest supported
+    shader model.
+    */
+    {
+        D3D12_FEATURE_DATA_SHADER_MODEL shaderModel = {};
+        for(size_t enumItemIndex = _countof(Enum_D3D_SHADER_MODEL) - 1; enumItemIndex--;)
+        {
+            shaderModel.HighestShaderModel = D3D_SHADER_MODEL(Enum_D3D_SHADER_MODEL[enumItemIndex].m_Value);
+            if(SUCCEEDED(CheckFeatureSupport(
+                   device, D3D12_FEATURE_SHADER_MODEL, &shaderModel, sizeof(shaderModel))))
+            {
+                PrintFeatureData(D3D12_FEATURE_SHADER_MODEL, shaderModel, Print_D3D12_FEATURE_DATA_SHADER_MODEL);
+                break;
+            }
+        }
+    }
+
+    if(D3D12_FEATURE_DATA_ROOT_SIGNATURE rootSignature = { .HighestVersion = HIGHEST_ROOT_SIGNATURE_VERSION };
+        SUCCEEDED(CheckFeatureSupport(
+            device, D3D12_FEATURE_ROOT_SIGNATURE, &rootSignature, sizeof(rootSignature))))
+        PrintFeatureData(D3D12_FEATURE_ROOT_SIGNATURE, rootSignature, Print_D3D12_FEATURE_DATA_ROOT_SIGNATURE);
+
+    if(D3D12_FEATURE_DATA_ARCHITECTURE1 architecture1 = {};
+        SUCCEEDED(CheckFeatureSupport(
+            device, D3D12_FEATURE_ARCHITECTURE1, &architecture1, sizeof(architecture1))))
+        PrintFeatureData(D3D12_FEATURE_ARCHITECTURE1, architecture1, Print_D3D12_FEATURE_DATA_ARCHITECTURE1);
+    else
+    {
+        if(D3D12_FEATURE_DATA_ARCHITECTURE architecture = {};
+            SUCCEEDED(CheckFeatureSupport(
+                device, D3D12_FEATURE_ARCHITECTURE, &architecture, sizeof(architecture))))
+            PrintFeatureData(D3D12_FEATURE_ARCHITECTURE, architecture, Print_D3D12_FEATURE_DATA_ARCHITECTURE);
+    }
+
+    {
+        D3D12_FEATURE_DATA_FEATURE_LEVELS featureLevels = { _countof(FEATURE_LEVELS_ARRAY), FEATURE_LEVELS_ARRAY,
+            MAX_FEATURE_LEVEL };
+        if(SUCCEEDED(CheckFeatureSupport(
+               device, D3D12_FEATURE_FEATURE_LEVELS, &featureLevels, sizeof(featureLevels))))
+            PrintFeatureData(D3D12_FEATURE_FEATURE_LEVELS, featureLevels, Print_D3D12_FEATURE_DATA_FEATURE_LEVELS);
+    }
+
+    if(D3D12_FEATURE_DATA_SHADER_CACHE shaderCache = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_SHADER_CACHE, &shaderCache, sizeof(shaderCache))))
+        PrintFeatureData(D3D12_FEATURE_SHADER_CACHE, shaderCache, Print_D3D12_FEATURE_DATA_SHADER_CACHE);
+
+    PrintCommandQueuePriorities(device);
+
+    if(D3D12_FEATURE_DATA_SERIALIZATION serialization = {};
+        SUCCEEDED(CheckFeatureSupport(
+            device, D3D12_FEATURE_SERIALIZATION, &serialization, sizeof(serialization))))
+        PrintFeatureData(D3D12_FEATURE_SERIALIZATION, serialization, Print_D3D12_FEATURE_DATA_SERIALIZATION);
+
+    if(D3D12_FEATURE_DATA_CROSS_NODE crossNode = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_CROSS_NODE, &crossNode, sizeof(crossNode))))
+        PrintFeatureData(D3D12_FEATURE_CROSS_NODE, crossNode, Print_D3D12_FEATURE_CROSS_NODE);
+
+    if(D3D12_FEATURE_DATA_PREDICATION predication = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_PREDICATION, &predication, sizeof(predication))))
+        PrintFeatureData(D3D12_FEATURE_PREDICATION, predication, Print_D3D12_FEATURE_PREDICATION);
+
+    if(D3D12_FEATURE_DATA_HARDWARE_COPY hardwareCopy = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_HARDWARE_COPY, &hardwareCopy, sizeof(hardwareCopy))))
+        PrintFeatureData(D3D12_FEATURE_HARDWARE_COPY, hardwareCopy, Print_D3D12_FEATURE_HARDWARE_COPY);
+
+    if(D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE appSpecificDriverState = {};
+        SUCCEEDED(CheckFeatureSupport(device, D3D12_FEATURE_APPLICATION_SPECIFIC_DRIVER_STATE,
+            &appSpecificDriverState, sizeof(appSpecificDriverState))))
+        PrintFeatureData(D3D12_FEATURE_APPLICATION_SPECIFIC_DRIVER_STATE, appSpecificDriverState,
+            Print_D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE);
+
+    PrintBarrierLayouts(device);
+
+#ifdef USE_PREVIEW_AGILITY_SDK
+    if(D3D12_FEATURE_DATA_ASYNC_COMMANDS asyncCommands = {};
+        SUCCEEDED(CheckFeatureSupport(
+            device, D3D12_FEATURE_ASYNC_COMMANDS, &asyncCommands, sizeof(asyncCommands))))
+        PrintFeatureData(D3D12_FEATURE_ASYNC_COMMANDS, asyncCommands, Print_D3D12_FEATURE_DATA_ASYNC_COMMANDS);
+
+    PrintFenceBarriers(device);
+#endif
+
+    // TODO: In Agility SDK 1.715.0-preview how to query for D3D12_FEATURE_D3D12_OPTIONS_EXPERIMENTAL1?
+    // What is the corresponding structure?
+
+    // TODO: D3D12_FEATURE_PLACED_RESOURCE_SUPPORT_INFO - What is this? How to query it? What structure to use?
+
+    PrintDeviceOptions(device);
+
+    if(ReportSelection::IsSelected(L"GetDescriptorHandleIncrementSize"))
+        PrintDescriptorSizes(device);
+
+    if(ReportSelection::IsOptionalSectionIncluded(printMetaCommands, L"EnumerateMetaCommands"))
+    {
+        ComPtr<ID3D12Device5> device5;
+        if(SUCCEEDED(device->QueryInterface(IID_PPV_ARGS(&device5))))
+            PrintMetaCommands(device5.Get());
+    }
+
+#if USE_NVAPI
+    if(vendorApis.IsApplicable(VendorApi::NvApi, desc.VendorId, softwareAdapter) &&
+        ReportSelection::IsPrefixSelected(L"NvAPI_D3D12"))
+    {
+        if(NvAPI_Inititalize_RAII* nvApi = vendorApis.GetNvApi())
+            nvApi->PrintD3d12DeviceData(device);
+    }
+#endif
+
+    if(ReportSelection::IsSelected(L"TranslationLayerDetection"))
+        DetectTranslationLayersDevice(device);
+
+    if(ReportSelection::IsOptionalSectionIncluded(printFormats, L"Formats"))
+        PrintFormatInformation(device);
+}
+
+void PrintRawRecord(const RawFeatureData::Record& record)
+{
+    for(const RawRecordDecoder& decoder : RAW_RECORD_DECODERS)
+    {
+        if(decoder.m_Id == record.m_Id)
+        {
+            // The record may come from a version that knew a different size of the structure.
+            std::vector<char> extraData;
+            const std::vector<char> data = RawFeatureData::FitRecordData(record, decoder.m_DataSize, extraData);
+            decoder.m_Decode(data.data());
+            if(!extraData.empty())
+            {
+                ReportScopeObject scope(std::format(L"{}_ExtraData", decoder.m_Name));
+                ReportFormatter::GetInstance().AddFieldHexBytes(L"Data", extraData.data(), extraData.size());
+            }
+            return;
+        }
+    }
+
+    // Structures unknown to this version are printed as they are, so nothing is lost.
+    const wchar_t* const featureName = FindEnumItemName(record.m_Id, Enum_D3D12_FEATURE);
+    ReportScopeObject scope(featureName ? std::wstring(featureName) : std::format(L"D3D12_FEATURE {}", record.m_Id));
+    ReportFormatter::GetInstance().AddFieldHexBytes(L"Data", record.m_Data.data(), record.m_Data.size());
+}
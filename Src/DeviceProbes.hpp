@@ -0,0 +1,29 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+#include "RawFeatureData.hpp"
+
+class VendorApis;
+
+// Queries of the adapter and the device, printed to ReportFormatter::GetInstance().
+
+void PrintAdapterDesc1(const DXGI_ADAPTER_DESC1& desc1);
+// The newest DXGI_ADAPTER_DESC* structure the adapter supports.
+void PrintAdapterDesc(IDXGIAdapter* adapter);
+void PrintAdapterMemoryInfo(IDXGIAdapter* adapter);
+
+// Everything queried from the device, real or replayed from a capture.
+// Formats and meta commands are printed if their option is set or, if paths are selected, if they are selected.
+void PrintDeviceCapabilities(ID3D12Device* device, const DXGI_ADAPTER_DESC1& desc, VendorApis& vendorApis,
+    bool printFormats, bool printMetaCommands);
+
+// Decodes a structure stored with --Raw. Structures unknown to this version are printed as hex bytes.
+void PrintRawRecord(const RawFeatureData::Record& record);
@@ -0,0 +1,212 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "DriverQuirks.hpp"
+
+#include "Json.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+#include "Utils.hpp"
+#include "VendorApis.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+struct Quirk
+{
+    std::wstring m_Name;
+    uint32_t m_VendorId = 0;
+    // 0 means any device of the vendor.
+    uint32_t m_DeviceId = 0;
+    // Inclusive range of the UMD version, in the format returned by IDXGIAdapter::CheckInterfaceSupport.
+    uint64_t m_MinUmdVersion = 0;
+    uint64_t m_MaxUmdVersion = UINT64_MAX;
+    std::wstring m_Probe;
+    QuirkAction m_Action = QuirkAction::Query;
+    std::wstring m_Reason;
+};
+
+// clang-format off
+static const Quirk EMBEDDED_QUIRKS[] = {
+    // Versions that have the bug are not known, so the query is still made on all of them, only guarded.
+    { L"AmdFormatA4B4G4R4Crash", VENDOR_ID_AMD, 0, 0, UINT64_MAX, L"DXGI_FORMAT_A4B4G4R4_UNORM", QuirkAction::Safe,
+        L"Drivers crash in CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT) for this format (as of November 2023)." },
+};
+// clang-format on
+
+static const wchar_t* const QUIRK_ACTION_NAMES[] = { L"Query", L"Skip", L"Safe" };
+
+// In the order of precedence.
+static std::vector<Quirk> g_Quirks(std::begin(EMBEDDED_QUIRKS), std::end(EMBEDDED_QUIRKS));
+// Probes of the current adapter, pointing to the quirk applying to each. Keys are views of Quirk::m_Probe.
+static std::unordered_map<std::wstring_view, size_t> g_AdapterQuirkIndices;
+// Indexed like g_Quirks.
+static std::vector<bool> g_Applied;
+
+// Parses "Major.Minor.Build.Revision", like AddFieldMicrosoftVersion prints it.
+static uint64_t ParseUmdVersion(const std::wstring& str)
+{
+    uint64_t result = 0;
+    size_t pos = 0;
+    for(uint32_t partIndex = 0; partIndex < 4; ++partIndex)
+    {
+        if(partIndex > 0)
+        {
+            if(pos >= str.length() || str[pos] != L'.')
+                throw std::runtime_error("Invalid driver version in the quirks file.");
+            ++pos;
+        }
+        uint32_t part = 0;
+        const size_t begin = pos;
+        for(; pos < str.length() && str[pos] >= L'0' && str[pos] <= L'9'; ++pos)
+            part = part * 10 + uint32_t(str[pos] - L'0');
+        if(pos == begin || pos - begin > 5 || part > 0xFFFF)
+            throw std::runtime_error("Invalid driver version in the quirks file.");
+        result = (result << 16) | part;
+    }
+    if(pos != str.length())
+        throw std::runtime_error("Invalid driver version in the quirks file.");
+    return result;
+}
+
+// IDs may be given as JSON numbers or as strings, e.g. "0x1002".
+static uint32_t ParseId(const JsonValue& value)
+{
+    if(value.m_Type != JsonValue::Type::Number && value.m_Type != JsonValue::Type::String)
+        throw std::runtime_error("Invalid ID in the quirks file.");
+    wchar_t* end = nullptr;
+    const unsigned long id = wcstoul(value.m_String.c_str(), &end, 0);
+    if(value.m_String.empty() || *end != L'\0' || id > UINT32_MAX)
+        throw std::runtime_error("Invalid ID in the quirks file.");
+    return uint32_t(id);
+}
+
+static const std::wstring& GetString(const JsonValue& object, std::wstring_view name, bool required)
+{
+    static const std::wstring EMPTY;
+    const JsonValue* value = object.FindMember(name);
+    if(!value)
+    {
+        if(required)
+        {
+            const std::string narrowName = WstrToStr(std::wstring(name).c_str(), CP_UTF8);
+            throw std::runtime_error(std::format("Quirk is missing \"{}\".", narrowName));
+        }
+        return EMPTY;
+    }
+    if(value->m_Type != JsonValue::Type::String)
+        throw std::runtime_error("Invalid string in the quirks file.");
+    return value->m_String;
+}
+
+static Quirk ParseQuirk(const JsonValue& object)
+{
+    if(!object.IsObject())
+        throw std::runtime_error("Quirk is not an object.");
+
+    Quirk quirk;
+    quirk.m_Name = GetString(object, L"Name", true);
+    quirk.m_Probe = GetString(object, L"Probe", true);
+    quirk.m_Reason = GetString(object, L"Reason", false);
+
+    const JsonValue* vendorId = object.FindMember(L"VendorId");
+    if(!vendorId)
+        throw std::runtime_error("Quirk is missing \"VendorId\".");
+    quirk.m_VendorId = ParseId(*vendorId);
+    if(const JsonValue* deviceId = object.FindMember(L"DeviceId"))
+        quirk.m_DeviceId = ParseId(*deviceId);
+
+    if(const std::wstring& version = GetString(object, L"MinDriverVersion", false); !version.empty())
+        quirk.m_MinUmdVersion = ParseUmdVersion(version);
+    if(const std::wstring& version = GetString(object, L"MaxDriverVersion", false); !version.empty())
+        quirk.m_MaxUmdVersion = ParseUmdVersion(version);
+
+    const std::wstring& action = GetString(object, L"Action", true);
+    auto actionIt = std::find(std::begin(QUIRK_ACTION_NAMES), std::end(QUIRK_ACTION_NAMES), action);
+    if(actionIt == std::end(QUIRK_ACTION_NAMES))
+        throw std::runtime_error("Invalid action in the quirks file. Expected Query, Skip or Safe.");
+    quirk.m_Action = QuirkAction(actionIt - std::begin(QUIRK_ACTION_NAMES));
+
+    return quirk;
+}
+
+static bool DoesQuirkApply(const Quirk& quirk, uint32_t vendorId, uint32_t deviceId, uint64_t umdVersion)
+{
+    return quirk.m_VendorId == vendorId && (quirk.m_DeviceId == 0 || quirk.m_DeviceId == deviceId) &&
+        umdVersion >= quirk.m_MinUmdVersion && umdVersion <= quirk.m_MaxUmdVersion;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+void DriverQuirks::LoadFile(const std::wstring& filePath)
+{
+    const JsonValue root = ParseJson(LoadTextFile(filePath));
+    const JsonValue* quirks = root.FindMember(L"Quirks");
+    if(!quirks || !quirks->IsArray())
+        throw std::runtime_error("Quirks file has no \"Quirks\" array.");
+
+    std::vector<Quirk> loadedQuirks;
+    loadedQuirks.reserve(quirks->m_Items.size() + g_Quirks.size());
+    for(const JsonValue& item : quirks->m_Items)
+        loadedQuirks.push_back(ParseQuirk(item));
+    loadedQuirks.insert(loadedQuirks.end(), g_Quirks.begin(), g_Quirks.end());
+
+    g_AdapterQuirkIndices.clear();
+    g_Quirks = std::move(loadedQuirks);
+}
+
+void DriverQuirks::SetAdapter(uint32_t vendorId, uint32_t deviceId, uint64_t umdVersion)
+{
+    g_AdapterQuirkIndices.clear();
+    g_Applied.assign(g_Quirks.size(), false);
+    for(size_t i = 0; i < g_Quirks.size(); ++i)
+    {
+        // The first quirk for a probe wins.
+        if(DoesQuirkApply(g_Quirks[i], vendorId, deviceId, umdVersion))
+            g_AdapterQuirkIndices.emplace(g_Quirks[i].m_Probe, i);
+    }
+}
+
+bool DriverQuirks::IsAnyActive()
+{
+    return !g_AdapterQuirkIndices.empty();
+}
+
+QuirkAction DriverQuirks::Find(const wchar_t* probeName)
+{
+    if(!probeName || g_AdapterQuirkIndices.empty())
+        return QuirkAction::Query;
+    const auto it = g_AdapterQuirkIndices.find(probeName);
+    if(it == g_AdapterQuirkIndices.end())
+        return QuirkAction::Query;
+    g_Applied[it->second] = true;
+    return g_Quirks[it->second].m_Action;
+}
+
+void DriverQuirks::PrintApplied()
+{
+    ReportScopeObjectConditional scope(L"DriverQuirks");
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    for(size_t i = 0; i < g_Applied.size(); ++i)
+    {
+        if(!g_Applied[i])
+            continue;
+        const Quirk& quirk = g_Quirks[i];
+        scope.Enable();
+        ReportScopeObject quirkScope(quirk.m_Name);
+        formatter.AddFieldString(L"Probe", quirk.m_Probe);
+        formatter.AddFieldString(L"Action", QUIRK_ACTION_NAMES[size_t(quirk.m_Action)]);
+        if(quirk.m_MinUmdVersion != 0)
+            formatter.AddFieldMicrosoftVersion(L"MinDriverVersion", quirk.m_MinUmdVersion);
+        if(quirk.m_MaxUmdVersion != UINT64_MAX)
+            formatter.AddFieldMicrosoftVersion(L"MaxDriverVersion", quirk.m_MaxUmdVersion);
+        if(!quirk.m_Reason.empty())
+            formatter.AddFieldString(L"Reason", quirk.m_Reason);
+    }
+}
@@ -0,0 +1,43 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+enum class QuirkAction
+{
+    // Make the query as usual.
+    Query,
+    // Don't make the query, as if it failed.
+    Skip,
+    // Make the query under a structured exception handler, so a crash in the driver only fails it.
+    Safe
+};
+
+// Known problems of specific drivers with individual queries ("probes"), e.g. ones that crash or take very long.
+// Quirks come from a table embedded in the program, optionally preceded by ones loaded from a file.
+// A quirk applies to an adapter by its vendor ID, device ID and range of the UMD version.
+// Probes are named after the D3D12_FEATURE queried, e.g. "D3D12_FEATURE_D3D12_OPTIONS",
+// or after the DXGI_FORMAT whose support is queried, e.g. "DXGI_FORMAT_A4B4G4R4_UNORM".
+class DriverQuirks
+{
+public:
+    // Quirks from the file take precedence over the embedded ones for the same probe. Throws on failure.
+    static void LoadFile(const std::wstring& filePath);
+
+    // Selects the quirks that apply to the adapter queried next. umdVersion is 0 if unknown.
+    static void SetAdapter(uint32_t vendorId, uint32_t deviceId, uint64_t umdVersion);
+    // Whether any quirk applies to the current adapter, so names of probes are worth looking up.
+    static bool IsAnyActive();
+    // Tells what to do with a probe of the current adapter, in constant time. Null probeName means Query.
+    // Call only from the thread that queries the adapter.
+    static QuirkAction Find(const wchar_t* probeName);
+
+    // Prints the "DriverQuirks" section with the quirks applied to the current adapter, if any.
+    static void PrintApplied();
+};
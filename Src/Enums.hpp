@@ -9,116 +9,7 @@ For more information, see files README.md, LICENSE.txt.
 */
 #pragma once
 
-struct EnumItem
-{
-    const wchar_t* m_Name;
-    uint32_t m_Value;
-};
-
-class EnumCollection
-{
-public:
-    std::unordered_map<wstring, const EnumItem*> m_Enums;
-
-    static EnumCollection& GetInstance()
-    {
-        static EnumCollection obj;
-        return obj;
-    }
-
-    void Add(const wchar_t* enumName, const EnumItem* items)
-    {
-        m_Enums.insert({ enumName, items });
-    }
-};
-
-class EnumRegistration
-{
-public:
-    EnumRegistration(const wchar_t* enumName, const EnumItem* items)
-    {
-        EnumCollection::GetInstance().Add(enumName, items);
-    }
-};
-
-#define ENUM_BEGIN(name)   static const EnumItem Enum_ ## name[] = {
-#define ENUM_END(name)   { NULL, UINT32_MAX } }; \
-	static EnumRegistration g_Enum_ ## name ## _Registration(L"" #name, Enum_ ## name);
-#define ENUM_ITEM(name)   { L"" #name, uint32_t(name) },
-
-// If not found, returns null.
-inline const wchar_t* FindEnumItemName(uint32_t value, const EnumItem* items)
-{
-    for(size_t i = 0; items[i].m_Name != nullptr; ++i)
-    {
-        if(items[i].m_Value == value)
-            return items[i].m_Name;
-    }
-    return nullptr;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-// Other enums
-
-static const EnumItem Enum_VendorId[] = {
-    // PCI IDs
-    { L"AMD/ATI",   0x1002     },
-    { L"AMD",       0x1022     },
-    { L"NVIDIA",    0x10de     },
-    { L"Microsoft", 0x1414     },
-    { L"Parallels", 0x1ab8     },
-    { L"Qualcomm",  0x5143     },
-    { L"Intel",     0x8086     },
-    // ACPI IDs
-    { L"Parallels", 0x344C5250 },
-    { L"NVIDIA",    0x4144564E },
-    { L"Intel",     0x43544E49 },
-    { L"Intel",     0x4C544E49 },
-    { L"AMD",       0x49444D41 },
-    { L"Intel",     0x49504341 },
-    { L"Qualcomm",  0x4D4F4351 },
-    { L"Microsoft", 0x5446534D },
-    { L"Microsoft", 0x5748534D },
-    { L"Microsoft", 0x5941534D },
-    { NULL,         UINT32_MAX }
-};
-static EnumRegistration g_Enum_VendorId_Registration(L"VendorId", Enum_VendorId);
-
-static const EnumItem Enum_SubsystemVendorId[] = {
-    { L"AMD/ATI",            0x1002     },
-    { L"AMD",                0x1022     },
-    { L"Acer",               0x1025     },
-    { L"Dell",               0x1028     },
-    { L"HP",                 0x103c     },
-    { L"ASUS",               0x1043     },
-    { L"Sony",               0x104d     },
-    { L"Apple",              0x106b     },
-    { L"Gateway",            0x107b     },
-    { L"Diamond Multimedia", 0x106b     },
-    { L"NVIDIA",             0x10de     },
-    { L"Toshiba",            0x1179     },
-    { L"Microsoft",          0x1414     },
-    { L"Gigabyte",           0x1458     },
-    { L"MSI",                0x1462     },
-    { L"PowerColor",         0x148c     },
-    { L"VisionTek",          0x1545     },
-    { L"Palit",              0x1569     },
-    { L"XFX",                0x1682     },
-    { L"Jetway",             0x16f3     },
-    { L"Lenovo",             0x17aa     },
-    { L"HIS",                0x17af     },
-    { L"ASRock",             0x1849     },
-    { L"GeCube",             0x18bc     },
-    { L"Club 3D",            0x196d     },
-    { L"PNY",                0x196e     },
-    { L"Razer",              0x1a58     },
-    { L"Parallels",          0x1ab8     },
-    { L"Sapphire",           0x1da2     },
-    { L"Qualcomm",           0x5143     },
-    { L"Intel",              0x8086     },
-    { NULL,                  UINT32_MAX }
-};
-static EnumRegistration g_Enum_SubsystemVendorId_Registration(L"SubsystemVendorId", Enum_SubsystemVendorId);
+#include "EnumsBase.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
 // WinAPI enums
@@ -273,6 +164,87 @@ ENUM_BEGIN(DXGI_FORMAT)
     ENUM_ITEM(DXGI_FORMAT_A4B4G4R4_UNORM)
 ENUM_END(DXGI_FORMAT)
 
+ENUM_BEGIN(D3D12_FEATURE)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS)
+    ENUM_ITEM(D3D12_FEATURE_ARCHITECTURE)
+    ENUM_ITEM(D3D12_FEATURE_FEATURE_LEVELS)
+    ENUM_ITEM(D3D12_FEATURE_FORMAT_SUPPORT)
+    ENUM_ITEM(D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS)
+    ENUM_ITEM(D3D12_FEATURE_FORMAT_INFO)
+    ENUM_ITEM(D3D12_FEATURE_GPU_VIRTUAL_ADDRESS_SUPPORT)
+    ENUM_ITEM(D3D12_FEATURE_SHADER_MODEL)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS1)
+#ifdef USE_PREVIEW_AGILITY_SDK
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS_EXPERIMENTAL)
+#endif
+    ENUM_ITEM(D3D12_FEATURE_PROTECTED_RESOURCE_SESSION_SUPPORT)
+    ENUM_ITEM(D3D12_FEATURE_ROOT_SIGNATURE)
+#ifdef USE_PREVIEW_AGILITY_SDK
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS_EXPERIMENTAL1)
+#endif
+    ENUM_ITEM(D3D12_FEATURE_ARCHITECTURE1)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS2)
+    ENUM_ITEM(D3D12_FEATURE_SHADER_CACHE)
+    ENUM_ITEM(D3D12_FEATURE_COMMAND_QUEUE_PRIORITY)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS3)
+    ENUM_ITEM(D3D12_FEATURE_EXISTING_HEAPS)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS4)
+    ENUM_ITEM(D3D12_FEATURE_SERIALIZATION)
+    ENUM_ITEM(D3D12_FEATURE_CROSS_NODE)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS5)
+    ENUM_ITEM(D3D12_FEATURE_DISPLAYABLE)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS6)
+    ENUM_ITEM(D3D12_FEATURE_QUERY_META_COMMAND)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS7)
+    ENUM_ITEM(D3D12_FEATURE_PROTECTED_RESOURCE_SESSION_TYPE_COUNT)
+    ENUM_ITEM(D3D12_FEATURE_PROTECTED_RESOURCE_SESSION_TYPES)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS8)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS9)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS10)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS11)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS12)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS13)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS14)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS15)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS16)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS17)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS18)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS19)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS20)
+    ENUM_ITEM(D3D12_FEATURE_PREDICATION)
+    ENUM_ITEM(D3D12_FEATURE_PLACED_RESOURCE_SUPPORT_INFO)
+    ENUM_ITEM(D3D12_FEATURE_HARDWARE_COPY)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS21)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_TIGHT_ALIGNMENT)
+#ifdef USE_PREVIEW_AGILITY_SDK
+    ENUM_ITEM(D3D12_FEATURE_GUID_TEXTURE_LAYOUT)
+#endif
+    ENUM_ITEM(D3D12_FEATURE_APPLICATION_SPECIFIC_DRIVER_STATE)
+    ENUM_ITEM(D3D12_FEATURE_BYTECODE_BYPASS_HASH_SUPPORTED)
+#ifdef USE_PREVIEW_AGILITY_SDK
+    ENUM_ITEM(D3D12_FEATURE_FENCE_BARRIERS)
+    ENUM_ITEM(D3D12_FEATURE_HARDWARE_SCHEDULING_QUEUE_GROUPINGS)
+#endif
+    ENUM_ITEM(D3D12_FEATURE_SHADER_CACHE_ABI_SUPPORT)
+#ifdef USE_PREVIEW_AGILITY_SDK
+    ENUM_ITEM(D3D12_FEATURE_ASYNC_COMMANDS)
+#endif
+    ENUM_ITEM(D3D12_FEATURE_BARRIER_LAYOUT)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS22)
+#ifdef USE_PREVIEW_AGILITY_SDK
+    ENUM_ITEM(D3D12_FEATURE_PARTIAL_GRAPHICS_PROGRAMS)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS_MLIR)
+    ENUM_ITEM(D3D12_FEATURE_MLIR_EXCHANGE)
+    ENUM_ITEM(D3D12_FEATURE_MLIR_INTERFACE_SUPPORT)
+    ENUM_ITEM(D3D12_FEATURE_DUMP_FILE)
+    ENUM_ITEM(D3D12_FEATURE_D3D12_OPTIONS_PREVIEW)
+    ENUM_ITEM(D3D12_FEATURE_USER_DEFINED_ANNOTATION)
+    ENUM_ITEM(D3D12_FEATURE_DEBUG_BREAK)
+    ENUM_ITEM(D3D12_FEATURE_LINEAR_ALGEBRA_SUPPORT)
+    ENUM_ITEM(D3D12_FEATURE_LINEAR_ALGEBRA_LINEAR_ALGEBRA_MATRIX_OPERATION_SUPPORT)
+#endif
+ENUM_END(D3D12_FEATURE)
+
 ENUM_BEGIN(D3D12_COMMAND_LIST_TYPE)
     ENUM_ITEM(D3D12_COMMAND_LIST_TYPE_DIRECT)
     ENUM_ITEM(D3D12_COMMAND_LIST_TYPE_BUNDLE)
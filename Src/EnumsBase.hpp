@@ -0,0 +1,124 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Enums that don't need Windows headers, together with the types and functions to define and look up any enums.
+// The rest of the enums are in Enums.hpp.
+
+struct EnumItem
+{
+    const wchar_t* m_Name;
+    uint32_t m_Value;
+};
+
+class EnumCollection
+{
+public:
+    std::unordered_map<wstring, const EnumItem*> m_Enums;
+
+    static EnumCollection& GetInstance()
+    {
+        static EnumCollection obj;
+        return obj;
+    }
+
+    void Add(const wchar_t* enumName, const EnumItem* items)
+    {
+        m_Enums.insert({ enumName, items });
+    }
+};
+
+class EnumRegistration
+{
+public:
+    EnumRegistration(const wchar_t* enumName, const EnumItem* items)
+    {
+        EnumCollection::GetInstance().Add(enumName, items);
+    }
+};
+
+#define ENUM_BEGIN(name)   static const EnumItem Enum_ ## name[] = {
+#define ENUM_END(name)   { NULL, UINT32_MAX } }; \
+	static EnumRegistration g_Enum_ ## name ## _Registration(L"" #name, Enum_ ## name);
+#define ENUM_ITEM(name)   { L"" #name, uint32_t(name) },
+
+// If not found, returns null.
+inline const wchar_t* FindEnumItemName(uint32_t value, const EnumItem* items)
+{
+    for(size_t i = 0; items[i].m_Name != nullptr; ++i)
+    {
+        if(items[i].m_Value == value)
+            return items[i].m_Name;
+    }
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Other enums
+
+static const EnumItem Enum_VendorId[] = {
+    // PCI IDs
+    { L"AMD/ATI",   0x1002     },
+    { L"AMD",       0x1022     },
+    { L"NVIDIA",    0x10de     },
+    { L"Microsoft", 0x1414     },
+    { L"Parallels", 0x1ab8     },
+    { L"Qualcomm",  0x5143     },
+    { L"Intel",     0x8086     },
+    // ACPI IDs
+    { L"Parallels", 0x344C5250 },
+    { L"NVIDIA",    0x4144564E },
+    { L"Intel",     0x43544E49 },
+    { L"Intel",     0x4C544E49 },
+    { L"AMD",       0x49444D41 },
+    { L"Intel",     0x49504341 },
+    { L"Qualcomm",  0x4D4F4351 },
+    { L"Microsoft", 0x5446534D },
+    { L"Microsoft", 0x5748534D },
+    { L"Microsoft", 0x5941534D },
+    { NULL,         UINT32_MAX }
+};
+static EnumRegistration g_Enum_VendorId_Registration(L"VendorId", Enum_VendorId);
+
+static const EnumItem Enum_SubsystemVendorId[] = {
+    { L"AMD/ATI",            0x1002     },
+    { L"AMD",                0x1022     },
+    { L"Acer",               0x1025     },
+    { L"Dell",               0x1028     },
+    { L"HP",                 0x103c     },
+    { L"ASUS",               0x1043     },
+    { L"Sony",               0x104d     },
+    { L"Apple",              0x106b     },
+    { L"Gateway",            0x107b     },
+    { L"Diamond Multimedia", 0x106b     },
+    { L"NVIDIA",             0x10de     },
+    { L"Toshiba",            0x1179     },
+    { L"Microsoft",          0x1414     },
+    { L"Gigabyte",           0x1458     },
+    { L"MSI",                0x1462     },
+    { L"PowerColor",         0x148c     },
+    { L"VisionTek",          0x1545     },
+    { L"Palit",              0x1569     },
+    { L"XFX",                0x1682     },
+    { L"Jetway",             0x16f3     },
+    { L"Lenovo",             0x17aa     },
+    { L"HIS",                0x17af     },
+    { L"ASRock",             0x1849     },
+    { L"GeCube",             0x18bc     },
+    { L"Club 3D",            0x196d     },
+    { L"PNY",                0x196e     },
+    { L"Razer",              0x1a58     },
+    { L"Parallels",          0x1ab8     },
+    { L"Sapphire",           0x1da2     },
+    { L"Qualcomm",           0x5143     },
+    { L"Intel",              0x8086     },
+    { NULL,                  UINT32_MAX }
+};
+static EnumRegistration g_Enum_SubsystemVendorId_Registration(L"SubsystemVendorId", Enum_SubsystemVendorId);
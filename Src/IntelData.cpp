@@ -16,6 +16,7 @@ See the original library in directory: Src\ThirdParty\gpudetect
 
 #include "Enums.hpp"
 #include "Printer.hpp"
+#include "ProbeTimings.hpp"
 #include "ReportFormatter/ReportFormatter.hpp"
 #include "Utils.hpp"
 
@@ -103,17 +104,17 @@ namespace IntelData
     void PrintAdapterData(IDXGIAdapter* adapter)
     {
         ComPtr<ID3D11Device> device;
-        int r = GPUDetect::InitDevice(adapter, &device);
+        int r = PROBE_CALL(GPUDetect::InitDevice, adapter, &device);
         if(r != EXIT_SUCCESS)
             return;
 
         GPUDetect::GPUData gpuData = {};
-        r = GPUDetect::InitExtensionInfo(&gpuData, adapter, device.Get());
+        r = PROBE_CALL(GPUDetect::InitExtensionInfo, &gpuData, adapter, device.Get());
         if(r != EXIT_SUCCESS)
             return;
 
         ReportScopeObject region(L"Intel GPUDetect::GPUData");
-        ReportFormatter& formatter = ReportFormatter::GetInstance();
+        ReportSink& formatter = ReportFormatter::GetInstance();
         formatter.AddFieldVendorId(L"VendorId", gpuData.vendorID);
         formatter.AddFieldHex32(L"deviceID", gpuData.deviceID);
         formatter.AddFieldBool(L"isUMAArchitecture", gpuData.isUMAArchitecture ? TRUE : FALSE);
@@ -122,7 +123,7 @@ namespace IntelData
         formatter.AddFieldHex32(L"extensionVersion", gpuData.extensionVersion);
         formatter.AddFieldBool(L"intelExtensionAvailability", gpuData.intelExtensionAvailability ? TRUE : FALSE);
 
-        r = GPUDetect::InitDxDriverVersion(&gpuData);
+        r = PROBE_CALL(GPUDetect::InitDxDriverVersion, &gpuData);
         if(r == EXIT_SUCCESS && gpuData.d3dRegistryDataAvailability)
         {
             char driverVersionStr[19] = {};
@@ -137,7 +138,7 @@ namespace IntelData
             const GPUDetect::PresetLevel presetLevel = GPUDetect::GetDefaultFidelityPreset(&gpuData);
             formatter.AddFieldEnum(L"DefaultFidelityPreset", (uint32_t)presetLevel, GPUDetect::Enum_PresetLevel);
 
-            r = GPUDetect::InitCounterInfo(&gpuData, device.Get());
+            r = PROBE_CALL(GPUDetect::InitCounterInfo, &gpuData, device.Get());
             if(r == EXIT_SUCCESS)
             {
                 string architectureStr = GPUDetect::GetIntelGPUArchitectureString(gpuData.architecture);
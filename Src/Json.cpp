@@ -0,0 +1,355 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Json.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static constexpr size_t INDENT_SIZE = 4;
+
+class JsonParser
+{
+public:
+    JsonParser(std::wstring_view text)
+        : m_Text(text)
+    {
+    }
+
+    JsonValue ParseDocument()
+    {
+        JsonValue result = ParseValue();
+        SkipWhitespace();
+        if(m_Pos != m_Text.length())
+            Fail("Unexpected data after the end of the document");
+        return result;
+    }
+
+private:
+    std::wstring_view m_Text;
+    size_t m_Pos = 0;
+
+    [[noreturn]] void Fail(const char* message) const
+    {
+        throw std::runtime_error(std::format("Invalid JSON at character {}: {}.", m_Pos, message));
+    }
+
+    void SkipWhitespace()
+    {
+        while(m_Pos < m_Text.length() &&
+              (m_Text[m_Pos] == L' ' || m_Text[m_Pos] == L'\t' || m_Text[m_Pos] == L'\n' || m_Text[m_Pos] == L'\r'))
+            ++m_Pos;
+    }
+
+    bool TryConsume(wchar_t ch)
+    {
+        SkipWhitespace();
+        if(m_Pos < m_Text.length() && m_Text[m_Pos] == ch)
+        {
+            ++m_Pos;
+            return true;
+        }
+        return false;
+    }
+
+    void Expect(wchar_t ch)
+    {
+        if(!TryConsume(ch))
+            Fail("Unexpected character");
+    }
+
+    bool TryConsumeKeyword(std::wstring_view keyword)
+    {
+        if(m_Text.substr(m_Pos, keyword.length()) != keyword)
+            return false;
+        m_Pos += keyword.length();
+        return true;
+    }
+
+    JsonValue ParseValue()
+    {
+        SkipWhitespace();
+        if(m_Pos == m_Text.length())
+            Fail("Unexpected end of the document");
+
+        JsonValue value;
+        const wchar_t ch = m_Text[m_Pos];
+        if(ch == L'{')
+        {
+            ++m_Pos;
+            value.m_Type = JsonValue::Type::Object;
+            if(!TryConsume(L'}'))
+            {
+                do
+                {
+                    SkipWhitespace();
+                    std::wstring name = ParseString();
+                    Expect(L':');
+                    value.m_Members.emplace_back(std::move(name), ParseValue());
+                } while(TryConsume(L','));
+                Expect(L'}');
+            }
+        }
+        else if(ch == L'[')
+        {
+            ++m_Pos;
+            value.m_Type = JsonValue::Type::Array;
+            if(!TryConsume(L']'))
+            {
+                do
+                {
+                    value.m_Items.push_back(ParseValue());
+                } while(TryConsume(L','));
+                Expect(L']');
+            }
+        }
+        else if(ch == L'"')
+        {
+            value.m_Type = JsonValue::Type::String;
+            value.m_String = ParseString();
+        }
+        else if(ch == L'-' || (ch >= L'0' && ch <= L'9'))
+        {
+            value.m_Type = JsonValue::Type::Number;
+            value.m_String = ParseNumber();
+        }
+        else if(TryConsumeKeyword(L"true"))
+        {
+            value.m_Type = JsonValue::Type::Bool;
+            value.m_Bool = true;
+        }
+        else if(TryConsumeKeyword(L"false"))
+        {
+            value.m_Type = JsonValue::Type::Bool;
+        }
+        else if(!TryConsumeKeyword(L"null"))
+            Fail("Unexpected character");
+        return value;
+    }
+
+    std::wstring ParseString()
+    {
+        if(m_Pos == m_Text.length() || m_Text[m_Pos] != L'"')
+            Fail("Expected string");
+        ++m_Pos;
+
+        std::wstring result;
+        while(true)
+        {
+            if(m_Pos == m_Text.length())
+                Fail("Unterminated string");
+            wchar_t ch = m_Text[m_Pos++];
+            if(ch == L'"')
+                return result;
+            if(ch != L'\\')
+            {
+                result += ch;
+                continue;
+            }
+
+            if(m_Pos == m_Text.length())
+                Fail("Unterminated string");
+            ch = m_Text[m_Pos++];
+            switch(ch)
+            {
+            case L'"':
+            case L'\\':
+            case L'/':
+                result += ch;
+                break;
+            case L'b':
+                result += L'\b';
+                break;
+            case L'f':
+                result += L'\f';
+                break;
+            case L'n':
+                result += L'\n';
+                break;
+            case L'r':
+                result += L'\r';
+                break;
+            case L't':
+                result += L'\t';
+                break;
+            case L'u': {
+                if(m_Text.length() - m_Pos < 4)
+                    Fail("Invalid escape sequence");
+                uint32_t code = 0;
+                for(size_t i = 0; i < 4; ++i)
+                {
+                    const wchar_t digit = m_Text[m_Pos++];
+                    code <<= 4;
+                    if(digit >= L'0' && digit <= L'9')
+                        code |= uint32_t(digit - L'0');
+                    else if(digit >= L'a' && digit <= L'f')
+                        code |= uint32_t(digit - L'a' + 10);
+                    else if(digit >= L'A' && digit <= L'F')
+                        code |= uint32_t(digit - L'A' + 10);
+                    else
+                        Fail("Invalid escape sequence");
+                }
+                result += wchar_t(code);
+            }
+            break;
+            default:
+                Fail("Invalid escape sequence");
+            }
+        }
+    }
+
+    std::wstring ParseNumber()
+    {
+        const size_t begin = m_Pos;
+        auto skipDigits = [this]() {
+            const size_t digitsBegin = m_Pos;
+            while(m_Pos < m_Text.length() && m_Text[m_Pos] >= L'0' && m_Text[m_Pos] <= L'9')
+                ++m_Pos;
+            if(m_Pos == digitsBegin)
+                Fail("Invalid number");
+        };
+
+        if(m_Text[m_Pos] == L'-')
+            ++m_Pos;
+        skipDigits();
+        if(m_Pos < m_Text.length() && m_Text[m_Pos] == L'.')
+        {
+            ++m_Pos;
+            skipDigits();
+        }
+        if(m_Pos < m_Text.length() && (m_Text[m_Pos] == L'e' || m_Text[m_Pos] == L'E'))
+        {
+            ++m_Pos;
+            if(m_Pos < m_Text.length() && (m_Text[m_Pos] == L'+' || m_Text[m_Pos] == L'-'))
+                ++m_Pos;
+            skipDigits();
+        }
+        return std::wstring(m_Text.substr(begin, m_Pos - begin));
+    }
+};
+
+static void WriteNewLineAndIndent(bool prettyPrint, size_t indentLevel, std::wstring& out)
+{
+    if(prettyPrint)
+    {
+        out += L'\n';
+        out.append(indentLevel * INDENT_SIZE, L' ');
+    }
+}
+
+static void WriteJsonValue(const JsonValue& value, bool prettyPrint, size_t indentLevel, std::wstring& out)
+{
+    switch(value.m_Type)
+    {
+    case JsonValue::Type::Null:
+        out += L"null";
+        break;
+    case JsonValue::Type::Bool:
+        out += value.m_Bool ? L"true" : L"false";
+        break;
+    case JsonValue::Type::Number:
+        out += value.m_String;
+        break;
+    case JsonValue::Type::String:
+        out += L'"';
+        out += EscapeJsonString(value.m_String);
+        out += L'"';
+        break;
+    case JsonValue::Type::Array:
+        out += L'[';
+        for(size_t i = 0; i < value.m_Items.size(); ++i)
+        {
+            if(i > 0)
+                out += L',';
+            WriteNewLineAndIndent(prettyPrint, indentLevel + 1, out);
+            WriteJsonValue(value.m_Items[i], prettyPrint, indentLevel + 1, out);
+        }
+        if(!value.m_Items.empty())
+            WriteNewLineAndIndent(prettyPrint, indentLevel, out);
+        out += L']';
+        break;
+    case JsonValue::Type::Object:
+        out += L'{';
+        for(size_t i = 0; i < value.m_Members.size(); ++i)
+        {
+            if(i > 0)
+                out += L',';
+            WriteNewLineAndIndent(prettyPrint, indentLevel + 1, out);
+            out += L'"';
+            out += EscapeJsonString(value.m_Members[i].first);
+            out += prettyPrint ? L"\": " : L"\":";
+            WriteJsonValue(value.m_Members[i].second, prettyPrint, indentLevel + 1, out);
+        }
+        if(!value.m_Members.empty())
+            WriteNewLineAndIndent(prettyPrint, indentLevel, out);
+        out += L'}';
+        break;
+    default:
+        assert(0);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+const JsonValue* JsonValue::FindMember(std::wstring_view name) const
+{
+    for(const auto& member : m_Members)
+    {
+        if(member.first == name)
+            return &member.second;
+    }
+    return nullptr;
+}
+
+JsonValue ParseJson(std::wstring_view text)
+{
+    return JsonParser(text).ParseDocument();
+}
+
+void WriteJson(const JsonValue& value, bool prettyPrint, std::wstring& out)
+{
+    WriteJsonValue(value, prettyPrint, 0, out);
+}
+
+std::wstring EscapeJsonString(std::wstring_view str)
+{
+    std::wstring escapedStr;
+    escapedStr.reserve(str.size());
+    for(wchar_t ch : str)
+    {
+        switch(ch)
+        {
+        case L'"':
+            escapedStr += L"\\\"";
+            break;
+        case L'\\':
+            escapedStr += L"\\\\";
+            break;
+        case L'\b':
+            escapedStr += L"\\b";
+            break;
+        case L'\f':
+            escapedStr += L"\\f";
+            break;
+        case L'\n':
+            escapedStr += L"\\n";
+            break;
+        case L'\r':
+            escapedStr += L"\\r";
+            break;
+        case L'\t':
+            escapedStr += L"\\t";
+            break;
+        default:
+            escapedStr += ch;
+        }
+    }
+    return escapedStr;
+}
@@ -0,0 +1,48 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Minimal JSON document model, used to read back reports produced by JSONReportFormatter.
+struct JsonValue
+{
+    enum class Type
+    {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    Type m_Type = Type::Null;
+    bool m_Bool = false;
+    // String value, or the number exactly as it appeared in the text, so it round-trips without any precision loss.
+    std::wstring m_String;
+    std::vector<JsonValue> m_Items;
+    std::vector<std::pair<std::wstring, JsonValue>> m_Members;
+
+    bool IsObject() const
+    {
+        return m_Type == Type::Object;
+    }
+    bool IsArray() const
+    {
+        return m_Type == Type::Array;
+    }
+    // Returns null if not found or this is not an object.
+    const JsonValue* FindMember(std::wstring_view name) const;
+};
+
+// Throws std::runtime_error on syntax error.
+JsonValue ParseJson(std::wstring_view text);
+// Indentation and spacing follow JSONReportFormatter, so the output looks the same.
+void WriteJson(const JsonValue& value, bool prettyPrint, std::wstring& out);
+std::wstring EscapeJsonString(std::wstring_view str);
@@ -0,0 +1,238 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "JsonPatch.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static JsonValue MakeStringValue(std::wstring_view str)
+{
+    JsonValue value;
+    value.m_Type = JsonValue::Type::String;
+    value.m_String = str;
+    return value;
+}
+
+// JSON Pointer (RFC 6901) escaping.
+static std::wstring MakePath(std::wstring_view parentPath, std::wstring_view token)
+{
+    std::wstring path(parentPath);
+    path += L'/';
+    for(wchar_t ch : token)
+    {
+        if(ch == L'~')
+            path += L"~0";
+        else if(ch == L'/')
+            path += L"~1";
+        else
+            path += ch;
+    }
+    return path;
+}
+
+static std::wstring MakePath(std::wstring_view parentPath, size_t index)
+{
+    return MakePath(parentPath, std::to_wstring(index));
+}
+
+class JsonPatchBuilder
+{
+public:
+    JsonPatchBuilder(const JsonArrayItemKeyFunc& getItemKey)
+        : m_GetItemKey(getItemKey)
+    {
+        m_Patch.m_Type = JsonValue::Type::Array;
+    }
+
+    JsonValue& GetPatch()
+    {
+        return m_Patch;
+    }
+
+    void Diff(const JsonValue& from, const JsonValue& to, const std::wstring& path)
+    {
+        if(from.m_Type != to.m_Type)
+        {
+            AddOperation(L"replace", path, &to);
+            return;
+        }
+
+        switch(to.m_Type)
+        {
+        case JsonValue::Type::Object:
+            DiffObjects(from, to, path);
+            break;
+        case JsonValue::Type::Array:
+            if(!DiffKeyedArrays(from, to, path))
+                DiffArrays(from, to, path);
+            break;
+        case JsonValue::Type::Bool:
+            if(from.m_Bool != to.m_Bool)
+                AddOperation(L"replace", path, &to);
+            break;
+        case JsonValue::Type::Number:
+        case JsonValue::Type::String:
+            if(from.m_String != to.m_String)
+                AddOperation(L"replace", path, &to);
+            break;
+        default:
+            break;
+        }
+    }
+
+private:
+    const JsonArrayItemKeyFunc& m_GetItemKey;
+    JsonValue m_Patch;
+
+    void AddOperation(std::wstring_view op, std::wstring_view path, const JsonValue* value)
+    {
+        JsonValue& operation = m_Patch.m_Items.emplace_back();
+        operation.m_Type = JsonValue::Type::Object;
+        operation.m_Members.emplace_back(L"op", MakeStringValue(op));
+        operation.m_Members.emplace_back(L"path", MakeStringValue(path));
+        if(value)
+            operation.m_Members.emplace_back(L"value", *value);
+    }
+
+    void AddMoveOperation(std::wstring_view fromPath, std::wstring_view path)
+    {
+        JsonValue& operation = m_Patch.m_Items.emplace_back();
+        operation.m_Type = JsonValue::Type::Object;
+        operation.m_Members.emplace_back(L"op", MakeStringValue(L"move"));
+        operation.m_Members.emplace_back(L"from", MakeStringValue(fromPath));
+        operation.m_Members.emplace_back(L"path", MakeStringValue(path));
+    }
+
+    void DiffObjects(const JsonValue& from, const JsonValue& to, const std::wstring& path)
+    {
+        std::unordered_map<std::wstring_view, size_t> fromIndices;
+        fromIndices.reserve(from.m_Members.size());
+        for(size_t i = 0; i < from.m_Members.size(); ++i)
+            fromIndices.emplace(from.m_Members[i].first, i);
+
+        std::vector<bool> fromMatched(from.m_Members.size());
+        for(const auto& toMember : to.m_Members)
+        {
+            const std::wstring memberPath = MakePath(path, toMember.first);
+            if(auto it = fromIndices.find(toMember.first); it != fromIndices.end())
+            {
+                fromMatched[it->second] = true;
+                Diff(from.m_Members[it->second].second, toMember.second, memberPath);
+            }
+            else
+                AddOperation(L"add", memberPath, &toMember.second);
+        }
+
+        for(size_t i = 0; i < from.m_Members.size(); ++i)
+        {
+            if(!fromMatched[i])
+                AddOperation(L"remove", MakePath(path, from.m_Members[i].first), nullptr);
+        }
+    }
+
+    void DiffArrays(const JsonValue& from, const JsonValue& to, const std::wstring& path)
+    {
+        const size_t commonCount = std::min(from.m_Items.size(), to.m_Items.size());
+        for(size_t i = 0; i < commonCount; ++i)
+            Diff(from.m_Items[i], to.m_Items[i], MakePath(path, i));
+        for(size_t i = commonCount; i < to.m_Items.size(); ++i)
+            AddOperation(L"add", MakePath(path, i), &to.m_Items[i]);
+        // Removing from the end, so indices of items still to be removed don't change.
+        for(size_t i = from.m_Items.size(); i-- > commonCount;)
+            AddOperation(L"remove", MakePath(path, i), nullptr);
+    }
+
+    // Returns false if items of these arrays cannot be matched by key.
+    bool MakeKeyIndices(const JsonValue& arr, std::vector<std::wstring>& outKeys,
+        std::unordered_map<std::wstring_view, size_t>& outIndices)
+    {
+        outKeys.reserve(arr.m_Items.size());
+        for(const JsonValue& item : arr.m_Items)
+        {
+            outKeys.push_back(m_GetItemKey(item));
+            if(outKeys.back().empty())
+                return false;
+        }
+        outIndices.reserve(outKeys.size());
+        for(size_t i = 0; i < outKeys.size(); ++i)
+        {
+            if(!outIndices.emplace(outKeys[i], i).second)
+                return false;
+        }
+        return true;
+    }
+
+    bool DiffKeyedArrays(const JsonValue& from, const JsonValue& to, const std::wstring& path)
+    {
+        if(!m_GetItemKey || from.m_Items.empty() || to.m_Items.empty())
+            return false;
+
+        std::vector<std::wstring> fromKeys, toKeys;
+        std::unordered_map<std::wstring_view, size_t> fromIndices, toIndices;
+        if(!MakeKeyIndices(from, fromKeys, fromIndices) || !MakeKeyIndices(to, toKeys, toIndices))
+            return false;
+
+        // Operations are applied in order, so simulate the array to know current index of each item.
+        // 1. Remove items that are gone.
+        std::vector<size_t> current; // Indices into from.m_Items.
+        for(size_t i = from.m_Items.size(); i--;)
+        {
+            if(toIndices.find(fromKeys[i]) == toIndices.end())
+                AddOperation(L"remove", MakePath(path, i), nullptr);
+        }
+        for(size_t i = 0; i < from.m_Items.size(); ++i)
+        {
+            if(toIndices.find(fromKeys[i]) != toIndices.end())
+                current.push_back(i);
+        }
+
+        // 2. Move remaining items to the order they have now.
+        std::vector<size_t> desired;
+        for(size_t i = 0; i < to.m_Items.size(); ++i)
+        {
+            if(auto it = fromIndices.find(toKeys[i]); it != fromIndices.end())
+                desired.push_back(it->second);
+        }
+        for(size_t i = 0; i < desired.size(); ++i)
+        {
+            if(current[i] == desired[i])
+                continue;
+            const size_t srcIndex = size_t(std::find(current.begin() + i, current.end(), desired[i]) - current.begin());
+            AddMoveOperation(MakePath(path, srcIndex), MakePath(path, i));
+            std::rotate(current.begin() + i, current.begin() + srcIndex, current.begin() + srcIndex + 1);
+        }
+
+        // 3. Insert new items. Going in increasing order, all items before each one are already in place.
+        for(size_t i = 0; i < to.m_Items.size(); ++i)
+        {
+            if(fromIndices.find(toKeys[i]) == fromIndices.end())
+                AddOperation(L"add", MakePath(path, i), &to.m_Items[i]);
+        }
+
+        // 4. Now indices are final - diff contents of matching items.
+        for(size_t i = 0; i < to.m_Items.size(); ++i)
+        {
+            if(auto it = fromIndices.find(toKeys[i]); it != fromIndices.end())
+                Diff(from.m_Items[it->second], to.m_Items[i], MakePath(path, i));
+        }
+
+        return true;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+JsonValue MakeJsonPatch(const JsonValue& from, const JsonValue& to, const JsonArrayItemKeyFunc& getItemKey)
+{
+    JsonPatchBuilder builder(getItemKey);
+    builder.Diff(from, to, std::wstring());
+    return std::move(builder.GetPatch());
+}
@@ -0,0 +1,20 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+#include "Json.hpp"
+
+// Returns a key identifying an array item, e.g. the adapter LUID, or empty string if the item has none.
+// Arrays where all items have unique keys are matched by key instead of by index.
+using JsonArrayItemKeyFunc = std::function<std::wstring(const JsonValue& item)>;
+
+// Makes a JSON Patch (RFC 6902) that turns `from` into `to`, as an array of operations.
+// Runs in time linear to the size of both documents, except for reordering of keyed array items.
+JsonValue MakeJsonPatch(const JsonValue& from, const JsonValue& to, const JsonArrayItemKeyFunc& getItemKey);
@@ -0,0 +1,172 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "JsonRpc.hpp"
+
+#include "Utils.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static std::wstring WriteJsonRpcId(const JsonValue& id)
+{
+    std::wstring str;
+    WriteJson(id, false, str);
+    return str;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+JsonRpcRequest ParseJsonRpcRequest(std::wstring_view text)
+{
+    JsonValue message;
+    try
+    {
+        message = ParseJson(text);
+    }
+    catch(const std::exception& ex)
+    {
+        throw JsonRpcError(JSON_RPC_ERROR_PARSE, ex.what());
+    }
+
+    if(!message.IsObject())
+        throw JsonRpcError(JSON_RPC_ERROR_INVALID_REQUEST, "Request must be an object.");
+
+    const JsonValue* version = message.FindMember(L"jsonrpc");
+    if(!version || version->m_Type != JsonValue::Type::String || version->m_String != L"2.0")
+        throw JsonRpcError(JSON_RPC_ERROR_INVALID_REQUEST, "Request must have \"jsonrpc\": \"2.0\".");
+
+    JsonRpcRequest request;
+    if(const JsonValue* id = message.FindMember(L"id"))
+    {
+        if(id->m_Type != JsonValue::Type::String && id->m_Type != JsonValue::Type::Number &&
+            id->m_Type != JsonValue::Type::Null)
+            throw JsonRpcError(JSON_RPC_ERROR_INVALID_REQUEST, "Request id must be a string, a number, or null.");
+        request.m_HasId = true;
+        request.m_Id = *id;
+    }
+
+    const JsonValue* method = message.FindMember(L"method");
+    if(!method || method->m_Type != JsonValue::Type::String)
+        throw JsonRpcError(JSON_RPC_ERROR_INVALID_REQUEST, "Request must have a \"method\" string.");
+    request.m_Method = method->m_String;
+
+    if(const JsonValue* params = message.FindMember(L"params"))
+    {
+        if(!params->IsObject() && !params->IsArray())
+            throw JsonRpcError(JSON_RPC_ERROR_INVALID_REQUEST, "Request \"params\" must be an object or an array.");
+        request.m_Params = *params;
+    }
+
+    return request;
+}
+
+std::wstring MakeJsonRpcResult(const JsonValue& id, std::wstring_view resultJson)
+{
+    return std::format(L"{{\"jsonrpc\":\"2.0\",\"id\":{},\"result\":{}}}", WriteJsonRpcId(id), resultJson);
+}
+
+std::wstring MakeJsonRpcError(const JsonValue& id, int code, std::string_view message)
+{
+    const std::wstring messageW = StrToWstr(std::string(message).c_str(), CP_UTF8);
+    return std::format(L"{{\"jsonrpc\":\"2.0\",\"id\":{},\"error\":{{\"code\":{},\"message\":\"{}\"}}}}",
+        WriteJsonRpcId(id), code, EscapeJsonString(messageW));
+}
+
+std::wstring GetJsonRpcReportOptions(const JsonValue& params)
+{
+    if(params.IsArray())
+        throw JsonRpcError(JSON_RPC_ERROR_INVALID_PARAMS, "Parameters must be given by name.");
+
+    std::wstring options;
+    if(const JsonValue* adapter = params.FindMember(L"adapter"))
+    {
+        if(adapter->m_Type != JsonValue::Type::Number || adapter->m_String.empty() ||
+            adapter->m_String.find_first_not_of(L"0123456789") != std::wstring::npos)
+            throw JsonRpcError(JSON_RPC_ERROR_INVALID_PARAMS, "Parameter \"adapter\" must be an adapter index.");
+        options += std::format(L"--Adapter={} ", adapter->m_String);
+    }
+    if(const JsonValue* select = params.FindMember(L"select"))
+    {
+        // It's put in quotes, which it could otherwise end, or escape with a backslash, to inject more options.
+        if(select->m_Type != JsonValue::Type::String ||
+            select->m_String.find_first_of(L"\"\\") != std::wstring::npos)
+            throw JsonRpcError(JSON_RPC_ERROR_INVALID_PARAMS,
+                "Parameter \"select\" must be a string without quotes and backslashes.");
+        options += std::format(L"\"--Select={}\" ", select->m_String);
+    }
+    if(const JsonValue* extraOptions = params.FindMember(L"options"))
+    {
+        if(extraOptions->m_Type != JsonValue::Type::String)
+            throw JsonRpcError(JSON_RPC_ERROR_INVALID_PARAMS, "Parameter \"options\" must be a string.");
+        options += extraOptions->m_String;
+    }
+    return options;
+}
+
+JsonRpcServer::JsonRpcServer(JsonRpcReportSource& reportSource)
+    : m_ReportSource(reportSource)
+{
+}
+
+std::wstring JsonRpcServer::HandleLine(std::string_view line)
+{
+    if(line.find_first_not_of(" \t\r") == std::string_view::npos)
+        return {};
+
+    JsonRpcRequest request;
+    // Errors of requests that could not be parsed are answered with null id.
+    bool respond = true;
+    std::wstring response;
+    try
+    {
+        request = ParseJsonRpcRequest(StrToWstr(std::string(line).c_str(), CP_UTF8));
+        respond = request.m_HasId;
+        response = HandleRequest(request);
+    }
+    catch(const JsonRpcError& ex)
+    {
+        response = MakeJsonRpcError(request.m_Id, ex.GetCode(), ex.what());
+    }
+    catch(const std::exception& ex)
+    {
+        response = MakeJsonRpcError(request.m_Id, JSON_RPC_ERROR_SERVER, ex.what());
+    }
+    // Notifications get no response.
+    return respond ? response : std::wstring();
+}
+
+std::wstring JsonRpcServer::HandleRequest(const JsonRpcRequest& request)
+{
+    if(request.m_Method == L"report")
+    {
+        const std::wstring options = GetJsonRpcReportOptions(request.m_Params);
+        auto it = m_Reports.find(options);
+        if(it == m_Reports.end())
+            it = m_Reports.emplace(options, m_ReportSource.PrintReport(options)).first;
+        return MakeJsonRpcResult(request.m_Id, it->second);
+    }
+    if(request.m_Method == L"videoMemory")
+    {
+        const JsonValue* adapter = request.m_Params.FindMember(L"adapter");
+        if(!adapter)
+            throw JsonRpcError(JSON_RPC_ERROR_INVALID_PARAMS, "Parameter \"adapter\" is required.");
+        // Budget and usage change all the time, so they are never answered from memory.
+        const std::wstring options =
+            GetJsonRpcReportOptions(request.m_Params) + L" --Select=Adapters/*/DXGI_QUERY_VIDEO_MEMORY_INFO*";
+        return MakeJsonRpcResult(request.m_Id, m_ReportSource.PrintReport(options));
+    }
+    if(request.m_Method == L"shutdown")
+    {
+        m_ShutDown = true;
+        return MakeJsonRpcResult(request.m_Id, L"null");
+    }
+    throw JsonRpcError(JSON_RPC_ERROR_METHOD_NOT_FOUND, "Method not found.");
+}
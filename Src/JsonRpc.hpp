@@ -0,0 +1,100 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+#include "Json.hpp"
+
+// Messages of JSON-RPC 2.0, as exchanged by --Serve, one per line.
+
+// Error codes defined by JSON-RPC 2.0.
+enum JSON_RPC_ERROR
+{
+    JSON_RPC_ERROR_PARSE = -32700,
+    JSON_RPC_ERROR_INVALID_REQUEST = -32600,
+    JSON_RPC_ERROR_METHOD_NOT_FOUND = -32601,
+    JSON_RPC_ERROR_INVALID_PARAMS = -32602,
+    // First of the range reserved for errors of the server itself.
+    JSON_RPC_ERROR_SERVER = -32000,
+};
+
+// Thrown while handling a request, so it gets answered with an error response of that code.
+class JsonRpcError : public std::runtime_error
+{
+public:
+    JsonRpcError(int code, const std::string& message)
+        : std::runtime_error(message)
+        , m_Code(code)
+    {
+    }
+    int GetCode() const
+    {
+        return m_Code;
+    }
+
+private:
+    int m_Code;
+};
+
+struct JsonRpcRequest
+{
+    // Requests without an id are notifications, which get no response.
+    bool m_HasId = false;
+    JsonValue m_Id;
+    std::wstring m_Method;
+    // Null if not given, otherwise an object or an array.
+    JsonValue m_Params;
+};
+
+// Throws JsonRpcError if the text is not valid JSON or not a valid request.
+JsonRpcRequest ParseJsonRpcRequest(std::wstring_view text);
+
+// resultJson must be already serialized JSON, e.g. a report printed by JSONReportFormatter.
+std::wstring MakeJsonRpcResult(const JsonValue& id, std::wstring_view resultJson);
+std::wstring MakeJsonRpcError(const JsonValue& id, int code, std::string_view message);
+
+// Turns parameters "adapter", "select" and "options" of a request into command-line options.
+// Throws JsonRpcError if they are invalid.
+std::wstring GetJsonRpcReportOptions(const JsonValue& params);
+
+// Prints the reports asked for by JsonRpcServer, e.g. from the D3D12 devices of the program or from a fake one.
+class JsonRpcReportSource
+{
+public:
+    virtual ~JsonRpcReportSource() = default;
+    // Returns the report printed with the command-line options, as minimized JSON.
+    // Throws JsonRpcError if the options are invalid, or another exception if printing fails.
+    virtual std::wstring PrintReport(const std::wstring& options) = 0;
+};
+
+// Methods of --Serve:
+// - "report" with optional "adapter", "select" and "options" returns the report. A report asked for again with the
+//   same options is answered from memory, as capabilities don't change while the program runs.
+// - "videoMemory" with "adapter" returns current budget and usage of video memory, never from memory.
+// - "shutdown" returns null and ends the server.
+class JsonRpcServer
+{
+public:
+    JsonRpcServer(JsonRpcReportSource& reportSource);
+
+    // Returns the response to a line of input, in UTF-8, or empty if there is none, for notifications and empty lines.
+    std::wstring HandleLine(std::string_view line);
+    bool IsShutDown() const
+    {
+        return m_ShutDown;
+    }
+
+private:
+    JsonRpcReportSource& m_ReportSource;
+    // Keys are command-line options.
+    std::unordered_map<std::wstring, std::wstring> m_Reports;
+    bool m_ShutDown = false;
+
+    std::wstring HandleRequest(const JsonRpcRequest& request);
+};
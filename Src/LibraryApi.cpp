@@ -0,0 +1,137 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "D3d12infoApi.h"
+
+#include "Main.hpp"
+#include "ReportTree.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+struct D3d12infoReport
+{
+    ReportTree m_Tree;
+    // Written on the first call to D3d12info_GetReportJson.
+    mutable std::optional<std::string> m_Json;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+D3d12infoResult D3d12info_GetAdapters(D3d12infoAdapter* adapters, uint32_t* count)
+{
+    if(count == nullptr)
+        return D3D12INFO_ERROR_INVALID_ARGUMENT;
+    try
+    {
+        const std::vector<D3d12infoAdapter> found = GetLibraryAdapters();
+        if(adapters == nullptr)
+        {
+            *count = uint32_t(found.size());
+            return D3D12INFO_SUCCESS;
+        }
+
+        const uint32_t writtenCount = std::min(*count, uint32_t(found.size()));
+        std::copy_n(found.begin(), writtenCount, adapters);
+        *count = writtenCount;
+        return writtenCount < found.size() ? D3D12INFO_INCOMPLETE : D3D12INFO_SUCCESS;
+    }
+    catch(...)
+    {
+        return D3D12INFO_ERROR_FAILED;
+    }
+}
+
+D3d12infoResult D3d12info_CreateReport(const wchar_t* options, D3d12infoReport** outReport)
+{
+    if(outReport == nullptr)
+        return D3D12INFO_ERROR_INVALID_ARGUMENT;
+    *outReport = nullptr;
+    try
+    {
+        auto report = std::make_unique<D3d12infoReport>();
+        PrintLibraryReport(options != nullptr ? options : L"", std::make_unique<ReportTreeBuilder>(report->m_Tree));
+        *outReport = report.release();
+        return D3D12INFO_SUCCESS;
+    }
+    catch(const std::invalid_argument&)
+    {
+        return D3D12INFO_ERROR_INVALID_ARGUMENT;
+    }
+    catch(...)
+    {
+        return D3D12INFO_ERROR_FAILED;
+    }
+}
+
+void D3d12info_DestroyReport(D3d12infoReport* report)
+{
+    delete report;
+}
+
+const char* D3d12info_GetReportJson(const D3d12infoReport* report)
+{
+    if(report == nullptr)
+        return nullptr;
+    try
+    {
+        if(!report->m_Json)
+            report->m_Json = report->m_Tree.WriteJson();
+        return report->m_Json->c_str();
+    }
+    catch(...)
+    {
+        return nullptr;
+    }
+}
+
+D3d12infoResult D3d12info_GetReportUint64(const D3d12infoReport* report, const char* path, uint64_t* outValue)
+{
+    if(report == nullptr || path == nullptr || outValue == nullptr)
+        return D3D12INFO_ERROR_INVALID_ARGUMENT;
+    const uint32_t index = report->m_Tree.Find(path);
+    if(index == ReportTree::NO_NODE)
+        return D3D12INFO_ERROR_NOT_FOUND;
+    const ReportTree::Node& node = report->m_Tree.GetNode(index);
+    switch(node.m_Type)
+    {
+    case ReportTree::Type::Bool:
+    case ReportTree::Type::Uint32:
+    case ReportTree::Type::Uint64:
+        *outValue = node.m_Uint64;
+        return D3D12INFO_SUCCESS;
+    case ReportTree::Type::Int32:
+        if(node.m_Int32 < 0)
+            return D3D12INFO_ERROR_INVALID_ARGUMENT;
+        *outValue = uint64_t(node.m_Int32);
+        return D3D12INFO_SUCCESS;
+    default:
+        return D3D12INFO_ERROR_INVALID_ARGUMENT;
+    }
+}
+
+D3d12infoResult D3d12info_GetReportString(const D3d12infoReport* report, const char* path, const char** outValue)
+{
+    if(report == nullptr || path == nullptr || outValue == nullptr)
+        return D3D12INFO_ERROR_INVALID_ARGUMENT;
+    const uint32_t index = report->m_Tree.Find(path);
+    if(index == ReportTree::NO_NODE)
+        return D3D12INFO_ERROR_NOT_FOUND;
+    const ReportTree::Node& node = report->m_Tree.GetNode(index);
+    if(node.m_Type != ReportTree::Type::String)
+        return D3D12INFO_ERROR_INVALID_ARGUMENT;
+    *outValue = report->m_Tree.GetString(node.m_String);
+    return D3D12INFO_SUCCESS;
+}
+
+void D3d12info_Shutdown(void)
+{
+    ReleaseLibraryState();
+}
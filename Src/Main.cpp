@@ -7,16 +7,40 @@ License: MIT
 
 For more information, see files README.md, LICENSE.txt.
 */
+#include "AdapterWatcher.hpp"
 #include "AgsData.hpp"
 #include "AmdDeviceInfoData.hpp"
+#include "Benchmark.hpp"
+#include "CapabilityArchive.hpp"
+#include "DeviceCapture.hpp"
+#include "DeviceProbes.hpp"
+#include "DriverQuirks.hpp"
 #include "Enums.hpp"
 #include "IntelData.hpp"
+#include "JsonRpc.hpp"
+#include "Main.hpp"
+#include "MemoryMonitor.hpp"
+#include "NvApiMonitor.hpp"
+#include "OpenMetrics.hpp"
 #include "NvApiData.hpp"
 #include "Printer.hpp"
+#include "JsonPatch.hpp"
+#include "ProbeTimings.hpp"
+#include "RawFeatureData.hpp"
+#include "ReplayDevice.hpp"
+#include "ReportCache.hpp"
+#include "ReportFormatter/CallLogReportFormatter.hpp"
 #include "ReportFormatter/ReportFormatter.hpp"
+#include "ReportRenderer.hpp"
+#include "ReportSelection.hpp"
+#include "ReportStats.hpp"
+#include "SharedSnapshot.hpp"
 #include "SystemData.hpp"
+#include "Trace.hpp"
 #include "Utils.hpp"
+#include "VendorApis.hpp"
 #include "VulkanData.hpp"
+#include "Watchdog.hpp"
 
 #define WIDE_CHAR_STRING_HELPER(x) L ## x
 #define WIDE_CHAR_STRING(x) WIDE_CHAR_STRING_HELPER(x)
@@ -24,56 +48,12 @@ constexpr const wchar_t* BUILD_TIME = WIDE_CHAR_STRING(__DATE__) L" " WIDE_CHAR_
 #undef WIDE_CHAR_STRING
 #undef WIDE_CHAR_STRING_HELPER
 
-// For Direct3D 12 Agility SDK
-extern "C"
-{
+// Version of the Agility SDK headers, which the executable exports as D3D12SDKVersion, see ProgramMain.cpp.
 #ifdef USE_PREVIEW_AGILITY_SDK
-    __declspec(dllexport) extern const UINT D3D12SDKVersion = D3D12_PREVIEW_SDK_VERSION;
-    __declspec(dllexport) extern const char* D3D12SDKPath = ".\\D3D12_preview\\";
+static const UINT AGILITY_SDK_VERSION = D3D12_PREVIEW_SDK_VERSION;
 #else
-    __declspec(dllexport) extern const UINT D3D12SDKVersion = D3D12_SDK_VERSION;
-    __declspec(dllexport) extern const char* D3D12SDKPath = ".\\D3D12\\";
+static const UINT AGILITY_SDK_VERSION = D3D12_SDK_VERSION;
 #endif
-}
-
-// VendorIDs used for deciding whether to use Vendor specific APIs with each device
-enum VENDOR_ID
-{
-    VENDOR_ID_AMD = 0x1002,
-    VENDOR_ID_NVIDIA = 0x10de,
-    VENDOR_ID_INTEL = 0x8086
-};
-
-constexpr D3D12_COMMAND_LIST_TYPE COMMAND_LIST_TYPES[] = {
-    D3D12_COMMAND_LIST_TYPE_DIRECT,
-    D3D12_COMMAND_LIST_TYPE_COMPUTE,
-    D3D12_COMMAND_LIST_TYPE_COPY,
-    D3D12_COMMAND_LIST_TYPE_VIDEO_DECODE,
-    D3D12_COMMAND_LIST_TYPE_VIDEO_PROCESS,
-    D3D12_COMMAND_LIST_TYPE_VIDEO_ENCODE,
-};
-constexpr size_t COMMAND_LIST_TYPES_COUNT = _countof(COMMAND_LIST_TYPES);
-
-constexpr D3D12_COMMAND_QUEUE_PRIORITY COMMAND_QUEUE_PRIORITIES[] = { D3D12_COMMAND_QUEUE_PRIORITY_NORMAL,
-    D3D12_COMMAND_QUEUE_PRIORITY_HIGH, D3D12_COMMAND_QUEUE_PRIORITY_GLOBAL_REALTIME };
-constexpr size_t COMMAND_QUEUE_PRIORITIES_COUNT = _countof(COMMAND_QUEUE_PRIORITIES);
-
-constexpr D3D12_BARRIER_LAYOUT BARRIER_LAYOUTS[] = { D3D12_BARRIER_LAYOUT_COMMON, D3D12_BARRIER_LAYOUT_GENERIC_READ,
-    D3D12_BARRIER_LAYOUT_RENDER_TARGET, D3D12_BARRIER_LAYOUT_UNORDERED_ACCESS, D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_WRITE,
-    D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ, D3D12_BARRIER_LAYOUT_SHADER_RESOURCE, D3D12_BARRIER_LAYOUT_COPY_SOURCE,
-    D3D12_BARRIER_LAYOUT_COPY_DEST, D3D12_BARRIER_LAYOUT_RESOLVE_SOURCE, D3D12_BARRIER_LAYOUT_RESOLVE_DEST,
-    D3D12_BARRIER_LAYOUT_SHADING_RATE_SOURCE, D3D12_BARRIER_LAYOUT_VIDEO_DECODE_READ,
-    D3D12_BARRIER_LAYOUT_VIDEO_DECODE_WRITE, D3D12_BARRIER_LAYOUT_VIDEO_PROCESS_READ,
-    D3D12_BARRIER_LAYOUT_VIDEO_PROCESS_WRITE, D3D12_BARRIER_LAYOUT_VIDEO_ENCODE_READ,
-    D3D12_BARRIER_LAYOUT_VIDEO_ENCODE_WRITE, D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_COMMON,
-    D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_GENERIC_READ, D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_UNORDERED_ACCESS,
-    D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_SHADER_RESOURCE, D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_COPY_SOURCE,
-    D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_COPY_DEST, D3D12_BARRIER_LAYOUT_COMPUTE_QUEUE_COMMON,
-    D3D12_BARRIER_LAYOUT_COMPUTE_QUEUE_GENERIC_READ, D3D12_BARRIER_LAYOUT_COMPUTE_QUEUE_UNORDERED_ACCESS,
-    D3D12_BARRIER_LAYOUT_COMPUTE_QUEUE_SHADER_RESOURCE, D3D12_BARRIER_LAYOUT_COMPUTE_QUEUE_COPY_SOURCE,
-    D3D12_BARRIER_LAYOUT_COMPUTE_QUEUE_COPY_DEST,
-    D3D12_BARRIER_LAYOUT_DIRECT_QUEUE_GENERIC_READ_COMPUTE_QUEUE_ACCESSIBLE };
-constexpr size_t BARRIER_LAYOUTS_COUNT = _countof(BARRIER_LAYOUTS);
 
 // #define AUTO_LINK_DX12    // use this on everything before Win10
 #if defined(AUTO_LINK_DX12)
@@ -88,15 +68,6 @@ typedef HRESULT(WINAPI* PFN_DXGI_CREATE_FACTORY1)(REFIID riid, _COM_Outptr_ void
 HMODULE g_DxgiLibrary = nullptr;
 HMODULE g_Dx12Library = nullptr;
 
-static const D3D_ROOT_SIGNATURE_VERSION HIGHEST_ROOT_SIGNATURE_VERSION = D3D_ROOT_SIGNATURE_VERSION_1_2;
-static const D3D_FEATURE_LEVEL FEATURE_LEVELS_ARRAY[] = {
-    D3D_FEATURE_LEVEL_12_2,
-    D3D_FEATURE_LEVEL_12_1,
-    D3D_FEATURE_LEVEL_12_0,
-    D3D_FEATURE_LEVEL_11_1,
-    D3D_FEATURE_LEVEL_11_0,
-};
-static const D3D_FEATURE_LEVEL MAX_FEATURE_LEVEL = D3D_FEATURE_LEVEL_12_2;
 static const D3D_FEATURE_LEVEL MIN_FEATURE_LEVEL = D3D_FEATURE_LEVEL_11_0;
 
 const wchar_t* const DYN_LIB_DXGI = L"dxgi.dll";
@@ -114,564 +85,83 @@ PFN_D3D12_GET_INTERFACE g_D3D12GetInterface;                              // Opt
 
 #endif // #if defined(AUTO_LINK_DX12)
 
-// # From vkd3d-proton project, see:
-// https://github.com/HansKristian-Work/vkd3d-proton/issues/2459
-// https://github.com/HansKristian-Work/vkd3d-proton/blob/master/include/vkd3d_device_vkd3d_ext.idl
-DEFINE_GUID(IID_ID3D12DXVKInteropDevice, 0x39da4e09, 0xbd1c, 0x4198, 0x9f, 0xae, 0x86, 0xbb, 0xe3, 0xbe, 0x41, 0xfd);
-
 // D3d12info GUID for use with ID3D12ApplicationIdentity
 DEFINE_GUID(APPID_D3D12INFO, 0x86671909, 0x7f0b, 0x44d6, 0xb0, 0xf9, 0xbe, 0xca, 0x2f, 0xc7, 0x4e, 0x2e);
 
-// Command line flags
-static bool g_ShowVersionAndQuit = false;
-static bool g_ShowCommandLineSyntaxAndQuit = false;
-static bool g_ShowCommandLineSyntaxAndFail = false;
-static bool g_ListAdapters = false;
-static bool g_ShowAllAdapters = true;
-static bool g_SkipSoftwareAdapter = true;
-static bool g_UseJsonOutput = false;
-static bool g_UseJsonPrettyPrint = true;
-static bool g_OutputFile = false;
-static bool g_PrintFormats = false;
-static bool g_PrintMetaCommands = false;
-static bool g_PrintEnums = false;
-static bool g_PureD3D12 = false;
+// Command line flags. With --Batch, each job has its own copy, made from the options of the whole batch.
+struct ProgramOptions
+{
+    bool ShowVersionAndQuit = false;
+    bool ShowCommandLineSyntaxAndQuit = false;
+    bool ShowCommandLineSyntaxAndFail = false;
+    bool ListAdapters = false;
+    bool ListVendorData = false;
+    bool ShowAllAdapters = true;
+    bool SkipSoftwareAdapter = true;
+    bool UseJsonOutput = false;
+    bool UseJsonPrettyPrint = true;
+    bool UseFlatOutput = false;
+    bool OutputFile = false;
+    bool PrintFormats = false;
+    bool PrintMetaCommands = false;
+    bool PrintEnums = false;
+    bool PureD3D12 = false;
 #ifdef USE_PREVIEW_AGILITY_SDK
-static bool g_EnableExperimental = true;
+    bool EnableExperimental = true;
 #else
-static bool g_EnableExperimental = false;
+    bool EnableExperimental = false;
 #endif
-static bool g_ForceVendorAPI = false;
-static bool g_WARP = false;
-static std::wstring g_OutputFilePath;
+    bool ForceVendorAPI = false;
+    bool WARP = false;
+    bool UseCache = false;
+    bool ClearCache = false;
+    bool PrintTimings = false;
+    bool PrintStats = false;
+    // UINT32_MAX means first non-software and non-remote adapter.
+    uint32_t AdapterIndex = UINT32_MAX;
+    std::wstring OutputFilePath;
+    std::wstring BaselineFilePath;
+    std::wstring TraceFilePath;
+    std::wstring RecordFilePath;
+    std::wstring ReplayFilePath;
+    std::wstring ArchiveFilePath;
+    std::wstring RawFilePath;
+    std::wstring DecodeRawFilePath;
+    std::wstring RenderDirectoryPath;
+    std::wstring QuirksFilePath;
+    std::wstring SelectPaths;
+    std::wstring BatchFilePath;
+    bool Serve = false;
+    // Printed through the library API in another program, whose process-wide D3D12 state must stay unchanged.
+    bool InLibrary = false;
+    std::wstring PublishName;
+    uint32_t PublishIntervalSeconds = 0;
+    // 0 means not monitoring.
+    uint32_t MonitorIntervalMilliseconds = 0;
+    uint32_t MonitorNvApiIntervalMilliseconds = 0;
+    // 0 means not serving metrics.
+    uint32_t MetricsPort = 0;
+    std::wstring MetricsFilePath;
+    uint32_t MetricsIntervalSeconds = 0;
+    bool Watch = false;
+    // 0 means not benchmarking.
+    uint32_t BenchmarkRunCount = 0;
+    uint32_t TimeoutSeconds = 0;
+    uint32_t ProbeTimeoutMilliseconds = 0;
+};
+
+// Options of the report being printed.
+static ProgramOptions g_Options;
 
 // Derived flags
 static bool g_PrintAdaptersAsArray = true;
 
-static wstring LuidToStr(LUID value)
-{
-    wchar_t s[64];
-    swprintf_s(s, L"%08X-%08X", (uint32_t)value.HighPart, (uint32_t)value.LowPart);
-    return wstring{ s };
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS(const D3D12_FEATURE_DATA_D3D12_OPTIONS& options)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"DoublePrecisionFloatShaderOps", options.DoublePrecisionFloatShaderOps);
-    formatter.AddFieldBool(L"OutputMergerLogicOp", options.OutputMergerLogicOp);
-    formatter.AddFieldEnum(
-        L"MinPrecisionSupport", options.MinPrecisionSupport, Enum_D3D12_SHADER_MIN_PRECISION_SUPPORT);
-    formatter.AddFieldEnum(L"TiledResourcesTier", options.TiledResourcesTier, Enum_D3D12_TILED_RESOURCES_TIER);
-    formatter.AddFieldEnum(L"ResourceBindingTier", options.ResourceBindingTier, Enum_D3D12_RESOURCE_BINDING_TIER);
-    formatter.AddFieldBool(L"PSSpecifiedStencilRefSupported", options.PSSpecifiedStencilRefSupported);
-    formatter.AddFieldBool(L"TypedUAVLoadAdditionalFormats", options.TypedUAVLoadAdditionalFormats);
-    formatter.AddFieldBool(L"ROVsSupported", options.ROVsSupported);
-    formatter.AddFieldEnum(L"ConservativeRasterizationTier", options.ConservativeRasterizationTier,
-        Enum_D3D12_CONSERVATIVE_RASTERIZATION_TIER);
-    formatter.AddFieldUint32(L"MaxGPUVirtualAddressBitsPerResource", options.MaxGPUVirtualAddressBitsPerResource);
-    formatter.AddFieldBool(L"StandardSwizzle64KBSupported", options.StandardSwizzle64KBSupported);
-    formatter.AddFieldEnum(L"CrossNodeSharingTier", options.CrossNodeSharingTier, Enum_D3D12_CROSS_NODE_SHARING_TIER);
-    formatter.AddFieldBool(L"CrossAdapterRowMajorTextureSupported", options.CrossAdapterRowMajorTextureSupported);
-    formatter.AddFieldBool(L"VPAndRTArrayIndexFromAnyShaderFeedingRasterizerSupportedWithoutGSEmulation",
-        options.VPAndRTArrayIndexFromAnyShaderFeedingRasterizerSupportedWithoutGSEmulation);
-    formatter.AddFieldEnum(L"ResourceHeapTier", options.ResourceHeapTier, Enum_D3D12_RESOURCE_HEAP_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_ARCHITECTURE(const D3D12_FEATURE_DATA_ARCHITECTURE& architecture)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_ARCHITECTURE");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldUint32(L"NodeIndex", architecture.NodeIndex);
-    formatter.AddFieldBool(L"TileBasedRenderer", architecture.TileBasedRenderer);
-    formatter.AddFieldBool(L"UMA", architecture.UMA);
-    formatter.AddFieldBool(L"CacheCoherentUMA", architecture.CacheCoherentUMA);
-}
-
-static void Print_D3D12_FEATURE_DATA_ARCHITECTURE1(const D3D12_FEATURE_DATA_ARCHITECTURE1& architecture1)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_ARCHITECTURE1");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldUint32(L"NodeIndex", architecture1.NodeIndex);
-    formatter.AddFieldBool(L"TileBasedRenderer", architecture1.TileBasedRenderer);
-    formatter.AddFieldBool(L"UMA", architecture1.UMA);
-    formatter.AddFieldBool(L"CacheCoherentUMA", architecture1.CacheCoherentUMA);
-    formatter.AddFieldBool(L"IsolatedMMU", architecture1.IsolatedMMU);
-}
-
-static void Print_D3D12_FEATURE_DATA_FEATURE_LEVELS(const D3D12_FEATURE_DATA_FEATURE_LEVELS& featureLevels)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_FEATURE_LEVELS");
-
-    // NumFeatureLevels and pFeatureLevelsRequested are IN parameters
-    // They let the app to specify what enum values does the app expect
-    // So same API can be used when new feature levels are added in the future
-    // No need to print those IN parameters here
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"MaxSupportedFeatureLevel", featureLevels.MaxSupportedFeatureLevel, Enum_D3D_FEATURE_LEVEL);
-}
-
-static void Print_D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT(
-    const D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT& virtualAddressSupport)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT");
-    ReportFormatter::GetInstance().AddFieldUint32(
-        L"MaxGPUVirtualAddressBitsPerResource", virtualAddressSupport.MaxGPUVirtualAddressBitsPerResource);
-    ReportFormatter::GetInstance().AddFieldUint32(
-        L"MaxGPUVirtualAddressBitsPerProcess", virtualAddressSupport.MaxGPUVirtualAddressBitsPerProcess);
-}
-
-static void Print_D3D12_FEATURE_DATA_SHADER_MODEL(const D3D12_FEATURE_DATA_SHADER_MODEL& shaderModel)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SHADER_MODEL");
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"HighestShaderModel", shaderModel.HighestShaderModel, Enum_D3D_SHADER_MODEL);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS1(const D3D12_FEATURE_DATA_D3D12_OPTIONS1& options1)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS1");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"WaveOps", options1.WaveOps);
-    formatter.AddFieldUint32(L"WaveLaneCountMin", options1.WaveLaneCountMin);
-    formatter.AddFieldUint32(L"WaveLaneCountMax", options1.WaveLaneCountMax);
-    formatter.AddFieldUint32(L"TotalLaneCount", options1.TotalLaneCount);
-    formatter.AddFieldBool(L"ExpandedComputeResourceStates", options1.ExpandedComputeResourceStates);
-    formatter.AddFieldBool(L"Int64ShaderOps", options1.Int64ShaderOps);
-}
-
-static void Print_D3D12_FEATURE_DATA_ROOT_SIGNATURE(const D3D12_FEATURE_DATA_ROOT_SIGNATURE& rootSignature)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_ROOT_SIGNATURE");
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"HighestVersion", rootSignature.HighestVersion, Enum_D3D_ROOT_SIGNATURE_VERSION);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS2(const D3D12_FEATURE_DATA_D3D12_OPTIONS2& options2)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS2");
-    ReportFormatter::GetInstance().AddFieldBool(L"DepthBoundsTestSupported", options2.DepthBoundsTestSupported);
-    ReportFormatter::GetInstance().AddFieldEnum(L"ProgrammableSamplePositionsTier",
-        options2.ProgrammableSamplePositionsTier, Enum_D3D12_PROGRAMMABLE_SAMPLE_POSITIONS_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_SHADER_CACHE(const D3D12_FEATURE_DATA_SHADER_CACHE& shaderCache)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SHADER_CACHE");
-    ReportFormatter::GetInstance().AddFieldFlags(
-        L"SupportFlags", shaderCache.SupportFlags, Enum_D3D12_SHADER_CACHE_SUPPORT_FLAGS);
-}
-
-static void Print_D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY(
-    const std::array<std::array<bool, COMMAND_QUEUE_PRIORITIES_COUNT>, COMMAND_LIST_TYPES_COUNT>& commandQueuePriority)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-
-    const wchar_t* commandListTypeNames[] = { L"TYPE_DIRECT", L"TYPE_COMPUTE", L"TYPE_COPY", L"TYPE_VIDEO_DECODE",
-        L"TYPE_VIDEO_PROCESS", L"TYPE_VIDEO_ENCODE" };
-
-    const wchar_t* commandQueuePriorityNames[] = { L"PRIORITY_NORMAL", L"PRIORITY_HIGH", L"PRIORITY_GLOBAL_REALTIME" };
-
-    for(size_t i = 0; i < COMMAND_LIST_TYPES_COUNT; ++i)
-    {
-        for(size_t j = 0; j < COMMAND_QUEUE_PRIORITIES_COUNT; ++j)
-        {
-            std::wstring fieldName = std::wstring(commandListTypeNames[i]) + L"." + commandQueuePriorityNames[j] +
-                                     L".PriorityForTypeIsSupported";
-            formatter.AddFieldBool(fieldName, commandQueuePriority[i][j]);
-        }
-    }
-}
-
-static void Print_D3D12_FEATURE_DATA_BARRIER_LAYOUT(
-    const std::array<std::array<bool, BARRIER_LAYOUTS_COUNT>, COMMAND_LIST_TYPES_COUNT>& barrierLayout)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_BARRIER_LAYOUT");
-
-    for(size_t i = 0; i < barrierLayout.size(); i++)
-    {
-        const wchar_t* commandListName = FindEnumItemName(COMMAND_LIST_TYPES[i], Enum_D3D12_COMMAND_LIST_TYPE);
-        assert(commandListName);
-
-        ReportScopeObject scopeCmdListType(commandListName);
-
-        for(size_t j = 0; j < barrierLayout[i].size(); j++)
-        {
-            const wchar_t* resourceStateName = FindEnumItemName(BARRIER_LAYOUTS[j], Enum_D3D12_BARRIER_LAYOUT);
-            assert(resourceStateName);
-            if(IsJsonOutput() || barrierLayout[i][j])
-            {
-                ReportFormatter::GetInstance().AddFieldBool(resourceStateName, barrierLayout[i][j]);
-            }
-        }
-    }
-}
-
-#ifdef USE_PREVIEW_AGILITY_SDK
-static void Print_D3D12_FEATURE_DATA_FENCE_BARRIERS(
-    const std::array<D3D12_FENCE_BARRIERS_TIER, COMMAND_LIST_TYPES_COUNT>& fenceBarriers)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_FENCE_BARRIERS");
-
-    for(size_t i = 0; i < fenceBarriers.size(); i++)
-    {
-        const wchar_t* commandListName = FindEnumItemName(COMMAND_LIST_TYPES[i], Enum_D3D12_COMMAND_LIST_TYPE);
-        assert(commandListName);
-
-        ReportFormatter::GetInstance().AddFieldEnum(commandListName, fenceBarriers[i], Enum_D3D12_FENCE_BARRIERS_TIER);
-    }
-}
-#endif
-
-static void Print_D3D12_FEATURE_DATA_SERIALIZATION(const D3D12_FEATURE_DATA_SERIALIZATION& serialization)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SERIALIZATION");
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"HeapSerializationTier", serialization.HeapSerializationTier, Enum_D3D12_HEAP_SERIALIZATION_TIER);
-}
-
-static void Print_D3D12_FEATURE_CROSS_NODE(const D3D12_FEATURE_DATA_CROSS_NODE& crossNode)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_CROSS_NODE");
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"SharingTier", crossNode.SharingTier, Enum_D3D12_CROSS_NODE_SHARING_TIER);
-    ReportFormatter::GetInstance().AddFieldBool(L"AtomicShaderInstructions", crossNode.AtomicShaderInstructions);
-}
-
-static void Print_D3D12_FEATURE_PREDICATION(const D3D12_FEATURE_DATA_PREDICATION& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_PREDICATION");
-    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
-}
-
-static void Print_D3D12_FEATURE_HARDWARE_COPY(const D3D12_FEATURE_DATA_HARDWARE_COPY& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_HARDWARE_COPY");
-    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
-}
-
-#ifdef USE_PREVIEW_AGILITY_SDK
-static void Print_D3D12_FEATURE_DATA_ASYNC_COMMANDS(const D3D12_FEATURE_DATA_ASYNC_COMMANDS& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_ASYNC_COMMANDS");
-    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
-}
-#endif
-
-static void Print_D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE(
-    const D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE");
-    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS3(const D3D12_FEATURE_DATA_D3D12_OPTIONS3& options3)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS3");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"CopyQueueTimestampQueriesSupported", options3.CopyQueueTimestampQueriesSupported);
-    formatter.AddFieldBool(L"CastingFullyTypedFormatSupported", options3.CastingFullyTypedFormatSupported);
-    formatter.AddFieldFlags(L"WriteBufferImmediateSupportFlags", options3.WriteBufferImmediateSupportFlags,
-        Enum_D3D12_COMMAND_LIST_SUPPORT_FLAGS);
-    formatter.AddFieldEnum(L"ViewInstancingTier", options3.ViewInstancingTier, Enum_D3D12_VIEW_INSTANCING_TIER);
-    formatter.AddFieldBool(L"BarycentricsSupported", options3.BarycentricsSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS4(const D3D12_FEATURE_DATA_D3D12_OPTIONS4& options4)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS4");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"MSAA64KBAlignedTextureSupported", options4.MSAA64KBAlignedTextureSupported);
-    formatter.AddFieldEnum(L"SharedResourceCompatibilityTier", options4.SharedResourceCompatibilityTier,
-        Enum_D3D12_SHARED_RESOURCE_COMPATIBILITY_TIER);
-    formatter.AddFieldBool(L"Native16BitShaderOpsSupported", options4.Native16BitShaderOpsSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS5(const D3D12_FEATURE_DATA_D3D12_OPTIONS5& options5)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS5");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"SRVOnlyTiledResourceTier3", options5.SRVOnlyTiledResourceTier3);
-    formatter.AddFieldEnum(L"RenderPassesTier", options5.RenderPassesTier, Enum_D3D12_RENDER_PASS_TIER);
-    formatter.AddFieldEnum(L"RaytracingTier", options5.RaytracingTier, Enum_D3D12_RAYTRACING_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS6(const D3D12_FEATURE_DATA_D3D12_OPTIONS6& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS6");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"AdditionalShadingRatesSupported", o.AdditionalShadingRatesSupported);
-    formatter.AddFieldBool(L"PerPrimitiveShadingRateSupportedWithViewportIndexing",
-        o.PerPrimitiveShadingRateSupportedWithViewportIndexing);
-    formatter.AddFieldEnum(
-        L"VariableShadingRateTier", o.VariableShadingRateTier, Enum_D3D12_VARIABLE_SHADING_RATE_TIER);
-    formatter.AddFieldUint32(L"ShadingRateImageTileSize", o.ShadingRateImageTileSize);
-    formatter.AddFieldBool(L"BackgroundProcessingSupported", o.BackgroundProcessingSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS7(const D3D12_FEATURE_DATA_D3D12_OPTIONS7& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS7");
-    ReportFormatter::GetInstance().AddFieldEnum(L"MeshShaderTier", o.MeshShaderTier, Enum_D3D12_MESH_SHADER_TIER);
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"SamplerFeedbackTier", o.SamplerFeedbackTier, Enum_D3D12_SAMPLER_FEEDBACK_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS8(const D3D12_FEATURE_DATA_D3D12_OPTIONS8& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS8");
-    ReportFormatter::GetInstance().AddFieldBool(L"UnalignedBlockTexturesSupported", o.UnalignedBlockTexturesSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS9(const D3D12_FEATURE_DATA_D3D12_OPTIONS9& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS9");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"MeshShaderPipelineStatsSupported", o.MeshShaderPipelineStatsSupported);
-    formatter.AddFieldBool(
-        L"MeshShaderSupportsFullRangeRenderTargetArrayIndex", o.MeshShaderSupportsFullRangeRenderTargetArrayIndex);
-    formatter.AddFieldBool(L"AtomicInt64OnTypedResourceSupported", o.AtomicInt64OnTypedResourceSupported);
-    formatter.AddFieldBool(L"AtomicInt64OnGroupSharedSupported", o.AtomicInt64OnGroupSharedSupported);
-    formatter.AddFieldBool(
-        L"DerivativesInMeshAndAmplificationShadersSupported", o.DerivativesInMeshAndAmplificationShadersSupported);
-    formatter.AddFieldEnum(L"WaveMMATier", o.WaveMMATier, Enum_D3D12_WAVE_MMA_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS10(const D3D12_FEATURE_DATA_D3D12_OPTIONS10& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS10");
-    ReportFormatter::GetInstance().AddFieldBool(
-        L"VariableRateShadingSumCombinerSupported", o.VariableRateShadingSumCombinerSupported);
-    ReportFormatter::GetInstance().AddFieldBool(
-        L"MeshShaderPerPrimitiveShadingRateSupported", o.MeshShaderPerPrimitiveShadingRateSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS11(const D3D12_FEATURE_DATA_D3D12_OPTIONS11& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS11");
-    ReportFormatter::GetInstance().AddFieldBool(
-        L"AtomicInt64OnDescriptorHeapResourceSupported", o.AtomicInt64OnDescriptorHeapResourceSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS12(const D3D12_FEATURE_DATA_D3D12_OPTIONS12& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS12");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldEnumSigned(L"MSPrimitivesPipelineStatisticIncludesCulledPrimitives",
-        o.MSPrimitivesPipelineStatisticIncludesCulledPrimitives, Enum_D3D12_TRI_STATE);
-    formatter.AddFieldBool(L"EnhancedBarriersSupported", o.EnhancedBarriersSupported);
-    formatter.AddFieldBool(L"RelaxedFormatCastingSupported", o.RelaxedFormatCastingSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS13(const D3D12_FEATURE_DATA_D3D12_OPTIONS13& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS13");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(
-        L"UnrestrictedBufferTextureCopyPitchSupported", o.UnrestrictedBufferTextureCopyPitchSupported);
-    formatter.AddFieldBool(
-        L"UnrestrictedVertexElementAlignmentSupported", o.UnrestrictedVertexElementAlignmentSupported);
-    formatter.AddFieldBool(L"InvertedViewportHeightFlipsYSupported", o.InvertedViewportHeightFlipsYSupported);
-    formatter.AddFieldBool(L"InvertedViewportDepthFlipsZSupported", o.InvertedViewportDepthFlipsZSupported);
-    formatter.AddFieldBool(L"TextureCopyBetweenDimensionsSupported", o.TextureCopyBetweenDimensionsSupported);
-    formatter.AddFieldBool(L"AlphaBlendFactorSupported", o.AlphaBlendFactorSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS14(const D3D12_FEATURE_DATA_D3D12_OPTIONS14& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS14");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"AdvancedTextureOpsSupported", o.AdvancedTextureOpsSupported);
-    formatter.AddFieldBool(L"WriteableMSAATexturesSupported", o.WriteableMSAATexturesSupported);
-    formatter.AddFieldBool(
-        L"IndependentFrontAndBackStencilRefMaskSupported", o.IndependentFrontAndBackStencilRefMaskSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS15(const D3D12_FEATURE_DATA_D3D12_OPTIONS15& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS15");
-    ReportFormatter::GetInstance().AddFieldBool(L"TriangleFanSupported", o.TriangleFanSupported);
-    ReportFormatter::GetInstance().AddFieldBool(
-        L"DynamicIndexBufferStripCutSupported", o.DynamicIndexBufferStripCutSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS16(const D3D12_FEATURE_DATA_D3D12_OPTIONS16& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS16");
-    ReportFormatter::GetInstance().AddFieldBool(L"DynamicDepthBiasSupported", o.DynamicDepthBiasSupported);
-    ReportFormatter::GetInstance().AddFieldBool(L"GPUUploadHeapSupported", o.GPUUploadHeapSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS17(const D3D12_FEATURE_DATA_D3D12_OPTIONS17& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS17");
-    ReportFormatter::GetInstance().AddFieldBool(
-        L"NonNormalizedCoordinateSamplersSupported", o.NonNormalizedCoordinateSamplersSupported);
-    ReportFormatter::GetInstance().AddFieldBool(
-        L"ManualWriteTrackingResourceSupported", o.ManualWriteTrackingResourceSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS18(const D3D12_FEATURE_DATA_D3D12_OPTIONS18& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS18");
-    ReportFormatter::GetInstance().AddFieldBool(L"RenderPassesValid", o.RenderPassesValid);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS19(const D3D12_FEATURE_DATA_D3D12_OPTIONS19& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS19");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"MismatchingOutputDimensionsSupported", o.MismatchingOutputDimensionsSupported);
-    formatter.AddFieldUint32(L"SupportedSampleCountsWithNoOutputs", o.SupportedSampleCountsWithNoOutputs);
-    formatter.AddFieldBool(L"PointSamplingAddressesNeverRoundUp", o.PointSamplingAddressesNeverRoundUp);
-    formatter.AddFieldBool(L"RasterizerDesc2Supported", o.RasterizerDesc2Supported);
-    formatter.AddFieldBool(L"NarrowQuadrilateralLinesSupported", o.NarrowQuadrilateralLinesSupported);
-    formatter.AddFieldBool(L"AnisoFilterWithPointMipSupported", o.AnisoFilterWithPointMipSupported);
-    formatter.AddFieldUint32(L"MaxSamplerDescriptorHeapSize", o.MaxSamplerDescriptorHeapSize);
-    formatter.AddFieldUint32(
-        L"MaxSamplerDescriptorHeapSizeWithStaticSamplers", o.MaxSamplerDescriptorHeapSizeWithStaticSamplers);
-    formatter.AddFieldUint32(L"MaxViewDescriptorHeapSize", o.MaxViewDescriptorHeapSize);
-    formatter.AddFieldBool(L"ComputeOnlyCustomHeapSupported", o.ComputeOnlyCustomHeapSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS20(const D3D12_FEATURE_DATA_D3D12_OPTIONS20& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS20");
-    ReportFormatter::GetInstance().AddFieldBool(L"ComputeOnlyWriteWatchSupported", o.ComputeOnlyWriteWatchSupported);
-    ReportFormatter::GetInstance().AddFieldEnum(L"RecreateAtTier", o.RecreateAtTier, Enum_D3D12_RECREATE_AT_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS21(const D3D12_FEATURE_DATA_D3D12_OPTIONS21& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS21");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldEnum(L"WorkGraphsTier", o.WorkGraphsTier, Enum_D3D12_WORK_GRAPHS_TIER);
-    formatter.AddFieldEnum(L"ExecuteIndirectTier", o.ExecuteIndirectTier, Enum_D3D12_EXECUTE_INDIRECT_TIER);
-    formatter.AddFieldBool(L"SampleCmpGradientAndBiasSupported", o.SampleCmpGradientAndBiasSupported);
-    formatter.AddFieldBool(L"ExtendedCommandInfoSupported", o.ExtendedCommandInfoSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS22(const D3D12_FEATURE_DATA_D3D12_OPTIONS22& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS22");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"ShaderExecutionReorderingActuallyReorders", o.ShaderExecutionReorderingActuallyReorders);
-    formatter.AddFieldBool(L"CreateByteOffsetViewsSupported", o.CreateByteOffsetViewsSupported);
-    formatter.AddFieldUint32(L"Max1DDispatchSize", o.Max1DDispatchSize);
-    formatter.AddFieldUint32(L"Max1DDispatchMeshSize", o.Max1DDispatchMeshSize);
-}
-
-static void Print_D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED(
-    const D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED");
-    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
-}
-
-static void Print_D3D12_FEATURE_DATA_TIGHT_ALIGNMENT(const D3D12_FEATURE_DATA_TIGHT_ALIGNMENT& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_TIGHT_ALIGNMENT");
-    ReportFormatter::GetInstance().AddFieldEnum(L"SupportTier", o.SupportTier, Enum_D3D12_TIGHT_ALIGNMENT_TIER);
-}
-
-#ifndef USE_PREVIEW_AGILITY_SDK
-static void Print_D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT(
-    const D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT& shaderCacheABISupport)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT");
-    ReportFormatter::GetInstance().AddFieldString(L"szAdapterFamily", shaderCacheABISupport.szAdapterFamily);
-    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
-        L"MinimumABISupportVersion", shaderCacheABISupport.MinimumABISupportVersion);
-    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
-        L"MaximumABISupportVersion", shaderCacheABISupport.MaximumABISupportVersion);
-    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
-        L"CompilerVersion", shaderCacheABISupport.CompilerVersion.Version);
-    ReportFormatter::GetInstance().AddFieldMicrosoftVersion(
-        L"ApplicationProfileVersion", shaderCacheABISupport.ApplicationProfileVersion.Version);
-}
-#endif
-
-#ifdef USE_PREVIEW_AGILITY_SDK
-static void Print_D3D12_FEATURE_DATA_PARTIAL_GRAPHICS_PROGRAMS(
-    const D3D12_FEATURE_DATA_PARTIAL_GRAPHICS_PROGRAMS& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_PARTIAL_GRAPHICS_PROGRAMS");
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"PartialGraphicsProgramsTier", o.PartialGraphicsProgramsTier, Enum_D3D12_PARTIAL_GRAPHICS_PROGRAMS_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_DUMP_FILE(const D3D12_FEATURE_DATA_DUMP_FILE& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_DUMP_FILE");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"Supported", o.Supported);
-    formatter.AddFieldEnum(L"DumpFileDriverTier", o.DumpFileDriverTier, Enum_D3D12_DUMP_FILE_DRIVER_TIER);
-    formatter.AddFieldFlags(L"DumpFileDriverOptionsMask", o.DumpFileDriverOptionsMask, Enum_D3D12_DUMP_FILE_DRIVER_OPTIONS);
-}
-
-static void Print_D3D12_FEATURE_DATA_USER_DEFINED_ANNOTATION(const D3D12_FEATURE_DATA_USER_DEFINED_ANNOTATION& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_USER_DEFINED_ANNOTATION");
-    ReportFormatter::GetInstance().AddFieldBool(L"Supported", o.Supported);
-}
-
-static void Print_D3D12_FEATURE_DATA_DEBUG_BREAK(const D3D12_FEATURE_DATA_DEBUG_BREAK& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_DEBUG_BREAK");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldBool(L"HaltSupported", o.HaltSupported);
-    formatter.AddFieldBool(L"LiveDebuggingSupported", o.LiveDebuggingSupported);
-    formatter.AddFieldBool(L"CpuSupported", o.CpuSupported);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_MLIR(const D3D12_FEATURE_DATA_D3D12_OPTIONS_MLIR& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS_MLIR");
-    ReportFormatter::GetInstance().AddFieldEnum(L"MlirProgramsTier", o.MlirProgramsTier, Enum_D3D12_MLIR_PROGRAMS_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_LINEAR_ALGEBRA_SUPPORT(const D3D12_FEATURE_DATA_LINEAR_ALGEBRA_SUPPORT& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_LINEAR_ALGEBRA_SUPPORT");
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"LinearAlgebraTier", o.LinearAlgebraTier, Enum_D3D12_LINEAR_ALGEBRA_TIER);
-}
-
-static void Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_PREVIEW(const D3D12_FEATURE_DATA_D3D12_OPTIONS_PREVIEW& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS_PREVIEW");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-
-    formatter.AddFieldUint32(L"MaxGroupSharedMemoryPerGroupCS", o.MaxGroupSharedMemoryPerGroupCS);
-    formatter.AddFieldUint32(L"MaxGroupSharedMemoryPerGroupAS", o.MaxGroupSharedMemoryPerGroupAS);
-    formatter.AddFieldUint32(L"MaxGroupSharedMemoryPerGroupMS", o.MaxGroupSharedMemoryPerGroupMS);
-    formatter.AddFieldBool(L"UAVOfDepthStencilSupported", o.UAVOfDepthStencilSupported);
-    formatter.AddFieldBool(L"D32S8Interleaved", o.D32S8Interleaved);
-}
-
-static void Print_D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS(
-    const D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS& o)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldUint32(L"ComputeQueuesPer3DQueue", o.ComputeQueuesPer3DQueue);
-}
-#endif // #ifdef USE_PREVIEW_AGILITY_SDK
-
-static void Print_D3D12_FEATURE_DATA_EXISTING_HEAPS(const D3D12_FEATURE_DATA_EXISTING_HEAPS& existingHeaps)
-{
-    ReportScopeObject scope(L"D3D12_FEATURE_DATA_EXISTING_HEAPS");
-    ReportFormatter::GetInstance().AddFieldBool(L"Supported", existingHeaps.Supported);
-}
-
-static void Print_DXGI_QUERY_VIDEO_MEMORY_INFO(const DXGI_QUERY_VIDEO_MEMORY_INFO& videoMemoryInfo)
-{
-    // Not printing videoMemoryInfo.CurrentUsage, videoMemoryInfo.CurrentReservation.
-    ReportFormatter::GetInstance().AddFieldSize(L"Budget", videoMemoryInfo.Budget);
-    ReportFormatter::GetInstance().AddFieldSize(L"AvailableForReservation", videoMemoryInfo.AvailableForReservation);
-}
+// Kept until the end of the program, so the following jobs of --Batch reuse them.
+// D3D12 devices created so far, by adapter LUID.
+static std::unordered_map<std::wstring, ComPtr<ID3D12Device>> g_Devices;
+// Option passed to the last call of EnableExperimentalFeatures and the features it enabled.
+static std::optional<bool> g_ExperimentalFeaturesEnabled;
+static std::vector<std::wstring> g_EnabledExperimentalFeatures;
 
 #ifdef _DEBUG
 static const wchar_t* const CONFIG_STR = L"Debug";
@@ -709,7 +199,14 @@ static void PrintVersionHeader()
     Printer::PrintString(L"============================");
 }
 
-static void PrintVersionData()
+// --List without --ListVendorData, which uses nothing but DXGI.
+static bool IsDxgiOnlyAdapterList()
+{
+    return g_Options.ListAdapters && !g_Options.ListVendorData;
+}
+
+// Versions of vendor libraries are queried only if vendorApis has an adapter that needs them, as that loads them.
+static void PrintVersionData(const VendorApis* vendorApis)
 {
     if(IsTextOutput())
     {
@@ -719,7 +216,7 @@ static void PrintVersionData()
     }
 
     ReportScopeObject scope(SelectString(L"General", L"Header"));
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    ReportSink& formatter = ReportFormatter::GetInstance();
 
     if(IsJsonOutput())
     {
@@ -735,22 +232,27 @@ static void PrintVersionData()
     {
         formatter.AddFieldBool(L"Using preview Agility SDK", true);
     }
-    formatter.AddFieldUint32(L"D3D12_PREVIEW_SDK_VERSION", uint32_t(D3D12SDKVersion));
+    formatter.AddFieldUint32(L"D3D12_PREVIEW_SDK_VERSION", uint32_t(AGILITY_SDK_VERSION));
 #else
     if(IsJsonOutput())
     {
         formatter.AddFieldBool(L"Using preview Agility SDK", false);
     }
-    formatter.AddFieldUint32(L"D3D12_SDK_VERSION", uint32_t(D3D12SDKVersion));
+    formatter.AddFieldUint32(L"D3D12_SDK_VERSION", uint32_t(AGILITY_SDK_VERSION));
 #endif
 
-    if(!g_PureD3D12)
+    // The adapter list has no vendor data, so neither does its header.
+    if(!g_Options.PureD3D12 && !IsDxgiOnlyAdapterList())
     {
 #if USE_NVAPI
         NvAPI_Inititalize_RAII::PrintStaticParams();
+        if(vendorApis && vendorApis->IsApplicableToAnyAdapter(VendorApi::NvApi))
+            NvAPI_Inititalize_RAII::PrintLibraryVersion();
 #endif
 #if USE_AGS
         AGS_Initialize_RAII::PrintStaticParams();
+        if(vendorApis && vendorApis->IsApplicableToAnyAdapter(VendorApi::Ags))
+            AGS_Initialize_RAII::PrintLibraryVersion();
 #endif
 #if USE_AMD_DEVICE_INFO
         AmdDeviceInfo_Initialize_RAII::PrintStaticParams();
@@ -788,7 +290,7 @@ static void SetApplicationIdentity()
         return;
 
     ReportScopeObject scope(L"SetApplicationIdentity");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    ReportSink& formatter = ReportFormatter::GetInstance();
     formatter.AddFieldString(L"pExeFilename", appDesc.pExeFilename);
     formatter.AddFieldString(L"pName", appDesc.pName);
     formatter.AddFieldMicrosoftVersion(L"Version", appDesc.Version.Version);
@@ -825,17 +327,32 @@ static void PrintDXGIFeatureInfo()
     if(FAILED(hr) || !dxgiFactory)
         return;
     BOOL allowTearing = FALSE;
-    hr = dxgiFactory->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing));
+    hr = ProbeCall(L"DXGI_FEATURE_PRESENT_ALLOW_TEARING", [&]() {
+        return CaptureCall(L"DXGI_FEATURE_PRESENT_ALLOW_TEARING", &allowTearing, sizeof(allowTearing), [&]() {
+            return dxgiFactory->CheckFeatureSupport(
+                DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing));
+        });
+    });
     if(SUCCEEDED(hr))
     {
         ReportFormatter::GetInstance().AddFieldBool(L"DXGI_FEATURE_PRESENT_ALLOW_TEARING", allowTearing);
     }
 }
 
-static void EnableExperimentalFeatures()
+// Returns names of the features enabled.
+static std::vector<std::wstring> SetExperimentalFeatures(bool enable)
 {
-    if(g_D3D12EnableExperimentalFeatures == nullptr || !g_EnableExperimental)
-        return;
+    TraceSpan traceSpan(L"EnableExperimentalFeatures");
+    std::vector<std::wstring> enabledFeatures;
+    if(g_D3D12EnableExperimentalFeatures == nullptr)
+        return enabledFeatures;
+    if(!enable)
+    {
+        // Only a previous job of --Batch could have enabled them. Passing no features disables all of them.
+        if(g_ExperimentalFeaturesEnabled == true)
+            g_D3D12EnableExperimentalFeatures(0, nullptr, nullptr, nullptr);
+        return enabledFeatures;
+    }
 
 #ifdef USE_PREVIEW_AGILITY_SDK
     static const UUID FEATURE_UUIDS[] = { D3D12ExperimentalShaderModels, D3D12GPUUploadHeapsOnUnsupportedOS,
@@ -873,8 +390,6 @@ static void EnableExperimentalFeatures()
 
     if(featureBitMask != 0) // Means enablement succeeded.
     {
-        std::vector<std::wstring> enabledFeatures;
-
         for(size_t featureIndex = 0; featureIndex < FEATURE_COUNT; ++featureIndex)
         {
             if((featureBitMask & (1u << featureIndex)) != 0)
@@ -882,8 +397,25 @@ static void EnableExperimentalFeatures()
                 enabledFeatures.push_back(FEATURE_NAMES[featureIndex]);
             }
         }
+    }
+    return enabledFeatures;
+}
+
+static void EnableExperimentalFeatures()
+{
+    // Changing experimental features makes the devices created so far unusable, so with --Batch it's done
+    // only when the option differs from the previous job.
+    if(g_ExperimentalFeaturesEnabled != g_Options.EnableExperimental)
+    {
+        g_Devices.clear();
+        g_EnabledExperimentalFeatures = SetExperimentalFeatures(g_Options.EnableExperimental);
+        g_ExperimentalFeaturesEnabled = g_Options.EnableExperimental;
+    }
 
-        ReportFormatter::GetInstance().AddFieldStringArray(L"D3D12EnableExperimentalFeatures", enabledFeatures);
+    if(!g_EnabledExperimentalFeatures.empty())
+    {
+        ReportFormatter::GetInstance().AddFieldStringArray(
+            L"D3D12EnableExperimentalFeatures", g_EnabledExperimentalFeatures);
     }
 }
 
@@ -911,113 +443,65 @@ static void DetectTranslationLayersGlobal()
     }
 }
 
-static void PrintAdapterDescMembers(const DXGI_ADAPTER_DESC& desc)
-{
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldString(L"Description", desc.Description);
-    formatter.AddFieldVendorId(L"VendorId", desc.VendorId);
-    formatter.AddFieldHex32(L"DeviceId", desc.DeviceId);
-    formatter.AddFieldSubsystemId(L"SubSysId", desc.SubSysId);
-    formatter.AddFieldHex32(L"Revision", desc.Revision);
-    formatter.AddFieldSize(L"DedicatedVideoMemory", desc.DedicatedVideoMemory);
-    formatter.AddFieldSize(L"DedicatedSystemMemory", desc.DedicatedSystemMemory);
-    formatter.AddFieldSize(L"SharedSystemMemory", desc.SharedSystemMemory);
-    formatter.AddFieldString(L"AdapterLuid", LuidToStr(desc.AdapterLuid).c_str());
-}
-
-static void PrintAdapterDesc1Members(const DXGI_ADAPTER_DESC1& desc1)
-{
-    PrintAdapterDescMembers((const DXGI_ADAPTER_DESC&)desc1);
-    ReportFormatter::GetInstance().AddFieldFlags(L"Flags", desc1.Flags, Enum_DXGI_ADAPTER_FLAG);
-}
+// Filled while a report to be stored in the cache is printed.
+static std::optional<ReportFragment> g_RecordedFragment;
 
-static void PrintAdapterDesc2Members(const DXGI_ADAPTER_DESC2& desc2)
-{
-    PrintAdapterDesc1Members((const DXGI_ADAPTER_DESC1&)desc2);
-    ReportFormatter::GetInstance().AddFieldEnum(L"GraphicsPreemptionGranularity", desc2.GraphicsPreemptionGranularity,
-        Enum_DXGI_GRAPHICS_PREEMPTION_GRANULARITY);
-    ReportFormatter::GetInstance().AddFieldEnum(
-        L"ComputePreemptionGranularity", desc2.ComputePreemptionGranularity, Enum_DXGI_COMPUTE_PREEMPTION_GRANULARITY);
-}
-
-static void PrintAdapterDesc(const DXGI_ADAPTER_DESC& desc)
-{
-    ReportScopeObject scope(L"DXGI_ADAPTER_DESC");
-    PrintAdapterDescMembers(desc);
-}
+static const wchar_t* const VOLATILE_SECTION_SYSTEM_MEMORY = L"SystemMemory";
+static const wchar_t* const VOLATILE_SECTION_VIDEO_MEMORY_PREFIX = L"VideoMemory ";
 
-static void PrintAdapterDesc1(const DXGI_ADAPTER_DESC1& desc1)
+// Marks a section of the report that changes from run to run, like free memory, so it is not stored in the report
+// cache, but printed again by PrintVolatileSection each time the cached report is reused.
+class VolatileSectionScope
 {
-    ReportScopeObject scope(L"DXGI_ADAPTER_DESC1");
-    PrintAdapterDesc1Members(desc1);
-}
+public:
+    VolatileSectionScope(std::wstring id)
+        : m_Recording(g_RecordedFragment.has_value())
+    {
+        if(m_Recording)
+        {
+            std::wstring text = Printer::EndCapture();
+            g_RecordedFragment->Segments.push_back({ std::move(text), ReportFormatter::TakeCallLog(), std::move(id) });
+        }
+    }
+    ~VolatileSectionScope()
+    {
+        if(m_Recording)
+        {
+            // The section makes its calls to the formatter again when it is printed again.
+            ReportFormatter::TakeCallLog();
+            Printer::BeginCapture();
+        }
+    }
 
-static void PrintAdapterDesc2(const DXGI_ADAPTER_DESC2& desc2)
-{
-    ReportScopeObject scope(L"DXGI_ADAPTER_DESC2");
-    PrintAdapterDesc2Members(desc2);
-}
+private:
+    const bool m_Recording;
+};
 
-static void PrintAdapterDesc3(const DXGI_ADAPTER_DESC3& desc3)
+static std::wstring GetVideoMemorySectionId(IDXGIAdapter* adapter)
 {
-    ReportScopeObject scope(L"DXGI_ADAPTER_DESC3");
-    // Same members as DESC2. They only added new items to Flags.
-    PrintAdapterDesc2Members((const DXGI_ADAPTER_DESC2&)desc3);
+    DXGI_ADAPTER_DESC desc = {};
+    CHECK_HR(adapter->GetDesc(&desc));
+    return std::format(L"{}{:08X}{:08X}", VOLATILE_SECTION_VIDEO_MEMORY_PREFIX, uint32_t(desc.AdapterLuid.HighPart),
+        desc.AdapterLuid.LowPart);
 }
 
-static void PrintAdapterDesc(IDXGIAdapter* adapter)
+static void PrintVolatileSection(IDXGIFactory4* dxgiFactory, std::wstring_view id)
 {
-    if(ComPtr<IDXGIAdapter4> adapter4; SUCCEEDED(adapter->QueryInterface(IID_PPV_ARGS(&adapter4))))
-    {
-        if(DXGI_ADAPTER_DESC3 desc3; SUCCEEDED(adapter4->GetDesc3(&desc3)))
-            PrintAdapterDesc3(desc3);
-    }
-    else if(ComPtr<IDXGIAdapter2> adapter2; SUCCEEDED(adapter->QueryInterface(IID_PPV_ARGS(&adapter2))))
+    if(id == VOLATILE_SECTION_SYSTEM_MEMORY)
     {
-        if(DXGI_ADAPTER_DESC2 desc2; SUCCEEDED(adapter2->GetDesc2(&desc2)))
-            PrintAdapterDesc2(desc2);
+        PrintSystemMemoryInfo();
     }
-    else if(ComPtr<IDXGIAdapter1> adapter1; SUCCEEDED(adapter->QueryInterface(IID_PPV_ARGS(&adapter1))))
+    else if(id.starts_with(VOLATILE_SECTION_VIDEO_MEMORY_PREFIX))
     {
-        if(DXGI_ADAPTER_DESC1 desc1; SUCCEEDED(adapter1->GetDesc1(&desc1)))
-            PrintAdapterDesc1(desc1);
-    }
-    else if(DXGI_ADAPTER_DESC desc; SUCCEEDED(adapter->GetDesc(&desc)))
-    {
-        PrintAdapterDesc(desc);
-    }
-}
-
-static void PrintAdapterMemoryInfo(IDXGIAdapter* adapter)
-{
-    ComPtr<IDXGIAdapter3> adapter3;
-    if(SUCCEEDED(adapter->QueryInterface<IDXGIAdapter3>(&adapter3)))
-    {
-        for(uint32_t memorySegmentGroup = 0; memorySegmentGroup < 2; ++memorySegmentGroup)
-        {
-            DXGI_QUERY_VIDEO_MEMORY_INFO videoMemoryInfo = {};
-            if(SUCCEEDED(
-                   adapter3->QueryVideoMemoryInfo(0, (DXGI_MEMORY_SEGMENT_GROUP)memorySegmentGroup, &videoMemoryInfo)))
-            {
-                const wchar_t* structName = nullptr;
-                switch(memorySegmentGroup)
-                {
-                case 0:
-                    structName = L"DXGI_QUERY_VIDEO_MEMORY_INFO[DXGI_MEMORY_SEGMENT_GROUP_LOCAL]";
-                    break;
-                case 1:
-                    structName = L"DXGI_QUERY_VIDEO_MEMORY_INFO[DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL]";
-                    break;
-                default:
-                    assert(0);
-                }
-                {
-                    ReportScopeObject scope(structName);
-                    Print_DXGI_QUERY_VIDEO_MEMORY_INFO(videoMemoryInfo);
-                }
-            }
-        }
+        const uint64_t luidValue =
+            std::stoull(std::wstring(id.substr(wcslen(VOLATILE_SECTION_VIDEO_MEMORY_PREFIX))), nullptr, 16);
+        const LUID luid = { .LowPart = DWORD(luidValue), .HighPart = LONG(luidValue >> 32) };
+        ComPtr<IDXGIAdapter> adapter;
+        CHECK_HR(dxgiFactory->EnumAdapterByLuid(luid, IID_PPV_ARGS(&adapter)));
+        PrintAdapterMemoryInfo(adapter.Get());
     }
+    else
+        throw std::runtime_error("Invalid section in the report cache.");
 }
 
 static void PrintAdapterInterfaceSupport(IDXGIAdapter* adapter)
@@ -1031,567 +515,83 @@ static void PrintAdapterInterfaceSupport(IDXGIAdapter* adapter)
 
 static void PrintAdapterData(IDXGIAdapter* adapter)
 {
+    TraceSpan traceSpan(L"PrintAdapterData");
     assert(adapter != nullptr);
-    PrintAdapterDesc(adapter);
-    PrintAdapterMemoryInfo(adapter);
-    PrintAdapterInterfaceSupport(adapter);
+    if(ReportSelection::IsPrefixSelected(L"DXGI_ADAPTER_DESC"))
+        PrintAdapterDesc(adapter);
+    if(ReportSelection::IsPrefixSelected(L"DXGI_QUERY_VIDEO_MEMORY_INFO"))
+    {
+        VolatileSectionScope volatileSectionScope(GetVideoMemorySectionId(adapter));
+        PrintAdapterMemoryInfo(adapter);
+    }
+    if(ReportSelection::IsSelected(L"CheckInterfaceSupport"))
+        PrintAdapterInterfaceSupport(adapter);
 }
 
-enum class FormatSupportResult
+static int PrintDeviceDetails(IDXGIAdapter1* adapter1, VendorApis& vendorApis)
 {
-    Ok,
-    Failed,
-    Crashed
-};
+    ComPtr<ID3D12Device> device;
 
-static FormatSupportResult CheckFormatSupport(ID3D12Device* device, D3D12_FEATURE_DATA_FORMAT_SUPPORT& formatSupport)
-{
-    __try
-    {
-        const HRESULT hr =
-            device->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &formatSupport, UINT(sizeof formatSupport));
-        return SUCCEEDED(hr) ? FormatSupportResult::Ok : FormatSupportResult::Failed;
-    }
-    // This is needed because latest (as of November 2023) AMD drivers crash when calling:
-    // ID3D12Device::CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, DXGI_FORMAT_A4B4G4R4_UNORM)
-    __except(EXCEPTION_EXECUTE_HANDLER)
-    {
-        return FormatSupportResult::Crashed;
-    }
-}
-
-static void PrintFormatInformation(ID3D12Device* device)
-{
-    ReportScopeObject scope(L"Formats");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-
-    D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = {};
-    D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS msQualityLevels = {};
-    D3D12_FEATURE_DATA_FORMAT_INFO formatInfo = {};
-    for(size_t formatIndex = 0; Enum_DXGI_FORMAT[formatIndex].m_Name != nullptr; ++formatIndex)
-    {
-        const DXGI_FORMAT format = (DXGI_FORMAT)Enum_DXGI_FORMAT[formatIndex].m_Value;
-        const wchar_t* name = Enum_DXGI_FORMAT[formatIndex].m_Name;
-
-        formatSupport.Format = format;
-
-        const FormatSupportResult formatSupportResult = CheckFormatSupport(device, formatSupport);
-        if(formatSupportResult == FormatSupportResult::Crashed)
-        {
-            ErrorPrinter::PrintFormat(
-                L"ERROR: ID3D12Device::CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, {}) crashed.\n",
-                std::make_wformat_args(name));
-            break;
-        }
-
-        ReportScopeObjectConditional scope2(SelectString(name, std::format(L"{}", (size_t)format)));
-
-        if(formatSupportResult == FormatSupportResult::Ok)
-        {
-            scope2.Enable();
-            formatter.AddFieldFlags(L"Support1", formatSupport.Support1, Enum_D3D12_FORMAT_SUPPORT1);
-            formatter.AddFieldFlags(L"Support2", formatSupport.Support2, Enum_D3D12_FORMAT_SUPPORT2);
-
-            ReportScopeObjectConditional scope3(IsJsonOutput(), L"MultisampleQualityLevels");
-            msQualityLevels.Format = format;
-            for(msQualityLevels.SampleCount = 1;; msQualityLevels.SampleCount *= 2)
-            {
-                if(SUCCEEDED(device->CheckFeatureSupport(
-                       D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS, &msQualityLevels, UINT(sizeof msQualityLevels))) &&
-                    msQualityLevels.NumQualityLevels > 0)
-                {
-                    if(IsJsonOutput())
-                    {
-                        ReportScopeObject scope4(std::format(L"{}", msQualityLevels.SampleCount));
-                        formatter.AddFieldUint32(L"NumQualityLevels", msQualityLevels.NumQualityLevels);
-                        formatter.AddFieldUint32(L"Flags", uint32_t(msQualityLevels.Flags));
-                    }
-                    else
-                    {
-                        bool multisampleTiled =
-                            (msQualityLevels.Flags & D3D12_MULTISAMPLE_QUALITY_LEVELS_FLAG_TILED_RESOURCE) != 0;
-                        formatter.AddFieldString(L"SampleCount",
-                            std::format(L"{}: NumQualityLevels = {}{}", msQualityLevels.SampleCount,
-                                msQualityLevels.NumQualityLevels,
-                                multisampleTiled ? L"  D3D12_MULTISAMPLE_QUALITY_LEVELS_FLAG_TILED_RESOURCE" : L""));
-                    }
-                }
-                else
-                    break;
-            }
-        }
-
-        formatInfo.Format = format;
-        if(SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_FORMAT_INFO, &formatInfo, UINT(sizeof formatInfo))))
-        {
-            scope2.Enable();
-            formatter.AddFieldUint32(L"PlaneCount", formatInfo.PlaneCount);
-        }
-    }
-}
-
-void DetectTranslationLayersDevice(ID3D12Device* device)
-{
-    ReportScopeObjectConditional scope(L"TranslationLayerDetection");
-
-    // WARNING for Game Developers!
-    // If you are looking at this code as a reference to implement something in a game engine
-    // You likely should NOT try to detect vkd3d-proton
-    // You really shouldn't make any assumptions based on whether you are running under vkd3d-proton
-    // If there's some features that are not available under vkd3d-proton, you should just query support for those
-    // features from normal d3d12 interfaces (or vendor extension interfaces if you use those)
-    // No engine logic should depend on such detection
-    ComPtr<IUnknown> vkd3dInteropDevice;
-    HRESULT hr = device->QueryInterface(IID_ID3D12DXVKInteropDevice, &vkd3dInteropDevice);
-
-    if(SUCCEEDED(hr) && vkd3dInteropDevice)
-    {
-        scope.Enable();
-        ReportFormatter::GetInstance().AddFieldBool(L"ID3D12DXVKInteropDevice", true);
-    }
-}
-
-static void PrintDeviceOptions(ID3D12Device* device)
-{
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS1(options1);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS2 options2 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS2, &options2, sizeof(options2))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS2(options2);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS3 options3 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS3, &options3, sizeof(options3))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS3(options3);
-
-    if(D3D12_FEATURE_DATA_EXISTING_HEAPS existingHeaps = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_EXISTING_HEAPS, &existingHeaps, sizeof(existingHeaps))))
-        Print_D3D12_FEATURE_DATA_EXISTING_HEAPS(existingHeaps);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS4 options4 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS4, &options4, sizeof(options4))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS4(options4);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS5 options5 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS5, &options5, sizeof(options5))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS5(options5);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS6 options6 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS6, &options6, sizeof(options6))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS6(options6);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS7 options7 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS7, &options7, sizeof(options7))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS7(options7);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS8 options8 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS8, &options8, sizeof(options8))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS8(options8);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS9 options9 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS9, &options9, sizeof(options9))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS9(options9);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS10 options10 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS10, &options10, sizeof(options10))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS10(options10);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS11 options11 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS11, &options11, sizeof(options11))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS11(options11);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS12 options12 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &options12, sizeof(options12))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS12(options12);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS13 options13 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS13, &options13, sizeof(options13))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS13(options13);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS14 options14 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS14, &options14, sizeof(options14))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS14(options14);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS15 options15 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS15, &options15, sizeof(options15))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS15(options15);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS16 options16 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS16, &options16, sizeof(options16))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS16(options16);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS17 options17 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS17, &options17, sizeof(options17))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS17(options17);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS18 options18 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS18, &options18, sizeof(options18))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS18(options18);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS19 options19 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS19, &options19, sizeof(options19))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS19(options19);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS20 options20 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS20, &options20, sizeof(options20))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS20(options20);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS21 options21 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS21, &options21, sizeof(options21))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS21(options21);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS22 options22 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS22, &options22, sizeof(options22))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS22(options22);
-
-    if(D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED bytecodeBypassHashSupported = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_BYTECODE_BYPASS_HASH_SUPPORTED,
-            &bytecodeBypassHashSupported, sizeof(bytecodeBypassHashSupported))))
-        Print_D3D12_FEATURE_DATA_BYTECODE_BYPASS_HASH_SUPPORTED(bytecodeBypassHashSupported);
-
-    if(D3D12_FEATURE_DATA_TIGHT_ALIGNMENT tightAlignment = {}; SUCCEEDED(
-           device->CheckFeatureSupport(D3D12_FEATURE_D3D12_TIGHT_ALIGNMENT, &tightAlignment, sizeof(tightAlignment))))
-        Print_D3D12_FEATURE_DATA_TIGHT_ALIGNMENT(tightAlignment);
-
-#ifndef USE_PREVIEW_AGILITY_SDK
-    if(D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT shaderCacheABISupport = {}; SUCCEEDED(device->CheckFeatureSupport(
-           D3D12_FEATURE_SHADER_CACHE_ABI_SUPPORT, &shaderCacheABISupport, sizeof(shaderCacheABISupport))))
-        Print_D3D12_FEATURE_DATA_SHADERCACHE_ABI_SUPPORT(shaderCacheABISupport);
-#endif
-
-#ifdef USE_PREVIEW_AGILITY_SDK
-    if(D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS groupings = {}; SUCCEEDED(device->CheckFeatureSupport(
-           D3D12_FEATURE_HARDWARE_SCHEDULING_QUEUE_GROUPINGS, &groupings, sizeof(groupings))))
-        Print_D3D12_FEATURE_DATA_HARDWARE_SCHEDULING_QUEUE_GROUPINGS(groupings);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS_MLIR optionsMlir = {}; SUCCEEDED(
-           device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS_MLIR, &optionsMlir, sizeof(optionsMlir))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_MLIR(optionsMlir);
-
-    if(D3D12_FEATURE_DATA_LINEAR_ALGEBRA_SUPPORT linearAlgebraSupport = {}; SUCCEEDED(
-           device->CheckFeatureSupport(D3D12_FEATURE_LINEAR_ALGEBRA_SUPPORT, &linearAlgebraSupport,
-               sizeof(linearAlgebraSupport))))
-        Print_D3D12_FEATURE_DATA_LINEAR_ALGEBRA_SUPPORT(linearAlgebraSupport);
-
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS_PREVIEW optionsPreview = {}; SUCCEEDED(
-           device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS_PREVIEW, &optionsPreview, sizeof(optionsPreview))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS_PREVIEW(optionsPreview);
-
-    if(D3D12_FEATURE_DATA_PARTIAL_GRAPHICS_PROGRAMS partialGraphicsPrograms = {}; SUCCEEDED(device->CheckFeatureSupport(
-           D3D12_FEATURE_PARTIAL_GRAPHICS_PROGRAMS, &partialGraphicsPrograms, sizeof(partialGraphicsPrograms))))
-        Print_D3D12_FEATURE_DATA_PARTIAL_GRAPHICS_PROGRAMS(partialGraphicsPrograms);
-
-    if(D3D12_FEATURE_DATA_DUMP_FILE dumpFile = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_DUMP_FILE, &dumpFile, sizeof(dumpFile))))
-        Print_D3D12_FEATURE_DATA_DUMP_FILE(dumpFile);
-
-    if(D3D12_FEATURE_DATA_USER_DEFINED_ANNOTATION userDefinedAnnotation = {}; SUCCEEDED(device->CheckFeatureSupport(
-           D3D12_FEATURE_USER_DEFINED_ANNOTATION, &userDefinedAnnotation, sizeof(userDefinedAnnotation))))
-        Print_D3D12_FEATURE_DATA_USER_DEFINED_ANNOTATION(userDefinedAnnotation);
-
-    if(D3D12_FEATURE_DATA_DEBUG_BREAK debugBreak = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_DEBUG_BREAK, &debugBreak, sizeof(debugBreak))))
-        Print_D3D12_FEATURE_DATA_DEBUG_BREAK(debugBreak);
-#endif
-}
-
-static void PrintDescriptorSizes(ID3D12Device* device)
-{
-    ReportScopeObject scope(L"GetDescriptorHandleIncrementSize");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-    formatter.AddFieldUint32(L"D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV",
-        device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV));
-    formatter.AddFieldUint32(L"D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER",
-        device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER));
-    formatter.AddFieldUint32(
-        L"D3D12_DESCRIPTOR_HEAP_TYPE_RTV", device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV));
-    formatter.AddFieldUint32(
-        L"D3D12_DESCRIPTOR_HEAP_TYPE_DSV", device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV));
-}
-
-static void PrintMetaCommand(ID3D12Device5* device5, UINT index, const D3D12_META_COMMAND_DESC& desc)
-{
-    ReportScopeArrayItem scope;
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
-
-    formatter.AddFieldString(L"Id", GuidToStr(desc.Id).c_str());
-    formatter.AddFieldString(L"Name", desc.Name);
-    formatter.AddFieldFlags(L"InitializationDirtyState", desc.InitializationDirtyState, Enum_D3D12_GRAPHICS_STATES);
-    formatter.AddFieldFlags(L"ExecutionDirtyState", desc.ExecutionDirtyState, Enum_D3D12_GRAPHICS_STATES);
-
-    for(UINT stageIndex = 0; stageIndex < 3; ++stageIndex)
-    {
-        UINT totalStructureSizeInBytes = 0;
-        UINT paramCount = 0;
-        HRESULT hr = device5->EnumerateMetaCommandParameters(
-            desc.Id, (D3D12_META_COMMAND_PARAMETER_STAGE)stageIndex, &totalStructureSizeInBytes, &paramCount, nullptr);
-        if(FAILED(hr))
-            continue;
-
-        ReportScopeObject scope2(Enum_D3D12_META_COMMAND_PARAMETER_STAGE[stageIndex].m_Name);
-        formatter.AddFieldUint32(L"TotalStructureSizeInBytes", totalStructureSizeInBytes);
-
-        if(paramCount > 0)
-        {
-            std::vector<D3D12_META_COMMAND_PARAMETER_DESC> paramDescs(paramCount);
-            hr = device5->EnumerateMetaCommandParameters(
-                desc.Id, (D3D12_META_COMMAND_PARAMETER_STAGE)stageIndex, nullptr, &paramCount, paramDescs.data());
-            if(SUCCEEDED(hr))
-            {
-                ReportScopeArray scope3(L"Parameters");
-
-                for(UINT paramIndex = 0; paramIndex < paramCount; ++paramIndex)
-                {
-                    const auto& paramDesc = paramDescs[paramIndex];
-
-                    ReportScopeArrayItem scope4;
-
-                    formatter.AddFieldString(L"Name", paramDesc.Name);
-                    formatter.AddFieldEnum(L"Type", paramDesc.Type, Enum_D3D12_META_COMMAND_PARAMETER_TYPE);
-                    formatter.AddFieldFlags(L"Flags", paramDesc.Flags, Enum_D3D12_META_COMMAND_PARAMETER_FLAGS);
-                    formatter.AddFieldFlags(
-                        L"RequiredResourceState", paramDesc.RequiredResourceState, Enum_D3D12_RESOURCE_STATES);
-                    formatter.AddFieldUint32(L"StructureOffset", paramDesc.StructureOffset);
-                }
-            }
-        }
-    }
-}
-
-static void PrintMetaCommands(ID3D12Device5* device5)
-{
-    UINT num = 0;
-    if(FAILED(device5->EnumerateMetaCommands(&num, nullptr)))
-        return;
-    if(num == 0)
-        return;
-    std::vector<D3D12_META_COMMAND_DESC> descs(num);
-    if(FAILED(device5->EnumerateMetaCommands(&num, descs.data())))
-        return;
-
-    ReportScopeArray scope(L"EnumerateMetaCommands");
-
-    for(UINT i = 0; i < num; ++i)
-        PrintMetaCommand(device5, i, descs[i]);
-}
-
-static void PrintCommandQueuePriorities(ID3D12Device* device)
-{
-    D3D12_COMMAND_QUEUE_PRIORITY cmdQueuePriorities[] = { D3D12_COMMAND_QUEUE_PRIORITY_NORMAL,
-        D3D12_COMMAND_QUEUE_PRIORITY_HIGH, D3D12_COMMAND_QUEUE_PRIORITY_GLOBAL_REALTIME };
-
-    std::array<std::array<bool, COMMAND_QUEUE_PRIORITIES_COUNT>, COMMAND_LIST_TYPES_COUNT> queuePrioritySupport = {};
-
-    for(size_t i = 0; i < COMMAND_LIST_TYPES_COUNT; ++i)
-    {
-        for(size_t j = 0; j < COMMAND_QUEUE_PRIORITIES_COUNT; ++j)
-        {
-            D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY commandQueuePriority = {};
-            commandQueuePriority.CommandListType = COMMAND_LIST_TYPES[i];
-            commandQueuePriority.Priority = COMMAND_QUEUE_PRIORITIES[j];
-            if(FAILED(device->CheckFeatureSupport(
-                   D3D12_FEATURE_COMMAND_QUEUE_PRIORITY, &commandQueuePriority, sizeof(commandQueuePriority))))
-                return;
-
-            queuePrioritySupport[i][j] = commandQueuePriority.PriorityForTypeIsSupported;
-        }
-    }
-
-    Print_D3D12_FEATURE_DATA_COMMAND_QUEUE_PRIORITY(queuePrioritySupport);
-}
-
-static void PrintBarrierLayouts(ID3D12Device* device)
-{
-    std::array<std::array<bool, BARRIER_LAYOUTS_COUNT>, COMMAND_LIST_TYPES_COUNT> barrierLayoutSupport = {};
-
-    for(size_t i = 0; i < COMMAND_LIST_TYPES_COUNT; ++i)
-    {
-        for(size_t j = 0; j < BARRIER_LAYOUTS_COUNT; ++j)
-        {
-            D3D12_FEATURE_DATA_BARRIER_LAYOUT barrierLayout = {};
-            barrierLayout.CommandListType = COMMAND_LIST_TYPES[i];
-            barrierLayout.Layout = D3D12_BARRIER_LAYOUT(BARRIER_LAYOUTS[j]);
-            if(FAILED(device->CheckFeatureSupport(D3D12_FEATURE_BARRIER_LAYOUT, &barrierLayout, sizeof(barrierLayout))))
-                return;
-            barrierLayoutSupport[i][j] = barrierLayout.Supported;
-        }
-    }
-
-    Print_D3D12_FEATURE_DATA_BARRIER_LAYOUT(barrierLayoutSupport);
-}
-
-#ifdef USE_PREVIEW_AGILITY_SDK
-static void PrintFenceBarriers(ID3D12Device* device)
-{
-    std::array<D3D12_FENCE_BARRIERS_TIER, COMMAND_LIST_TYPES_COUNT> fenceBarriersSupport = {};
-
-    for(size_t i = 0; i < COMMAND_LIST_TYPES_COUNT; ++i)
-    {
-        D3D12_FEATURE_DATA_FENCE_BARRIERS fenceBarriers = {};
-        fenceBarriers.CommandListType = COMMAND_LIST_TYPES[i];
-        if(FAILED(device->CheckFeatureSupport(D3D12_FEATURE_FENCE_BARRIERS, &fenceBarriers, sizeof(fenceBarriers))))
-            return;
-        fenceBarriersSupport[i] = fenceBarriers.FenceBarriersTier;
-    }
-
-    Print_D3D12_FEATURE_DATA_FENCE_BARRIERS(fenceBarriersSupport);
-}
-#endif
-
-static int PrintDeviceDetails(IDXGIAdapter1* adapter1, NvAPI_Inititalize_RAII* nvAPI, AGS_Initialize_RAII* ags)
-{
-    ComPtr<ID3D12Device> device;
-
-    DXGI_ADAPTER_DESC desc = {};
+    DXGI_ADAPTER_DESC1 desc = {};
     // On fail desc will be empty
     // So code that depends on VendorId will receive 0x0
-    adapter1->GetDesc(&desc);
+    adapter1->GetDesc1(&desc);
+    const bool softwareAdapter = (desc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) != 0;
 
 #if USE_AGS
-    bool useAGS = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_AMD;
-    if(useAGS && ags && ags->IsInitialized())
+    // The device is created through AGS only to print which extensions it supports.
+    AGS_Initialize_RAII* ags = nullptr;
+    if(vendorApis.IsApplicable(VendorApi::Ags, desc.VendorId, softwareAdapter) &&
+        ReportSelection::IsSelected(L"AGSDX12ExtensionsSupported"))
+        ags = vendorApis.GetAgs();
+    if(ags)
     {
+        // Device created by D3D12 for this adapter would be returned again, without AGS extensions.
+        g_Devices.erase(LuidToStr(desc.AdapterLuid));
         ComPtr<IDXGIAdapter> adapter;
         if(SUCCEEDED(adapter1->QueryInterface(IID_PPV_ARGS(&adapter))))
+        {
+            TraceSpan traceSpan(L"AGS_Initialize_RAII::CreateDeviceAndPrintData");
+            BenchmarkScope benchmarkScope(
+                L"AGS_Initialize_RAII::CreateDeviceAndPrintData", Benchmark::Kind::DeviceCreation);
             device = ags->CreateDeviceAndPrintData(adapter.Get(), MIN_FEATURE_LEVEL);
+        }
     }
 #endif
 
+    if(!device)
+    {
+        if(auto it = g_Devices.find(LuidToStr(desc.AdapterLuid)); it != g_Devices.end())
+            device = it->second;
+    }
+
     if(!device)
     {
         HRESULT hr;
+        {
+            TraceSpan traceSpan(L"D3D12CreateDevice");
+            BenchmarkScope benchmarkScope(L"D3D12CreateDevice", Benchmark::Kind::DeviceCreation);
+            ProbeTimer timer(L"D3D12CreateDevice");
 #if defined(AUTO_LINK_DX12)
-        hr = ::D3D12CreateDevice(adapter1, MIN_FEATURE_LEVEL, IID_PPV_ARGS(&device));
+            hr = ::D3D12CreateDevice(adapter1, MIN_FEATURE_LEVEL, IID_PPV_ARGS(&device));
 #else
-        hr = g_D3D12CreateDevice(adapter1, MIN_FEATURE_LEVEL, IID_PPV_ARGS(&device));
+            hr = g_D3D12CreateDevice(adapter1, MIN_FEATURE_LEVEL, IID_PPV_ARGS(&device));
 #endif
+        }
         if(hr == 0x887E0003)
             throw std::runtime_error(
                 "D3D12CreateDevice returned 0x887E0003. Make sure Developer Mode is enabled in Windows settings.");
         CHECK_HR(hr);
+        g_Devices.emplace(LuidToStr(desc.AdapterLuid), device);
     }
 
     if(!device)
         return PROGRAM_EXIT_ERROR_D3D12;
 
-    if(D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options))))
-        Print_D3D12_FEATURE_DATA_D3D12_OPTIONS(options);
-
-    if(D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT gpuVirtualAddressSupport = {};
-        SUCCEEDED(device->CheckFeatureSupport(
-            D3D12_FEATURE_GPU_VIRTUAL_ADDRESS_SUPPORT, &gpuVirtualAddressSupport, sizeof(gpuVirtualAddressSupport))))
-        Print_D3D12_FEATURE_DATA_GPU_VIRTUAL_ADDRESS_SUPPORT(gpuVirtualAddressSupport);
-
-    /*
-    Microsoft documentation says:
-
-    ID3D12Device::CheckFeatureSupport returns E_INVALIDARG if HighestShaderModel
-    isn't known by the current runtime. For that reason, we recommend that you call
-    this in a loop with decreasing shader models to determine the highest supported
-    shader model.
-    */
-    {
-        D3D12_FEATURE_DATA_SHADER_MODEL shaderModel = {};
-        for(size_t enumItemIndex = _countof(Enum_D3D_SHADER_MODEL) - 1; enumItemIndex--;)
-        {
-            shaderModel.HighestShaderModel = D3D_SHADER_MODEL(Enum_D3D_SHADER_MODEL[enumItemIndex].m_Value);
-            if(SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &shaderModel, sizeof(shaderModel))))
-            {
-                Print_D3D12_FEATURE_DATA_SHADER_MODEL(shaderModel);
-                break;
-            }
-        }
-    }
-
-    if(D3D12_FEATURE_DATA_ROOT_SIGNATURE rootSignature = { .HighestVersion = HIGHEST_ROOT_SIGNATURE_VERSION };
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_ROOT_SIGNATURE, &rootSignature, sizeof(rootSignature))))
-        Print_D3D12_FEATURE_DATA_ROOT_SIGNATURE(rootSignature);
-
-    if(D3D12_FEATURE_DATA_ARCHITECTURE1 architecture1 = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_ARCHITECTURE1, &architecture1, sizeof(architecture1))))
-        Print_D3D12_FEATURE_DATA_ARCHITECTURE1(architecture1);
-    else
-    {
-        if(D3D12_FEATURE_DATA_ARCHITECTURE architecture = {};
-            SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_ARCHITECTURE, &architecture, sizeof(architecture))))
-            Print_D3D12_FEATURE_DATA_ARCHITECTURE(architecture);
-    }
-
-    {
-        D3D12_FEATURE_DATA_FEATURE_LEVELS featureLevels = { _countof(FEATURE_LEVELS_ARRAY), FEATURE_LEVELS_ARRAY,
-            MAX_FEATURE_LEVEL };
-        if(SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_FEATURE_LEVELS, &featureLevels, sizeof(featureLevels))))
-            Print_D3D12_FEATURE_DATA_FEATURE_LEVELS(featureLevels);
-    }
-
-    if(D3D12_FEATURE_DATA_SHADER_CACHE shaderCache = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_SHADER_CACHE, &shaderCache, sizeof(shaderCache))))
-        Print_D3D12_FEATURE_DATA_SHADER_CACHE(shaderCache);
-
-    PrintCommandQueuePriorities(device.Get());
-
-    if(D3D12_FEATURE_DATA_SERIALIZATION serialization = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_SERIALIZATION, &serialization, sizeof(serialization))))
-        Print_D3D12_FEATURE_DATA_SERIALIZATION(serialization);
-
-    if(D3D12_FEATURE_DATA_CROSS_NODE crossNode = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_CROSS_NODE, &crossNode, sizeof(crossNode))))
-        Print_D3D12_FEATURE_CROSS_NODE(crossNode);
-
-    if(D3D12_FEATURE_DATA_PREDICATION predication = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_PREDICATION, &predication, sizeof(predication))))
-        Print_D3D12_FEATURE_PREDICATION(predication);
-
-    if(D3D12_FEATURE_DATA_HARDWARE_COPY hardwareCopy = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_HARDWARE_COPY, &hardwareCopy, sizeof(hardwareCopy))))
-        Print_D3D12_FEATURE_HARDWARE_COPY(hardwareCopy);
-
-    if(D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE appSpecificDriverState = {};
-        SUCCEEDED(device->CheckFeatureSupport(
-            D3D12_FEATURE_APPLICATION_SPECIFIC_DRIVER_STATE, &appSpecificDriverState, sizeof(appSpecificDriverState))))
-        Print_D3D12_FEATURE_DATA_APPLICATION_SPECIFIC_DRIVER_STATE(appSpecificDriverState);
-
-    PrintBarrierLayouts(device.Get());
-
-#ifdef USE_PREVIEW_AGILITY_SDK
-    if(D3D12_FEATURE_DATA_ASYNC_COMMANDS asyncCommands = {};
-        SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_ASYNC_COMMANDS, &asyncCommands, sizeof(asyncCommands))))
-        Print_D3D12_FEATURE_DATA_ASYNC_COMMANDS(asyncCommands);
-
-    PrintFenceBarriers(device.Get());
-#endif
-
-    // TODO: In Agility SDK 1.715.0-preview how to query for D3D12_FEATURE_D3D12_OPTIONS_EXPERIMENTAL1?
-    // What is the corresponding structure?
-
-    // TODO: D3D12_FEATURE_PLACED_RESOURCE_SUPPORT_INFO - What is this? How to query it? What structure to use?
-
-    PrintDeviceOptions(device.Get());
-
-    PrintDescriptorSizes(device.Get());
-
-    if(g_PrintMetaCommands)
-    {
-        ComPtr<ID3D12Device5> device5;
-        if(SUCCEEDED(device->QueryInterface(IID_PPV_ARGS(&device5))))
-            PrintMetaCommands(device5.Get());
-    }
-
-#if USE_NVAPI
-    bool useNVAPI = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_NVIDIA;
-    if(nvAPI && nvAPI->IsInitialized())
-        nvAPI->PrintD3d12DeviceData(device.Get());
-#endif
-
-    DetectTranslationLayersDevice(device.Get());
-
-    if(g_PrintFormats)
-        PrintFormatInformation(device.Get());
+    PrintDeviceCapabilities(device.Get(), desc, vendorApis, g_Options.PrintFormats, g_Options.PrintMetaCommands);
 
 #if USE_AGS
-    if(useAGS && ags && ags->IsInitialized())
+    if(ags)
         ags->DestroyDevice(std::move(device));
 #endif
 
@@ -1600,15 +600,34 @@ static int PrintDeviceDetails(IDXGIAdapter1* adapter1, NvAPI_Inititalize_RAII* n
 
 #if !defined(AUTO_LINK_DX12)
 
-static bool LoadLibraries()
+// Loads only the libraries not loaded yet, e.g. by a previous job of --Batch.
+// With loadD3d12 = false, only DXGI is loaded, which is enough to enumerate adapters.
+static bool LoadLibraries(bool loadD3d12)
 {
-    g_DxgiLibrary = ::LoadLibraryEx(DYN_LIB_DXGI, nullptr, LOAD_LIBRARY_SEARCH_SYSTEM32);
+    if(g_CreateDXGIFactory1 && (!loadD3d12 || g_D3D12CreateDevice))
+        return true;
+
+    TraceSpan traceSpan(L"LoadLibraries");
     if(!g_DxgiLibrary)
     {
-        ErrorPrinter::PrintFormat(L"could not load {}\n", std::make_wformat_args(DYN_LIB_DXGI));
-        return false;
+        g_DxgiLibrary = ::LoadLibraryEx(DYN_LIB_DXGI, nullptr, LOAD_LIBRARY_SEARCH_SYSTEM32);
+        if(!g_DxgiLibrary)
+        {
+            ErrorPrinter::PrintFormat(L"could not load {}\n", std::make_wformat_args(DYN_LIB_DXGI));
+            return false;
+        }
+
+        g_CreateDXGIFactory1 =
+            reinterpret_cast<PFN_DXGI_CREATE_FACTORY1>(::GetProcAddress(g_DxgiLibrary, "CreateDXGIFactory1"));
+        if(!g_CreateDXGIFactory1)
+        {
+            return false;
+        }
     }
 
+    if(!loadD3d12)
+        return true;
+
     g_Dx12Library = ::LoadLibraryEx(DYN_LIB_DX12, nullptr, LOAD_LIBRARY_SEARCH_SYSTEM32);
     if(!g_Dx12Library)
     {
@@ -1616,13 +635,6 @@ static bool LoadLibraries()
         return false;
     }
 
-    g_CreateDXGIFactory1 =
-        reinterpret_cast<PFN_DXGI_CREATE_FACTORY1>(::GetProcAddress(g_DxgiLibrary, "CreateDXGIFactory1"));
-    if(!g_CreateDXGIFactory1)
-    {
-        return false;
-    }
-
     g_D3D12CreateDevice =
         reinterpret_cast<PFN_D3D12_CREATE_DEVICE>(::GetProcAddress(g_Dx12Library, "D3D12CreateDevice"));
     if(!g_D3D12CreateDevice)
@@ -1648,17 +660,110 @@ static void UnloadLibraries()
 
     BOOL rc;
 
-    rc = ::FreeLibrary(g_DxgiLibrary);
-    assert(rc);
-    g_DxgiLibrary = nullptr;
+    if(g_DxgiLibrary)
+    {
+        rc = ::FreeLibrary(g_DxgiLibrary);
+        assert(rc);
+        g_DxgiLibrary = nullptr;
+    }
 
-    rc = ::FreeLibrary(g_Dx12Library);
-    assert(rc);
-    g_Dx12Library = nullptr;
+    if(g_Dx12Library)
+    {
+        rc = ::FreeLibrary(g_Dx12Library);
+        assert(rc);
+        g_Dx12Library = nullptr;
+    }
 }
 
 #endif
 
+// Releases the D3D12 devices and libraries that reports keep for the following ones.
+static void ReleaseLibraries()
+{
+    g_Devices.clear();
+#if !defined(AUTO_LINK_DX12)
+    UnloadLibraries();
+#endif
+}
+
+// Releases the D3D12 devices and libraries that reports keep for the following jobs of --Batch.
+class LibrariesScope
+{
+public:
+    ~LibrariesScope()
+    {
+        ReleaseLibraries();
+    }
+};
+
+static std::filesystem::path GetReportCacheDirectory()
+{
+    wchar_t basePath[MAX_PATH];
+    DWORD length = ::GetEnvironmentVariable(L"LOCALAPPDATA", basePath, MAX_PATH);
+    if(length == 0 || length >= MAX_PATH)
+    {
+        length = ::GetTempPath(MAX_PATH, basePath);
+        if(length == 0 || length > MAX_PATH)
+            throw std::runtime_error("Could not find a directory for the report cache.");
+    }
+    return std::filesystem::path(basePath) / L"D3d12info" / L"Cache";
+}
+
+// Describes everything that can be found on the adapters without creating a D3D12 device or initializing any vendor
+// API, so the cache can be checked before doing any expensive work.
+static ReportCacheKey MakeReportCacheKey(uint32_t adapterIndex)
+{
+    ReportCacheKey key;
+    key.ProgramVersion = PROGRAM_VERSION_NUMBER;
+    key.AgilitySDKVersion = AGILITY_SDK_VERSION;
+    key.OSVersion = GetOsVersionString();
+    key.Options = std::format(L"JSON={},PrettyPrint={},Flat={},List={},Adapter={},AllAdapters={},"
+                              L"SkipSoftwareAdapter={},Formats={},MetaCommands={},Enums={},PureD3D12={},"
+                              L"EnableExperimental={},ForceVendorAPI={},WARP={},Select={}",
+        g_Options.UseJsonOutput, g_Options.UseJsonPrettyPrint, g_Options.UseFlatOutput, g_Options.ListAdapters,
+        adapterIndex, g_Options.ShowAllAdapters, g_Options.SkipSoftwareAdapter, g_Options.PrintFormats,
+        g_Options.PrintMetaCommands, g_Options.PrintEnums, g_Options.PureD3D12, g_Options.EnableExperimental,
+        g_Options.ForceVendorAPI, g_Options.WARP, g_Options.SelectPaths);
+
+    ComPtr<IDXGIFactory4> dxgiFactory;
+#if defined(AUTO_LINK_DX12)
+    CHECK_HR(::CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#else
+    CHECK_HR(g_CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#endif
+
+    auto addAdapter = [&key](IDXGIAdapter1* adapter1) {
+        DXGI_ADAPTER_DESC1 desc = {};
+        adapter1->GetDesc1(&desc);
+        ReportCacheKey::Adapter& keyAdapter = key.Adapters.emplace_back();
+        keyAdapter.LuidLowPart = desc.AdapterLuid.LowPart;
+        keyAdapter.LuidHighPart = desc.AdapterLuid.HighPart;
+        keyAdapter.VendorId = desc.VendorId;
+        keyAdapter.DeviceId = desc.DeviceId;
+        keyAdapter.SubSysId = desc.SubSysId;
+        keyAdapter.Revision = desc.Revision;
+        if(LARGE_INTEGER umdVersion; SUCCEEDED(adapter1->CheckInterfaceSupport(__uuidof(IDXGIDevice), &umdVersion)))
+            keyAdapter.UMDVersion = uint64_t(umdVersion.QuadPart);
+    };
+
+    ComPtr<IDXGIAdapter1> adapter1;
+    if(g_Options.WARP)
+    {
+        CHECK_HR(dxgiFactory->EnumWarpAdapter(IID_PPV_ARGS(&adapter1)));
+        addAdapter(adapter1.Get());
+    }
+    else
+    {
+        for(UINT i = 0; dxgiFactory->EnumAdapters1(i, &adapter1) != DXGI_ERROR_NOT_FOUND; ++i)
+        {
+            addAdapter(adapter1.Get());
+            adapter1.Reset();
+        }
+    }
+
+    return key;
+}
+
 template <typename PrinterClass>
 void PrintCommandLineSyntax()
 {
@@ -1666,11 +771,13 @@ void PrintCommandLineSyntax()
     PrinterClass::PrintString(L"Options:\n");
     PrinterClass::PrintString(L"  -v --Version                     Only print program version information.\n");
     PrinterClass::PrintString(L"  -h --Help                        Only print this help (command line syntax).\n");
-    PrinterClass::PrintString(L"  -l --List                        Only print the list of all adapters.\n");
+    PrinterClass::PrintString(L"  -l --List                        Only print the list of all adapters, as reported by DXGI.\n");
+    PrinterClass::PrintString(L"  --ListVendorData                 With --List, also print System Info and data of the adapters from vendor-specific APIs.\n");
     PrinterClass::PrintString(L"  -a --Adapter=<Index>             Print details of adapter at specified index.\n");
     PrinterClass::PrintString(L"  --AllAdapters                    Print details of all adapters.\n");
     PrinterClass::PrintString(L"  -j --JSON                        Print output in JSON format instead of human-friendly text.\n");
     PrinterClass::PrintString(L"  --MinimizeJson                   Print JSON in minimal size form.\n");
+    PrinterClass::PrintString(L"  --Flat                           Print one line path<TAB>type<TAB>value for each field, with names of the JSON report and enums and flags as integers.\n");
     PrinterClass::PrintString(L"  -o --OutputFile=<FilePath>       Output to specified file.\n");
     PrinterClass::PrintString(L"  -f --Formats                     Include information about DXGI format capabilities.\n");
     PrinterClass::PrintString(L"  --MetaCommands                   Include information about meta commands.\n");
@@ -1683,88 +790,164 @@ void PrintCommandLineSyntax()
 #endif
     PrinterClass::PrintString(L"  --ForceVendorAPI                 Tries to query info via vendor-specific APIs, even in case when vendor doesn't match.\n");
     PrinterClass::PrintString(L"  --WARP                           Use WARP adapter.\n");
+    PrinterClass::PrintString(L"  --Cache                          Reuse the report stored for the same adapters, drivers and options, or store it for next time.\n");
+    PrinterClass::PrintString(L"  --NoCache                        Neither read nor write the report cache. Overrides --Cache.\n");
+    PrinterClass::PrintString(L"  --ClearCache                     Remove all reports stored in the cache before running.\n");
+    PrinterClass::PrintString(L"  --Baseline=<FilePath>            Print only differences from a previous JSON report, as JSON Patch. Implies --JSON.\n");
+    PrinterClass::PrintString(L"  --Timings                        Include durations of individual queries to D3D12 and vendor libraries.\n");
+    PrinterClass::PrintString(L"  --Stats                          After the report, print heap calls, bytes allocated, peak live heap bytes and bytes printed in each section of it to the error output.\n");
+    PrinterClass::PrintString(L"  --Trace=<FilePath>               Write durations of the program's phases to a file in Chrome trace event format.\n");
+    PrinterClass::PrintString(L"  --Timeout=<Seconds>              Stop with a partial report and exit code -6 when the whole run takes longer.\n");
+    PrinterClass::PrintString(L"  --ProbeTimeout=<Milliseconds>    Stop with a partial report and exit code -6 when a single query takes longer.\n");
+    PrinterClass::PrintString(L"  --Record=<FilePath>              Write raw results of queries to the D3D12 device to a capture file.\n");
+    PrinterClass::PrintString(L"  --Replay=<FilePath>              Answer queries to the D3D12 device from a capture file written with --Record, with no adapter needed.\n");
+    PrinterClass::PrintString(L"  --AppendToArchive=<FilePath>     Append raw results of queries to the D3D12 device to a binary capability archive.\n");
+    PrinterClass::PrintString(L"  --Raw=<FilePath>                 Write D3D12 feature structures undecoded to a compact file instead of the report.\n");
+    PrinterClass::PrintString(L"  --DecodeRaw=<FilePath>           Print D3D12 feature structures stored by --Raw, no formats, meta commands or System Info.\n");
+    PrinterClass::PrintString(L"  --RenderDir=<Directory>          Render every JSON report in the directory again as JSON, in parallel, to the directory given by --OutputFile. Requires --JSON.\n");
+    PrinterClass::PrintString(L"  --Quirks=<FilePath>              Load driver quirks from a JSON file, taking precedence over the built-in ones.\n");
+    PrinterClass::PrintString(L"  --Batch=<FilePath>               Print a report for each line of the file, with the options given on that line, reusing libraries and devices.\n");
+    PrinterClass::PrintString(L"  --Serve                          Answer JSON-RPC requests for reports, read from standard input one per line, keeping libraries and devices alive.\n");
+    PrinterClass::PrintString(L"  --Publish=<Name>                 Write the report to shared memory with the name, for other processes to read, and keep running until stopped.\n");
+    PrinterClass::PrintString(L"  --PublishInterval=<Seconds>      With --Publish, print the report and write it to shared memory again after this interval.\n");
+    PrinterClass::PrintString(L"  --Monitor=<Milliseconds>         Sample video memory budget and usage of adapters at this interval as CSV, or NDJSON with --JSON, until Ctrl+C, then print a summary.\n");
+#if USE_NVAPI
+    PrinterClass::PrintString(L"  --MonitorNvApi=<Milliseconds>    Sample video memory evictions and promotions, clocks and performance state of NVIDIA GPUs at this interval and print changes during each interval as CSV, or NDJSON with --JSON, until Ctrl+C.\n");
+#endif
+    PrinterClass::PrintString(L"  --Metrics=<Port>                 Serve adapter and video memory metrics in OpenMetrics format over HTTP on the port of localhost, until stopped.\n");
+    PrinterClass::PrintString(L"  --MetricsFile=<FilePath>         Write adapter and video memory metrics in OpenMetrics format to the file, again after each --MetricsInterval, until stopped.\n");
+    PrinterClass::PrintString(L"  --MetricsInterval=<Seconds>      With --MetricsFile, how often to write the file. Default is 15.\n");
+    PrinterClass::PrintString(L"  --Benchmark=<N>                  Print the report N times after a warm-up run and print min, median, 95th, 99th percentile and max time of creating the devices, groups of queries, each format and rendering the report, as JSON.\n");
+    PrinterClass::PrintString(L"  --Watch                          Wait for adapters to be added, removed or changed and print each change as a line of NDJSON with the report of the adapter, until stopped.\n");
+    PrinterClass::PrintString(L"  --Select=<Paths>                 Query and print only parts of the report at paths like Adapters/*/D3D12_FEATURE_DATA_D3D12_OPTIONS5, separated by ','. Implies --JSON.\n");
     // clang-format on
 }
 
-static void ListAdapter(uint32_t adapterIndex, IDXGIAdapter* adapter, NvAPI_Inititalize_RAII* nvApi,
-    AGS_Initialize_RAII* ags, AmdDeviceInfo_Initialize_RAII* amdDeviceInfo, Vulkan_Initialize_RAII* vk)
+static std::wstring GetAdapterProbeScopeName(uint32_t adapterIndex)
 {
-    ReportScopeArrayItem scope;
-
-    if(!g_WARP && !g_ShowAllAdapters)
-    {
-        // In case of WARP, we queried adapter via different API that didn't use adapter index
-        // In case we show all adapters, array index equals adapter index
-        ReportFormatter::GetInstance().AddFieldUint32(L"AdapterIndex", adapterIndex);
-    }
+    return g_Options.WARP ? std::wstring(L"WARP") : std::format(L"Adapter {}", adapterIndex);
+}
 
-    PrintAdapterData(adapter);
+static bool IsSoftwareAdapter(IDXGIAdapter1* adapter1)
+{
+    DXGI_ADAPTER_DESC1 desc1 = {};
+    return SUCCEEDED(adapter1->GetDesc1(&desc1)) && (desc1.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) != 0;
+}
 
-    DXGI_ADAPTER_DESC desc = {};
-    if(SUCCEEDED(adapter->GetDesc(&desc)))
-    {
+static void PrintVendorAdapterData(const DXGI_ADAPTER_DESC& desc, bool softwareAdapter, VendorApis& vendorApis)
+{
 #if USE_NVAPI
-        bool useNVAPI = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_NVIDIA;
-        if(useNVAPI && nvApi && nvApi->IsInitialized())
-        {
+    if(vendorApis.IsApplicable(VendorApi::NvApi, desc.VendorId, softwareAdapter) &&
+        ReportSelection::IsSelected(L"NvPhysicalGpuHandle"))
+    {
+        if(NvAPI_Inititalize_RAII* nvApi = vendorApis.GetNvApi())
             nvApi->PrintPhysicalGpuData(desc.AdapterLuid);
-        }
+    }
 #endif
 #if USE_AGS
-        bool useAGS = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_AMD;
-        if(useAGS && ags && ags->IsInitialized())
+    if(vendorApis.IsApplicable(VendorApi::Ags, desc.VendorId, softwareAdapter) &&
+        ReportSelection::IsSelected(L"AGSDeviceInfo"))
+    {
+        if(AGS_Initialize_RAII* ags = vendorApis.GetAgs())
         {
             AGS_Initialize_RAII::DeviceId deviceId = {
                 .vendorId = (int)desc.VendorId, .deviceId = (int)desc.DeviceId, .revisionId = (int)desc.Revision
             };
             ags->PrintAgsDeviceData(deviceId);
         }
+    }
 #endif
 #if USE_AMD_DEVICE_INFO
-        bool useAmdDeviceInfo = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_AMD;
-        if(useAmdDeviceInfo && amdDeviceInfo)
+    if(vendorApis.IsApplicable(VendorApi::AmdDeviceInfo, desc.VendorId, softwareAdapter) &&
+        ReportSelection::IsSelected(L"AMD GDT_DeviceInfo"))
+    {
+        if(AmdDeviceInfo_Initialize_RAII* amdDeviceInfo = vendorApis.GetAmdDeviceInfo())
         {
             AmdDeviceInfo_Initialize_RAII::DeviceId deviceId = { desc.DeviceId, desc.Revision };
             amdDeviceInfo->PrintDeviceData(deviceId);
         }
+    }
 #endif
 #if USE_VULKAN
-        if(vk && vk->IsInitialized())
+    if(vendorApis.IsApplicable(VendorApi::Vulkan, desc.VendorId, softwareAdapter) &&
+        ReportSelection::IsPrefixSelected(L"VkPhysicalDevice"))
+    {
+        if(Vulkan_Initialize_RAII* vk = vendorApis.GetVulkan())
             vk->PrintData(desc);
+    }
 #endif
+}
+
+static void ListAdapter(uint32_t adapterIndex, IDXGIAdapter1* adapter1, VendorApis& vendorApis)
+{
+    ReportScopeArrayItem scope;
+    ProbeScope probeScope(GetAdapterProbeScopeName(adapterIndex));
+
+    if(!g_Options.WARP && !g_Options.ShowAllAdapters)
+    {
+        // In case of WARP, we queried adapter via different API that didn't use adapter index
+        // In case we show all adapters, array index equals adapter index
+        ReportFormatter::GetInstance().AddFieldUint32(L"AdapterIndex", adapterIndex);
     }
+
+    PrintAdapterData(adapter1);
+
+    DXGI_ADAPTER_DESC desc = {};
+    if(SUCCEEDED(adapter1->GetDesc(&desc)))
+        PrintVendorAdapterData(desc, IsSoftwareAdapter(adapter1), vendorApis);
 }
 
-static void ListAdapters(IDXGIFactory4* dxgiFactory, NvAPI_Inititalize_RAII* nvApi, AGS_Initialize_RAII* ags,
-    AmdDeviceInfo_Initialize_RAII* amdDeviceInfo, Vulkan_Initialize_RAII* vk)
+static void ListAdapters(IDXGIFactory4* dxgiFactory, VendorApis& vendorApis)
 {
-    ComPtr<IDXGIAdapter> adapter;
-    if(!g_WARP)
+    ComPtr<IDXGIAdapter1> adapter1;
+    if(!g_Options.WARP)
     {
         UINT adapterIndex = 0;
-        while(dxgiFactory->EnumAdapters(adapterIndex, &adapter) != DXGI_ERROR_NOT_FOUND)
+        while(dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND)
         {
-            ListAdapter(adapterIndex, adapter.Get(), nvApi, ags, amdDeviceInfo, vk);
-            adapter.Reset();
+            ListAdapter(adapterIndex, adapter1.Get(), vendorApis);
+            adapter1.Reset();
             ++adapterIndex;
         }
     }
     else
     {
-        CHECK_HR(dxgiFactory->EnumWarpAdapter(IID_PPV_ARGS(&adapter)));
-        ListAdapter(0, adapter.Get(), nvApi, ags, amdDeviceInfo, vk);
+        CHECK_HR(dxgiFactory->EnumWarpAdapter(IID_PPV_ARGS(&adapter1)));
+        ListAdapter(0, adapter1.Get(), vendorApis);
+    }
+}
+
+// Name of the call that gets the version of the user mode driver in the device capture.
+static const wchar_t* const UMD_VERSION_CALL_NAME = L"CheckInterfaceSupport IDXGIDevice";
+
+// Tells raw feature data and driver quirks which adapter is inspected from here on.
+static void BeginAdapterInspection(const DXGI_ADAPTER_DESC1& desc1, uint64_t umdVersion)
+{
+    if(RawFeatureData::IsRecording())
+        RawFeatureData::AddRecord(RawFeatureData::ADAPTER_RECORD_ID, &desc1, sizeof(desc1));
+    DriverQuirks::SetAdapter(desc1.VendorId, desc1.DeviceId, umdVersion);
+}
+
+static void EndAdapterInspection(const std::wstring& adapterName)
+{
+    DriverQuirks::PrintApplied();
+
+    if(!g_Options.ArchiveFilePath.empty())
+    {
+        CapabilityArchive::Append(g_Options.ArchiveFilePath, CapabilityArchive::MakeKey(adapterName),
+            DeviceCapture::GetAdapterCalls(adapterName));
     }
 }
 
-int InspectAdapter(NvAPI_Inititalize_RAII* nvApi, AGS_Initialize_RAII* ags,
-    AmdDeviceInfo_Initialize_RAII* amdDeviceInfo, Vulkan_Initialize_RAII* vk, uint32_t& adapterIndex,
-    ComPtr<IDXGIAdapter1>& adapter1)
+int InspectAdapter(VendorApis& vendorApis, uint32_t& adapterIndex, ComPtr<IDXGIAdapter1>& adapter1)
 {
     ReportScopeArrayItemConditional scope(g_PrintAdaptersAsArray);
+    ProbeScope probeScope(GetAdapterProbeScopeName(adapterIndex));
+    DeviceCapture::SetAdapter(GetAdapterProbeScopeName(adapterIndex));
 
     int programResult = PROGRAM_EXIT_SUCCESS;
 
-    if(!g_WARP && !g_ShowAllAdapters)
+    if(!g_Options.WARP && !g_Options.ShowAllAdapters)
     {
         // In case of WARP, we queried adapter via different API that didn't use adapter index
         // In case we show all adapters, array index equals adapter index
@@ -1776,38 +959,11 @@ int InspectAdapter(NvAPI_Inititalize_RAII* nvApi, AGS_Initialize_RAII* ags,
     DXGI_ADAPTER_DESC desc = {};
     if(SUCCEEDED(adapter1->GetDesc(&desc)))
     {
-#if USE_NVAPI
-        bool useNVAPI = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_NVIDIA;
-        if(useNVAPI && nvApi && nvApi->IsInitialized())
-        {
-            nvApi->PrintPhysicalGpuData(desc.AdapterLuid);
-        }
-#endif
-#if USE_AGS
-        bool useAGS = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_AMD;
-        if(useAGS && ags && ags->IsInitialized())
-        {
-            AGS_Initialize_RAII::DeviceId deviceId = {
-                .vendorId = (int)desc.VendorId, .deviceId = (int)desc.DeviceId, .revisionId = (int)desc.Revision
-            };
-            ags->PrintAgsDeviceData(deviceId);
-        }
-#endif
-#if USE_AMD_DEVICE_INFO
-        bool useAmdDeviceInfo = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_AMD;
-        if(useAmdDeviceInfo && amdDeviceInfo)
-        {
-            AmdDeviceInfo_Initialize_RAII::DeviceId deviceId = { desc.DeviceId, desc.Revision };
-            amdDeviceInfo->PrintDeviceData(deviceId);
-        }
-#endif
-#if USE_VULKAN
-        if(vk && vk->IsInitialized())
-            vk->PrintData(desc);
-#endif
+        const bool softwareAdapter = IsSoftwareAdapter(adapter1.Get());
+        PrintVendorAdapterData(desc, softwareAdapter, vendorApis);
 #if USE_INTEL_GPUDETECT
-        bool useGPUDetect = g_ForceVendorAPI || desc.VendorId == VENDOR_ID_INTEL;
-        if(useGPUDetect && !g_PureD3D12)
+        if(vendorApis.IsApplicable(VendorApi::IntelGpuDetect, desc.VendorId, softwareAdapter) &&
+            ReportSelection::IsSelected(L"Intel GPUDetect::GPUData"))
         {
             ComPtr<IDXGIAdapter> adapter;
             adapter1->QueryInterface(IID_PPV_ARGS(&adapter));
@@ -1816,20 +972,83 @@ int InspectAdapter(NvAPI_Inititalize_RAII* nvApi, AGS_Initialize_RAII* ags,
 #endif
     }
 
-    programResult = PrintDeviceDetails(adapter1.Get(), nvApi, ags);
+    // Captured, so --Replay knows the adapter without having it.
+    DXGI_ADAPTER_DESC1 desc1 = {};
+    CaptureCall(L"GetDesc1", &desc1, sizeof(desc1), [&]() { return adapter1->GetDesc1(&desc1); });
+    LARGE_INTEGER umdVersion = {};
+    CaptureCall(UMD_VERSION_CALL_NAME, &umdVersion, sizeof(umdVersion),
+        [&]() { return adapter1->CheckInterfaceSupport(__uuidof(IDXGIDevice), &umdVersion); });
+
+    BeginAdapterInspection(desc1, uint64_t(umdVersion.QuadPart));
+    programResult = PrintDeviceDetails(adapter1.Get(), vendorApis);
+    EndAdapterInspection(GetAdapterProbeScopeName(adapterIndex));
 
     return programResult;
 }
 
-static int InspectAllAdapters(IDXGIFactory4* dxgiFactory, NvAPI_Inititalize_RAII* nvApi, AGS_Initialize_RAII* ags,
-    AmdDeviceInfo_Initialize_RAII* amdDeviceInfo, Vulkan_Initialize_RAII* vk)
+// With --Replay, the adapter is known only from the capture and its device is faked.
+static int InspectReplayedAdapter(VendorApis& vendorApis, const std::wstring& adapterName)
+{
+    ReportScopeArrayItemConditional scope(g_PrintAdaptersAsArray);
+    ProbeScope probeScope(adapterName);
+    DeviceCapture::SetAdapter(adapterName);
+
+    if(uint32_t adapterIndex = 0;
+        !g_Options.ShowAllAdapters && swscanf_s(adapterName.c_str(), L"Adapter %u", &adapterIndex) == 1)
+        ReportFormatter::GetInstance().AddFieldUint32(L"AdapterIndex", adapterIndex);
+
+    DXGI_ADAPTER_DESC1 desc1 = {};
+    if(SUCCEEDED(DeviceCapture::ReplayCall(L"GetDesc1", &desc1, sizeof(desc1))) &&
+        ReportSelection::IsPrefixSelected(L"DXGI_ADAPTER_DESC"))
+        PrintAdapterDesc1(desc1);
+    LARGE_INTEGER umdVersion = {};
+    DeviceCapture::ReplayCall(UMD_VERSION_CALL_NAME, &umdVersion, sizeof(umdVersion));
+
+    BeginAdapterInspection(desc1, uint64_t(umdVersion.QuadPart));
+    PrintDeviceCapabilities(
+        CreateReplayDevice().Get(), desc1, vendorApis, g_Options.PrintFormats, g_Options.PrintMetaCommands);
+    EndAdapterInspection(adapterName);
+
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+// Chooses among the adapters in the capture like among the ones in the system, by --Adapter, --WARP or --AllAdapters.
+static int InspectReplayedAdapters(VendorApis& vendorApis)
+{
+    std::vector<std::wstring> adapterNames = DeviceCapture::GetAdapterNames();
+    // Calls not made for any adapter, like DXGI_FEATURE_PRESENT_ALLOW_TEARING.
+    std::erase(adapterNames, std::wstring());
+    if(adapterNames.empty())
+        throw std::runtime_error("No D3D12 adapters to show.");
+
+    if(!g_Options.ShowAllAdapters)
+    {
+        // No explicit adapter requested: Choose the first one captured.
+        std::wstring adapterName = adapterNames[0];
+        if(g_Options.WARP || g_Options.AdapterIndex != UINT32_MAX)
+            adapterName = GetAdapterProbeScopeName(g_Options.AdapterIndex);
+        if(std::find(adapterNames.begin(), adapterNames.end(), adapterName) == adapterNames.end())
+            throw std::runtime_error("No valid adapter chosen to show D3D12 device details.");
+        adapterNames = { adapterName };
+    }
+
+    for(const std::wstring& adapterName : adapterNames)
+    {
+        int result = InspectReplayedAdapter(vendorApis, adapterName);
+        if(result != PROGRAM_EXIT_SUCCESS)
+            return result;
+    }
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+static int InspectAllAdapters(IDXGIFactory4* dxgiFactory, VendorApis& vendorApis)
 {
     uint32_t adapterIndex = 0;
     bool anyInspected = false;
     ComPtr<IDXGIAdapter1> adapter1;
     while(dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND)
     {
-        if(g_SkipSoftwareAdapter)
+        if(g_Options.SkipSoftwareAdapter)
         {
             DXGI_ADAPTER_DESC1 desc = {};
             adapter1->GetDesc1(&desc);
@@ -1840,7 +1059,7 @@ static int InspectAllAdapters(IDXGIFactory4* dxgiFactory, NvAPI_Inititalize_RAII
             }
         }
 
-        int result = InspectAdapter(nvApi, ags, amdDeviceInfo, vk, adapterIndex, adapter1);
+        int result = InspectAdapter(vendorApis, adapterIndex, adapter1);
         anyInspected = true;
         if(result != PROGRAM_EXIT_SUCCESS)
             return result;
@@ -1854,11 +1073,10 @@ static int InspectAllAdapters(IDXGIFactory4* dxgiFactory, NvAPI_Inititalize_RAII
 }
 
 // adapterIndex == UINT_MAX means first non-software and non-remote adapter.
-static int InspectAdapter(IDXGIFactory4* dxgiFactory, NvAPI_Inititalize_RAII* nvApi, AGS_Initialize_RAII* ags,
-    AmdDeviceInfo_Initialize_RAII* amdDeviceInfo, Vulkan_Initialize_RAII* vk, uint32_t adapterIndex)
+static int InspectAdapter(IDXGIFactory4* dxgiFactory, VendorApis& vendorApis, uint32_t adapterIndex)
 {
     ComPtr<IDXGIAdapter1> adapter1;
-    if(g_WARP)
+    if(g_Options.WARP)
     {
         CHECK_HR(dxgiFactory->EnumWarpAdapter(IID_PPV_ARGS(&adapter1)));
     }
@@ -1879,39 +1097,391 @@ static int InspectAdapter(IDXGIFactory4* dxgiFactory, NvAPI_Inititalize_RAII* nv
         }
     }
 
-    if(adapter1)
+    if(adapter1)
+    {
+        return InspectAdapter(vendorApis, adapterIndex, adapter1);
+    }
+
+    throw std::runtime_error("No valid adapter chosen to show D3D12 device details.");
+}
+
+static ComPtr<IDXGIFactory4> CreateDxgiFactory()
+{
+    TraceSpan traceSpan(L"CreateDXGIFactory1");
+    ComPtr<IDXGIFactory4> dxgiFactory;
+#if defined(AUTO_LINK_DX12)
+    CHECK_HR(::CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#else
+    CHECK_HR(g_CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+#endif
+    assert(dxgiFactory != nullptr);
+    return dxgiFactory;
+}
+
+// Lets vendorApis know which vendors have adapters in the system, before any of them is inspected.
+static void AddPresentAdapters(IDXGIFactory4* dxgiFactory, VendorApis& vendorApis)
+{
+    ComPtr<IDXGIAdapter1> adapter1;
+    if(g_Options.WARP)
+    {
+        CHECK_HR(dxgiFactory->EnumWarpAdapter(IID_PPV_ARGS(&adapter1)));
+        DXGI_ADAPTER_DESC desc = {};
+        if(SUCCEEDED(adapter1->GetDesc(&desc)))
+            vendorApis.AddPresentAdapter(desc.VendorId, IsSoftwareAdapter(adapter1.Get()));
+        return;
+    }
+    for(UINT adapterIndex = 0; dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND;
+        ++adapterIndex)
+    {
+        DXGI_ADAPTER_DESC desc = {};
+        if(SUCCEEDED(adapter1->GetDesc(&desc)))
+            vendorApis.AddPresentAdapter(desc.VendorId, IsSoftwareAdapter(adapter1.Get()));
+        adapter1.Reset();
+    }
+}
+
+// The fast path of --List, called e.g. by game launchers on every start just to choose a GPU.
+// It uses only DXGI: D3D12 is not loaded, vendor APIs are not initialized and System Info is not queried.
+// It's about as fast as checking the report cache, so it bypasses it.
+static int PrintAdapterList()
+{
+#if !defined(AUTO_LINK_DX12)
+    if(!LoadLibraries(false))
+        throw std::runtime_error("Could not load DXGI library.");
+#endif
+
+    // Scope for COM objects.
+    {
+        ComPtr<IDXGIFactory4> dxgiFactory = CreateDxgiFactory();
+        // Disabled, so no vendor API is ever initialized.
+        VendorApis vendorApis;
+
+        ReportScopeArrayConditional scopeArray(
+            g_PrintAdaptersAsArray, SelectString(L"Adapter", L"Adapters"), ReportFormatter::ARRAY_SUFFIX_NONE);
+        ReportScopeObjectConditional scopeObject(!g_PrintAdaptersAsArray, L"Adapter");
+        ListAdapters(dxgiFactory.Get(), vendorApis);
+    }
+
+    if(g_Options.PrintTimings)
+        ProbeTimings::PrintReport();
+
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+// Prints a report stored in the cache, querying its volatile sections again.
+static void PrintCachedReport(const ReportFragment& fragment)
+{
+    ComPtr<IDXGIFactory4> dxgiFactory;
+    for(const ReportFragment::Segment& segment : fragment.Segments)
+    {
+        Printer::PrintString(segment.Text);
+        // The formatter is brought to the state it was in after printing the text, without printing it again.
+        Printer::BeginCapture(false);
+        CallLogReportFormatter::Replay(ReportFormatter::GetInstance(), segment.CallLog);
+        Printer::EndCapture();
+
+        if(!segment.VolatileSection.empty())
+        {
+            if(!dxgiFactory)
+                dxgiFactory = CreateDxgiFactory();
+            PrintVolatileSection(dxgiFactory.Get(), segment.VolatileSection);
+        }
+    }
+}
+
+// Libraries stay loaded and vendorApis initialized after it returns, for the next report, if any.
+static int PrintReport(VendorApis& vendorApis)
+{
+    if(IsDxgiOnlyAdapterList())
+    {
+        PrintVersionData(nullptr);
+        return PrintAdapterList();
+    }
+
+#if !defined(AUTO_LINK_DX12)
+    if(!LoadLibraries(true))
+        throw std::runtime_error("Could not load DXGI & D3D12 libraries.");
+#endif
+
+    // Vendor APIs are initialized on first use. A replayed capture has no adapters to use them with.
+    vendorApis.SetOptions(!g_Options.PureD3D12 && !DeviceCapture::IsReplaying(), g_Options.ForceVendorAPI);
+
+    // The vendors of the adapters decide which APIs to initialize, so the DXGI factory is created and the adapters
+    // enumerated first, before anything else, even the header. With --Replay, the adapters come from the capture
+    // instead.
+    ComPtr<IDXGIFactory4> dxgiFactory;
+    if(!DeviceCapture::IsReplaying())
+    {
+        dxgiFactory = CreateDxgiFactory();
+        AddPresentAdapters(dxgiFactory.Get(), vendorApis);
+    }
+
+    PrintVersionData(&vendorApis);
+
+    if(g_Options.ClearCache)
+        ReportCache(GetReportCacheDirectory()).Clear();
+
+    // Everything printed from here on is what gets stored in the cache, except the volatile sections.
+    g_RecordedFragment.reset();
+    std::optional<ReportCache> reportCache;
+    ReportCacheKey reportCacheKey;
+    // Timings and stats are measured anew on every run and captures need the queries to be made, so they bypass the
+    // cache.
+    if(g_Options.UseCache && !g_Options.PrintTimings && !g_Options.PrintStats && g_Options.RecordFilePath.empty() &&
+        g_Options.ReplayFilePath.empty() && g_Options.ArchiveFilePath.empty() && g_Options.RawFilePath.empty() &&
+        g_Options.QuirksFilePath.empty())
+    {
+        reportCache.emplace(GetReportCacheDirectory());
+        reportCacheKey = MakeReportCacheKey(g_Options.AdapterIndex);
+        if(ReportFragment fragment; reportCache->Load(reportCacheKey, fragment))
+        {
+            PrintCachedReport(fragment);
+            return PROGRAM_EXIT_SUCCESS;
+        }
+        Printer::BeginCapture();
+        ReportFormatter::BeginCallLog();
+        g_RecordedFragment.emplace();
+    }
+
+    int programResult = PROGRAM_EXIT_SUCCESS;
+
+    // Scope for COM objects.
+    {
+        // Vendor APIs initialize while the application identity is set and System Info is queried.
+        // With --Select, only those needed for the sections selected are initialized, on first use.
+        if(!ReportSelection::IsEnabled())
+            vendorApis.StartInitialization();
+
+        // Before any D3D12 device is created.
+        if(!g_Options.InLibrary)
+            SetApplicationIdentity();
+
+        {
+            ReportScopeObject scope(SelectString(L"System Info", L"SystemInfo"));
+            ProbeScope probeScope(L"SystemInfo");
+
+            if(!g_Options.PureD3D12)
+            {
+                if(ReportSelection::IsSelected(L"OS Info"))
+                    PrintOsVersionInfo();
+                if(ReportSelection::IsSelected(L"System memory"))
+                {
+                    VolatileSectionScope volatileSectionScope(VOLATILE_SECTION_SYSTEM_MEMORY);
+                    PrintSystemMemoryInfo();
+                }
+            }
+
+            if(ReportSelection::IsSelected(L"DXGI_FEATURE"))
+                PrintDXGIFeatureInfo();
+
+#if USE_NVAPI
+            if(vendorApis.IsApplicableToAnyAdapter(VendorApi::NvApi) && ReportSelection::IsPrefixSelected(L"NvAPI_SYS"))
+            {
+                if(NvAPI_Inititalize_RAII* nvApi = vendorApis.GetNvApi())
+                    nvApi->PrintData();
+            }
+#endif
+#if USE_AGS
+            if(vendorApis.IsApplicableToAnyAdapter(VendorApi::Ags) && ReportSelection::IsSelected(L"AGSGPUInfo"))
+            {
+                if(AGS_Initialize_RAII* ags = vendorApis.GetAgs())
+                    ags->PrintData();
+            }
+#endif
+
+            EnableExperimentalFeatures();
+
+            if(ReportSelection::IsSelected(L"TranslationLayerDetection"))
+                DetectTranslationLayersGlobal();
+        }
+
+        if(ReportSelection::IsOptionalSectionIncluded(g_Options.PrintEnums, L"Enums"))
+            PrintEnums();
+
+        ReportScopeArrayConditional scopeArray(
+            g_PrintAdaptersAsArray, SelectString(L"Adapter", L"Adapters"), ReportFormatter::ARRAY_SUFFIX_NONE);
+        ReportScopeObjectConditional scopeObject(!g_PrintAdaptersAsArray, L"Adapter");
+
+        if(DeviceCapture::IsReplaying())
+            programResult = InspectReplayedAdapters(vendorApis);
+        else if(g_Options.ListAdapters)
+            ListAdapters(dxgiFactory.Get(), vendorApis);
+        else
+        {
+            if(g_Options.WARP)
+                InspectAdapter(dxgiFactory.Get(), vendorApis, UINT32_MAX);
+            else if(!g_Options.ShowAllAdapters)
+                InspectAdapter(dxgiFactory.Get(), vendorApis, g_Options.AdapterIndex);
+            else
+                InspectAllAdapters(dxgiFactory.Get(), vendorApis);
+        }
+    }
+
+    if(g_Options.PrintTimings)
+        ProbeTimings::PrintReport();
+
+    if(reportCache)
+    {
+        std::wstring text = Printer::EndCapture();
+        g_RecordedFragment->Segments.push_back({ std::move(text), ReportFormatter::TakeCallLog(), {} });
+        ReportFormatter::EndCallLog();
+        if(programResult == PROGRAM_EXIT_SUCCESS)
+            reportCache->Store(reportCacheKey, *g_RecordedFragment);
+        g_RecordedFragment.reset();
+    }
+
+    return programResult;
+}
+
+// Adapters are matched by LUID, so they are compared correctly even if their order has changed.
+static std::wstring GetAdapterLuidKey(const JsonValue& item)
+{
+    for(const auto& member : item.m_Members)
+    {
+        if(!member.first.starts_with(L"DXGI_ADAPTER_DESC"))
+            continue;
+        if(const JsonValue* luid = member.second.FindMember(L"AdapterLuid"))
+            return luid->m_String;
+    }
+    return {};
+}
+
+// Decodes a file written with --Raw into the structures it would show in the report, one adapter after another.
+static int PrintRawFeatureDataReport()
+{
+    const std::vector<RawFeatureData::Record> records = RawFeatureData::LoadFile(g_Options.DecodeRawFilePath);
+    if(records.empty() || records.front().m_Id != RawFeatureData::ADAPTER_RECORD_ID)
+        throw std::runtime_error("Invalid raw feature data file.");
+
+    PrintVersionData(nullptr);
+
+    ReportScopeArray scopeArray(SelectString(L"Adapter", L"Adapters"), ReportFormatter::ARRAY_SUFFIX_NONE);
+    std::optional<ReportScopeArrayItem> adapterScope;
+    for(const RawFeatureData::Record& record : records)
+    {
+        if(record.m_Id == RawFeatureData::ADAPTER_RECORD_ID)
+        {
+            adapterScope.reset();
+            adapterScope.emplace();
+        }
+        PrintRawRecord(record);
+    }
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+// Prints only the differences between the baseline report and the current one, as JSON Patch.
+static int PrintDeltaReport(ReportFormatter::FLAGS flags, VendorApis& vendorApis)
+{
+    const JsonValue baseline = ParseJson(LoadTextFile(g_Options.BaselineFilePath));
+
+    int programResult = PROGRAM_EXIT_SUCCESS;
+    Printer::BeginCapture(false);
     {
-        return InspectAdapter(nvApi, ags, amdDeviceInfo, vk, adapterIndex, adapter1);
+        ReportFormatterScope formatterScope(flags);
+        programResult = PrintReport(vendorApis);
     }
+    const JsonValue current = ParseJson(Printer::EndCapture());
 
-    throw std::runtime_error("No valid adapter chosen to show D3D12 device details.");
-}
+    std::wstring patchStr;
+    WriteJson(MakeJsonPatch(baseline, current, GetAdapterLuidKey), g_Options.UseJsonPrettyPrint, patchStr);
+    Printer::PrintString(patchStr);
+    Printer::PrintNewLine();
 
-int wmain3(int argc, wchar_t** argv)
-{
-    UINT adapterIndex = UINT32_MAX;
+    return programResult;
+}
 
-    CmdLineParser cmdLineParser(argc, argv);
+enum CMD_LINE_PARAM
+{
+    CMD_LINE_OPT_VERSION,
+    CMD_LINE_OPT_HELP,
+    CMD_LINE_OPT_LIST,
+    CMD_LINE_OPT_LIST_VENDOR_DATA,
+    CMD_LINE_OPT_ADAPTER,
+    CMD_LINE_OPT_ALL_ADAPTERS,
+    CMD_LINE_OPT_JSON,
+    CMD_LINE_OPT_MINIMIZE_JSON,
+    CMD_LINE_OPT_OUTPUT_TO_FILE,
+    CMD_LINE_OPT_FORMATS,
+    CMD_LINE_OPT_META_COMMANDS,
+    CMD_LINE_OPT_ENUMS,
+    CMD_LINE_OPT_PURE_D3D12,
+    CMD_LINE_OPT_ENABLE_EXPERIMENTAL,
+    CMD_LINE_OPT_FORCE_VENDOR_SPECIFIC,
+    CMD_LINE_OPT_WARP,
+    CMD_LINE_OPT_CACHE,
+    CMD_LINE_OPT_NO_CACHE,
+    CMD_LINE_OPT_CLEAR_CACHE,
+    CMD_LINE_OPT_BASELINE,
+    CMD_LINE_OPT_TIMINGS,
+    CMD_LINE_OPT_TRACE,
+    CMD_LINE_OPT_TIMEOUT,
+    CMD_LINE_OPT_PROBE_TIMEOUT,
+    CMD_LINE_OPT_RECORD,
+    CMD_LINE_OPT_REPLAY,
+    CMD_LINE_OPT_APPEND_TO_ARCHIVE,
+    CMD_LINE_OPT_RAW,
+    CMD_LINE_OPT_DECODE_RAW,
+    CMD_LINE_OPT_RENDER_DIR,
+    CMD_LINE_OPT_QUIRKS,
+    CMD_LINE_OPT_SELECT,
+    CMD_LINE_OPT_BATCH,
+    CMD_LINE_OPT_SERVE,
+    CMD_LINE_OPT_PUBLISH,
+    CMD_LINE_OPT_PUBLISH_INTERVAL,
+    CMD_LINE_OPT_MONITOR,
+    CMD_LINE_OPT_MONITOR_NVAPI,
+    CMD_LINE_OPT_METRICS,
+    CMD_LINE_OPT_METRICS_FILE,
+    CMD_LINE_OPT_METRICS_INTERVAL,
+    CMD_LINE_OPT_FLAT,
+    CMD_LINE_OPT_WATCH,
+    CMD_LINE_OPT_BENCHMARK,
+    CMD_LINE_OPT_STATS,
+    CMD_LINE_OPT_COUNT
+};
 
-    enum CMD_LINE_PARAM
-    {
-        CMD_LINE_OPT_VERSION,
-        CMD_LINE_OPT_HELP,
-        CMD_LINE_OPT_LIST,
-        CMD_LINE_OPT_ADAPTER,
-        CMD_LINE_OPT_ALL_ADAPTERS,
-        CMD_LINE_OPT_JSON,
-        CMD_LINE_OPT_MINIMIZE_JSON,
-        CMD_LINE_OPT_OUTPUT_TO_FILE,
-        CMD_LINE_OPT_FORMATS,
-        CMD_LINE_OPT_META_COMMANDS,
-        CMD_LINE_OPT_ENUMS,
-        CMD_LINE_OPT_PURE_D3D12,
-        CMD_LINE_OPT_ENABLE_EXPERIMENTAL,
-        CMD_LINE_OPT_FORCE_VENDOR_SPECIFIC,
-        CMD_LINE_OPT_WARP,
-    };
+// Options that apply to the whole --Batch or --Serve, given on the command line next to it, rather than to each of
+// its jobs or requests, or that choose another mode of the program.
+static bool IsBatchOpt(uint32_t optId)
+{
+    switch(optId)
+    {
+    case CMD_LINE_OPT_VERSION:
+    case CMD_LINE_OPT_HELP:
+    case CMD_LINE_OPT_CLEAR_CACHE:
+    case CMD_LINE_OPT_TIMINGS:
+    case CMD_LINE_OPT_TRACE:
+    case CMD_LINE_OPT_TIMEOUT:
+    case CMD_LINE_OPT_PROBE_TIMEOUT:
+    case CMD_LINE_OPT_RECORD:
+    case CMD_LINE_OPT_REPLAY:
+    case CMD_LINE_OPT_APPEND_TO_ARCHIVE:
+    case CMD_LINE_OPT_RAW:
+    case CMD_LINE_OPT_RENDER_DIR:
+    case CMD_LINE_OPT_QUIRKS:
+    case CMD_LINE_OPT_BATCH:
+    case CMD_LINE_OPT_SERVE:
+    case CMD_LINE_OPT_PUBLISH:
+    case CMD_LINE_OPT_PUBLISH_INTERVAL:
+    case CMD_LINE_OPT_MONITOR:
+    case CMD_LINE_OPT_MONITOR_NVAPI:
+    case CMD_LINE_OPT_METRICS:
+    case CMD_LINE_OPT_METRICS_FILE:
+    case CMD_LINE_OPT_METRICS_INTERVAL:
+    case CMD_LINE_OPT_WATCH:
+    case CMD_LINE_OPT_BENCHMARK:
+    case CMD_LINE_OPT_STATS:
+        return true;
+    default:
+        return false;
+    }
+}
 
+// Reads options into options, leaving the others unchanged. batchJob means a line of the --Batch file or options of
+// a --Serve request.
+// On failure, sets options.ShowCommandLineSyntaxAndFail.
+static void ParseCommandLine(CmdLineParser& cmdLineParser, bool batchJob, ProgramOptions& options)
+{
     // clang-format off
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_VERSION,               L"Version",             false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_VERSION,               L'v',                   false);
@@ -1919,6 +1489,7 @@ int wmain3(int argc, wchar_t** argv)
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_HELP,                  L'h',                   false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_LIST,                  L"List",                false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_LIST,                  L'l',                   false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_LIST_VENDOR_DATA,      L"ListVendorData",      false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_ADAPTER,               L"Adapter",             true);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_ADAPTER,               L'a',                   true);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_ALL_ADAPTERS,          L"AllAdapters",         false);
@@ -1937,6 +1508,35 @@ int wmain3(int argc, wchar_t** argv)
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_ENABLE_EXPERIMENTAL,   L'x',                   true);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_FORCE_VENDOR_SPECIFIC, L"ForceVendorAPI",      false);
     cmdLineParser.RegisterOpt(CMD_LINE_OPT_WARP,                  L"WARP",                false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_CACHE,                 L"Cache",               false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_NO_CACHE,              L"NoCache",             false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_CLEAR_CACHE,           L"ClearCache",          false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_BASELINE,              L"Baseline",            true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_TIMINGS,               L"Timings",             false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_TRACE,                 L"Trace",               true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_TIMEOUT,               L"Timeout",             true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_PROBE_TIMEOUT,         L"ProbeTimeout",        true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_RECORD,                L"Record",              true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_REPLAY,                L"Replay",              true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_APPEND_TO_ARCHIVE,     L"AppendToArchive",     true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_RAW,                   L"Raw",                 true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_DECODE_RAW,            L"DecodeRaw",           true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_RENDER_DIR,            L"RenderDir",           true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_QUIRKS,                L"Quirks",              true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_SELECT,                L"Select",              true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_BATCH,                 L"Batch",               true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_SERVE,                 L"Serve",               false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_PUBLISH,               L"Publish",             true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_PUBLISH_INTERVAL,      L"PublishInterval",     true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_MONITOR,               L"Monitor",             true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_MONITOR_NVAPI,         L"MonitorNvApi",        true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_METRICS,               L"Metrics",             true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_METRICS_FILE,          L"MetricsFile",         true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_METRICS_INTERVAL,      L"MetricsInterval",     true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_FLAT,                  L"Flat",                false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_WATCH,                 L"Watch",               false);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_BENCHMARK,             L"Benchmark",           true);
+    cmdLineParser.RegisterOpt(CMD_LINE_OPT_STATS,                 L"Stats",               false);
     // clang-format on
 
     CmdLineParser::RESULT cmdLineResult;
@@ -1949,7 +1549,14 @@ int wmain3(int argc, wchar_t** argv)
         if(cmdLineResult == CmdLineParser::RESULT_ERROR ||
             cmdLineResult == CmdLineParser::RESULT_PARAMETER)
         {
-            g_ShowCommandLineSyntaxAndFail = true;
+            options.ShowCommandLineSyntaxAndFail = true;
+            break;
+        }
+
+        // Options of the whole batch can't be given to a single job.
+        if(batchJob && IsBatchOpt(cmdLineParser.GetOptId()))
+        {
+            options.ShowCommandLineSyntaxAndFail = true;
             break;
         }
 
@@ -1959,70 +1566,78 @@ int wmain3(int argc, wchar_t** argv)
             switch(cmdLineParser.GetOptId())
             {
             case CMD_LINE_OPT_VERSION:
-                g_ShowVersionAndQuit = true;
+                options.ShowVersionAndQuit = true;
                 break;
             case CMD_LINE_OPT_HELP:
-                g_ShowCommandLineSyntaxAndQuit = true;
+                options.ShowCommandLineSyntaxAndQuit = true;
                 break;
             case CMD_LINE_OPT_LIST:
                 if(cmdLineParser.IsOptEncountered(CMD_LINE_OPT_ADAPTER) ||
                     cmdLineParser.IsOptEncountered(CMD_LINE_OPT_ALL_ADAPTERS) ||
                     cmdLineParser.IsOptEncountered(CMD_LINE_OPT_WARP))
                 {
-                    g_ShowCommandLineSyntaxAndFail = true;
+                    options.ShowCommandLineSyntaxAndFail = true;
                     break;
                 }
-                g_ListAdapters = true;
+                options.ListAdapters = true;
+                break;
+            case CMD_LINE_OPT_LIST_VENDOR_DATA:
+                options.ListVendorData = true;
                 break;
             case CMD_LINE_OPT_ADAPTER:
                 if(cmdLineParser.IsOptEncountered(CMD_LINE_OPT_LIST) ||
                     cmdLineParser.IsOptEncountered(CMD_LINE_OPT_ALL_ADAPTERS) ||
                     cmdLineParser.IsOptEncountered(CMD_LINE_OPT_WARP))
                 {
-                    g_ShowCommandLineSyntaxAndFail = true;
+                    options.ShowCommandLineSyntaxAndFail = true;
                     break;
                 }
-                g_ShowAllAdapters = false;
-                adapterIndex = _wtoi(cmdLineParser.GetParameter().c_str());
+                options.ShowAllAdapters = false;
+                options.AdapterIndex = _wtoi(cmdLineParser.GetParameter().c_str());
                 break;
             case CMD_LINE_OPT_ALL_ADAPTERS:
                 if(cmdLineParser.IsOptEncountered(CMD_LINE_OPT_LIST) ||
                     cmdLineParser.IsOptEncountered(CMD_LINE_OPT_ADAPTER) ||
                     cmdLineParser.IsOptEncountered(CMD_LINE_OPT_WARP))
                 {
-                    g_ShowCommandLineSyntaxAndFail = true;
+                    options.ShowCommandLineSyntaxAndFail = true;
                     break;
                 }
-                g_ShowAllAdapters = true;
-                g_SkipSoftwareAdapter = false;
-                adapterIndex = UINT32_MAX;
+                options.ShowAllAdapters = true;
+                options.SkipSoftwareAdapter = false;
+                options.AdapterIndex = UINT32_MAX;
                 break;
             case CMD_LINE_OPT_JSON:
-                g_UseJsonOutput = true;
+                options.UseJsonOutput = true;
                 break;
             case CMD_LINE_OPT_MINIMIZE_JSON:
-                g_UseJsonPrettyPrint = false;
+                options.UseJsonPrettyPrint = false;
+                break;
+            case CMD_LINE_OPT_FLAT:
+                // Paths are made of names from the JSON report.
+                options.UseJsonOutput = true;
+                options.UseFlatOutput = true;
                 break;
             case CMD_LINE_OPT_OUTPUT_TO_FILE:
-                g_OutputFile = true;
-                g_OutputFilePath = cmdLineParser.GetParameter();
+                options.OutputFile = true;
+                options.OutputFilePath = cmdLineParser.GetParameter();
                 break;
             case CMD_LINE_OPT_FORMATS:
-                g_PrintFormats = true;
+                options.PrintFormats = true;
                 break;
             case CMD_LINE_OPT_META_COMMANDS:
-                g_PrintMetaCommands = true;
+                options.PrintMetaCommands = true;
                 break;
             case CMD_LINE_OPT_ENUMS:
-                g_PrintEnums = true;
+                options.PrintEnums = true;
                 break;
             case CMD_LINE_OPT_PURE_D3D12:
                 if(cmdLineParser.IsOptEncountered(CMD_LINE_OPT_FORCE_VENDOR_SPECIFIC))
                 {
-                    g_ShowCommandLineSyntaxAndFail = true;
+                    options.ShowCommandLineSyntaxAndFail = true;
                     break;
                 }
-                g_PureD3D12 = true;
+                options.PureD3D12 = true;
                 break;
             case CMD_LINE_OPT_ENABLE_EXPERIMENTAL: {
                 std::wstring param = cmdLineParser.GetParameter();
@@ -2030,67 +1645,194 @@ int wmain3(int argc, wchar_t** argv)
                 bool isOff = ::_wcsicmp(param.c_str(), L"off") == 0;
                 if(!isOn && !isOff)
                 {
-                    g_ShowCommandLineSyntaxAndFail = true;
+                    options.ShowCommandLineSyntaxAndFail = true;
                     break;
                 }
-                g_EnableExperimental = isOn;
+                options.EnableExperimental = isOn;
             }
             break;
             case CMD_LINE_OPT_FORCE_VENDOR_SPECIFIC:
                 if(cmdLineParser.IsOptEncountered(CMD_LINE_OPT_PURE_D3D12))
                 {
-                    g_ShowCommandLineSyntaxAndFail = true;
+                    options.ShowCommandLineSyntaxAndFail = true;
                     break;
                 }
-                g_ForceVendorAPI = true;
+                options.ForceVendorAPI = true;
                 break;
             case CMD_LINE_OPT_WARP:
                 if(cmdLineParser.IsOptEncountered(CMD_LINE_OPT_LIST) ||
                     cmdLineParser.IsOptEncountered(CMD_LINE_OPT_ADAPTER) ||
                     cmdLineParser.IsOptEncountered(CMD_LINE_OPT_ALL_ADAPTERS))
                 {
-                    g_ShowCommandLineSyntaxAndFail = true;
+                    options.ShowCommandLineSyntaxAndFail = true;
+                    break;
+                }
+                options.WARP = true;
+                break;
+            case CMD_LINE_OPT_CACHE:
+                options.UseCache = !cmdLineParser.IsOptEncountered(CMD_LINE_OPT_NO_CACHE);
+                break;
+            case CMD_LINE_OPT_NO_CACHE:
+                options.UseCache = false;
+                break;
+            case CMD_LINE_OPT_CLEAR_CACHE:
+                options.ClearCache = true;
+                break;
+            case CMD_LINE_OPT_BASELINE:
+                options.BaselineFilePath = cmdLineParser.GetParameter();
+                // Baseline can only be compared with a report in the same format.
+                options.UseJsonOutput = true;
+                break;
+            case CMD_LINE_OPT_TIMINGS:
+                options.PrintTimings = true;
+                break;
+            case CMD_LINE_OPT_TRACE:
+                options.TraceFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_TIMEOUT:
+                options.TimeoutSeconds = uint32_t(_wtoi(cmdLineParser.GetParameter().c_str()));
+                break;
+            case CMD_LINE_OPT_PROBE_TIMEOUT:
+                options.ProbeTimeoutMilliseconds = uint32_t(_wtoi(cmdLineParser.GetParameter().c_str()));
+                break;
+            case CMD_LINE_OPT_RECORD:
+                if(cmdLineParser.IsOptEncountered(CMD_LINE_OPT_REPLAY))
+                {
+                    options.ShowCommandLineSyntaxAndFail = true;
+                    break;
+                }
+                options.RecordFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_REPLAY:
+                if(cmdLineParser.IsOptEncountered(CMD_LINE_OPT_RECORD))
+                {
+                    options.ShowCommandLineSyntaxAndFail = true;
                     break;
                 }
-                g_WARP = true;
+                options.ReplayFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_APPEND_TO_ARCHIVE:
+                options.ArchiveFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_RAW:
+                options.RawFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_DECODE_RAW:
+                options.DecodeRawFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_RENDER_DIR:
+                options.RenderDirectoryPath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_QUIRKS:
+                options.QuirksFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_SELECT:
+                if(!options.SelectPaths.empty())
+                    options.SelectPaths += L',';
+                options.SelectPaths += cmdLineParser.GetParameter();
+                // Paths are made of names from the JSON report.
+                options.UseJsonOutput = true;
+                break;
+            case CMD_LINE_OPT_BATCH:
+                options.BatchFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_SERVE:
+                options.Serve = true;
+                break;
+            case CMD_LINE_OPT_PUBLISH:
+                options.PublishName = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_PUBLISH_INTERVAL:
+                options.PublishIntervalSeconds = _wtoi(cmdLineParser.GetParameter().c_str());
+                break;
+            case CMD_LINE_OPT_MONITOR:
+                options.MonitorIntervalMilliseconds = _wtoi(cmdLineParser.GetParameter().c_str());
+                if(options.MonitorIntervalMilliseconds == 0)
+                    options.ShowCommandLineSyntaxAndFail = true;
+                break;
+            case CMD_LINE_OPT_MONITOR_NVAPI:
+                options.MonitorNvApiIntervalMilliseconds = _wtoi(cmdLineParser.GetParameter().c_str());
+                if(options.MonitorNvApiIntervalMilliseconds == 0)
+                    options.ShowCommandLineSyntaxAndFail = true;
+                break;
+            case CMD_LINE_OPT_METRICS:
+                options.MetricsPort = _wtoi(cmdLineParser.GetParameter().c_str());
+                if(options.MetricsPort == 0 || options.MetricsPort > UINT16_MAX)
+                    options.ShowCommandLineSyntaxAndFail = true;
+                break;
+            case CMD_LINE_OPT_METRICS_FILE:
+                options.MetricsFilePath = cmdLineParser.GetParameter();
+                break;
+            case CMD_LINE_OPT_METRICS_INTERVAL:
+                options.MetricsIntervalSeconds = _wtoi(cmdLineParser.GetParameter().c_str());
+                if(options.MetricsIntervalSeconds == 0)
+                    options.ShowCommandLineSyntaxAndFail = true;
+                break;
+            case CMD_LINE_OPT_WATCH:
+                options.Watch = true;
+                break;
+            case CMD_LINE_OPT_BENCHMARK:
+                options.BenchmarkRunCount = _wtoi(cmdLineParser.GetParameter().c_str());
+                if(options.BenchmarkRunCount == 0)
+                    options.ShowCommandLineSyntaxAndFail = true;
+                break;
+            case CMD_LINE_OPT_STATS:
+                options.PrintStats = true;
                 break;
             default:
-                g_ShowCommandLineSyntaxAndFail = true;
+                options.ShowCommandLineSyntaxAndFail = true;
                 break;
             }
             break;
         default:
             assert(0);
-            g_ShowCommandLineSyntaxAndFail = true;
+            options.ShowCommandLineSyntaxAndFail = true;
             break;
         }
     }
 
-    if(g_ShowCommandLineSyntaxAndFail)
+    // Differences are printed as JSON Patch.
+    if(options.UseFlatOutput && !options.BaselineFilePath.empty())
+        options.ShowCommandLineSyntaxAndFail = true;
+
+    // Options of the jobs can't be given next to --Batch or --Serve.
+    if(!batchJob && (!options.BatchFilePath.empty() || options.Serve))
     {
-        PrinterScope scope(false, {});
-        PrintCommandLineSyntax<ErrorPrinter>();
-        return PROGRAM_EXIT_ERROR_COMMAND_LINE;
+        for(uint32_t optId = 0; optId < CMD_LINE_OPT_COUNT; ++optId)
+        {
+            if(!IsBatchOpt(optId) && cmdLineParser.IsOptEncountered(optId))
+                options.ShowCommandLineSyntaxAndFail = true;
+        }
     }
+}
 
-    g_PrintAdaptersAsArray = g_ShowAllAdapters || g_UseJsonOutput;
-
-    PrinterScope printerScope(g_OutputFile, g_OutputFilePath);
-
+static ReportFormatter::FLAGS GetReportFormatterFlags()
+{
     ReportFormatter::FLAGS flags = ReportFormatter::FLAGS::FLAG_NONE;
 
-    if(g_UseJsonOutput)
+    if(g_Options.UseJsonOutput)
     {
         flags |= ReportFormatter::FLAGS::FLAG_JSON;
     }
-    if(g_UseJsonPrettyPrint)
+    if(g_Options.UseJsonPrettyPrint)
     {
         flags |= ReportFormatter::FLAGS::FLAG_JSON_PRETTY_PRINT;
     }
+    if(g_Options.UseFlatOutput)
+    {
+        flags |= ReportFormatter::FLAGS::FLAG_FLAT;
+    }
+    return flags;
+}
 
-    ReportFormatterScope formatterScope(flags);
+// Prints what the program was asked for with g_Options to the report formatter of this thread, which must exist.
+static int PrintRequestedReport(VendorApis& vendorApis)
+{
+    // Created after the formatter, so it stops before the report is closed.
+    WatchdogScope watchdogScope(
+        std::chrono::seconds(g_Options.TimeoutSeconds), std::chrono::milliseconds(g_Options.ProbeTimeoutMilliseconds));
 
-    if(g_ShowVersionAndQuit)
+    if(g_Options.ShowVersionAndQuit)
     {
         if(IsTextOutput())
         {
@@ -2098,147 +1840,762 @@ int wmain3(int argc, wchar_t** argv)
         }
         else
         {
-            PrintVersionData();
+            PrintVersionData(nullptr);
         }
         return PROGRAM_EXIT_SUCCESS;
     }
 
-    if(g_ShowCommandLineSyntaxAndQuit)
+    if(g_Options.ShowCommandLineSyntaxAndQuit)
     {
         PrintCommandLineSyntax<Printer>();
         return PROGRAM_EXIT_SUCCESS;
     }
 
-    PrintVersionData();
+    if(!g_Options.DecodeRawFilePath.empty())
+        return PrintRawFeatureDataReport();
 
-#if !defined(AUTO_LINK_DX12)
-    if(!LoadLibraries())
-        throw std::runtime_error("Could not load DXGI & D3D12 libraries.");
-#endif
+    return PrintReport(vendorApis);
+}
 
-    std::unique_ptr<NvAPI_Inititalize_RAII> nvApiObjPtr;
-#if USE_NVAPI
-    if(!g_PureD3D12)
-        nvApiObjPtr = std::make_unique<NvAPI_Inititalize_RAII>();
-#endif
+// Prints what the program was asked for with g_Options to the output, which must be open.
+static int RunReport(VendorApis& vendorApis)
+{
+    g_PrintAdaptersAsArray = g_Options.ShowAllAdapters || g_Options.UseJsonOutput;
 
-    std::unique_ptr<AGS_Initialize_RAII> agsObjPtr;
-#if USE_AGS
-    if(!g_PureD3D12)
-        agsObjPtr = std::make_unique<AGS_Initialize_RAII>();
-#endif
+    ReportSelection::Clear();
+    if(!g_Options.SelectPaths.empty())
+        ReportSelection::Add(g_Options.SelectPaths);
 
-    std::unique_ptr<AmdDeviceInfo_Initialize_RAII> amdDeviceInfoObjPtr;
-#if USE_AMD_DEVICE_INFO
-    if(!g_PureD3D12)
-        amdDeviceInfoObjPtr = std::make_unique<AmdDeviceInfo_Initialize_RAII>();
-#endif
+    const ReportFormatter::FLAGS flags = GetReportFormatterFlags();
 
-    std::unique_ptr<Vulkan_Initialize_RAII> vkObjPtr;
-#if USE_VULKAN
-    if(!g_PureD3D12)
-        vkObjPtr = std::make_unique<Vulkan_Initialize_RAII>();
-#endif
+    if(!g_Options.BaselineFilePath.empty() && !g_Options.ShowVersionAndQuit &&
+        !g_Options.ShowCommandLineSyntaxAndQuit)
+        return PrintDeltaReport(flags, vendorApis);
+
+    ReportFormatterScope formatterScope(flags);
+    return PrintRequestedReport(vendorApis);
+}
+
+// Runs a job for each line of the batch file, with options given on that line, as if the program was launched
+// with them. The libraries, vendor APIs and D3D12 devices are loaded, initialized and created only once for all jobs.
+static int RunBatch(VendorApis& vendorApis)
+{
+    const ProgramOptions batchOptions = g_Options;
+
+    // All lines are parsed first, so an invalid one is reported before any job runs.
+    std::vector<ProgramOptions> jobs;
+    std::vector<size_t> jobLineNumbers;
+    const std::wstring batchText = LoadTextFile(batchOptions.BatchFilePath);
+    size_t lineNumber = 0;
+    for(size_t lineBegin = 0; lineBegin < batchText.length();)
+    {
+        const size_t lineEnd = std::min(batchText.find(L'\n', lineBegin), batchText.length());
+        std::wstring line = batchText.substr(lineBegin, lineEnd - lineBegin);
+        lineBegin = lineEnd + 1;
+        ++lineNumber;
+
+        while(!line.empty() && iswspace(line.back()))
+            line.pop_back();
+        const size_t optionsBegin = line.find_first_not_of(L" \t");
+        // Empty lines and lines starting with '#' are skipped.
+        if(optionsBegin == std::wstring::npos || line[optionsBegin] == L'#')
+            continue;
 
-    SetApplicationIdentity();
+        // Jobs start with the options of the whole batch.
+        ProgramOptions& job = jobs.emplace_back(batchOptions);
+        jobLineNumbers.push_back(lineNumber);
+        job.BatchFilePath.clear();
+        // The cache is cleared only once, before the first job.
+        job.ClearCache = false;
+        CmdLineParser cmdLineParser(line.c_str());
+        ParseCommandLine(cmdLineParser, true, job);
+        if(job.ShowCommandLineSyntaxAndFail)
+            throw std::runtime_error(std::format("Invalid options in line {} of the batch file.", lineNumber));
+    }
+
+    if(batchOptions.ClearCache)
+        ReportCache(GetReportCacheDirectory()).Clear();
 
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    size_t failedCount = 0;
+    for(size_t jobIndex = 0; jobIndex < jobs.size(); ++jobIndex)
     {
-        ReportScopeObject scope(SelectString(L"System Info", L"SystemInfo"));
+        g_Options = jobs[jobIndex];
+        if(g_Options.PrintTimings)
+            ProbeTimings::Clear();
 
-        if(!g_PureD3D12)
+        int jobResult = PROGRAM_EXIT_SUCCESS;
+        try
+        {
+            PrinterScope printerScope(g_Options.OutputFile, g_Options.OutputFilePath);
+            jobResult = RunReport(vendorApis);
+        }
+        catch(const std::exception& ex)
         {
-            PrintOsVersionInfo();
-            PrintSystemMemoryInfo();
+            const char* errorMessage = ex.what();
+            ErrorPrinter::PrintFormat("ERROR in line {} of the batch file: {}\n",
+                std::make_format_args(jobLineNumbers[jobIndex], errorMessage));
+            jobResult = PROGRAM_EXIT_ERROR_EXCEPTION;
         }
+        if(jobResult != PROGRAM_EXIT_SUCCESS)
+            ++failedCount;
+    }
+    g_Options = batchOptions;
 
-        PrintDXGIFeatureInfo();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    const size_t jobCount = jobs.size();
+    // Jobs without an output file print to the console, so the summary goes after them.
+    PrinterScope printerScope(false, {});
+    Printer::PrintFormat(
+        L"Ran {} jobs, {} failed, in {:.2f} s.\n", std::make_wformat_args(jobCount, failedCount, seconds));
 
-#if USE_NVAPI
-        if(nvApiObjPtr && nvApiObjPtr->IsInitialized())
-            nvApiObjPtr->PrintData();
-#endif
-#if USE_AGS
-        if(agsObjPtr && agsObjPtr->IsInitialized())
-            agsObjPtr->PrintData();
-#endif
+    return failedCount == 0 ? PROGRAM_EXIT_SUCCESS : PROGRAM_EXIT_ERROR_EXCEPTION;
+}
 
-        EnableExperimentalFeatures();
+// Prints the report asked for with g_Options as minimized JSON and returns it instead of writing it to the output.
+static std::wstring PrintReportToString(VendorApis& vendorApis)
+{
+    g_Options.UseJsonOutput = true;
+    g_Options.UseJsonPrettyPrint = false;
+    g_Options.UseFlatOutput = false;
 
-        DetectTranslationLayersGlobal();
+    std::wstring report;
+    int result;
+    {
+        // Own output of this thread, so a capture left open by an exception is dropped with it.
+        PrinterThreadScope printerScope(false, {});
+        Printer::BeginCapture(false);
+        result = RunReport(vendorApis);
+        report = Printer::EndCapture();
     }
+    if(result != PROGRAM_EXIT_SUCCESS)
+        throw std::runtime_error("Printing the report failed.");
 
-    if(g_PrintEnums)
-        PrintEnums();
+    while(!report.empty() && iswspace(report.back()))
+        report.pop_back();
+    return report;
+}
 
-    int programResult = PROGRAM_EXIT_SUCCESS;
+// Prints the report for a request of --Serve and returns it as minimized JSON.
+static std::wstring PrintServerReport(
+    const std::wstring& options, const ProgramOptions& serverOptions, VendorApis& vendorApis)
+{
+    g_Options = serverOptions;
+    g_Options.Serve = false;
+    CmdLineParser cmdLineParser(options.c_str());
+    ParseCommandLine(cmdLineParser, true, g_Options);
+    // The report is the result, so it can't go to a file.
+    if(g_Options.ShowCommandLineSyntaxAndFail || g_Options.OutputFile)
+        throw JsonRpcError(JSON_RPC_ERROR_INVALID_PARAMS, "Invalid options.");
+    // Reports are kept in memory by the server instead.
+    g_Options.UseCache = false;
+    return PrintReportToString(vendorApis);
+}
 
-    // Scope for COM objects.
+// Answers JSON-RPC requests read from the standard input, one per line, until it ends or "shutdown" is requested.
+// Libraries, vendor APIs and D3D12 devices stay alive between requests, and a report asked for again with the same
+// options is answered from memory, as capabilities don't change while the program runs.
+static int RunServer(VendorApis& vendorApis)
+{
+    // Prints the reports with the options of the server, changed by the options of the request.
+    class ReportSource : public JsonRpcReportSource
     {
-        ComPtr<IDXGIFactory4> dxgiFactory = nullptr;
-#if defined(AUTO_LINK_DX12)
-        CHECK_HR(::CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
-#else
-        CHECK_HR(g_CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
-#endif
-        assert(dxgiFactory != nullptr);
+    public:
+        ReportSource(VendorApis& vendorApis)
+            : m_VendorApis(vendorApis)
+            , m_ServerOptions(g_Options)
+        {
+        }
+        std::wstring PrintReport(const std::wstring& options) override
+        {
+            return PrintServerReport(options, m_ServerOptions, m_VendorApis);
+        }
 
-        ReportScopeArrayConditional scopeArray(
-            g_PrintAdaptersAsArray, SelectString(L"Adapter", L"Adapters"), ReportFormatter::ARRAY_SUFFIX_NONE);
-        ReportScopeObjectConditional scopeObject(!g_PrintAdaptersAsArray, L"Adapter");
+    private:
+        VendorApis& m_VendorApis;
+        const ProgramOptions m_ServerOptions;
+    };
+
+    const ProgramOptions serverOptions = g_Options;
+    ReportSource reportSource(vendorApis);
+    JsonRpcServer server(reportSource);
+
+    PrinterScope printerScope(false, {});
+    std::string line;
+    while(!server.IsShutDown() && std::getline(std::cin, line))
+    {
+        const std::wstring response = server.HandleLine(line);
+        g_Options = serverOptions;
+        // New line flushes the output, so the client gets the response right away.
+        if(!response.empty())
+        {
+            Printer::PrintString(response);
+            Printer::PrintNewLine();
+        }
+    }
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+// Writes the report to shared memory, where other processes can read it with SharedSnapshot::Reader, and keeps
+// the program running, as the shared memory exists only as long as it does. With --PublishInterval, the report is
+// printed and written again after each interval, e.g. to update the current video memory usage.
+static int RunPublisher(VendorApis& vendorApis)
+{
+    // Space for reports printed later to grow, e.g. when an adapter is added.
+    static const uint64_t MIN_CAPACITY = 1024 * 1024;
+
+    const ProgramOptions publisherOptions = g_Options;
+    PrinterScope printerScope(false, {});
+    std::unique_ptr<SharedSnapshot::Writer> writer;
+    while(true)
+    {
+        g_Options = publisherOptions;
+        // Printed again each time, so values that change are current.
+        g_Options.UseCache = false;
+        const std::string report = WstrToStr(PrintReportToString(vendorApis).c_str(), CP_UTF8);
+
+        if(!writer)
+        {
+            writer = std::make_unique<SharedSnapshot::Writer>(
+                publisherOptions.PublishName, std::max<uint64_t>(report.size() * 2, MIN_CAPACITY));
+            const std::wstring& name = publisherOptions.PublishName;
+            Printer::PrintFormat(L"Published the report to shared memory {}. Press Ctrl+C to stop.\n",
+                std::make_wformat_args(name));
+        }
+        writer->Write(report);
 
-        if(g_ListAdapters)
-            ListAdapters(
-                dxgiFactory.Get(), nvApiObjPtr.get(), agsObjPtr.get(), amdDeviceInfoObjPtr.get(), vkObjPtr.get());
+        if(publisherOptions.PublishIntervalSeconds == 0)
+            Sleep(INFINITE);
         else
+            Sleep(publisherOptions.PublishIntervalSeconds * 1000);
+    }
+}
+
+// Queries IDXGIAdapter3::QueryVideoMemoryInfo of the adapters, given with their indices.
+static MemoryMonitor::QueryFunc MakeVideoMemoryQueryFunc(
+    std::vector<uint32_t> adapterIndices, std::vector<ComPtr<IDXGIAdapter3>> adapters)
+{
+    // There are only a few adapters, so each query searches for its index.
+    return [adapterIndices = std::move(adapterIndices), adapters = std::move(adapters)](
+               uint32_t adapterIndex, uint32_t segmentGroup, VideoMemoryInfo& outInfo) {
+        const size_t i =
+            std::find(adapterIndices.begin(), adapterIndices.end(), adapterIndex) - adapterIndices.begin();
+        DXGI_QUERY_VIDEO_MEMORY_INFO info = {};
+        if(FAILED(adapters[i]->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP(segmentGroup), &info)))
+            return false;
+        outInfo = { info.Budget, info.CurrentUsage, info.AvailableForReservation, info.CurrentReservation };
+        return true;
+    };
+}
+
+// Samples video memory of the adapter chosen by --Adapter, or of all adapters, until stopped by Ctrl+C. Only DXGI is
+// used, so D3D12 devices and vendor APIs don't add to the usage being measured.
+static int RunMonitor()
+{
+#if !defined(AUTO_LINK_DX12)
+    if(!LoadLibraries(false))
+        throw std::runtime_error("Could not load DXGI library.");
+#endif
+
+    std::vector<uint32_t> adapterIndices;
+    std::vector<ComPtr<IDXGIAdapter3>> adapters;
+    ComPtr<IDXGIFactory4> dxgiFactory = CreateDxgiFactory();
+    ComPtr<IDXGIAdapter1> adapter1;
+    for(UINT adapterIndex = 0; dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND;
+        ++adapterIndex)
+    {
+        ComPtr<IDXGIAdapter3> adapter3;
+        if((g_Options.AdapterIndex == UINT32_MAX || g_Options.AdapterIndex == adapterIndex) &&
+            SUCCEEDED(adapter1->QueryInterface(IID_PPV_ARGS(&adapter3))))
         {
-            if(g_WARP)
-                InspectAdapter(dxgiFactory.Get(), nvApiObjPtr.get(), agsObjPtr.get(), amdDeviceInfoObjPtr.get(),
-                    vkObjPtr.get(), UINT32_MAX);
-            else if(!g_ShowAllAdapters)
-                InspectAdapter(dxgiFactory.Get(), nvApiObjPtr.get(), agsObjPtr.get(), amdDeviceInfoObjPtr.get(),
-                    vkObjPtr.get(), adapterIndex);
-            else
-                InspectAllAdapters(
-                    dxgiFactory.Get(), nvApiObjPtr.get(), agsObjPtr.get(), amdDeviceInfoObjPtr.get(), vkObjPtr.get());
+            adapterIndices.push_back(adapterIndex);
+            adapters.push_back(std::move(adapter3));
         }
+        adapter1.Reset();
+    }
+    if(adapters.empty())
+        throw std::runtime_error("No adapter supports querying video memory info.");
+
+    MemoryMonitor monitor(adapterIndices, MakeVideoMemoryQueryFunc(adapterIndices, std::move(adapters)),
+        std::chrono::milliseconds(g_Options.MonitorIntervalMilliseconds), g_Options.UseJsonOutput);
+    {
+        PrinterScope printerScope(g_Options.OutputFile, g_Options.OutputFilePath);
+        monitor.Run();
     }
 
+    // The summary goes to the console even if the samples go to a file.
+    PrinterScope printerScope(false, {});
+    ReportFormatterScope formatterScope(GetReportFormatterFlags());
+    monitor.PrintSummary();
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+// Serves metrics of the adapter chosen by --Adapter, or of all adapters, over HTTP or writes them to a file after each
+// interval, until the program is stopped. Only DXGI is used, so it's cheap enough to be scraped often.
+static int RunMetricsExporter()
+{
+    static const uint32_t DEFAULT_INTERVAL_SECONDS = 15;
+
 #if !defined(AUTO_LINK_DX12)
-    UnloadLibraries();
+    if(!LoadLibraries(false))
+        throw std::runtime_error("Could not load DXGI library.");
 #endif
 
-    return programResult;
+    std::vector<OpenMetricsExporter::Adapter> adapters;
+    std::vector<uint32_t> adapterIndices;
+    std::vector<ComPtr<IDXGIAdapter3>> dxgiAdapters;
+    ComPtr<IDXGIFactory4> dxgiFactory = CreateDxgiFactory();
+    ComPtr<IDXGIAdapter1> adapter1;
+    for(UINT adapterIndex = 0; dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND;
+        ++adapterIndex)
+    {
+        ComPtr<IDXGIAdapter3> adapter3;
+        if((g_Options.AdapterIndex == UINT32_MAX || g_Options.AdapterIndex == adapterIndex) &&
+            SUCCEEDED(adapter1->QueryInterface(IID_PPV_ARGS(&adapter3))))
+        {
+            DXGI_ADAPTER_DESC1 desc = {};
+            CHECK_HR(adapter3->GetDesc1(&desc));
+            OpenMetricsExporter::Adapter& adapter = adapters.emplace_back();
+            adapter.m_Index = adapterIndex;
+            adapter.m_Description = desc.Description;
+            adapter.m_VendorId = desc.VendorId;
+            adapter.m_DeviceId = desc.DeviceId;
+            adapter.m_SubSysId = desc.SubSysId;
+            adapter.m_Revision = desc.Revision;
+            adapter.m_DedicatedVideoMemory = desc.DedicatedVideoMemory;
+            adapter.m_DedicatedSystemMemory = desc.DedicatedSystemMemory;
+            adapter.m_SharedSystemMemory = desc.SharedSystemMemory;
+            adapter.m_Software = (desc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) != 0;
+            if(LARGE_INTEGER umdVersion;
+                SUCCEEDED(adapter3->CheckInterfaceSupport(__uuidof(IDXGIDevice), &umdVersion)))
+                adapter.m_DriverVersion = uint64_t(umdVersion.QuadPart);
+            adapterIndices.push_back(adapterIndex);
+            dxgiAdapters.push_back(std::move(adapter3));
+        }
+        adapter1.Reset();
+    }
+    if(adapters.empty())
+        throw std::runtime_error("No adapter supports querying video memory info.");
+
+    OpenMetricsExporter exporter(
+        std::move(adapters), MakeVideoMemoryQueryFunc(std::move(adapterIndices), std::move(dxgiAdapters)));
+    PrinterScope printerScope(false, {});
+    if(g_Options.MetricsPort != 0)
+    {
+        OpenMetricsServer server(uint16_t(g_Options.MetricsPort));
+        const uint32_t port = g_Options.MetricsPort;
+        Printer::PrintFormat(
+            L"Serving metrics on http://127.0.0.1:{}/metrics. Press Ctrl+C to stop.\n", std::make_wformat_args(port));
+        server.Run(exporter);
+    }
+
+    const uint32_t intervalSeconds =
+        g_Options.MetricsIntervalSeconds != 0 ? g_Options.MetricsIntervalSeconds : DEFAULT_INTERVAL_SECONDS;
+    const std::wstring& filePath = g_Options.MetricsFilePath;
+    Printer::PrintFormat(L"Writing metrics to {} every {} s. Press Ctrl+C to stop.\n",
+        std::make_wformat_args(filePath, intervalSeconds));
+    while(true)
+    {
+        WriteOpenMetricsFile(exporter, g_Options.MetricsFilePath);
+        Sleep(intervalSeconds * 1000);
+    }
+}
+
+// Adapters enumerated with DXGI. Waits for IDXGIFactory7::RegisterAdaptersChangedEvent, without polling.
+class DxgiAdapterSource : public AdapterWatcher::Source
+{
+public:
+    DxgiAdapterSource(CtrlCScope& ctrlCScope)
+        : m_CtrlCScope(ctrlCScope)
+    {
+        m_ChangedEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if(m_ChangedEvent == NULL)
+            throw std::runtime_error("CreateEvent failed.");
+    }
+    ~DxgiAdapterSource()
+    {
+        if(m_Factory)
+            m_Factory->UnregisterAdaptersChangedEvent(m_Cookie);
+        CloseHandle(m_ChangedEvent);
+    }
+
+    std::vector<WatchedAdapter> GetAdapters() override
+    {
+        // A factory created before the change still enumerates the adapters from before it.
+        if(!m_Factory || !m_Factory->IsCurrent())
+        {
+            if(m_Factory)
+                m_Factory->UnregisterAdaptersChangedEvent(m_Cookie);
+            m_Factory.Reset();
+            // Registered before enumerating, so a change in between is not missed.
+            if(FAILED(CreateDxgiFactory().As(&m_Factory)))
+                throw std::runtime_error("IDXGIFactory7 is not supported by this version of Windows.");
+            CHECK_HR(m_Factory->RegisterAdaptersChangedEvent(m_ChangedEvent, &m_Cookie));
+        }
+
+        std::vector<WatchedAdapter> adapters;
+        ComPtr<IDXGIAdapter1> adapter1;
+        for(UINT i = 0; m_Factory->EnumAdapters1(i, &adapter1) != DXGI_ERROR_NOT_FOUND; ++i)
+        {
+            DXGI_ADAPTER_DESC1 desc = {};
+            adapter1->GetDesc1(&desc);
+            WatchedAdapter& adapter = adapters.emplace_back();
+            adapter.m_Luid = uint64_t(uint32_t(desc.AdapterLuid.HighPart)) << 32 | desc.AdapterLuid.LowPart;
+            adapter.m_VendorId = desc.VendorId;
+            adapter.m_DeviceId = desc.DeviceId;
+            adapter.m_SubSysId = desc.SubSysId;
+            adapter.m_Revision = desc.Revision;
+            LARGE_INTEGER umdVersion;
+            if(SUCCEEDED(adapter1->CheckInterfaceSupport(__uuidof(IDXGIDevice), &umdVersion)))
+                adapter.m_UMDVersion = uint64_t(umdVersion.QuadPart);
+            adapter.m_Description = desc.Description;
+            adapter1.Reset();
+        }
+        return adapters;
+    }
+
+    bool WaitForChange() override
+    {
+        return !m_CtrlCScope.Wait(m_ChangedEvent, std::chrono::milliseconds(INFINITE));
+    }
+
+private:
+    CtrlCScope& m_CtrlCScope;
+    HANDLE m_ChangedEvent = NULL;
+    ComPtr<IDXGIFactory7> m_Factory;
+    DWORD m_Cookie = 0;
+};
+
+// Prints a line of NDJSON for all adapters at the start and then for each adapter added, removed or changed, e.g.
+// by a driver update, until stopped by Ctrl+C. Only the adapters added or changed are inspected again, with the
+// report options given next to --Watch.
+static int RunWatcher(VendorApis& vendorApis)
+{
+#if !defined(AUTO_LINK_DX12)
+    if(!LoadLibraries(false))
+        throw std::runtime_error("Could not load DXGI library.");
+#endif
+
+    const ProgramOptions watcherOptions = g_Options;
+    PrinterScope printerScope(watcherOptions.OutputFile, watcherOptions.OutputFilePath);
+    CtrlCScope ctrlCScope;
+    DxgiAdapterSource source(ctrlCScope);
+    AdapterWatcher watcher(source, [&](uint32_t adapterIndex, const WatchedAdapter& adapter) {
+        g_Options = watcherOptions;
+        g_Options.Watch = false;
+        g_Options.ShowAllAdapters = false;
+        g_Options.AdapterIndex = adapterIndex;
+        // System Info is the same for all adapters.
+        if(g_Options.SelectPaths.empty())
+            g_Options.SelectPaths = L"Adapters";
+        // The device kept for an adapter of the same LUID was created before the change.
+        const LUID luid = { .LowPart = DWORD(adapter.m_Luid), .HighPart = LONG(adapter.m_Luid >> 32) };
+        g_Devices.erase(LuidToStr(luid));
+        return PrintReportToString(vendorApis);
+    });
+    watcher.Run();
+    return PROGRAM_EXIT_SUCCESS;
 }
 
-int wmain2(int argc, wchar_t** argv)
+// Prints the report asked for with the other options --Benchmark times after a warm-up run, without printing it,
+// and prints latencies of creating the devices, of the groups of probes, of each format and of rendering the report
+// as JSON instead.
+static int RunBenchmark(VendorApis& vendorApis)
 {
-    try
+    // Loads the libraries, initializes vendor APIs and fills caches of the driver, which happens only once.
+    static const uint32_t WARM_UP_RUN_COUNT = 1;
+
+    const ProgramOptions benchmarkOptions = g_Options;
+    // Rendering is measured in the format asked for, but the results are always JSON.
+    const ReportFormatter::FLAGS renderFlags = GetReportFormatterFlags();
+    Benchmark::Start(benchmarkOptions.BenchmarkRunCount);
+    for(uint32_t runIndex = 0; runIndex < WARM_UP_RUN_COUNT + benchmarkOptions.BenchmarkRunCount; ++runIndex)
     {
-        return wmain3(argc, argv);
+        g_Options = benchmarkOptions;
+        g_Options.BenchmarkRunCount = 0;
+        g_Options.UseCache = false;
+        // Otherwise the device kept from the previous run would be used and its creation never measured again.
+        g_Devices.clear();
+
+        Benchmark::BeginRun(runIndex < WARM_UP_RUN_COUNT);
+        // Printing the report is part of the probes, as both are interleaved. To measure printing alone, the
+        // report is rendered once more from its JSON.
+        const JsonValue report = ParseJson(PrintReportToString(vendorApis));
+        {
+            PrinterThreadScope printerScope(false, {});
+            Printer::BeginCapture(false);
+            {
+                BenchmarkScope benchmarkScope(L"Report", Benchmark::Kind::Rendering);
+                ReportFormatterThreadScope formatterScope(renderFlags);
+                RenderJsonReport(report);
+            }
+            Printer::EndCapture();
+        }
+        Benchmark::EndRun();
     }
-    catch(const std::exception& ex)
+
+    g_Options = benchmarkOptions;
+    ReportFormatter::FLAGS flags = ReportFormatter::FLAGS::FLAG_JSON;
+    if(g_Options.UseJsonPrettyPrint)
+        flags |= ReportFormatter::FLAGS::FLAG_JSON_PRETTY_PRINT;
+    PrinterScope printerScope(g_Options.OutputFile, g_Options.OutputFilePath);
+    ReportFormatterScope formatterScope(flags);
+    Benchmark::PrintReport(WARM_UP_RUN_COUNT);
+    return PROGRAM_EXIT_SUCCESS;
+}
+
+#if USE_NVAPI
+// Prints how counters of NVIDIA GPUs, or the one chosen by --Adapter, changed during each interval, until stopped by
+// Ctrl+C. D3D12 devices are not created.
+static int RunNvApiMonitor(VendorApis& vendorApis)
+{
+#if !defined(AUTO_LINK_DX12)
+    if(!LoadLibraries(false))
+        throw std::runtime_error("Could not load DXGI library.");
+#endif
+
+    vendorApis.SetOptions(true, g_Options.ForceVendorAPI);
+    std::vector<uint32_t> adapterIndices;
+    std::vector<LUID> adapterLuids;
     {
-        const char* errorMessage = ex.what();
-        ErrorPrinter::PrintFormat("ERROR: {}\n", std::make_format_args(errorMessage));
-        return PROGRAM_EXIT_ERROR_EXCEPTION;
+        ComPtr<IDXGIFactory4> dxgiFactory = CreateDxgiFactory();
+        ComPtr<IDXGIAdapter1> adapter1;
+        for(UINT adapterIndex = 0; dxgiFactory->EnumAdapters1(adapterIndex, &adapter1) != DXGI_ERROR_NOT_FOUND;
+            ++adapterIndex)
+        {
+            DXGI_ADAPTER_DESC desc = {};
+            if((g_Options.AdapterIndex == UINT32_MAX || g_Options.AdapterIndex == adapterIndex) &&
+                SUCCEEDED(adapter1->GetDesc(&desc)) &&
+                vendorApis.IsApplicable(VendorApi::NvApi, desc.VendorId, IsSoftwareAdapter(adapter1.Get())))
+            {
+                adapterIndices.push_back(adapterIndex);
+                adapterLuids.push_back(desc.AdapterLuid);
+            }
+            adapter1.Reset();
+        }
     }
-    catch(...)
+    NvAPI_Inititalize_RAII* const nvApi = adapterIndices.empty() ? nullptr : vendorApis.GetNvApi();
+    if(!nvApi)
+        throw std::runtime_error("No adapter can be monitored with NVAPI.");
+
+    // There are only a few adapters, so each sample searches for its LUID.
+    NvApiMonitor monitor(
+        adapterIndices,
+        [&](uint32_t adapterIndex, NvGpuCounters& outCounters) {
+            const size_t i = std::find(adapterIndices.begin(), adapterIndices.end(), adapterIndex) -
+                adapterIndices.begin();
+            return nvApi->GetGpuCounters(adapterLuids[i], outCounters);
+        },
+        std::chrono::milliseconds(g_Options.MonitorNvApiIntervalMilliseconds), g_Options.UseJsonOutput);
+    PrinterScope printerScope(g_Options.OutputFile, g_Options.OutputFilePath);
+    monitor.Run();
+    return PROGRAM_EXIT_SUCCESS;
+}
+#endif
+
+// Kept by PrintLibraryReport for the following reports.
+static std::unique_ptr<VendorApis> g_LibraryVendorApis;
+
+void PrintLibraryReport(const wchar_t* options, std::unique_ptr<ReportSink> sink)
+{
+    ProgramOptions reportOptions;
+    // Experimental features are enabled for the whole process, so only when asked for.
+    reportOptions.EnableExperimental = false;
+    CmdLineParser cmdLineParser(options);
+    ParseCommandLine(cmdLineParser, true, reportOptions);
+    // The report goes only to the sink, so it can't go to a file, be a JSON Patch or the command line syntax.
+    if(reportOptions.ShowCommandLineSyntaxAndFail || reportOptions.ShowCommandLineSyntaxAndQuit ||
+        reportOptions.OutputFile || !reportOptions.BaselineFilePath.empty())
+        throw std::invalid_argument("Invalid options.");
+    reportOptions.InLibrary = true;
+    // The cache keeps printed text, which the sink doesn't make.
+    reportOptions.UseCache = false;
+    // Names of the JSON report.
+    reportOptions.UseJsonOutput = true;
+    reportOptions.UseJsonPrettyPrint = false;
+    reportOptions.UseFlatOutput = false;
+
+    if(!g_LibraryVendorApis)
+        g_LibraryVendorApis = std::make_unique<VendorApis>();
+    g_Options = reportOptions;
+    g_PrintAdaptersAsArray = true;
+    ReportSelection::Clear();
+    if(!g_Options.SelectPaths.empty())
+        ReportSelection::Add(g_Options.SelectPaths);
+
+    ReportFormatterThreadScope formatterScope(std::move(sink));
+    if(PrintRequestedReport(*g_LibraryVendorApis) != PROGRAM_EXIT_SUCCESS)
+        throw std::runtime_error("Printing the report failed.");
+}
+
+std::vector<D3d12infoAdapter> GetLibraryAdapters()
+{
+#if !defined(AUTO_LINK_DX12)
+    if(!LoadLibraries(false))
+        throw std::runtime_error("Could not load DXGI library.");
+#endif
+
+    ComPtr<IDXGIFactory4> dxgiFactory = CreateDxgiFactory();
+    std::vector<D3d12infoAdapter> adapters;
+    ComPtr<IDXGIAdapter1> adapter1;
+    for(UINT i = 0; dxgiFactory->EnumAdapters1(i, &adapter1) != DXGI_ERROR_NOT_FOUND; ++i)
     {
-        ErrorPrinter::PrintString("UNKNOWN ERROR.\n");
-        return PROGRAM_EXIT_ERROR_EXCEPTION;
+        DXGI_ADAPTER_DESC1 desc = {};
+        CHECK_HR(adapter1->GetDesc1(&desc));
+        adapter1.Reset();
+
+        D3d12infoAdapter& adapter = adapters.emplace_back();
+        static_assert(sizeof(adapter.Description) == sizeof(desc.Description));
+        memcpy(adapter.Description, desc.Description, sizeof(desc.Description));
+        adapter.VendorId = desc.VendorId;
+        adapter.DeviceId = desc.DeviceId;
+        adapter.SubSysId = desc.SubSysId;
+        adapter.Revision = desc.Revision;
+        adapter.DedicatedVideoMemory = desc.DedicatedVideoMemory;
+        adapter.DedicatedSystemMemory = desc.DedicatedSystemMemory;
+        adapter.SharedSystemMemory = desc.SharedSystemMemory;
+        adapter.AdapterLuidLowPart = desc.AdapterLuid.LowPart;
+        adapter.AdapterLuidHighPart = desc.AdapterLuid.HighPart;
+        adapter.Flags = desc.Flags;
     }
+    return adapters;
+}
+
+void ReleaseLibraryState()
+{
+    g_LibraryVendorApis.reset();
+    ReleaseLibraries();
 }
 
-int wmain(int argc, wchar_t** argv)
+int wmain3(int argc, wchar_t** argv)
 {
-    __try
+    CmdLineParser cmdLineParser(argc, argv);
+    ParseCommandLine(cmdLineParser, false, g_Options);
+
+    // Rendered reports are written to files in the output directory, never to the console.
+    if(!g_Options.RenderDirectoryPath.empty() && !g_Options.OutputFile)
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    // Rendered reports get their types from JSON, so only JSON is rendered without losing enum names and units.
+    if(!g_Options.RenderDirectoryPath.empty() && (!g_Options.UseJsonOutput || g_Options.UseFlatOutput))
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    // Reports of the jobs are written where each of them says.
+    if(!g_Options.BatchFilePath.empty() && !g_Options.RenderDirectoryPath.empty())
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    // Responses are written to the standard output.
+    if(g_Options.Serve && (!g_Options.BatchFilePath.empty() || !g_Options.RenderDirectoryPath.empty()))
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    // The report is written to shared memory.
+    if(!g_Options.PublishName.empty() && (g_Options.OutputFile || g_Options.Serve || !g_Options.BatchFilePath.empty()))
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    if(g_Options.PublishName.empty() && g_Options.PublishIntervalSeconds != 0)
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    // Samples are written to the output instead of a report.
+    if((g_Options.MonitorIntervalMilliseconds != 0 || g_Options.MonitorNvApiIntervalMilliseconds != 0) &&
+        (g_Options.Serve || !g_Options.BatchFilePath.empty() || !g_Options.RenderDirectoryPath.empty() ||
+            !g_Options.PublishName.empty()))
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    if(g_Options.MonitorIntervalMilliseconds != 0 && g_Options.MonitorNvApiIntervalMilliseconds != 0)
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    // Metrics are served or written to their own file and exclude all other modes.
+    if((g_Options.MetricsPort != 0 || !g_Options.MetricsFilePath.empty()) &&
+        (g_Options.OutputFile || g_Options.Serve || !g_Options.BatchFilePath.empty() ||
+            !g_Options.RenderDirectoryPath.empty() || !g_Options.PublishName.empty() ||
+            g_Options.MonitorIntervalMilliseconds != 0 || g_Options.MonitorNvApiIntervalMilliseconds != 0))
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    if(g_Options.MetricsPort != 0 && !g_Options.MetricsFilePath.empty())
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    if(g_Options.MetricsFilePath.empty() && g_Options.MetricsIntervalSeconds != 0)
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    // Changes are printed as they come, for all adapters, instead of a report.
+    if(g_Options.Watch &&
+        (g_Options.Serve || !g_Options.BatchFilePath.empty() || !g_Options.RenderDirectoryPath.empty() ||
+            !g_Options.PublishName.empty() || g_Options.MonitorIntervalMilliseconds != 0 ||
+            g_Options.MonitorNvApiIntervalMilliseconds != 0 || g_Options.MetricsPort != 0 ||
+            !g_Options.MetricsFilePath.empty() || !g_Options.BaselineFilePath.empty() || g_Options.WARP))
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    // Latencies are printed instead of the report, which is printed again and again.
+    if(g_Options.BenchmarkRunCount != 0 &&
+        (g_Options.Serve || !g_Options.BatchFilePath.empty() || !g_Options.RenderDirectoryPath.empty() ||
+            !g_Options.PublishName.empty() || g_Options.MonitorIntervalMilliseconds != 0 ||
+            g_Options.MonitorNvApiIntervalMilliseconds != 0 || g_Options.MetricsPort != 0 ||
+            !g_Options.MetricsFilePath.empty() || g_Options.Watch || !g_Options.BaselineFilePath.empty() ||
+            !g_Options.RecordFilePath.empty() || !g_Options.ArchiveFilePath.empty() || !g_Options.RawFilePath.empty()))
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+    // Stats are of a single report.
+    if(g_Options.PrintStats &&
+        (g_Options.Serve || !g_Options.BatchFilePath.empty() || !g_Options.RenderDirectoryPath.empty() ||
+            !g_Options.PublishName.empty() || g_Options.MonitorIntervalMilliseconds != 0 ||
+            g_Options.MonitorNvApiIntervalMilliseconds != 0 || g_Options.MetricsPort != 0 ||
+            !g_Options.MetricsFilePath.empty() || g_Options.Watch || g_Options.BenchmarkRunCount != 0))
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+#if !USE_NVAPI
+    if(g_Options.MonitorNvApiIntervalMilliseconds != 0)
+        g_Options.ShowCommandLineSyntaxAndFail = true;
+#endif
+
+    if(g_Options.ShowCommandLineSyntaxAndFail)
     {
-        return wmain2(argc, argv);
+        PrinterScope scope(false, {});
+        PrintCommandLineSyntax<ErrorPrinter>();
+        return PROGRAM_EXIT_ERROR_COMMAND_LINE;
     }
-    __except(EXCEPTION_EXECUTE_HANDLER)
+
+    if(g_Options.PrintTimings)
+        ProbeTimings::Enable();
+
+    // Declared before the printer, so flushing the output is part of the trace.
+    TraceScope traceScope(g_Options.TraceFilePath);
+
+    if(!g_Options.RenderDirectoryPath.empty() && !g_Options.ShowVersionAndQuit &&
+        !g_Options.ShowCommandLineSyntaxAndQuit)
     {
-        unsigned long exceptionCode = GetExceptionCode();
-        ErrorPrinter::PrintFormat("STRUCTURED EXCEPTION: 0x{:08X}\n", std::make_format_args(exceptionCode));
-        return PROGRAM_EXIT_ERROR_SEH_EXCEPTION;
+        // The output path is a directory and only the summary is printed to the console.
+        PrinterScope printerScope(false, {});
+        return RenderReportDirectory(
+            g_Options.RenderDirectoryPath, g_Options.OutputFilePath, GetReportFormatterFlags());
     }
+
+    // Released at the end of the program, after all reports, also those of --Batch.
+    LibrariesScope librariesScope;
+    VendorApis vendorApis;
+
+    // Saves the recorded capture when the report is finished.
+    DeviceCaptureScope captureScope(
+        g_Options.RecordFilePath, g_Options.ReplayFilePath, !g_Options.ArchiveFilePath.empty());
+    RawFeatureDataScope rawFeatureDataScope(g_Options.RawFilePath);
+
+    if(!g_Options.QuirksFilePath.empty())
+        DriverQuirks::LoadFile(g_Options.QuirksFilePath);
+
+    if(!g_Options.BatchFilePath.empty() && !g_Options.ShowVersionAndQuit && !g_Options.ShowCommandLineSyntaxAndQuit)
+        return RunBatch(vendorApis);
+    if(g_Options.Serve && !g_Options.ShowVersionAndQuit && !g_Options.ShowCommandLineSyntaxAndQuit)
+        return RunServer(vendorApis);
+    if(!g_Options.PublishName.empty() && !g_Options.ShowVersionAndQuit && !g_Options.ShowCommandLineSyntaxAndQuit)
+        return RunPublisher(vendorApis);
+    if(g_Options.MonitorIntervalMilliseconds != 0 && !g_Options.ShowVersionAndQuit &&
+        !g_Options.ShowCommandLineSyntaxAndQuit)
+        return RunMonitor();
+    if((g_Options.MetricsPort != 0 || !g_Options.MetricsFilePath.empty()) && !g_Options.ShowVersionAndQuit &&
+        !g_Options.ShowCommandLineSyntaxAndQuit)
+        return RunMetricsExporter();
+    if(g_Options.Watch && !g_Options.ShowVersionAndQuit && !g_Options.ShowCommandLineSyntaxAndQuit)
+        return RunWatcher(vendorApis);
+    if(g_Options.BenchmarkRunCount != 0 && !g_Options.ShowVersionAndQuit && !g_Options.ShowCommandLineSyntaxAndQuit)
+        return RunBenchmark(vendorApis);
+#if USE_NVAPI
+    if(g_Options.MonitorNvApiIntervalMilliseconds != 0 && !g_Options.ShowVersionAndQuit &&
+        !g_Options.ShowCommandLineSyntaxAndQuit)
+        return RunNvApiMonitor(vendorApis);
+#endif
+
+    // With --RenderDir, the output path is a directory, so --Version and --Help print to the console.
+    PrinterScope printerScope(
+        g_Options.OutputFile && g_Options.RenderDirectoryPath.empty(), g_Options.OutputFilePath);
+    if(!g_Options.PrintStats)
+        return RunReport(vendorApis);
+    ReportStats::Enable();
+    const int programResult = RunReport(vendorApis);
+    ReportStats::PrintSummary();
+    return programResult;
 }
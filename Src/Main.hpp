@@ -0,0 +1,26 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+#include "D3d12infoApi.h"
+#include "ReportSink.hpp"
+
+// Runs the program with its command-line arguments and returns its exit code. Throws on failure.
+int wmain3(int argc, wchar_t** argv);
+
+// Used by the library API, see D3d12infoApi.h.
+
+// Prints the report asked for with options given like on the command line to sink, with the names of the JSON report.
+// Throws std::invalid_argument if the options are not valid for the library, other exceptions on failure.
+void PrintLibraryReport(const wchar_t* options, std::unique_ptr<ReportSink> sink);
+// Every adapter DXGI enumerates, in the order of their indices.
+std::vector<D3d12infoAdapter> GetLibraryAdapters();
+// Releases the libraries, D3D12 devices and vendor APIs kept by PrintLibraryReport.
+void ReleaseLibraryState();
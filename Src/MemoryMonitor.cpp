@@ -0,0 +1,289 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "MemoryMonitor.hpp"
+
+#include "Printer.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+#include "Utils.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static const uint32_t SEGMENT_GROUP_COUNT = 2;
+static const wchar_t* const SEGMENT_GROUP_NAMES[SEGMENT_GROUP_COUNT] = {
+    L"DXGI_MEMORY_SEGMENT_GROUP_LOCAL", L"DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL" };
+static const uint32_t VALUE_COUNT = 4;
+static const wchar_t* const VALUE_NAMES[VALUE_COUNT] = {
+    L"Budget", L"CurrentUsage", L"AvailableForReservation", L"CurrentReservation" };
+// How often the writer thread drains the ring buffer.
+static const std::chrono::milliseconds WRITE_INTERVAL = std::chrono::milliseconds(100);
+
+struct MemorySample
+{
+    uint64_t m_TimeMicroseconds;
+    uint32_t m_SeriesIndex;
+    uint64_t m_Values[VALUE_COUNT];
+};
+
+// Lock-free queue for one producer thread and one consumer thread. Push never waits: when the consumer
+// falls behind and the buffer is full, the sample is dropped.
+class MemoryMonitor::SampleRing
+{
+public:
+    // Power of 2, enough for seconds of samples of a few adapters at 1 ms interval.
+    static const size_t CAPACITY = 8192;
+
+    bool Push(const MemorySample& sample)
+    {
+        const size_t tail = m_Tail.load(std::memory_order_relaxed);
+        if(tail - m_Head.load(std::memory_order_acquire) == CAPACITY)
+            return false;
+        m_Samples[tail % CAPACITY] = sample;
+        m_Tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    // Calls func(const MemorySample&) for each sample pushed so far, in order.
+    template<typename Func>
+    void PopAll(Func&& func)
+    {
+        const size_t head = m_Head.load(std::memory_order_relaxed);
+        const size_t tail = m_Tail.load(std::memory_order_acquire);
+        for(size_t i = head; i != tail; ++i)
+            func(m_Samples[i % CAPACITY]);
+        m_Head.store(tail, std::memory_order_release);
+    }
+
+private:
+    std::array<MemorySample, CAPACITY> m_Samples;
+    // Indices growing forever, on separate cache lines, as each is written by another thread.
+    alignas(64) std::atomic<size_t> m_Head = 0;
+    alignas(64) std::atomic<size_t> m_Tail = 0;
+};
+
+// Counts values in buckets as wide as a fixed fraction of the value, like HdrHistogram, so its size doesn't depend on
+// the number of values, and percentiles are found with an error below 1/128 of the value. Min and max are exact.
+class ValueHistogram
+{
+public:
+    void Add(uint64_t value)
+    {
+        ++m_Counts[GetBucketIndex(value)];
+        ++m_Count;
+        m_Min = std::min(m_Min, value);
+        m_Max = std::max(m_Max, value);
+    }
+    uint64_t GetCount() const { return m_Count; }
+    uint64_t GetMin() const { return m_Min; }
+    uint64_t GetMax() const { return m_Max; }
+    // Nearest-rank percentile, as the highest value of its bucket, but not beyond the values added.
+    uint64_t GetPercentile(size_t percent) const
+    {
+        assert(m_Count > 0);
+        const uint64_t rank = std::max<uint64_t>((m_Count * percent + 99) / 100, 1);
+        uint64_t count = 0;
+        for(size_t bucketIndex = 0; bucketIndex < BUCKET_COUNT; ++bucketIndex)
+        {
+            count += m_Counts[bucketIndex];
+            if(count >= rank)
+                return std::clamp(GetBucketMax(bucketIndex), m_Min, m_Max);
+        }
+        return m_Max;
+    }
+
+private:
+    // Values below 2 * SUB_BUCKET_COUNT have a bucket each. Each following power of 2 is split into SUB_BUCKET_COUNT
+    // buckets, so values are shifted right by up to 64 - 8 bits to fit.
+    static const uint32_t SUB_BUCKET_COUNT = 128;
+    static const size_t BUCKET_COUNT = (64 - 8 + 2) * SUB_BUCKET_COUNT;
+
+    std::array<uint64_t, BUCKET_COUNT> m_Counts = {};
+    uint64_t m_Count = 0;
+    uint64_t m_Min = UINT64_MAX;
+    uint64_t m_Max = 0;
+
+    static size_t GetBucketIndex(uint64_t value)
+    {
+        uint32_t shift = 0;
+        while((value >> shift) >= 2 * SUB_BUCKET_COUNT)
+            ++shift;
+        return shift * SUB_BUCKET_COUNT + size_t(value >> shift);
+    }
+    static uint64_t GetBucketMax(size_t bucketIndex)
+    {
+        const uint32_t shift = bucketIndex < 2 * SUB_BUCKET_COUNT ? 0 : uint32_t(bucketIndex / SUB_BUCKET_COUNT - 1);
+        const uint64_t top = bucketIndex - shift * SUB_BUCKET_COUNT;
+        // Wraps around to UINT64_MAX for the last bucket.
+        return ((top + 1) << shift) - 1;
+    }
+};
+
+static float ToMicroseconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration<float, std::micro>(duration).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+struct MemoryMonitor::Series
+{
+    ValueHistogram m_Values[VALUE_COUNT];
+};
+
+MemoryMonitor::MemoryMonitor(
+    std::vector<uint32_t> adapterIndices, QueryFunc queryFunc, std::chrono::milliseconds interval, bool json)
+    : m_AdapterIndices(std::move(adapterIndices))
+    , m_QueryFunc(std::move(queryFunc))
+    , m_Interval(interval)
+    , m_Json(json)
+    , m_Ring(std::make_unique<SampleRing>())
+    , m_Series(m_AdapterIndices.size() * SEGMENT_GROUP_COUNT)
+{
+}
+
+MemoryMonitor::~MemoryMonitor() = default;
+
+void MemoryMonitor::Run()
+{
+    std::atomic<bool> stopWriter = false;
+
+    if(!m_Json)
+    {
+        Printer::PrintString(L"TimeMs,Adapter,SegmentGroup");
+        for(const wchar_t* valueName : VALUE_NAMES)
+            Printer::PrintFormat(L",{}", std::make_wformat_args(valueName));
+        Printer::PrintNewLine();
+    }
+
+    std::thread writerThread([&]() {
+        while(true)
+        {
+            // Read before draining, so samples pushed before the stop are all written.
+            const bool stop = stopWriter.load(std::memory_order_acquire);
+            WriteSamples();
+            if(stop)
+                break;
+            std::this_thread::sleep_for(WRITE_INTERVAL);
+        }
+    });
+
+    // Stops sampling, so the summary is printed.
+    CtrlCScope ctrlCScope;
+
+    // Ticks are scheduled from the start, so the interval doesn't drift by the time of sampling.
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point nextTickTime = startTime;
+    while(true)
+    {
+        Tick(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime));
+
+        // If sampling fell behind, the ticks missed are skipped rather than taken in a burst.
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        do
+            nextTickTime += m_Interval;
+        while(nextTickTime <= now);
+        if(ctrlCScope.Wait(std::chrono::ceil<std::chrono::milliseconds>(nextTickTime - now)))
+            break;
+    }
+
+    stopWriter.store(true, std::memory_order_release);
+    writerThread.join();
+}
+
+void MemoryMonitor::Tick(std::chrono::microseconds time)
+{
+    const std::chrono::steady_clock::time_point tickBeginTime = std::chrono::steady_clock::now();
+    for(uint32_t seriesIndex = 0; seriesIndex < uint32_t(m_Series.size()); ++seriesIndex)
+    {
+        VideoMemoryInfo info;
+        if(!m_QueryFunc(m_AdapterIndices[seriesIndex / SEGMENT_GROUP_COUNT], seriesIndex % SEGMENT_GROUP_COUNT, info))
+            continue;
+        const MemorySample sample = { .m_TimeMicroseconds = uint64_t(time.count()),
+            .m_SeriesIndex = seriesIndex,
+            .m_Values = { info.m_Budget, info.m_CurrentUsage, info.m_AvailableForReservation,
+                info.m_CurrentReservation } };
+        if(!m_Ring->Push(sample))
+            ++m_DroppedSampleCount;
+    }
+    const std::chrono::steady_clock::duration tickTime = std::chrono::steady_clock::now() - tickBeginTime;
+    m_TotalTickTime += tickTime;
+    m_MaxTickTime = std::max(m_MaxTickTime, tickTime);
+    ++m_TickCount;
+}
+
+void MemoryMonitor::WriteSamples()
+{
+    m_Ring->PopAll([this](const MemorySample& sample) {
+        const double timeMilliseconds = sample.m_TimeMicroseconds / 1000.0;
+        const uint32_t adapterIndex = m_AdapterIndices[sample.m_SeriesIndex / SEGMENT_GROUP_COUNT];
+        const wchar_t* const segmentGroupName = SEGMENT_GROUP_NAMES[sample.m_SeriesIndex % SEGMENT_GROUP_COUNT];
+        if(m_Json)
+        {
+            m_Batch += std::format(L"{{\"TimeMs\":{:.3f},\"Adapter\":{},\"SegmentGroup\":\"{}\"",
+                timeMilliseconds, adapterIndex, segmentGroupName);
+            for(uint32_t i = 0; i < VALUE_COUNT; ++i)
+                m_Batch += std::format(L",\"{}\":{}", VALUE_NAMES[i], sample.m_Values[i]);
+            m_Batch += L"}\n";
+        }
+        else
+        {
+            m_Batch += std::format(L"{:.3f},{},{}", timeMilliseconds, adapterIndex, segmentGroupName);
+            for(uint64_t value : sample.m_Values)
+                m_Batch += std::format(L",{}", value);
+            m_Batch += L'\n';
+        }
+        Series& series = m_Series[sample.m_SeriesIndex];
+        for(uint32_t i = 0; i < VALUE_COUNT; ++i)
+            series.m_Values[i].Add(sample.m_Values[i]);
+    });
+    if(!m_Batch.empty())
+    {
+        Printer::PrintString(m_Batch);
+        m_Batch.clear();
+    }
+}
+
+void MemoryMonitor::PrintSummary()
+{
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    ReportScopeObject scope(L"MemoryMonitor");
+    formatter.AddFieldUint32(L"IntervalMs", uint32_t(m_Interval.count()), L"ms");
+    formatter.AddFieldUint64(L"TickCount", m_TickCount);
+    formatter.AddFieldUint64(L"DroppedSampleCount", m_DroppedSampleCount);
+    if(m_TickCount > 0)
+    {
+        formatter.AddFieldFloat(L"AverageTickTime", ToMicroseconds(m_TotalTickTime) / m_TickCount, L"us");
+        formatter.AddFieldFloat(L"MaxTickTime", ToMicroseconds(m_MaxTickTime), L"us");
+    }
+
+    ReportScopeArray adaptersScope(L"Adapters");
+    for(size_t adapterIndex = 0; adapterIndex < m_AdapterIndices.size(); ++adapterIndex)
+    {
+        ReportScopeArrayItem adapterScope;
+        formatter.AddFieldUint32(L"Adapter", m_AdapterIndices[adapterIndex]);
+        for(uint32_t segmentGroup = 0; segmentGroup < SEGMENT_GROUP_COUNT; ++segmentGroup)
+        {
+            const Series& series = m_Series[adapterIndex * SEGMENT_GROUP_COUNT + segmentGroup];
+            if(series.m_Values[0].GetCount() == 0)
+                continue;
+            ReportScopeObject segmentGroupScope(SEGMENT_GROUP_NAMES[segmentGroup]);
+            for(uint32_t i = 0; i < VALUE_COUNT; ++i)
+            {
+                const ValueHistogram& values = series.m_Values[i];
+                ReportScopeObject valueScope(VALUE_NAMES[i]);
+                formatter.AddFieldSize(L"Min", values.GetMin());
+                formatter.AddFieldSize(L"Max", values.GetMax());
+                formatter.AddFieldSize(L"P50", values.GetPercentile(50));
+                formatter.AddFieldSize(L"P95", values.GetPercentile(95));
+                formatter.AddFieldSize(L"P99", values.GetPercentile(99));
+            }
+        }
+    }
+}
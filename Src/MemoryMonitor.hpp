@@ -0,0 +1,64 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Values of DXGI_QUERY_VIDEO_MEMORY_INFO of one segment group of an adapter at one moment, for --Monitor and --Metrics.
+// They are plain values independent of DXGI, so made-up adapters can also be sampled.
+struct VideoMemoryInfo
+{
+    uint64_t m_Budget = 0;
+    uint64_t m_CurrentUsage = 0;
+    uint64_t m_AvailableForReservation = 0;
+    uint64_t m_CurrentReservation = 0;
+};
+
+// Samples video memory info of both segment groups of adapters at a fixed interval, for --Monitor.
+// The sampling thread only queries the adapters and pushes samples into a fixed-size lock-free ring buffer.
+// A writer thread drains it in batches, prints them to the output as CSV or NDJSON, and counts the values in
+// fixed-size histograms for the summary, so nothing is allocated or printed between the queries, and memory used
+// doesn't grow however long it runs.
+class MemoryMonitor
+{
+public:
+    // Queries the segment group of the adapter, 0 for local and 1 for non-local. Returns false on failure.
+    using QueryFunc = std::function<bool(uint32_t adapterIndex, uint32_t segmentGroup, VideoMemoryInfo& outInfo)>;
+
+    MemoryMonitor(std::vector<uint32_t> adapterIndices, QueryFunc queryFunc, std::chrono::milliseconds interval,
+        bool json);
+    ~MemoryMonitor();
+
+    // Samples on the calling thread until Ctrl+C or Ctrl+Break. The output must be open.
+    void Run();
+    // Queries each adapter and segment group once. time is since the start of sampling. Run calls it on every tick.
+    void Tick(std::chrono::microseconds time);
+    // Prints the samples of the ticks so far to the output, which must be open, and counts them for the summary.
+    // Run calls it on the writer thread.
+    void WriteSamples();
+    // Prints min, max and percentiles of each value to the report, which must be open.
+    void PrintSummary();
+
+private:
+    class SampleRing;
+    struct Series;
+
+    const std::vector<uint32_t> m_AdapterIndices;
+    const QueryFunc m_QueryFunc;
+    const std::chrono::milliseconds m_Interval;
+    const bool m_Json;
+    std::unique_ptr<SampleRing> m_Ring;
+    // For each adapter and segment group.
+    std::vector<Series> m_Series;
+    // Used only by WriteSamples.
+    std::wstring m_Batch;
+    uint64_t m_TickCount = 0;
+    uint64_t m_DroppedSampleCount = 0;
+    std::chrono::steady_clock::duration m_TotalTickTime = {};
+    std::chrono::steady_clock::duration m_MaxTickTime = {};
+};
@@ -10,7 +10,10 @@ For more information, see files README.md, LICENSE.txt.
 #include "NvApiData.hpp"
 
 #include "Enums.hpp"
+#include "NvApiMonitor.hpp"
+#include "ProbeTimings.hpp"
 #include "ReportFormatter/ReportFormatter.hpp"
+#include "Trace.hpp"
 #include "Utils.hpp"
 
 // Macro set by Cmake.
@@ -496,18 +499,18 @@ static wstring NvShortStringToStr(NvAPI_ShortString str)
 
 static void LoadGpus()
 {
-    if(NvAPI_EnumLogicalGPUs(g_LogicalGpuHandles, &g_LogicalGpuCount) != NVAPI_OK)
+    if(PROBE_CALL(NvAPI_EnumLogicalGPUs, g_LogicalGpuHandles, &g_LogicalGpuCount) != NVAPI_OK)
         g_LogicalGpuCount = 0;
     for(NvU32 i = 0; i < g_LogicalGpuCount; ++i)
     {
         g_LogicalGpuData[i] = { .version = NV_LOGICAL_GPU_DATA_VER, .pOSAdapterId = &g_LogicalGpuLuids[i] };
-        NvAPI_Status status = NvAPI_GPU_GetLogicalGpuInfo(g_LogicalGpuHandles[i], &g_LogicalGpuData[i]);
+        NvAPI_Status status = PROBE_CALL(NvAPI_GPU_GetLogicalGpuInfo, g_LogicalGpuHandles[i], &g_LogicalGpuData[i]);
         assert(status == NVAPI_OK);
     }
 
     // Success in fetching this structure is optional.
     g_PhysicalGpus.version = NV_PHYSICAL_GPUS_VER;
-    if(NvAPI_SYS_GetPhysicalGPUs(&g_PhysicalGpus) != NVAPI_OK)
+    if(PROBE_CALL(NvAPI_SYS_GetPhysicalGPUs, &g_PhysicalGpus) != NVAPI_OK)
     {
         ZeroMemory(&g_PhysicalGpus, sizeof g_PhysicalGpus);
     }
@@ -554,7 +557,7 @@ static bool FindPhysicalGpuAdapterType(NvPhysicalGpuHandle physicalGpuHandle, NV
 static void PrintCooperativeVectorProperty(size_t index, const NVAPI_COOPERATIVE_VECTOR_PROPERTIES& props)
 {
     ReportScopeArrayItem scope;
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    ReportSink& formatter = ReportFormatter::GetInstance();
 
     formatter.AddFieldHex32(L"version", props.version);
     formatter.AddFieldEnum(L"inputType", props.inputType, Enum_NVAPI_COOPERATIVE_VECTOR_COMPONENT_TYPE);
@@ -583,18 +586,25 @@ static void PrintCooperativeVectorProperties(const std::vector<NVAPI_COOPERATIVE
 
 void NvAPI_Inititalize_RAII::PrintStaticParams()
 {
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    ReportSink& formatter = ReportFormatter::GetInstance();
     formatter.AddFieldString(L"NvAPI compiled version", NVAPI_COMPILED_VERSION);
     formatter.AddFieldUint32(L"NVAPI_SDK_VERSION", NVAPI_SDK_VERSION);
+}
 
+void NvAPI_Inititalize_RAII::PrintLibraryVersion()
+{
     NvAPI_ShortString nvShortString;
-    if(NvAPI_GetInterfaceVersionString(nvShortString) == NVAPI_OK)
-        formatter.AddFieldString(L"NvAPI_GetInterfaceVersionString", NvShortStringToStr(nvShortString).c_str());
+    if(PROBE_CALL(NvAPI_GetInterfaceVersionString, nvShortString) == NVAPI_OK)
+    {
+        ReportFormatter::GetInstance().AddFieldString(L"NvAPI_GetInterfaceVersionString",
+            NvShortStringToStr(nvShortString).c_str());
+    }
 }
 
 NvAPI_Inititalize_RAII::NvAPI_Inititalize_RAII()
 {
-    m_Initialized = NvAPI_Initialize() == NVAPI_OK;
+    TraceSpan traceSpan(L"NvAPI_Inititalize_RAII");
+    m_Initialized = PROBE_CALL(NvAPI_Initialize) == NVAPI_OK;
     if(m_Initialized)
         LoadGpus();
 }
@@ -602,17 +612,17 @@ NvAPI_Inititalize_RAII::NvAPI_Inititalize_RAII()
 NvAPI_Inititalize_RAII::~NvAPI_Inititalize_RAII()
 {
     if(m_Initialized)
-        NvAPI_Unload();
+        PROBE_CALL(NvAPI_Unload);
 }
 
 void NvAPI_Inititalize_RAII::PrintData()
 {
     assert(m_Initialized);
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    ReportSink& formatter = ReportFormatter::GetInstance();
 
     NvU32 pDriverVersion = UINT32_MAX;
     NvAPI_ShortString szBuildBranchString = {};
-    if(NvAPI_SYS_GetDriverAndBranchVersion(&pDriverVersion, szBuildBranchString) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_SYS_GetDriverAndBranchVersion, &pDriverVersion, szBuildBranchString) == NVAPI_OK)
     {
         ReportScopeObject scope(L"NvAPI_SYS_GetDriverAndBranchVersion");
         formatter.AddFieldUint32(L"pDriverVersion", pDriverVersion);
@@ -621,7 +631,7 @@ void NvAPI_Inititalize_RAII::PrintData()
 
     {
         NV_DISPLAY_DRIVER_INFO info = { NV_DISPLAY_DRIVER_INFO_VER };
-        if(NvAPI_SYS_GetDisplayDriverInfo(&info) == NVAPI_OK)
+        if(PROBE_CALL(NvAPI_SYS_GetDisplayDriverInfo, &info) == NVAPI_OK)
         {
             ReportScopeObject scope(L"NvAPI_SYS_GetDisplayDriverInfo - NV_DISPLAY_DRIVER_INFO");
             formatter.AddFieldUint32(L"driverVersion", info.driverVersion);
@@ -641,13 +651,13 @@ void NvAPI_Inititalize_RAII::PrintData()
 void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
 {
     assert(m_Initialized);
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    ReportSink& formatter = ReportFormatter::GetInstance();
 
     wstring s;
 
     {
         NvU64 totalBytes = 0, freeBytes = 0;
-        if(NvAPI_D3D12_QueryCpuVisibleVidmem(device, &totalBytes, &freeBytes) == NVAPI_OK)
+        if(PROBE_CALL(NvAPI_D3D12_QueryCpuVisibleVidmem, device, &totalBytes, &freeBytes) == NVAPI_OK)
         {
             ReportScopeObject scope(L"NvAPI_D3D12_QueryCpuVisibleVidmem");
             formatter.AddFieldSize(L"pTotalBytes", totalBytes);
@@ -659,7 +669,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         for(const EnumItem* ei = Enum_NV_EXTN_OP; ei->m_Name != nullptr; ++ei)
         {
             bool supported = false;
-            if(NvAPI_D3D12_IsNvShaderExtnOpCodeSupported(device, ei->m_Value, &supported) == NVAPI_OK)
+            if(PROBE_CALL(NvAPI_D3D12_IsNvShaderExtnOpCodeSupported, device, ei->m_Value, &supported) == NVAPI_OK)
             {
                 scope.Enable();
                 formatter.AddFieldBool(ei->m_Name, supported);
@@ -669,7 +679,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
 
     {
         NvU32 threadCount = 0;
-        if(NvAPI_D3D12_GetOptimalThreadCountForMesh(device, &threadCount) == NVAPI_OK)
+        if(PROBE_CALL(NvAPI_D3D12_GetOptimalThreadCountForMesh, device, &threadCount) == NVAPI_OK)
         {
             ReportScopeObject scope(L"NvAPI_D3D12_GetOptimalThreadCountForMesh");
             formatter.AddFieldUint32(L"pThreadCount", (uint32_t)threadCount);
@@ -679,7 +689,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
     {
         ReportScopeObjectConditional scope(L"NvAPI_D3D12_GetRaytracingCaps");
         NVAPI_D3D12_RAYTRACING_THREAD_REORDERING_CAPS threadReorderingCaps = {};
-        if(NvAPI_D3D12_GetRaytracingCaps(device, NVAPI_D3D12_RAYTRACING_CAPS_TYPE_THREAD_REORDERING,
+        if(PROBE_CALL(NvAPI_D3D12_GetRaytracingCaps, device, NVAPI_D3D12_RAYTRACING_CAPS_TYPE_THREAD_REORDERING,
                &threadReorderingCaps, sizeof threadReorderingCaps) == NVAPI_OK)
         {
             scope.Enable();
@@ -688,7 +698,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         }
 
         NVAPI_D3D12_RAYTRACING_OPACITY_MICROMAP_CAPS opacityMicromapCaps = {};
-        if(NvAPI_D3D12_GetRaytracingCaps(device, NVAPI_D3D12_RAYTRACING_CAPS_TYPE_OPACITY_MICROMAP,
+        if(PROBE_CALL(NvAPI_D3D12_GetRaytracingCaps, device, NVAPI_D3D12_RAYTRACING_CAPS_TYPE_OPACITY_MICROMAP,
                &opacityMicromapCaps, sizeof opacityMicromapCaps) == NVAPI_OK)
         {
             scope.Enable();
@@ -697,7 +707,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         }
 
         NVAPI_D3D12_RAYTRACING_DISPLACEMENT_MICROMAP_CAPS displacementMicromapCaps = {};
-        if(NvAPI_D3D12_GetRaytracingCaps(device, NVAPI_D3D12_RAYTRACING_CAPS_TYPE_DISPLACEMENT_MICROMAP,
+        if(PROBE_CALL(NvAPI_D3D12_GetRaytracingCaps, device, NVAPI_D3D12_RAYTRACING_CAPS_TYPE_DISPLACEMENT_MICROMAP,
                &displacementMicromapCaps, sizeof displacementMicromapCaps) == NVAPI_OK)
         {
             scope.Enable();
@@ -706,7 +716,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         }
 
         if(NVAPI_D3D12_RAYTRACING_CLUSTER_OPERATIONS_CAPS caps = {};
-            NvAPI_D3D12_GetRaytracingCaps(
+            PROBE_CALL(NvAPI_D3D12_GetRaytracingCaps,
                 device, NVAPI_D3D12_RAYTRACING_CAPS_TYPE_CLUSTER_OPERATIONS, &caps, sizeof caps) == NVAPI_OK)
         {
             scope.Enable();
@@ -715,7 +725,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         }
 
         if(NVAPI_D3D12_RAYTRACING_PARTITIONED_TLAS_CAPS caps = {};
-            NvAPI_D3D12_GetRaytracingCaps(
+            PROBE_CALL(NvAPI_D3D12_GetRaytracingCaps,
                 device, NVAPI_D3D12_RAYTRACING_CAPS_TYPE_PARTITIONED_TLAS, &caps, sizeof caps) == NVAPI_OK)
         {
             scope.Enable();
@@ -724,8 +734,8 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         }
 
         if(NVAPI_D3D12_RAYTRACING_SPHERES_CAPS caps = {};
-            NvAPI_D3D12_GetRaytracingCaps(device, NVAPI_D3D12_RAYTRACING_CAPS_TYPE_SPHERES, &caps, sizeof caps) ==
-            NVAPI_OK)
+            PROBE_CALL(NvAPI_D3D12_GetRaytracingCaps,
+                device, NVAPI_D3D12_RAYTRACING_CAPS_TYPE_SPHERES, &caps, sizeof caps) == NVAPI_OK)
         {
             scope.Enable();
             formatter.AddFieldEnum(
@@ -733,7 +743,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         }
 
         if(NVAPI_D3D12_RAYTRACING_LINEAR_SWEPT_SPHERES_CAPS caps = {};
-            NvAPI_D3D12_GetRaytracingCaps(
+            PROBE_CALL(NvAPI_D3D12_GetRaytracingCaps,
                 device, NVAPI_D3D12_RAYTRACING_CAPS_TYPE_LINEAR_SWEPT_SPHERES, &caps, sizeof caps) == NVAPI_OK)
         {
             scope.Enable();
@@ -749,14 +759,14 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
         };
 
         params.workstationFeatureType = NV_D3D12_WORKSTATION_FEATURE_TYPE_PRESENT_BARRIER;
-        if(NvAPI_D3D12_QueryWorkstationFeatureProperties(device, &params) == NVAPI_OK)
+        if(PROBE_CALL(NvAPI_D3D12_QueryWorkstationFeatureProperties, device, &params) == NVAPI_OK)
         {
             scope.Enable();
             formatter.AddFieldBool(L"NV_D3D12_WORKSTATION_FEATURE_TYPE_PRESENT_BARRIER - supported", params.supported);
         }
 
         params.workstationFeatureType = NV_D3D12_WORKSTATION_FEATURE_TYPE_RDMA_BAR1_SUPPORT;
-        if(NvAPI_D3D12_QueryWorkstationFeatureProperties(device, &params) == NVAPI_OK)
+        if(PROBE_CALL(NvAPI_D3D12_QueryWorkstationFeatureProperties, device, &params) == NVAPI_OK)
         {
             scope.Enable();
             formatter.AddFieldBool(
@@ -771,7 +781,7 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
 
     {
         bool appClampNeeded = false;
-        if(NvAPI_D3D12_GetNeedsAppFPBlendClamping(device, &appClampNeeded) == NVAPI_OK)
+        if(PROBE_CALL(NvAPI_D3D12_GetNeedsAppFPBlendClamping, device, &appClampNeeded) == NVAPI_OK)
         {
             ReportScopeObject scope(L"NvAPI_D3D12_GetNeedsAppFPBlendClamping");
             formatter.AddFieldBool(L"pAppClampNeeded", appClampNeeded);
@@ -779,16 +789,55 @@ void NvAPI_Inititalize_RAII::PrintD3d12DeviceData(ID3D12Device* device)
     }
 
     if(NvU32 count = 0;
-        NvAPI_D3D12_GetPhysicalDeviceCooperativeVectorProperties(device, &count, nullptr) == NVAPI_OK && count > 0)
+        PROBE_CALL(NvAPI_D3D12_GetPhysicalDeviceCooperativeVectorProperties, device, &count, nullptr) == NVAPI_OK &&
+        count > 0)
     {
         if(std::vector<NVAPI_COOPERATIVE_VECTOR_PROPERTIES> props(count);
-            NvAPI_D3D12_GetPhysicalDeviceCooperativeVectorProperties(device, &count, props.data()) == NVAPI_OK)
+            PROBE_CALL(NvAPI_D3D12_GetPhysicalDeviceCooperativeVectorProperties, device, &count, props.data()) ==
+            NVAPI_OK)
         {
             PrintCooperativeVectorProperties(props);
         }
     }
 }
 
+bool NvAPI_Inititalize_RAII::GetGpuCounters(const LUID& adapterLuid, NvGpuCounters& outCounters)
+{
+    assert(m_Initialized);
+
+    NvPhysicalGpuHandle gpu = {};
+    if(!FindPhysicalGpu(adapterLuid, gpu))
+        return false;
+
+    // Called in a loop, so not with PROBE_CALL, which would keep adding samples to --Timings.
+    NV_GPU_MEMORY_INFO_EX memInfo = { NV_GPU_MEMORY_INFO_EX_VER };
+    if(NvAPI_GPU_GetMemoryInfoEx(gpu, &memInfo) != NVAPI_OK)
+        return false;
+    outCounters = {};
+    outCounters.m_CurAvailableDedicatedVideoMemory = memInfo.curAvailableDedicatedVideoMemory;
+    outCounters.m_EvictionsSize = memInfo.dedicatedVideoMemoryEvictionsSize;
+    outCounters.m_EvictionCount = memInfo.dedicatedVideoMemoryEvictionCount;
+    outCounters.m_PromotionsSize = memInfo.dedicatedVideoMemoryPromotionsSize;
+    outCounters.m_PromotionCount = memInfo.dedicatedVideoMemoryPromotionCount;
+
+    NV_GPU_CLOCK_FREQUENCIES clocks = {};
+    clocks.version = NV_GPU_CLOCK_FREQUENCIES_VER;
+    clocks.ClockType = NV_GPU_CLOCK_FREQUENCIES_CURRENT_FREQ;
+    if(NvAPI_GPU_GetAllClockFrequencies(gpu, &clocks) == NVAPI_OK)
+    {
+        if(clocks.domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS].bIsPresent)
+            outCounters.m_GraphicsClockKHz = clocks.domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS].frequency;
+        if(clocks.domain[NVAPI_GPU_PUBLIC_CLOCK_MEMORY].bIsPresent)
+            outCounters.m_MemoryClockKHz = clocks.domain[NVAPI_GPU_PUBLIC_CLOCK_MEMORY].frequency;
+    }
+
+    NV_GPU_PERF_PSTATE_ID performanceState = NVAPI_GPU_PERF_PSTATE_UNDEFINED;
+    if(NvAPI_GPU_GetCurrentPstate(gpu, &performanceState) == NVAPI_OK &&
+        performanceState != NVAPI_GPU_PERF_PSTATE_UNDEFINED)
+        outCounters.m_PerformanceState = uint32_t(performanceState);
+    return true;
+}
+
 void NvAPI_Inititalize_RAII::PrintPhysicalGpuData(const LUID& adapterLuid)
 {
     assert(m_Initialized);
@@ -800,7 +849,7 @@ void NvAPI_Inititalize_RAII::PrintPhysicalGpuData(const LUID& adapterLuid)
         return;
 
     ReportScopeObject scope(L"NvPhysicalGpuHandle");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    ReportSink& formatter = ReportFormatter::GetInstance();
 
     if(NV_ADAPTER_TYPE adapterType; FindPhysicalGpuAdapterType(gpu, adapterType))
     {
@@ -808,15 +857,15 @@ void NvAPI_Inititalize_RAII::PrintPhysicalGpuData(const LUID& adapterLuid)
     }
 
     NV_SYSTEM_TYPE systemType = {};
-    if(NvAPI_GPU_GetSystemType(gpu, &systemType) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetSystemType, gpu, &systemType) == NVAPI_OK)
         formatter.AddFieldEnum(L"NvAPI_GPU_GetSystemType", systemType, Enum_NV_SYSTEM_TYPE);
 
     NvAPI_ShortString name = {};
-    if(NvAPI_GPU_GetFullName(gpu, name) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetFullName, gpu, name) == NVAPI_OK)
         formatter.AddFieldString(L"NvAPI_GPU_GetFullName", StrToWstr(name, CP_ACP).c_str());
 
     NvU32 DeviceId = 0, SubSystemId = 0, RevisionId = 0, ExtDeviceId = 0;
-    if(NvAPI_GPU_GetPCIIdentifiers(gpu, &DeviceId, &SubSystemId, &RevisionId, &ExtDeviceId) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetPCIIdentifiers, gpu, &DeviceId, &SubSystemId, &RevisionId, &ExtDeviceId) == NVAPI_OK)
     {
         formatter.AddFieldHex32(L"NvAPI_GPU_GetPCIIdentifiers - pDeviceID", DeviceId);
         formatter.AddFieldSubsystemId(L"NvAPI_GPU_GetPCIIdentifiers - pSubSystemId", SubSystemId);
@@ -825,35 +874,35 @@ void NvAPI_Inititalize_RAII::PrintPhysicalGpuData(const LUID& adapterLuid)
     }
 
     NV_GPU_TYPE gpuType = {};
-    if(NvAPI_GPU_GetGPUType(gpu, &gpuType) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetGPUType, gpu, &gpuType) == NVAPI_OK)
         formatter.AddFieldEnum(L"NvAPI_GPU_GetGPUType", gpuType, Enum_NV_GPU_TYPE);
 
     NV_GPU_BUS_TYPE busType = {};
-    if(NvAPI_GPU_GetBusType(gpu, &busType) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetBusType, gpu, &busType) == NVAPI_OK)
         formatter.AddFieldEnum(L"NvAPI_GPU_GetBusType", busType, Enum_NV_GPU_BUS_TYPE);
 
     NvU32 biosRevision = 0;
-    if(NvAPI_GPU_GetVbiosRevision(gpu, &biosRevision) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetVbiosRevision, gpu, &biosRevision) == NVAPI_OK)
         formatter.AddFieldUint32(L"NvAPI_GPU_GetVbiosRevision", biosRevision);
 
     NvU32 biosOemRevision = 0;
-    if(NvAPI_GPU_GetVbiosOEMRevision(gpu, &biosOemRevision) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetVbiosOEMRevision, gpu, &biosOemRevision) == NVAPI_OK)
         formatter.AddFieldUint32(L"NvAPI_GPU_GetVbiosOEMRevision", biosOemRevision);
 
     NvAPI_ShortString biosVersionString = {};
-    if(NvAPI_GPU_GetVbiosVersionString(gpu, biosVersionString) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetVbiosVersionString, gpu, biosVersionString) == NVAPI_OK)
         formatter.AddFieldString(L"NvAPI_GPU_GetVbiosVersionString", StrToWstr(biosVersionString, CP_ACP).c_str());
 
     NvU32 physicalFrameBufferSize = 0;
-    if(NvAPI_GPU_GetPhysicalFrameBufferSize(gpu, &physicalFrameBufferSize) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetPhysicalFrameBufferSize, gpu, &physicalFrameBufferSize) == NVAPI_OK)
         formatter.AddFieldSizeKilobytes(L"NvAPI_GPU_GetPhysicalFrameBufferSize", physicalFrameBufferSize);
 
     NvU32 virtualFrameBufferSize = 0;
-    if(NvAPI_GPU_GetVirtualFrameBufferSize(gpu, &virtualFrameBufferSize) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetVirtualFrameBufferSize, gpu, &virtualFrameBufferSize) == NVAPI_OK)
         formatter.AddFieldSizeKilobytes(L"NvAPI_GPU_GetVirtualFrameBufferSize", virtualFrameBufferSize);
 
     NV_GPU_ARCH_INFO archInfo = { NV_GPU_ARCH_INFO_VER };
-    if(NvAPI_GPU_GetArchInfo(gpu, &archInfo) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetArchInfo, gpu, &archInfo) == NVAPI_OK)
     {
         formatter.AddFieldEnum(L"NvAPI_GPU_GetArchInfo - NV_GPU_ARCH_INFO::architecture_id", archInfo.architecture_id,
             Enum_NV_GPU_ARCHITECTURE_ID);
@@ -865,7 +914,7 @@ void NvAPI_Inititalize_RAII::PrintPhysicalGpuData(const LUID& adapterLuid)
     }
 
     NV_GPU_VR_READY vrReady = { NV_GPU_VR_READY_VER };
-    if(NvAPI_GPU_GetVRReadyData(gpu, &vrReady) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetVRReadyData, gpu, &vrReady) == NVAPI_OK)
         formatter.AddFieldBool(L"NvAPI_GPU_GetVRReadyData - NV_GPU_VR_READY::isVRReady", vrReady.isVRReady != 0);
 
     NV_GPU_QUERY_ILLUMINATION_SUPPORT_PARM queryIlluminationSupportParm = {
@@ -874,7 +923,7 @@ void NvAPI_Inititalize_RAII::PrintPhysicalGpuData(const LUID& adapterLuid)
     for(const EnumItem* ei = Enum_NV_GPU_ILLUMINATION_ATTRIB; ei->m_Name != nullptr; ++ei)
     {
         queryIlluminationSupportParm.Attribute = (NV_GPU_ILLUMINATION_ATTRIB)ei->m_Value;
-        if(NvAPI_GPU_QueryIlluminationSupport(&queryIlluminationSupportParm) == NVAPI_OK)
+        if(PROBE_CALL(NvAPI_GPU_QueryIlluminationSupport, &queryIlluminationSupportParm) == NVAPI_OK)
         {
             formatter.AddFieldBool(std::format(L"NvAPI_GPU_QueryIlluminationSupport({})", ei->m_Name).c_str(),
                 queryIlluminationSupportParm.bSupported != 0);
@@ -884,14 +933,14 @@ void NvAPI_Inititalize_RAII::PrintPhysicalGpuData(const LUID& adapterLuid)
     for(const EnumItem* ei = Enum_NV_GPU_WORKSTATION_FEATURE_TYPE; ei->m_Name != nullptr; ++ei)
     {
         NvAPI_Status status =
-            NvAPI_GPU_QueryWorkstationFeatureSupport(gpu, (NV_GPU_WORKSTATION_FEATURE_TYPE)ei->m_Value);
+            PROBE_CALL(NvAPI_GPU_QueryWorkstationFeatureSupport, gpu, (NV_GPU_WORKSTATION_FEATURE_TYPE)ei->m_Value);
         formatter.AddFieldEnumSigned(std::format(L"NvAPI_GPU_QueryWorkstationFeatureSupport({})", ei->m_Name).c_str(),
             status, Enum_NvAPI_Status);
     }
 
     {
         NV_GPU_MEMORY_INFO_EX memInfo = { NV_GPU_MEMORY_INFO_EX_VER };
-        if(NvAPI_GPU_GetMemoryInfoEx(gpu, &memInfo) == NVAPI_OK)
+        if(PROBE_CALL(NvAPI_GPU_GetMemoryInfoEx, gpu, &memInfo) == NVAPI_OK)
         {
             formatter.AddFieldSize(L"NvAPI_GPU_GetMemoryInfoEx - NV_GPU_MEMORY_INFO_EX::dedicatedVideoMemory",
                 memInfo.dedicatedVideoMemory);
@@ -920,15 +969,15 @@ void NvAPI_Inititalize_RAII::PrintPhysicalGpuData(const LUID& adapterLuid)
     }
 
     NvU32 shaderSubPipeCount = 0;
-    if(NvAPI_GPU_GetShaderSubPipeCount(gpu, &shaderSubPipeCount) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetShaderSubPipeCount, gpu, &shaderSubPipeCount) == NVAPI_OK)
         formatter.AddFieldUint32(L"NvAPI_GPU_GetShaderSubPipeCount", shaderSubPipeCount);
 
     NvU32 gpuCoreCount = 0;
-    if(NvAPI_GPU_GetGpuCoreCount(gpu, &gpuCoreCount) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetGpuCoreCount, gpu, &gpuCoreCount) == NVAPI_OK)
         formatter.AddFieldUint32(L"NvAPI_GPU_GetGpuCoreCount", gpuCoreCount);
 
     NV_GPU_ECC_STATUS_INFO GPUECCStatusInfo = { NV_GPU_ECC_STATUS_INFO_VER };
-    if(NvAPI_GPU_GetECCStatusInfo(gpu, &GPUECCStatusInfo) == NVAPI_OK)
+    if(PROBE_CALL(NvAPI_GPU_GetECCStatusInfo, gpu, &GPUECCStatusInfo) == NVAPI_OK)
     {
         formatter.AddFieldBool(
             L"NvAPI_GPU_GetECCStatusInfo - NV_GPU_ECC_STATUS_INFO::isSupported", GPUECCStatusInfo.isSupported != 0);
@@ -940,13 +989,13 @@ void NvAPI_Inititalize_RAII::PrintPhysicalGpuData(const LUID& adapterLuid)
 
     {
         NvU32 busWidth = 0;
-        if(NvAPI_GPU_GetRamBusWidth(gpu, &busWidth) == NVAPI_OK)
+        if(PROBE_CALL(NvAPI_GPU_GetRamBusWidth, gpu, &busWidth) == NVAPI_OK)
             formatter.AddFieldUint32(L"NvAPI_GPU_GetRamBusWidth", busWidth);
     }
 
     {
         NV_GPU_INFO gpuInfo = { NV_GPU_INFO_VER };
-        if(NvAPI_GPU_GetGPUInfo(gpu, &gpuInfo) == NVAPI_OK)
+        if(PROBE_CALL(NvAPI_GPU_GetGPUInfo, gpu, &gpuInfo) == NVAPI_OK)
         {
             formatter.AddFieldBool(L"NvAPI_GPU_GetGPUInfo - NV_GPU_INFO::bIsExternalGpu", gpuInfo.bIsExternalGpu);
             formatter.AddFieldUint32(L"NvAPI_GPU_GetGPUInfo - NV_GPU_INFO::rayTracingCores", gpuInfo.rayTracingCores);
@@ -956,7 +1005,7 @@ void NvAPI_Inititalize_RAII::PrintPhysicalGpuData(const LUID& adapterLuid)
 
     {
         NV_GPU_GSP_INFO gspInfo = { NV_GPU_GSP_INFO_VER };
-        if(NvAPI_GPU_GetGspFeatures(gpu, &gspInfo) == NVAPI_OK)
+        if(PROBE_CALL(NvAPI_GPU_GetGspFeatures, gpu, &gspInfo) == NVAPI_OK)
         {
             formatter.AddFieldHexBytes(L"NvAPI_GPU_GetGspFeatures - NV_GPU_GSP_INFO::firmwareVersion",
                 gspInfo.firmwareVersion, NVAPI_GPU_MAX_BUILD_VERSION_LENGTH);
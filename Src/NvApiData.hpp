@@ -9,6 +9,8 @@ For more information, see files README.md, LICENSE.txt.
 */
 #pragma once
 
+struct NvGpuCounters;
+
 // Macro set by Cmake.
 #if USE_NVAPI
 
@@ -17,6 +19,8 @@ class NvAPI_Inititalize_RAII
 public:
     // Prints parameters related to NVAPI itself, regardless of whether intialization succeeded.
     static void PrintStaticParams();
+    // Prints the version of nvapi64.dll. Loads it, so call it only if an adapter needs NVAPI.
+    static void PrintLibraryVersion();
 
     NvAPI_Inititalize_RAII();
     ~NvAPI_Inititalize_RAII();
@@ -29,6 +33,9 @@ public:
     void PrintData();
     void PrintD3d12DeviceData(ID3D12Device* device);
     void PrintPhysicalGpuData(const LUID& adapterLuid);
+    // Reads current counters of the physical GPU of the adapter, for --MonitorNvApi.
+    // Returns false if it's not an NVIDIA GPU or its memory info could not be read.
+    bool GetGpuCounters(const LUID& adapterLuid, NvGpuCounters& outCounters);
 
 private:
     bool m_Initialized = false;
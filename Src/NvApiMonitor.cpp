@@ -0,0 +1,125 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "NvApiMonitor.hpp"
+
+#include "Printer.hpp"
+#include "Utils.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static const wchar_t* const CSV_HEADER = L"TimeMs,Adapter,EvictionsSize,EvictionCount,PromotionsSize,PromotionCount,"
+                                         L"CurAvailableDedicatedVideoMemory,GraphicsClockKHz,MemoryClockKHz,"
+                                         L"PerformanceState";
+
+static uint64_t GetCounterDelta(uint64_t prev, uint64_t curr)
+{
+    return curr >= prev ? curr - prev : curr;
+}
+
+// Unknown values are left empty in CSV and omitted from JSON.
+static void AppendValue(std::wstring& line, bool json, const wchar_t* name, uint64_t value)
+{
+    if(json)
+        line += std::format(L",\"{}\":{}", name, value);
+    else
+        line += std::format(L",{}", value);
+}
+static void AppendOptionalValue(std::wstring& line, bool json, const wchar_t* name, uint32_t value)
+{
+    if(value != NvGpuCounters::UNKNOWN)
+        AppendValue(line, json, name, value);
+    else if(!json)
+        line += L',';
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+NvGpuCounters GetNvGpuCountersDelta(const NvGpuCounters& prev, const NvGpuCounters& curr)
+{
+    NvGpuCounters delta = curr;
+    delta.m_EvictionsSize = GetCounterDelta(prev.m_EvictionsSize, curr.m_EvictionsSize);
+    delta.m_EvictionCount = GetCounterDelta(prev.m_EvictionCount, curr.m_EvictionCount);
+    delta.m_PromotionsSize = GetCounterDelta(prev.m_PromotionsSize, curr.m_PromotionsSize);
+    delta.m_PromotionCount = GetCounterDelta(prev.m_PromotionCount, curr.m_PromotionCount);
+    return delta;
+}
+
+NvApiMonitor::NvApiMonitor(std::vector<uint32_t> adapterIndices, SampleFunc sampleFunc,
+    std::chrono::milliseconds interval, bool json)
+    : m_AdapterIndices(std::move(adapterIndices))
+    , m_SampleFunc(std::move(sampleFunc))
+    , m_Interval(interval)
+    , m_Json(json)
+    , m_PrevCounters(m_AdapterIndices.size())
+{
+}
+
+void NvApiMonitor::Run()
+{
+    if(!m_Json)
+    {
+        Printer::PrintString(CSV_HEADER);
+        Printer::PrintNewLine();
+    }
+
+    CtrlCScope ctrlCScope;
+    // Ticks are scheduled from the start, so the interval doesn't drift by the time of sampling.
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point nextTickTime = startTime;
+    while(true)
+    {
+        Tick(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime));
+
+        // If sampling fell behind, the ticks missed are skipped, so the next delta covers a longer time.
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        do
+            nextTickTime += m_Interval;
+        while(nextTickTime <= now);
+        if(ctrlCScope.Wait(std::chrono::ceil<std::chrono::milliseconds>(nextTickTime - now)))
+            break;
+    }
+}
+
+void NvApiMonitor::Tick(std::chrono::milliseconds time)
+{
+    for(size_t i = 0; i < m_AdapterIndices.size(); ++i)
+    {
+        NvGpuCounters counters;
+        if(!m_SampleFunc(m_AdapterIndices[i], counters))
+            continue;
+        std::optional<NvGpuCounters>& prevCounters = m_PrevCounters[i];
+        // The first sample is only the base for the deltas.
+        if(prevCounters)
+        {
+            const NvGpuCounters delta = GetNvGpuCountersDelta(*prevCounters, counters);
+            m_Line.clear();
+            if(m_Json)
+                m_Line += std::format(L"{{\"TimeMs\":{},\"Adapter\":{}", time.count(), m_AdapterIndices[i]);
+            else
+                m_Line += std::format(L"{},{}", time.count(), m_AdapterIndices[i]);
+            AppendValue(m_Line, m_Json, L"EvictionsSize", delta.m_EvictionsSize);
+            AppendValue(m_Line, m_Json, L"EvictionCount", delta.m_EvictionCount);
+            AppendValue(m_Line, m_Json, L"PromotionsSize", delta.m_PromotionsSize);
+            AppendValue(m_Line, m_Json, L"PromotionCount", delta.m_PromotionCount);
+            AppendValue(m_Line, m_Json, L"CurAvailableDedicatedVideoMemory", delta.m_CurAvailableDedicatedVideoMemory);
+            AppendOptionalValue(m_Line, m_Json, L"GraphicsClockKHz", delta.m_GraphicsClockKHz);
+            AppendOptionalValue(m_Line, m_Json, L"MemoryClockKHz", delta.m_MemoryClockKHz);
+            AppendOptionalValue(m_Line, m_Json, L"PerformanceState", delta.m_PerformanceState);
+            if(m_Json)
+                m_Line += L'}';
+            // New line flushes the output, so each interval can be watched as it comes.
+            Printer::PrintString(m_Line);
+            Printer::PrintNewLine();
+        }
+        prevCounters = counters;
+    }
+}
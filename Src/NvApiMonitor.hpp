@@ -0,0 +1,58 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Values of NV_GPU_MEMORY_INFO_EX, clocks and performance state of a GPU at one moment, for --MonitorNvApi.
+// They are plain values independent of NVAPI, so deltas can also be computed from made-up samples.
+struct NvGpuCounters
+{
+    static constexpr uint32_t UNKNOWN = UINT32_MAX;
+
+    uint64_t m_CurAvailableDedicatedVideoMemory = 0;
+    // Cumulative since the driver started.
+    uint64_t m_EvictionsSize = 0;
+    uint64_t m_EvictionCount = 0;
+    uint64_t m_PromotionsSize = 0;
+    uint64_t m_PromotionCount = 0;
+    uint32_t m_GraphicsClockKHz = UNKNOWN;
+    uint32_t m_MemoryClockKHz = UNKNOWN;
+    // NV_GPU_PERF_PSTATE_ID.
+    uint32_t m_PerformanceState = UNKNOWN;
+};
+
+// Returns curr with its cumulative counters replaced by how much they grew since prev.
+// A counter lower than before means the driver was restarted, so it grew by its whole current value.
+NvGpuCounters GetNvGpuCountersDelta(const NvGpuCounters& prev, const NvGpuCounters& curr);
+
+// Samples counters of GPUs at a fixed interval and prints how they changed during each interval as a time series,
+// one line of CSV or NDJSON per GPU and interval.
+class NvApiMonitor
+{
+public:
+    // Reads counters of the GPU of the adapter. Returns false if they are not available.
+    using SampleFunc = std::function<bool(uint32_t adapterIndex, NvGpuCounters& outCounters)>;
+
+    NvApiMonitor(std::vector<uint32_t> adapterIndices, SampleFunc sampleFunc, std::chrono::milliseconds interval,
+        bool json);
+
+    // Samples on the calling thread until Ctrl+C or Ctrl+Break. The output must be open.
+    void Run();
+    // Samples each GPU once and prints changes since its previous sample. Run calls it after each interval.
+    void Tick(std::chrono::milliseconds time);
+
+private:
+    const std::vector<uint32_t> m_AdapterIndices;
+    const SampleFunc m_SampleFunc;
+    const std::chrono::milliseconds m_Interval;
+    const bool m_Json;
+    // For each adapter, empty until it's sampled successfully.
+    std::vector<std::optional<NvGpuCounters>> m_PrevCounters;
+    std::wstring m_Line;
+};
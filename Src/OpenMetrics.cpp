@@ -0,0 +1,320 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "OpenMetrics.hpp"
+
+#include "Utils.hpp"
+
+#include <charconv>
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+
+    #pragma comment(lib, "ws2_32.lib")
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+#ifdef _WIN32
+static const int SEND_FLAGS = 0;
+#else
+using SOCKET = int;
+static const SOCKET INVALID_SOCKET = -1;
+static const int SOCKET_ERROR = -1;
+static const int SD_SEND = SHUT_WR;
+// A client that closes the connection early must not stop the program with SIGPIPE.
+static const int SEND_FLAGS = MSG_NOSIGNAL;
+
+static int closesocket(SOCKET socket)
+{
+    return close(socket);
+}
+#endif
+
+static const uint32_t SEGMENT_GROUP_COUNT = 2;
+static const char* const SEGMENT_GROUP_LABELS[SEGMENT_GROUP_COUNT] = { "local", "non_local" };
+
+struct VideoMemoryMetric
+{
+    const char* m_Name;
+    const char* m_Help;
+    uint64_t VideoMemoryInfo::*m_Member;
+};
+
+static const VideoMemoryMetric VIDEO_MEMORY_METRICS[] = {
+    { "d3d12info_video_memory_budget_bytes", "DXGI_QUERY_VIDEO_MEMORY_INFO::Budget.", &VideoMemoryInfo::m_Budget },
+    { "d3d12info_video_memory_current_usage_bytes", "DXGI_QUERY_VIDEO_MEMORY_INFO::CurrentUsage.",
+        &VideoMemoryInfo::m_CurrentUsage },
+    { "d3d12info_video_memory_available_for_reservation_bytes",
+        "DXGI_QUERY_VIDEO_MEMORY_INFO::AvailableForReservation.", &VideoMemoryInfo::m_AvailableForReservation },
+    { "d3d12info_video_memory_current_reservation_bytes", "DXGI_QUERY_VIDEO_MEMORY_INFO::CurrentReservation.",
+        &VideoMemoryInfo::m_CurrentReservation },
+};
+
+static const std::string_view END_OF_METRICS = "# EOF\n";
+// Digits of the longest uint64_t.
+static const size_t MAX_VALUE_LENGTH = 20;
+
+static std::string EscapeLabelValue(const wchar_t* value)
+{
+    const std::string utf8 = WstrToStr(value, CP_UTF8);
+    std::string result;
+    for(char ch : utf8)
+    {
+        if(ch == '\\')
+            result += "\\\\";
+        else if(ch == '"')
+            result += "\\\"";
+        else if(ch == '\n')
+            result += "\\n";
+        else
+            result += ch;
+    }
+    return result;
+}
+
+static std::string MicrosoftVersionToStr(uint64_t value)
+{
+    return std::format("{}.{}.{}.{}", value >> 48, (value >> 32) & 0xFFFF, (value >> 16) & 0xFFFF, value & 0xFFFF);
+}
+
+// Lines before the samples of a gauge metric family, all of which are in bytes.
+static std::string MakeGaugeMetadata(std::string_view name, std::string_view help)
+{
+    return std::format("# TYPE {0} gauge\n# UNIT {0} bytes\n# HELP {0} {1}\n", name, help);
+}
+
+// Unlike send, doesn't return until all data is sent or the connection fails.
+static bool SendAll(SOCKET socket, const char* data, size_t size)
+{
+    while(size > 0)
+    {
+        const int sent = int(send(socket, data, int(std::min<size_t>(size, INT_MAX)), SEND_FLAGS));
+        if(sent == SOCKET_ERROR)
+            return false;
+        data += sent;
+        size -= size_t(sent);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+const char* const OpenMetricsExporter::CONTENT_TYPE = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+OpenMetricsExporter::OpenMetricsExporter(std::vector<Adapter> adapters, MemoryMonitor::QueryFunc queryFunc)
+    : m_Adapters(std::move(adapters))
+    , m_QueryFunc(std::move(queryFunc))
+    , m_VideoMemoryInfo(m_Adapters.size() * SEGMENT_GROUP_COUNT)
+    , m_VideoMemoryInfoValid(m_Adapters.size() * SEGMENT_GROUP_COUNT)
+{
+
+    m_Buffer += "# TYPE d3d12info_build info\n# HELP d3d12info_build Version of D3d12info.\n";
+    m_Buffer += std::format("d3d12info_build_info{{version=\"{}\"}} 1\n", EscapeLabelValue(PROGRAM_VERSION));
+
+    m_Buffer += "# TYPE d3d12info_adapter info\n# HELP d3d12info_adapter DXGI_ADAPTER_DESC1 of the adapter.\n";
+    for(const Adapter& adapter : m_Adapters)
+    {
+        const std::string driverVersion =
+            adapter.m_DriverVersion != 0 ? MicrosoftVersionToStr(adapter.m_DriverVersion) : std::string();
+        m_Buffer += std::format("d3d12info_adapter_info{{adapter=\"{}\",description=\"{}\",vendor_id=\"0x{:04X}\","
+                                "device_id=\"0x{:04X}\",subsys_id=\"0x{:08X}\",revision=\"0x{:X}\","
+                                "driver_version=\"{}\",software=\"{}\"}} 1\n",
+            adapter.m_Index, EscapeLabelValue(adapter.m_Description.c_str()), adapter.m_VendorId, adapter.m_DeviceId,
+            adapter.m_SubSysId, adapter.m_Revision, driverVersion, adapter.m_Software);
+    }
+
+    m_Buffer += MakeGaugeMetadata("d3d12info_adapter_dedicated_video_memory_bytes",
+        "DXGI_ADAPTER_DESC1::DedicatedVideoMemory.");
+    for(const Adapter& adapter : m_Adapters)
+        m_Buffer += std::format("d3d12info_adapter_dedicated_video_memory_bytes{{adapter=\"{}\"}} {}\n",
+            adapter.m_Index, adapter.m_DedicatedVideoMemory);
+    m_Buffer += MakeGaugeMetadata("d3d12info_adapter_dedicated_system_memory_bytes",
+        "DXGI_ADAPTER_DESC1::DedicatedSystemMemory.");
+    for(const Adapter& adapter : m_Adapters)
+        m_Buffer += std::format("d3d12info_adapter_dedicated_system_memory_bytes{{adapter=\"{}\"}} {}\n",
+            adapter.m_Index, adapter.m_DedicatedSystemMemory);
+    m_Buffer += MakeGaugeMetadata("d3d12info_adapter_shared_system_memory_bytes",
+        "DXGI_ADAPTER_DESC1::SharedSystemMemory.");
+    for(const Adapter& adapter : m_Adapters)
+        m_Buffer += std::format("d3d12info_adapter_shared_system_memory_bytes{{adapter=\"{}\"}} {}\n",
+            adapter.m_Index, adapter.m_SharedSystemMemory);
+    m_StaticSize = m_Buffer.size();
+
+    // Reserves the longest text Render can append, so it never has to grow the buffer.
+    size_t maxSampleLabelsLength = 0;
+    for(const Adapter& adapter : m_Adapters)
+    {
+        for(const char* segmentGroup : SEGMENT_GROUP_LABELS)
+        {
+            const std::string& labels = m_SampleLabels.emplace_back(
+                std::format("{{adapter=\"{}\",segment_group=\"{}\"}}", adapter.m_Index, segmentGroup));
+            maxSampleLabelsLength = std::max(maxSampleLabelsLength, labels.size());
+        }
+    }
+    size_t dynamicSize = END_OF_METRICS.size();
+    for(const VideoMemoryMetric& metric : VIDEO_MEMORY_METRICS)
+    {
+        dynamicSize += m_VideoMemoryMetadata.emplace_back(MakeGaugeMetadata(metric.m_Name, metric.m_Help)).size();
+        dynamicSize +=
+            m_SampleLabels.size() * (strlen(metric.m_Name) + maxSampleLabelsLength + MAX_VALUE_LENGTH + 2);
+    }
+    m_Buffer.reserve(m_StaticSize + dynamicSize);
+}
+
+std::string_view OpenMetricsExporter::Render()
+{
+    for(size_t i = 0; i < m_VideoMemoryInfo.size(); ++i)
+        m_VideoMemoryInfoValid[i] = m_QueryFunc(
+            m_Adapters[i / SEGMENT_GROUP_COUNT].m_Index, uint32_t(i % SEGMENT_GROUP_COUNT), m_VideoMemoryInfo[i]);
+
+    // Shrinking and appending within the capacity reserved don't allocate.
+    m_Buffer.resize(m_StaticSize);
+    for(size_t metricIndex = 0; metricIndex < std::size(VIDEO_MEMORY_METRICS); ++metricIndex)
+    {
+        const VideoMemoryMetric& metric = VIDEO_MEMORY_METRICS[metricIndex];
+        m_Buffer += m_VideoMemoryMetadata[metricIndex];
+        for(size_t i = 0; i < m_VideoMemoryInfo.size(); ++i)
+        {
+            if(!m_VideoMemoryInfoValid[i])
+                continue;
+            m_Buffer += metric.m_Name;
+            m_Buffer += m_SampleLabels[i];
+            m_Buffer += ' ';
+            AppendValue(m_VideoMemoryInfo[i].*metric.m_Member);
+            m_Buffer += '\n';
+        }
+    }
+    m_Buffer += END_OF_METRICS;
+    return m_Buffer;
+}
+
+void OpenMetricsExporter::AppendValue(uint64_t value)
+{
+    char digits[MAX_VALUE_LENGTH];
+    const std::to_chars_result result = std::to_chars(digits, digits + MAX_VALUE_LENGTH, value);
+    m_Buffer.append(digits, result.ptr);
+}
+
+OpenMetricsServer::OpenMetricsServer(uint16_t port)
+{
+#ifdef _WIN32
+    WSADATA wsaData = {};
+    if(WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+        throw std::runtime_error("Could not initialize Windows Sockets.");
+#endif
+
+    const SOCKET listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addressSize = sizeof(address);
+    if(listenSocket == INVALID_SOCKET || bind(listenSocket, (const sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(listenSocket, SOMAXCONN) != 0 || getsockname(listenSocket, (sockaddr*)&address, &addressSize) != 0)
+    {
+        if(listenSocket != INVALID_SOCKET)
+            closesocket(listenSocket);
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        throw std::runtime_error(std::format("Could not listen on port {}.", port));
+    }
+    m_Socket = uintptr_t(listenSocket);
+    m_Port = ntohs(address.sin_port);
+}
+
+OpenMetricsServer::~OpenMetricsServer()
+{
+    closesocket(SOCKET(m_Socket));
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+void OpenMetricsServer::Run(OpenMetricsExporter& exporter)
+{
+    while(true)
+        AnswerRequest(exporter);
+}
+
+void OpenMetricsServer::AnswerRequest(OpenMetricsExporter& exporter)
+{
+    // A client that never finishes its request doesn't stop others for longer.
+    static const uint32_t RECEIVE_TIMEOUT_MILLISECONDS = 1000;
+
+    char request[4096];
+    char header[256];
+    SOCKET client = INVALID_SOCKET;
+    while(client == INVALID_SOCKET)
+        client = accept(SOCKET(m_Socket), NULL, NULL);
+
+#ifdef _WIN32
+    const DWORD receiveTimeout = RECEIVE_TIMEOUT_MILLISECONDS;
+#else
+    const timeval receiveTimeout = {
+        RECEIVE_TIMEOUT_MILLISECONDS / 1000, RECEIVE_TIMEOUT_MILLISECONDS % 1000 * 1000 };
+#endif
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, (const char*)&receiveTimeout, sizeof(receiveTimeout));
+
+    // Reads the request until the end of its headers. Requests that don't fit are answered all the same.
+    size_t requestSize = 0;
+    bool received = false;
+    while(!received && requestSize < sizeof(request))
+    {
+        const int size = int(recv(client, request + requestSize, int(sizeof(request) - requestSize), 0));
+        if(size <= 0)
+            break;
+        requestSize += size_t(size);
+        received = std::string_view(request, requestSize).find("\r\n\r\n") != std::string_view::npos;
+    }
+
+    if(received || requestSize == sizeof(request))
+    {
+        const std::string_view body = exporter.Render();
+        const std::format_to_n_result<char*> headerEnd = std::format_to_n(header, sizeof(header),
+            "HTTP/1.1 200 OK\r\nContent-Type: {}\r\nContent-Length: {}\r\nConnection: close\r\n\r\n",
+            OpenMetricsExporter::CONTENT_TYPE, body.size());
+        if(SendAll(client, header, size_t(headerEnd.out - header)))
+            SendAll(client, body.data(), body.size());
+    }
+    shutdown(client, SD_SEND);
+    closesocket(client);
+}
+
+void WriteOpenMetricsFile(OpenMetricsExporter& exporter, const std::wstring& filePath)
+{
+    const std::string_view metrics = exporter.Render();
+    const std::wstring tempFilePath = filePath + L".tmp";
+    {
+        std::ofstream file(std::filesystem::path(tempFilePath), std::ios::binary);
+        file.write(metrics.data(), std::streamsize(metrics.size()));
+        if(!file)
+        {
+            const std::string narrowPath = WstrToStr(tempFilePath.c_str(), CP_ACP);
+            throw std::runtime_error(std::format("Could not write {}.", narrowPath));
+        }
+    }
+    // Replaces the file in one step.
+    std::error_code error;
+    std::filesystem::rename(tempFilePath, filePath, error);
+    if(error)
+    {
+        const std::string narrowPath = WstrToStr(filePath.c_str(), CP_ACP);
+        throw std::runtime_error(std::format("Could not replace {}.", narrowPath));
+    }
+}
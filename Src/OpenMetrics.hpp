@@ -0,0 +1,82 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+#include "MemoryMonitor.hpp"
+
+// Renders metrics of adapters in OpenMetrics text exposition format, for --Metrics and --MetricsFile.
+// Facts that don't change, like DXGI_ADAPTER_DESC1, are rendered once when it's created, as info metrics and gauges.
+// Each Render only queries DXGI_QUERY_VIDEO_MEMORY_INFO and appends it as gauges to the same buffer, reserved
+// up front, so scrapes don't allocate memory. No D3D12 device is ever created.
+class OpenMetricsExporter
+{
+public:
+    // Facts about an adapter, from DXGI_ADAPTER_DESC1.
+    struct Adapter
+    {
+        uint32_t m_Index = 0;
+        std::wstring m_Description;
+        uint32_t m_VendorId = 0;
+        uint32_t m_DeviceId = 0;
+        uint32_t m_SubSysId = 0;
+        uint32_t m_Revision = 0;
+        uint64_t m_DedicatedVideoMemory = 0;
+        uint64_t m_DedicatedSystemMemory = 0;
+        uint64_t m_SharedSystemMemory = 0;
+        bool m_Software = false;
+        // UMD version from IDXGIAdapter::CheckInterfaceSupport, 0 if unknown.
+        uint64_t m_DriverVersion = 0;
+    };
+
+    static const char* const CONTENT_TYPE;
+
+    OpenMetricsExporter(std::vector<Adapter> adapters, MemoryMonitor::QueryFunc queryFunc);
+
+    // Returned text is valid until the next call.
+    std::string_view Render();
+
+private:
+    const std::vector<Adapter> m_Adapters;
+    const MemoryMonitor::QueryFunc m_QueryFunc;
+    // Labels of the samples of each adapter and segment group, like {adapter="0",segment_group="local"}.
+    std::vector<std::string> m_SampleLabels;
+    // For each of the metrics of video memory.
+    std::vector<std::string> m_VideoMemoryMetadata;
+    std::vector<VideoMemoryInfo> m_VideoMemoryInfo;
+    std::vector<bool> m_VideoMemoryInfoValid;
+    std::string m_Buffer;
+    // Length of the part rendered when created.
+    size_t m_StaticSize = 0;
+
+    void AppendValue(uint64_t value);
+};
+
+// Answers HTTP requests on a port of localhost with the metrics, whatever the path requested.
+class OpenMetricsServer
+{
+public:
+    // Starts listening. Port 0 picks a free port. Throws on failure.
+    explicit OpenMetricsServer(uint16_t port);
+    ~OpenMetricsServer();
+
+    uint16_t GetPort() const { return m_Port; }
+    // Answers requests one at a time until the program is stopped.
+    [[noreturn]] void Run(OpenMetricsExporter& exporter);
+    // Waits for a connection and answers its request.
+    void AnswerRequest(OpenMetricsExporter& exporter);
+
+private:
+    uintptr_t m_Socket;
+    uint16_t m_Port;
+};
+
+// Writes the metrics to a temporary file and moves it over the file, so readers never see it partially written.
+// Throws on failure.
+void WriteOpenMetricsFile(OpenMetricsExporter& exporter, const std::wstring& filePath);
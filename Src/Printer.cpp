@@ -9,63 +9,95 @@ For more information, see files README.md, LICENSE.txt.
 */
 #include "Printer.hpp"
 
+#include "ReportStats.hpp"
+#include "Trace.hpp"
 #include "Utils.hpp"
 
-bool Printer::m_IsInitialized = false;
-bool Printer::m_WritingToFile = false;
-std::wostream* Printer::m_Output = nullptr;
+Printer::State Printer::m_State;
+thread_local Printer::State* Printer::m_ThreadState = nullptr;
 
 bool Printer::Initialize(bool writeToFile, std::wstring_view name)
 {
-    assert(!m_IsInitialized);
+    State& state = GetState();
+    assert(!state.m_IsInitialized);
     if(writeToFile)
     {
-        m_Output = new std::wofstream(name.data(), std::ios_base::out);
-        if(!m_Output->good())
+        state.m_Output = new std::wofstream(std::filesystem::path(name), std::ios_base::out);
+        if(!state.m_Output->good())
         {
-            delete m_Output;
-            m_Output = nullptr;
+            delete state.m_Output;
+            state.m_Output = nullptr;
             return false;
         }
+        state.m_WritingToFile = true;
     }
     else
     {
-        m_Output = &std::wcout;
+        state.m_Output = &std::wcout;
     }
-    m_IsInitialized = true;
+    state.m_IsInitialized = true;
     return true;
 }
 
 void Printer::Release()
 {
-    assert(m_IsInitialized);
-    if(m_WritingToFile)
+    TraceSpan traceSpan(L"FlushOutput");
+    State& state = GetState();
+    assert(state.m_IsInitialized);
+    state.m_Output->flush();
+    if(state.m_WritingToFile)
     {
-        delete m_Output;
+        delete state.m_Output;
     }
-    m_Output = nullptr;
-    m_WritingToFile = false;
-    m_IsInitialized = false;
+    state.m_Output = nullptr;
+    state.m_Captures.clear();
+    state.m_SuppressOutputCount = 0;
+    state.m_WritingToFile = false;
+    state.m_IsInitialized = false;
 }
 
 void Printer::PrintNewLine()
 {
-    assert(m_IsInitialized);
-    *m_Output << std::endl;
+    State& state = GetState();
+    assert(state.m_IsInitialized);
+    if(state.m_SuppressOutputCount == 0)
+    {
+        *state.m_Output << std::endl;
+        // Written as CR LF.
+        ReportStats::AddOutput(2);
+    }
+    AppendToCaptures(state, L"\n");
 }
 
 void Printer::PrintString(const std::string& line)
 {
-    assert(m_IsInitialized);
+    State& state = GetState();
+    assert(state.m_IsInitialized);
 
-    *m_Output << line.c_str();
+    if(state.m_SuppressOutputCount == 0)
+    {
+        *state.m_Output << line.c_str();
+        ReportStats::AddOutput(line.length());
+    }
+    if(!state.m_Captures.empty())
+    {
+        const std::wstring wideLine(line.begin(), line.end());
+        AppendToCaptures(state, wideLine);
+    }
 }
 
 void Printer::PrintString(std::wstring_view line)
 {
-    assert(m_IsInitialized);
+    State& state = GetState();
+    assert(state.m_IsInitialized);
 
-    *m_Output << line;
+    if(state.m_SuppressOutputCount == 0)
+    {
+        *state.m_Output << line;
+        // A byte for each character, as written by the default locale.
+        ReportStats::AddOutput(line.length());
+    }
+    AppendToCaptures(state, line);
 }
 
 void Printer::PrintFormat(std::string_view format, std::format_args&& args)
@@ -80,6 +112,41 @@ void Printer::PrintFormat(std::wstring_view format, std::wformat_args&& args)
     PrintString(formatted);
 }
 
+void Printer::BeginCapture(bool writeToOutput)
+{
+    State& state = GetState();
+    assert(state.m_IsInitialized);
+    Capture& capture = state.m_Captures.emplace_back();
+    capture.m_WriteToOutput = writeToOutput;
+    if(!writeToOutput)
+        ++state.m_SuppressOutputCount;
+}
+
+std::wstring Printer::EndCapture()
+{
+    State& state = GetState();
+    assert(!state.m_Captures.empty());
+    std::wstring result = std::move(state.m_Captures.back().m_Text);
+    if(!state.m_Captures.back().m_WriteToOutput)
+        --state.m_SuppressOutputCount;
+    state.m_Captures.pop_back();
+    return result;
+}
+
+void Printer::AppendToCaptures(State& state, std::wstring_view str)
+{
+    // Text doesn't reach past the innermost capture that doesn't write to the output.
+    size_t firstIndex = state.m_Captures.size();
+    while(firstIndex > 0)
+    {
+        --firstIndex;
+        if(!state.m_Captures[firstIndex].m_WriteToOutput)
+            break;
+    }
+    for(size_t i = firstIndex; i < state.m_Captures.size(); ++i)
+        state.m_Captures[i].m_Text.append(str);
+}
+
 PrinterScope::PrinterScope(bool writeToFile, std::wstring_view name)
 {
     if(!Printer::Initialize(writeToFile, name))
@@ -102,6 +169,25 @@ PrinterScope::~PrinterScope()
     Printer::Release();
 }
 
+PrinterThreadScope::PrinterThreadScope(bool writeToFile, std::wstring_view name)
+{
+    assert(Printer::m_ThreadState == nullptr);
+    Printer::m_ThreadState = &m_State;
+    if(!Printer::Initialize(writeToFile, name))
+    {
+        Printer::m_ThreadState = nullptr;
+        std::wstring nameNullTerminated(name.begin(), name.end());
+        std::string narrowName = WstrToStr(nameNullTerminated.c_str(), CP_ACP);
+        throw std::runtime_error(std::format("Could not open {} for writing.", narrowName));
+    }
+}
+
+PrinterThreadScope::~PrinterThreadScope()
+{
+    Printer::Release();
+    Printer::m_ThreadState = nullptr;
+}
+
 void ErrorPrinter::PrintFormat(std::string_view format, std::format_args&& args)
 {
     std::string formatted = std::vformat(format, args);
@@ -26,10 +26,40 @@ public:
     static void PrintFormat(std::string_view format, std::format_args&& args);
     static void PrintFormat(std::wstring_view format, std::wformat_args&& args);
 
+    // Starts collecting a copy of everything printed from now on.
+    // If writeToOutput is false, printed text goes only to the capture and those nested in it, not to the output or
+    // the captures outside it.
+    // Captures can be nested - each one receives everything printed while it is active.
+    static void BeginCapture(bool writeToOutput = true);
+    // Stops collecting and returns everything printed since the matching BeginCapture.
+    static std::wstring EndCapture();
+
 private:
-    static bool m_IsInitialized;
-    static bool m_WritingToFile;
-    static std::wostream* m_Output;
+    friend class PrinterThreadScope;
+
+    struct Capture
+    {
+        std::wstring m_Text;
+        bool m_WriteToOutput = true;
+    };
+    struct State
+    {
+        bool m_IsInitialized = false;
+        bool m_WritingToFile = false;
+        std::wostream* m_Output = nullptr;
+        std::vector<Capture> m_Captures;
+        // Number of active captures with m_WriteToOutput = false.
+        uint32_t m_SuppressOutputCount = 0;
+    };
+    // Shared by all threads, except those that print to their own output with PrinterThreadScope.
+    static State m_State;
+    static thread_local State* m_ThreadState;
+
+    static State& GetState()
+    {
+        return m_ThreadState ? *m_ThreadState : m_State;
+    }
+    static void AppendToCaptures(State& state, std::wstring_view str);
 };
 
 class PrinterScope
@@ -39,6 +69,17 @@ public:
     ~PrinterScope();
 };
 
+// Gives the calling thread its own output, instead of the one shared by all threads, for the time it exists.
+class PrinterThreadScope
+{
+public:
+    PrinterThreadScope(bool writeToFile, std::wstring_view name);
+    ~PrinterThreadScope();
+
+private:
+    Printer::State m_State;
+};
+
 class ErrorPrinter
 {
 public:
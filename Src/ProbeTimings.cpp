@@ -0,0 +1,149 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "ProbeTimings.hpp"
+
+#include "ReportFormatter/ReportFormatter.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+struct ProbeData
+{
+    const wchar_t* m_Name = nullptr;
+    std::vector<ProbeTimings::Clock::duration> m_Samples;
+    ProbeTimings::Clock::duration m_TotalTime = {};
+};
+
+struct GroupData
+{
+    std::wstring m_Name;
+    std::vector<ProbeData> m_Probes;
+    // Probe names are static strings, so views of them can be used as keys.
+    std::unordered_map<std::wstring_view, size_t> m_ProbeIndices;
+};
+
+static const wchar_t* const GROUP_SEPARATOR = L" / ";
+static const wchar_t* const DEFAULT_GROUP_NAME = L"Other";
+
+// Probes can be issued from multiple threads. It guards g_Groups and g_GroupIndices.
+static std::mutex g_Mutex;
+// In the order of first use.
+static std::vector<GroupData> g_Groups;
+static std::unordered_map<std::wstring, size_t> g_GroupIndices;
+// Indices into g_Groups. Each thread has its own groups active.
+static thread_local std::vector<size_t> g_GroupStack;
+
+static size_t FindOrAddGroup(const std::wstring& name)
+{
+    if(auto it = g_GroupIndices.find(name); it != g_GroupIndices.end())
+        return it->second;
+    const size_t index = g_Groups.size();
+    g_Groups.emplace_back().m_Name = name;
+    g_GroupIndices.emplace(name, index);
+    return index;
+}
+
+static float ToMilliseconds(ProbeTimings::Clock::duration duration)
+{
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+static void PrintProbe(ProbeData& probe)
+{
+    const size_t count = probe.m_Samples.size();
+    // Nearest-rank percentile.
+    const size_t p99Index = (count * 99 + 99) / 100 - 1;
+    std::nth_element(probe.m_Samples.begin(), probe.m_Samples.begin() + p99Index, probe.m_Samples.end());
+    const ProbeTimings::Clock::duration p99Time = probe.m_Samples[p99Index];
+    const ProbeTimings::Clock::duration maxTime = *std::max_element(probe.m_Samples.begin(), probe.m_Samples.end());
+
+    ReportScopeObject scope(probe.m_Name);
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.AddFieldUint32(L"Count", uint32_t(count));
+    formatter.AddFieldFloat(L"Total", ToMilliseconds(probe.m_TotalTime), L"ms");
+    formatter.AddFieldFloat(L"Max", ToMilliseconds(maxTime), L"ms");
+    formatter.AddFieldFloat(L"P99", ToMilliseconds(p99Time), L"ms");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+bool ProbeTimings::s_Enabled = false;
+
+void ProbeTimings::Enable()
+{
+    s_Enabled = true;
+}
+
+void ProbeTimings::AddSample(const wchar_t* probeName, Clock::duration duration)
+{
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    const size_t groupIndex = g_GroupStack.empty() ? FindOrAddGroup(DEFAULT_GROUP_NAME) : g_GroupStack.back();
+    GroupData& group = g_Groups[groupIndex];
+
+    auto [it, inserted] = group.m_ProbeIndices.emplace(probeName, group.m_Probes.size());
+    if(inserted)
+        group.m_Probes.emplace_back().m_Name = probeName;
+
+    ProbeData& probe = group.m_Probes[it->second];
+    probe.m_Samples.push_back(duration);
+    probe.m_TotalTime += duration;
+}
+
+void ProbeTimings::PushGroup(std::wstring_view name)
+{
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    std::wstring path;
+    if(!g_GroupStack.empty())
+    {
+        path = g_Groups[g_GroupStack.back()].m_Name;
+        path += GROUP_SEPARATOR;
+    }
+    path += name;
+    g_GroupStack.push_back(FindOrAddGroup(path));
+}
+
+void ProbeTimings::PopGroup()
+{
+    assert(!g_GroupStack.empty());
+    g_GroupStack.pop_back();
+}
+
+void ProbeTimings::PrintReport()
+{
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    ReportScopeObject scope(L"Timings");
+
+    for(GroupData& group : g_Groups)
+    {
+        if(group.m_Probes.empty())
+            continue;
+
+        // Most expensive probes first.
+        std::vector<ProbeData*> sortedProbes;
+        sortedProbes.reserve(group.m_Probes.size());
+        for(ProbeData& probe : group.m_Probes)
+            sortedProbes.push_back(&probe);
+        std::sort(sortedProbes.begin(), sortedProbes.end(),
+            [](const ProbeData* lhs, const ProbeData* rhs) { return lhs->m_TotalTime > rhs->m_TotalTime; });
+
+        ReportScopeObject groupScope(group.m_Name);
+        for(ProbeData* probe : sortedProbes)
+            PrintProbe(*probe);
+    }
+}
+
+void ProbeTimings::Clear()
+{
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    assert(g_GroupStack.empty());
+    g_Groups.clear();
+    g_GroupIndices.clear();
+}
@@ -0,0 +1,118 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+#include "Benchmark.hpp"
+#include "Trace.hpp"
+#include "Watchdog.hpp"
+
+// Collects durations of individual queries to D3D12, DXGI and vendor libraries ("probes").
+// When disabled, which is the default, every probe costs only a check of one bool.
+class ProbeTimings
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static bool IsEnabled()
+    {
+        return s_Enabled;
+    }
+    static void Enable();
+
+    static void AddSample(const wchar_t* probeName, Clock::duration duration);
+    // Samples are grouped by the innermost group active when they were added.
+    static void PushGroup(std::wstring_view name);
+    static void PopGroup();
+
+    // Prints the "Timings" section of the report.
+    static void PrintReport();
+    // Forgets all samples, e.g. before the next job of --Batch. Call when no group is active.
+    static void Clear();
+
+private:
+    static bool s_Enabled;
+};
+
+// Names of probes are needed only if timings or the watchdog are enabled.
+inline bool AreProbesObserved()
+{
+    return ProbeTimings::IsEnabled() || Watchdog::IsEnabled();
+}
+
+// Measures the time from construction to destruction as one sample of a probe
+// and puts it under the deadline of the watchdog.
+// Pass null as probeName to measure nothing.
+class ProbeTimer
+{
+public:
+    ProbeTimer(const wchar_t* probeName)
+    {
+        if(!probeName)
+            return;
+        if(ProbeTimings::IsEnabled())
+        {
+            m_ProbeName = probeName;
+            m_BeginTime = ProbeTimings::Clock::now();
+        }
+        if(Watchdog::IsEnabled())
+        {
+            Watchdog::BeginProbe(probeName);
+            m_Watched = true;
+        }
+    }
+    ~ProbeTimer()
+    {
+        if(m_ProbeName)
+            ProbeTimings::AddSample(m_ProbeName, ProbeTimings::Clock::now() - m_BeginTime);
+        if(m_Watched)
+            Watchdog::EndProbe();
+    }
+
+private:
+    const wchar_t* m_ProbeName = nullptr;
+    ProbeTimings::Clock::time_point m_BeginTime;
+    bool m_Watched = false;
+};
+
+// Groups probes issued while it exists, e.g. all probes of one adapter or of one report section.
+// It is also recorded as a span of the trace and measured by the benchmark.
+class ProbeScope
+{
+public:
+    ProbeScope(std::wstring_view name)
+        : m_TraceSpan(name)
+        , m_BenchmarkScope(name, Benchmark::Kind::ProbeGroup)
+        , m_Enabled(ProbeTimings::IsEnabled())
+    {
+        if(m_Enabled)
+            ProbeTimings::PushGroup(name);
+    }
+    ~ProbeScope()
+    {
+        if(m_Enabled)
+            ProbeTimings::PopGroup();
+    }
+
+private:
+    TraceSpan m_TraceSpan;
+    BenchmarkScope m_BenchmarkScope;
+    const bool m_Enabled;
+};
+
+template<typename Func>
+auto ProbeCall(const wchar_t* probeName, Func&& func)
+{
+    ProbeTimer timer(probeName);
+    return func();
+}
+
+// Calls a function of a vendor library, measuring it as a probe named after the function.
+// Example: PROBE_CALL(NvAPI_GPU_GetFullName, gpu, name)
+#define PROBE_CALL(func, ...) ProbeCall(L"" #func, [&]() { return func(__VA_ARGS__); })
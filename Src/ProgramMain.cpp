@@ -0,0 +1,78 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Main.hpp"
+#include "Printer.hpp"
+#include "ReportStats.hpp"
+
+// Entry point of the executable. The rest of the program is in D3d12infoLib, which other programs can link too.
+
+// For Direct3D 12 Agility SDK. Only the executable exports it, as a program linking the library chooses its own.
+extern "C"
+{
+#ifdef USE_PREVIEW_AGILITY_SDK
+    __declspec(dllexport) extern const UINT D3D12SDKVersion = D3D12_PREVIEW_SDK_VERSION;
+    __declspec(dllexport) extern const char* D3D12SDKPath = ".\\D3D12_preview\\";
+#else
+    __declspec(dllexport) extern const UINT D3D12SDKVersion = D3D12_SDK_VERSION;
+    __declspec(dllexport) extern const char* D3D12SDKPath = ".\\D3D12\\";
+#endif
+}
+
+// Counting heap allocations for --Stats. Replaced only in the executable, as a program linking the library has its
+// own allocator. The other forms of operator new and delete, except the aligned ones, call these.
+void* operator new(size_t size)
+{
+    void* const ptr = malloc(size != 0 ? size : 1);
+    if(!ptr)
+        throw std::bad_alloc();
+    if(ReportStats::IsEnabled())
+        ReportStats::OnAllocate(size, _msize(ptr));
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if(ptr && ReportStats::IsEnabled())
+        ReportStats::OnFree(_msize(ptr));
+    free(ptr);
+}
+
+int wmain2(int argc, wchar_t** argv)
+{
+    try
+    {
+        return wmain3(argc, argv);
+    }
+    catch(const std::exception& ex)
+    {
+        const char* errorMessage = ex.what();
+        ErrorPrinter::PrintFormat("ERROR: {}\n", std::make_format_args(errorMessage));
+        return PROGRAM_EXIT_ERROR_EXCEPTION;
+    }
+    catch(...)
+    {
+        ErrorPrinter::PrintString("UNKNOWN ERROR.\n");
+        return PROGRAM_EXIT_ERROR_EXCEPTION;
+    }
+}
+
+int wmain(int argc, wchar_t** argv)
+{
+    __try
+    {
+        return wmain2(argc, argv);
+    }
+    __except(EXCEPTION_EXECUTE_HANDLER)
+    {
+        unsigned long exceptionCode = GetExceptionCode();
+        ErrorPrinter::PrintFormat("STRUCTURED EXCEPTION: 0x{:08X}\n", std::make_format_args(exceptionCode));
+        return PROGRAM_EXIT_ERROR_SEH_EXCEPTION;
+    }
+}
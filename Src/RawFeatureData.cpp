@@ -0,0 +1,136 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "RawFeatureData.hpp"
+
+#include "Printer.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// File starts with the magic and the version, followed by records until the end of the file.
+// Each record is its id, the size of its data in bytes and the data.
+static const char RAW_FILE_MAGIC[8] = { 'D', '3', 'D', '1', '2', 'R', 'A', 'W' };
+static const uint32_t RAW_FILE_VERSION = 1;
+// Largest D3D12_FEATURE_DATA_* structures are a few hundred bytes.
+static const uint32_t MAX_RECORD_DATA_SIZE = 64 * 1024;
+
+// Records already serialized in the format of the file.
+static std::vector<char> g_RecordBytes;
+
+template<typename T>
+static void AppendValue(std::vector<char>& bytes, const T& value)
+{
+    const char* const valueBytes = reinterpret_cast<const char*>(&value);
+    bytes.insert(bytes.end(), valueBytes, valueBytes + sizeof(T));
+}
+
+template<typename T>
+static bool ReadValue(std::ifstream& file, T& outValue)
+{
+    file.read(reinterpret_cast<char*>(&outValue), sizeof(T));
+    return file.good();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+bool RawFeatureData::s_Recording = false;
+
+void RawFeatureData::StartRecording()
+{
+    assert(!s_Recording);
+    s_Recording = true;
+}
+
+void RawFeatureData::AddRecord(uint32_t id, const void* data, size_t dataSize)
+{
+    assert(s_Recording && dataSize <= MAX_RECORD_DATA_SIZE);
+    AppendValue(g_RecordBytes, id);
+    AppendValue(g_RecordBytes, uint32_t(dataSize));
+    const char* const dataBytes = static_cast<const char*>(data);
+    g_RecordBytes.insert(g_RecordBytes.end(), dataBytes, dataBytes + dataSize);
+}
+
+void RawFeatureData::SaveFile(const std::wstring& filePath)
+{
+    assert(s_Recording);
+    std::ofstream file(std::filesystem::path(filePath), std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(RAW_FILE_MAGIC, sizeof(RAW_FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&RAW_FILE_VERSION), sizeof(RAW_FILE_VERSION));
+    file.write(g_RecordBytes.data(), std::streamsize(g_RecordBytes.size()));
+    if(!file.good())
+        throw std::runtime_error("Could not write the raw feature data file.");
+}
+
+std::vector<RawFeatureData::Record> RawFeatureData::LoadFile(const std::wstring& filePath)
+{
+    std::ifstream file(std::filesystem::path(filePath), std::ios::in | std::ios::binary);
+    if(!file.is_open())
+        throw std::runtime_error("Could not open the raw feature data file.");
+
+    char magic[sizeof(RAW_FILE_MAGIC)];
+    file.read(magic, sizeof(magic));
+    uint32_t version = 0;
+    if(!file.good() || !std::equal(magic, magic + sizeof(magic), RAW_FILE_MAGIC) || !ReadValue(file, version) ||
+        version != RAW_FILE_VERSION)
+        throw std::runtime_error("Invalid raw feature data file.");
+
+    std::vector<Record> records;
+    Record record;
+    while(ReadValue(file, record.m_Id))
+    {
+        uint32_t dataSize = 0;
+        // Protect against garbage in a damaged file.
+        if(!ReadValue(file, dataSize) || dataSize > MAX_RECORD_DATA_SIZE)
+            throw std::runtime_error("Invalid raw feature data file.");
+        record.m_Data.resize(dataSize);
+        file.read(record.m_Data.data(), std::streamsize(dataSize));
+        if(!file.good())
+            throw std::runtime_error("Invalid raw feature data file.");
+        records.push_back(std::move(record));
+        record = {};
+    }
+    // Anything but the end of the file between records is an error.
+    if(!file.eof() || file.gcount() != 0)
+        throw std::runtime_error("Invalid raw feature data file.");
+    return records;
+}
+
+std::vector<char> RawFeatureData::FitRecordData(
+    const Record& record, size_t structSize, std::vector<char>& outExtraData)
+{
+    const size_t commonSize = std::min(record.m_Data.size(), structSize);
+    std::vector<char> result(structSize, 0);
+    std::copy_n(record.m_Data.begin(), commonSize, result.begin());
+    outExtraData.assign(record.m_Data.begin() + commonSize, record.m_Data.end());
+    return result;
+}
+
+RawFeatureDataScope::RawFeatureDataScope(const std::wstring& filePath)
+    : m_FilePath(filePath)
+{
+    if(!m_FilePath.empty())
+        RawFeatureData::StartRecording();
+}
+
+RawFeatureDataScope::~RawFeatureDataScope()
+{
+    if(m_FilePath.empty())
+        return;
+    try
+    {
+        RawFeatureData::SaveFile(m_FilePath);
+    }
+    catch(const std::exception& ex)
+    {
+        const char* errorMessage = ex.what();
+        ErrorPrinter::PrintFormat("ERROR: {}\n", std::make_format_args(errorMessage));
+    }
+}
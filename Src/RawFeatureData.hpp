@@ -0,0 +1,57 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Collects D3D12_FEATURE_DATA_* structures exactly as returned by CheckFeatureSupport, instead of decoding them
+// into the report, and writes them to a compact file. Any version of the program can decode the file: members the
+// structures have in common are decoded, members missing in the file are zero, and bytes of members unknown to the
+// decoding version are kept undecoded. See FitRecordData.
+class RawFeatureData
+{
+public:
+    // Starts the records of the next adapter, holding its DXGI_ADAPTER_DESC1.
+    // Ids of other records are values of D3D12_FEATURE.
+    static const uint32_t ADAPTER_RECORD_ID = UINT32_MAX;
+
+    struct Record
+    {
+        uint32_t m_Id = 0;
+        std::vector<char> m_Data;
+    };
+
+    static bool IsRecording()
+    {
+        return s_Recording;
+    }
+    static void StartRecording();
+    static void AddRecord(uint32_t id, const void* data, size_t dataSize);
+    // Throws on failure.
+    static void SaveFile(const std::wstring& filePath);
+    // Returns records in the order they were added. Throws on failure.
+    static std::vector<Record> LoadFile(const std::wstring& filePath);
+    // Returns data of the record as a structure of structSize bytes, zero-filled past the end of the record, which
+    // was written by a version that knew fewer members. Bytes past structSize, from a version that knew more members,
+    // are returned in outExtraData.
+    static std::vector<char> FitRecordData(const Record& record, size_t structSize, std::vector<char>& outExtraData);
+
+private:
+    static bool s_Recording;
+};
+
+// Records raw feature data if filePath is not empty and writes it to that file when destroyed.
+class RawFeatureDataScope
+{
+public:
+    RawFeatureDataScope(const std::wstring& filePath);
+    ~RawFeatureDataScope();
+
+private:
+    const std::wstring m_FilePath;
+};
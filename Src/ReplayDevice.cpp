@@ -0,0 +1,302 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "ReplayDevice.hpp"
+
+#include "DeviceCapture.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+class ReplayDevice : public ID3D12Device
+{
+public:
+    // IUnknown
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+    {
+        if(!ppvObject)
+            return E_POINTER;
+        if(riid == __uuidof(IUnknown) || riid == __uuidof(ID3D12Object) || riid == __uuidof(ID3D12Device))
+        {
+            AddRef();
+            *ppvObject = static_cast<ID3D12Device*>(this);
+            return S_OK;
+        }
+        *ppvObject = nullptr;
+        return E_NOINTERFACE;
+    }
+    ULONG STDMETHODCALLTYPE AddRef() override
+    {
+        return ++m_RefCount;
+    }
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG refCount = --m_RefCount;
+        if(refCount == 0)
+            delete this;
+        return refCount;
+    }
+
+    // ID3D12Object
+
+    HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) override
+    {
+        return DXGI_ERROR_NOT_FOUND;
+    }
+    HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE SetName(LPCWSTR Name) override
+    {
+        return E_NOTIMPL;
+    }
+
+    // ID3D12Device - only these two are answered.
+
+    HRESULT STDMETHODCALLTYPE CheckFeatureSupport(
+        D3D12_FEATURE Feature, void* pFeatureSupportData, UINT FeatureSupportDataSize) override
+    {
+        return DeviceCapture::ReplayCall(GetCheckFeatureSupportCallName(Feature), pFeatureSupportData,
+            FeatureSupportDataSize, GetFeatureDataCapturePointers(Feature, pFeatureSupportData));
+    }
+    UINT STDMETHODCALLTYPE GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapType) override
+    {
+        DescriptorHandleIncrementSizeCall data = { DescriptorHeapType, 0 };
+        DeviceCapture::ReplayCall(L"GetDescriptorHandleIncrementSize", &data, sizeof(data));
+        return data.m_Size;
+    }
+
+    // ID3D12Device - the rest.
+
+    UINT STDMETHODCALLTYPE GetNodeCount() override
+    {
+        return 0;
+    }
+    HRESULT STDMETHODCALLTYPE CreateCommandQueue(
+        const D3D12_COMMAND_QUEUE_DESC* pDesc, REFIID riid, void** ppCommandQueue) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE CreateCommandAllocator(
+        D3D12_COMMAND_LIST_TYPE type, REFIID riid, void** ppCommandAllocator) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE CreateGraphicsPipelineState(
+        const D3D12_GRAPHICS_PIPELINE_STATE_DESC* pDesc, REFIID riid, void** ppPipelineState) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE CreateComputePipelineState(
+        const D3D12_COMPUTE_PIPELINE_STATE_DESC* pDesc, REFIID riid, void** ppPipelineState) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE CreateCommandList(UINT nodeMask, D3D12_COMMAND_LIST_TYPE type,
+        ID3D12CommandAllocator* pCommandAllocator, ID3D12PipelineState* pInitialState, REFIID riid,
+        void** ppCommandList) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE CreateDescriptorHeap(
+        const D3D12_DESCRIPTOR_HEAP_DESC* pDescriptorHeapDesc, REFIID riid, void** ppvHeap) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE CreateRootSignature(UINT nodeMask, const void* pBlobWithRootSignature,
+        SIZE_T blobLengthInBytes, REFIID riid, void** ppvRootSignature) override
+    {
+        return E_NOTIMPL;
+    }
+    void STDMETHODCALLTYPE CreateConstantBufferView(
+        const D3D12_CONSTANT_BUFFER_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor) override
+    {
+    }
+    void STDMETHODCALLTYPE CreateShaderResourceView(ID3D12Resource* pResource,
+        const D3D12_SHADER_RESOURCE_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor) override
+    {
+    }
+    void STDMETHODCALLTYPE CreateUnorderedAccessView(ID3D12Resource* pResource, ID3D12Resource* pCounterResource,
+        const D3D12_UNORDERED_ACCESS_VIEW_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor) override
+    {
+    }
+    void STDMETHODCALLTYPE CreateRenderTargetView(ID3D12Resource* pResource, const D3D12_RENDER_TARGET_VIEW_DESC* pDesc,
+        D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor) override
+    {
+    }
+    void STDMETHODCALLTYPE CreateDepthStencilView(ID3D12Resource* pResource, const D3D12_DEPTH_STENCIL_VIEW_DESC* pDesc,
+        D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor) override
+    {
+    }
+    void STDMETHODCALLTYPE CreateSampler(
+        const D3D12_SAMPLER_DESC* pDesc, D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptor) override
+    {
+    }
+    void STDMETHODCALLTYPE CopyDescriptors(UINT NumDestDescriptorRanges,
+        const D3D12_CPU_DESCRIPTOR_HANDLE* pDestDescriptorRangeStarts, const UINT* pDestDescriptorRangeSizes,
+        UINT NumSrcDescriptorRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* pSrcDescriptorRangeStarts,
+        const UINT* pSrcDescriptorRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType) override
+    {
+    }
+    void STDMETHODCALLTYPE CopyDescriptorsSimple(UINT NumDescriptors,
+        D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptorRangeStart, D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRangeStart,
+        D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType) override
+    {
+    }
+    D3D12_RESOURCE_ALLOCATION_INFO STDMETHODCALLTYPE GetResourceAllocationInfo(
+        UINT visibleMask, UINT numResourceDescs, const D3D12_RESOURCE_DESC* pResourceDescs) override
+    {
+        return {};
+    }
+    D3D12_HEAP_PROPERTIES STDMETHODCALLTYPE GetCustomHeapProperties(UINT nodeMask, D3D12_HEAP_TYPE heapType) override
+    {
+        return {};
+    }
+    HRESULT STDMETHODCALLTYPE CreateCommittedResource(const D3D12_HEAP_PROPERTIES* pHeapProperties,
+        D3D12_HEAP_FLAGS HeapFlags, const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialResourceState,
+        const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riidResource, void** ppvResource) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE CreateHeap(const D3D12_HEAP_DESC* pDesc, REFIID riid, void** ppvHeap) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE CreatePlacedResource(ID3D12Heap* pHeap, UINT64 HeapOffset,
+        const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialState,
+        const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riid, void** ppvResource) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE CreateReservedResource(const D3D12_RESOURCE_DESC* pDesc,
+        D3D12_RESOURCE_STATES InitialState, const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riid,
+        void** ppvResource) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE CreateSharedHandle(ID3D12DeviceChild* pObject, const SECURITY_ATTRIBUTES* pAttributes,
+        DWORD Access, LPCWSTR Name, HANDLE* pHandle) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE OpenSharedHandle(HANDLE NTHandle, REFIID riid, void** ppvObj) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE OpenSharedHandleByName(LPCWSTR Name, DWORD Access, HANDLE* pNTHandle) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE MakeResident(UINT NumObjects, ID3D12Pageable* const* ppObjects) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE Evict(UINT NumObjects, ID3D12Pageable* const* ppObjects) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE CreateFence(
+        UINT64 InitialValue, D3D12_FENCE_FLAGS Flags, REFIID riid, void** ppFence) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE GetDeviceRemovedReason() override
+    {
+        return S_OK;
+    }
+    void STDMETHODCALLTYPE GetCopyableFootprints(const D3D12_RESOURCE_DESC* pResourceDesc, UINT FirstSubresource,
+        UINT NumSubresources, UINT64 BaseOffset, D3D12_PLACED_SUBRESOURCE_FOOTPRINT* pLayouts, UINT* pNumRows,
+        UINT64* pRowSizeInBytes, UINT64* pTotalBytes) override
+    {
+    }
+    HRESULT STDMETHODCALLTYPE CreateQueryHeap(const D3D12_QUERY_HEAP_DESC* pDesc, REFIID riid, void** ppvHeap) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE SetStablePowerState(BOOL Enable) override
+    {
+        return E_NOTIMPL;
+    }
+    HRESULT STDMETHODCALLTYPE CreateCommandSignature(const D3D12_COMMAND_SIGNATURE_DESC* pDesc,
+        ID3D12RootSignature* pRootSignature, REFIID riid, void** ppvCommandSignature) override
+    {
+        return E_NOTIMPL;
+    }
+    void STDMETHODCALLTYPE GetResourceTiling(ID3D12Resource* pTiledResource, UINT* pNumTilesForEntireResource,
+        D3D12_PACKED_MIP_INFO* pPackedMipDesc, D3D12_TILE_SHAPE* pStandardTileShapeForNonPackedMips,
+        UINT* pNumSubresourceTilings, UINT FirstSubresourceTilingToGet,
+        D3D12_SUBRESOURCE_TILING* pSubresourceTilingsForNonPackedMips) override
+    {
+    }
+    LUID STDMETHODCALLTYPE GetAdapterLuid() override
+    {
+        return {};
+    }
+
+private:
+    std::atomic<ULONG> m_RefCount = 1;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+std::wstring GetCheckFeatureSupportCallName(D3D12_FEATURE feature)
+{
+    return std::format(L"CheckFeatureSupport {}", uint32_t(feature));
+}
+
+std::vector<CapturePointer> GetFeatureDataCapturePointers(D3D12_FEATURE feature, const void* featureSupportData)
+{
+    switch(feature)
+    {
+    case D3D12_FEATURE_FEATURE_LEVELS:
+    {
+        const auto& data = *static_cast<const D3D12_FEATURE_DATA_FEATURE_LEVELS*>(featureSupportData);
+        const CapturePointer requested = {
+            .m_Offset = offsetof(D3D12_FEATURE_DATA_FEATURE_LEVELS, pFeatureLevelsRequested),
+            .m_Input = data.pFeatureLevelsRequested,
+            .m_InputSize = data.NumFeatureLevels * sizeof(D3D_FEATURE_LEVEL) };
+        return { requested };
+    }
+    case D3D12_FEATURE_QUERY_META_COMMAND:
+    {
+        // The output buffer is not captured.
+        const auto& data = *static_cast<const D3D12_FEATURE_DATA_QUERY_META_COMMAND*>(featureSupportData);
+        const CapturePointer input = { .m_Offset = offsetof(D3D12_FEATURE_DATA_QUERY_META_COMMAND, pQueryInputData),
+            .m_Input = data.pQueryInputData,
+            .m_InputSize = data.QueryInputDataSizeInBytes };
+        const CapturePointer output = {
+            .m_Offset = offsetof(D3D12_FEATURE_DATA_QUERY_META_COMMAND, pQueryOutputData) };
+        return { input, output };
+    }
+    case D3D12_FEATURE_PROTECTED_RESOURCE_SESSION_TYPES:
+        // The output array is not captured.
+    {
+        const CapturePointer types = {
+            .m_Offset = offsetof(D3D12_FEATURE_DATA_PROTECTED_RESOURCE_SESSION_TYPES, pTypes) };
+        return { types };
+    }
+    default:
+        return {};
+    }
+}
+
+ComPtr<ID3D12Device> CreateReplayDevice()
+{
+    assert(DeviceCapture::IsReplaying());
+    ComPtr<ID3D12Device> device;
+    device.Attach(new ReplayDevice());
+    return device;
+}
@@ -0,0 +1,28 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+struct CapturePointer;
+
+// Input and output of ID3D12Device::GetDescriptorHandleIncrementSize, as passed through the device capture.
+struct DescriptorHandleIncrementSizeCall
+{
+    D3D12_DESCRIPTOR_HEAP_TYPE m_HeapType;
+    UINT m_Size;
+};
+
+// Name of ID3D12Device::CheckFeatureSupport for the feature in the device capture.
+std::wstring GetCheckFeatureSupportCallName(D3D12_FEATURE feature);
+// Pointer members of the structure queried for the feature, which must not identify the call in the device capture.
+std::vector<CapturePointer> GetFeatureDataCapturePointers(D3D12_FEATURE feature, const void* featureSupportData);
+
+// Creates a device that doesn't need any adapter. It answers CheckFeatureSupport and GetDescriptorHandleIncrementSize
+// from the capture being replayed, for the adapter set in DeviceCapture. Everything else fails or returns zeros.
+ComPtr<ID3D12Device> CreateReplayDevice();
@@ -0,0 +1,179 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "ReportCache.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static const char CACHE_FILE_MAGIC[8] = { 'D', '3', 'D', '1', '2', 'C', 'A', 'C' };
+static const uint32_t CACHE_FILE_VERSION = 2;
+// Protects against garbage in a damaged file.
+static const uint64_t MAX_SEGMENT_COUNT = 1 << 16;
+static const wchar_t* const CACHE_FILE_EXTENSION = L".cache";
+
+// FNV-1a
+static uint64_t HashString(std::wstring_view str)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for(wchar_t ch : str)
+    {
+        hash ^= uint64_t(ch);
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+template<typename T>
+static void WriteValue(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool ReadValue(std::ifstream& file, T& outValue)
+{
+    file.read(reinterpret_cast<char*>(&outValue), sizeof(T));
+    return file.good();
+}
+
+static void WriteString(std::ofstream& file, std::wstring_view str)
+{
+    WriteValue(file, uint64_t(str.length()));
+    file.write(reinterpret_cast<const char*>(str.data()), str.length() * sizeof(wchar_t));
+}
+
+static bool ReadString(std::ifstream& file, std::wstring& outStr)
+{
+    uint64_t length = 0;
+    if(!ReadValue(file, length))
+        return false;
+    // Protect against garbage in a damaged file.
+    if(length > (uint64_t(1) << 30))
+        return false;
+    outStr.resize(size_t(length));
+    file.read(reinterpret_cast<char*>(outStr.data()), outStr.length() * sizeof(wchar_t));
+    return file.good();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+std::wstring ReportCacheKey::ToString() const
+{
+    std::wstring result = std::format(L"ProgramVersion={:08X};AgilitySDKVersion={};OSVersion={};Options={}",
+        ProgramVersion, AgilitySDKVersion, OSVersion, Options);
+    for(const Adapter& adapter : Adapters)
+    {
+        result += std::format(L";Adapter={:08X}-{:08X},{:04X},{:04X},{:08X},{:02X},{:016X}",
+            uint32_t(adapter.LuidHighPart), adapter.LuidLowPart, adapter.VendorId, adapter.DeviceId, adapter.SubSysId,
+            adapter.Revision, adapter.UMDVersion);
+    }
+    return result;
+}
+
+ReportCache::ReportCache(std::filesystem::path directory)
+    : m_Directory(std::move(directory))
+{
+}
+
+bool ReportCache::Load(const ReportCacheKey& key, ReportFragment& outFragment) const
+{
+    const std::wstring keyStr = key.ToString();
+
+    std::ifstream file(GetEntryPath(keyStr), std::ios::in | std::ios::binary);
+    if(!file.is_open())
+        return false;
+
+    char magic[sizeof(CACHE_FILE_MAGIC)];
+    file.read(magic, sizeof(magic));
+    uint32_t version = 0;
+    if(!file.good() || !std::equal(magic, magic + sizeof(magic), CACHE_FILE_MAGIC) || !ReadValue(file, version) ||
+        version != CACHE_FILE_VERSION)
+        return false;
+
+    // The file name is only a hash, so the full key is stored and compared to rule out collisions.
+    std::wstring storedKeyStr;
+    if(!ReadString(file, storedKeyStr) || storedKeyStr != keyStr)
+        return false;
+
+    ReportFragment fragment;
+    uint64_t segmentCount = 0;
+    if(!ReadValue(file, segmentCount) || segmentCount == 0 || segmentCount > MAX_SEGMENT_COUNT)
+        return false;
+    fragment.Segments.resize(size_t(segmentCount));
+    for(ReportFragment::Segment& segment : fragment.Segments)
+    {
+        if(!ReadString(file, segment.Text) || !ReadString(file, segment.CallLog) ||
+            !ReadString(file, segment.VolatileSection))
+            return false;
+    }
+
+    outFragment = std::move(fragment);
+    return true;
+}
+
+void ReportCache::Store(const ReportCacheKey& key, const ReportFragment& fragment) const
+{
+    const std::wstring keyStr = key.ToString();
+    const std::filesystem::path entryPath = GetEntryPath(keyStr);
+    std::filesystem::path tempPath = entryPath;
+    tempPath += L".tmp";
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_Directory, ec);
+    if(ec)
+        return;
+
+    // Write to a temporary file first so a concurrently running instance never sees a partial entry.
+    {
+        std::ofstream file(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!file.is_open())
+            return;
+        file.write(CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC));
+        WriteValue(file, CACHE_FILE_VERSION);
+        WriteString(file, keyStr);
+        WriteValue(file, uint64_t(fragment.Segments.size()));
+        for(const ReportFragment::Segment& segment : fragment.Segments)
+        {
+            WriteString(file, segment.Text);
+            WriteString(file, segment.CallLog);
+            WriteString(file, segment.VolatileSection);
+        }
+        if(!file.good())
+        {
+            file.close();
+            std::filesystem::remove(tempPath, ec);
+            return;
+        }
+    }
+
+    std::filesystem::rename(tempPath, entryPath, ec);
+    if(ec)
+        std::filesystem::remove(tempPath, ec);
+}
+
+size_t ReportCache::Clear() const
+{
+    size_t removedCount = 0;
+    std::error_code ec;
+    for(std::filesystem::directory_iterator it(m_Directory, ec), end; !ec && it != end; it.increment(ec))
+    {
+        const std::filesystem::path& path = it->path();
+        std::error_code removeEc;
+        if(path.extension() == CACHE_FILE_EXTENSION && std::filesystem::remove(path, removeEc))
+            ++removedCount;
+    }
+    return removedCount;
+}
+
+std::filesystem::path ReportCache::GetEntryPath(std::wstring_view keyStr) const
+{
+    return m_Directory / std::format(L"{:016X}{}", HashString(keyStr), CACHE_FILE_EXTENSION);
+}
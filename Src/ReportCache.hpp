@@ -0,0 +1,77 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Everything that must match for a cached report to be reused.
+// Deliberately made of plain types only, so it doesn't depend on Windows headers.
+struct ReportCacheKey
+{
+    struct Adapter
+    {
+        uint32_t LuidLowPart = 0;
+        int32_t LuidHighPart = 0;
+        uint32_t VendorId = 0;
+        uint32_t DeviceId = 0;
+        uint32_t SubSysId = 0;
+        uint32_t Revision = 0;
+        // From IDXGIAdapter::CheckInterfaceSupport. 0 if unknown.
+        uint64_t UMDVersion = 0;
+    };
+
+    uint32_t ProgramVersion = 0;
+    uint32_t AgilitySDKVersion = 0;
+    std::wstring OSVersion;
+    // Command-line options that influence the contents of the report.
+    std::wstring Options;
+    std::vector<Adapter> Adapters;
+
+    std::wstring ToString() const;
+};
+
+// Text of a report stored in the cache, split around the sections that change from run to run, like free memory.
+// Those are not stored, but printed again each time the fragment is reused.
+struct ReportFragment
+{
+    struct Segment
+    {
+        std::wstring Text;
+        // Calls to the formatter that printed Text. Made again without output, they bring the formatter to the state
+        // it needs to print the volatile section that follows. See CallLogReportFormatter.
+        std::wstring CallLog;
+        // Identifies the section that follows Text. Empty after the last segment.
+        std::wstring VolatileSection;
+    };
+
+    std::vector<Segment> Segments;
+};
+
+// Stores report fragments on disk, one file per key.
+// All failures are silently ignored, as the cache is only an optimization.
+class ReportCache
+{
+public:
+    ReportCache(std::filesystem::path directory);
+
+    const std::filesystem::path& GetDirectory() const
+    {
+        return m_Directory;
+    }
+
+    // Returns true and fills outFragment if a valid entry exists for the key.
+    bool Load(const ReportCacheKey& key, ReportFragment& outFragment) const;
+    void Store(const ReportCacheKey& key, const ReportFragment& fragment) const;
+    // Removes all entries. Returns the number of entries removed.
+    size_t Clear() const;
+
+private:
+    std::filesystem::path m_Directory;
+
+    std::filesystem::path GetEntryPath(std::wstring_view keyStr) const;
+};
@@ -0,0 +1,231 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "CallLogReportFormatter.hpp"
+
+static const wchar_t CALL_PUSH_OBJECT = L'O';
+static const wchar_t CALL_PUSH_ARRAY = L'A';
+static const wchar_t CALL_PUSH_ARRAY_NO_SUFFIX = L'N';
+static const wchar_t CALL_PUSH_ARRAY_ITEM = L'I';
+static const wchar_t CALL_POP_SCOPE = L'P';
+static const wchar_t CALL_POP_ALL_SCOPES = L'R';
+static const wchar_t CALL_ADD_FIELD = L'F';
+
+CallLogReportFormatter::CallLogReportFormatter(std::unique_ptr<ReportFormatter> formatter)
+    : m_Formatter(std::move(formatter))
+{
+}
+
+std::wstring CallLogReportFormatter::TakeLog()
+{
+    return std::exchange(m_Log, std::wstring());
+}
+
+std::unique_ptr<ReportFormatter> CallLogReportFormatter::Release()
+{
+    return std::move(m_Formatter);
+}
+
+void CallLogReportFormatter::Replay(ReportSink& formatter, std::wstring_view log)
+{
+    while(!log.empty())
+    {
+        const size_t lineEnd = log.find(L'\n');
+        assert(lineEnd != std::wstring_view::npos);
+        const std::wstring_view name = log.substr(1, lineEnd - 1);
+        switch(log[0])
+        {
+        case CALL_PUSH_OBJECT:
+            formatter.PushObject(name);
+            break;
+        case CALL_PUSH_ARRAY:
+            formatter.PushArray(name, ARRAY_SUFFIX_SQUARE_BRACKETS);
+            break;
+        case CALL_PUSH_ARRAY_NO_SUFFIX:
+            formatter.PushArray(name, ARRAY_SUFFIX_NONE);
+            break;
+        case CALL_PUSH_ARRAY_ITEM:
+            formatter.PushArrayItem();
+            break;
+        case CALL_POP_SCOPE:
+            formatter.PopScope();
+            break;
+        case CALL_POP_ALL_SCOPES:
+            formatter.PopAllScopes();
+            break;
+        case CALL_ADD_FIELD:
+            // All kinds of fields change the state of the formatter the same way.
+            formatter.AddFieldBool(name, false);
+            break;
+        default:
+            assert(0);
+        }
+        log.remove_prefix(lineEnd + 1);
+    }
+}
+
+void CallLogReportFormatter::PushObject(std::wstring_view name)
+{
+    LogCall(CALL_PUSH_OBJECT, name);
+    m_Formatter->PushObject(name);
+}
+
+void CallLogReportFormatter::PushArray(std::wstring_view name, ARRAY_SUFFIX suffix)
+{
+    LogCall(suffix == ARRAY_SUFFIX_NONE ? CALL_PUSH_ARRAY_NO_SUFFIX : CALL_PUSH_ARRAY, name);
+    m_Formatter->PushArray(name, suffix);
+}
+
+void CallLogReportFormatter::PushArrayItem()
+{
+    LogCall(CALL_PUSH_ARRAY_ITEM);
+    m_Formatter->PushArrayItem();
+}
+
+void CallLogReportFormatter::PopScope()
+{
+    LogCall(CALL_POP_SCOPE);
+    m_Formatter->PopScope();
+}
+
+void CallLogReportFormatter::PopAllScopes()
+{
+    LogCall(CALL_POP_ALL_SCOPES);
+    m_Formatter->PopAllScopes();
+}
+
+void CallLogReportFormatter::AddFieldString(std::wstring_view name, std::wstring_view value)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldString(name, value);
+}
+
+void CallLogReportFormatter::AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldStringArray(name, value);
+}
+
+void CallLogReportFormatter::AddFieldBool(std::wstring_view name, bool value)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldBool(name, value);
+}
+
+void CallLogReportFormatter::AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldUint32(name, value, unit);
+}
+
+void CallLogReportFormatter::AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldUint64(name, value, unit);
+}
+
+void CallLogReportFormatter::AddFieldSize(std::wstring_view name, uint64_t value)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldSize(name, value);
+}
+
+void CallLogReportFormatter::AddFieldSizeKilobytes(std::wstring_view name, uint64_t value)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldSizeKilobytes(name, value);
+}
+
+void CallLogReportFormatter::AddFieldHex32(std::wstring_view name, uint32_t value)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldHex32(name, value);
+}
+
+void CallLogReportFormatter::AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldInt32(name, value, unit);
+}
+
+void CallLogReportFormatter::AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldFloat(name, value, unit);
+}
+
+void CallLogReportFormatter::AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldEnum(name, value, enumItems);
+}
+
+void CallLogReportFormatter::AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldEnumSigned(name, value, enumItems);
+}
+
+void CallLogReportFormatter::AddEnumArray(
+    std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddEnumArray(name, values, count, enumItems);
+}
+
+void CallLogReportFormatter::AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldFlags(name, value, enumItems);
+}
+
+void CallLogReportFormatter::AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldHexBytes(name, data, byteCount);
+}
+
+void CallLogReportFormatter::AddFieldVendorId(std::wstring_view name, uint32_t value)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldVendorId(name, value);
+}
+
+void CallLogReportFormatter::AddFieldSubsystemId(std::wstring_view name, uint32_t value)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldSubsystemId(name, value);
+}
+
+void CallLogReportFormatter::AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldMicrosoftVersion(name, value);
+}
+
+void CallLogReportFormatter::AddFieldAMDVersion(std::wstring_view name, uint64_t value)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldAMDVersion(name, value);
+}
+
+void CallLogReportFormatter::AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId,
+    uint32_t implementationId, const EnumItem* architecturePlusImplementationIDEnum)
+{
+    LogCall(CALL_ADD_FIELD, name);
+    m_Formatter->AddFieldNvidiaImplementationID(
+        name, architectureId, implementationId, architecturePlusImplementationIDEnum);
+}
+
+void CallLogReportFormatter::LogCall(wchar_t call, std::wstring_view name)
+{
+    m_Log += call;
+    m_Log += name;
+    m_Log += L'\n';
+}
@@ -0,0 +1,65 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+#pragma once
+
+#include "ReportFormatter.hpp"
+
+// Passes everything to another formatter and logs the calls that change its state: scopes pushed and popped and names
+// of fields. Made again with Replay while the output is suppressed, they bring another formatter of the same kind to
+// the state the first one was in, without printing anything. Used by the report cache, which stores the text of a
+// report together with the log, so it can print sections that are not stored in the middle of it.
+class CallLogReportFormatter final : public ReportFormatter
+{
+public:
+    CallLogReportFormatter(std::unique_ptr<ReportFormatter> formatter);
+
+    static void Replay(ReportSink& formatter, std::wstring_view log);
+
+    // Returns the calls logged since the previous call.
+    std::wstring TakeLog();
+    // Returns the formatter it passes everything to.
+    std::unique_ptr<ReportFormatter> Release();
+
+    void PushObject(std::wstring_view name) final;
+    void PushArray(std::wstring_view name, ARRAY_SUFFIX suffix = ARRAY_SUFFIX_SQUARE_BRACKETS) final;
+    void PushArrayItem() final;
+    void PopScope() final;
+    void PopAllScopes() final;
+
+    void AddFieldString(std::wstring_view name, std::wstring_view value) final;
+    void AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value) final;
+    void AddFieldBool(std::wstring_view name, bool value) final;
+    void AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit = {}) final;
+    void AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit = {}) final;
+    void AddFieldSize(std::wstring_view name, uint64_t value) final;
+    void AddFieldSizeKilobytes(std::wstring_view name, uint64_t value) final;
+    void AddFieldHex32(std::wstring_view name, uint32_t value) final;
+    void AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit = {}) final;
+    void AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit = {}) final;
+    void AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
+    void AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems) final;
+    void AddEnumArray(std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems) final;
+    void AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
+    void AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount) final;
+    void AddFieldVendorId(std::wstring_view name, uint32_t value) final;
+    void AddFieldSubsystemId(std::wstring_view name, uint32_t value) final;
+    void AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value) final;
+    void AddFieldAMDVersion(std::wstring_view name, uint64_t value) final;
+    void AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId, uint32_t implementationId,
+        const EnumItem* architecturePlusImplementationIDEnum) final;
+
+private:
+    std::unique_ptr<ReportFormatter> m_Formatter;
+    // One call per line: its letter followed by the name.
+    std::wstring m_Log;
+
+    void LogCall(wchar_t call, std::wstring_view name = {});
+};
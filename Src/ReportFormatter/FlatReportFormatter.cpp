@@ -0,0 +1,264 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "FlatReportFormatter.hpp"
+
+#include "Printer.hpp"
+
+#include <charconv>
+
+static const wchar_t PATH_SEPARATOR = L'/';
+static const wchar_t COLUMN_SEPARATOR = L'\t';
+
+// Characters that would break the row, escaped like in JSON strings.
+static void AppendEscaped(std::wstring& str, std::wstring_view value)
+{
+    for(wchar_t ch : value)
+    {
+        switch(ch)
+        {
+        case L'\\':
+            str += L"\\\\";
+            break;
+        case L'\t':
+            str += L"\\t";
+            break;
+        case L'\n':
+            str += L"\\n";
+            break;
+        case L'\r':
+            str += L"\\r";
+            break;
+        default:
+            str += ch;
+        }
+    }
+}
+
+// std::to_chars, which doesn't allocate, writes only narrow characters.
+template<typename T>
+static void AppendNumber(std::wstring& str, T value)
+{
+    char chars[32];
+    const std::to_chars_result result = std::to_chars(chars, chars + sizeof(chars), value);
+    for(const char* ch = chars; ch != result.ptr; ++ch)
+        str += wchar_t(*ch);
+}
+
+FlatReportFormatter::FlatReportFormatter()
+{
+    m_Path.reserve(256);
+    m_Row.reserve(512);
+    m_ScopeStack.reserve(16);
+}
+
+FlatReportFormatter::~FlatReportFormatter()
+{
+    assert(m_ScopeStack.empty());
+}
+
+void FlatReportFormatter::PushObject(std::wstring_view name)
+{
+    assert(!name.empty());
+    PushScope(name);
+}
+
+void FlatReportFormatter::PushArray(std::wstring_view name, ARRAY_SUFFIX suffix)
+{
+    assert(!name.empty());
+    PushScope(name);
+}
+
+void FlatReportFormatter::PushArrayItem()
+{
+    assert(!m_ScopeStack.empty());
+    const size_t index = m_ScopeStack.back().ItemCount++;
+    m_ScopeStack.push_back({ .PathLength = m_Path.length(), .ItemCount = 0 });
+    m_Path += L'[';
+    AppendNumber(m_Path, index);
+    m_Path += L']';
+}
+
+void FlatReportFormatter::PopScope()
+{
+    assert(!m_ScopeStack.empty());
+    m_Path.resize(m_ScopeStack.back().PathLength);
+    m_ScopeStack.pop_back();
+}
+
+void FlatReportFormatter::PopAllScopes()
+{
+    m_Path.clear();
+    m_ScopeStack.clear();
+}
+
+void FlatReportFormatter::AddFieldString(std::wstring_view name, std::wstring_view value)
+{
+    BeginRow(name, L"str");
+    AppendEscaped(m_Row, value);
+    EndRow();
+}
+
+void FlatReportFormatter::AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value)
+{
+    for(size_t i = 0; i < value.size(); ++i)
+    {
+        BeginRow(name, L"str", i);
+        AppendEscaped(m_Row, value[i]);
+        EndRow();
+    }
+}
+
+void FlatReportFormatter::AddFieldBool(std::wstring_view name, bool value)
+{
+    BeginRow(name, L"bool");
+    m_Row += value ? L"true" : L"false";
+    EndRow();
+}
+
+void FlatReportFormatter::AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit)
+{
+    BeginRow(name, L"u32");
+    AppendNumber(m_Row, value);
+    EndRow();
+}
+
+void FlatReportFormatter::AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit)
+{
+    BeginRow(name, L"u64");
+    AppendNumber(m_Row, value);
+    EndRow();
+}
+
+void FlatReportFormatter::AddFieldSize(std::wstring_view name, uint64_t value)
+{
+    AddFieldUint64(name, value);
+}
+
+void FlatReportFormatter::AddFieldSizeKilobytes(std::wstring_view name, uint64_t value)
+{
+    AddFieldUint64(name, value);
+}
+
+void FlatReportFormatter::AddFieldHex32(std::wstring_view name, uint32_t value)
+{
+    AddFieldUint32(name, value);
+}
+
+void FlatReportFormatter::AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit)
+{
+    BeginRow(name, L"i32");
+    AppendNumber(m_Row, value);
+    EndRow();
+}
+
+void FlatReportFormatter::AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit)
+{
+    BeginRow(name, L"f32");
+    AppendNumber(m_Row, value);
+    EndRow();
+}
+
+void FlatReportFormatter::AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    AddFieldUint32(name, value);
+}
+
+void FlatReportFormatter::AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems)
+{
+    AddFieldInt32(name, value);
+}
+
+void FlatReportFormatter::AddEnumArray(
+    std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems)
+{
+    for(size_t i = 0; i < count; ++i)
+    {
+        BeginRow(name, L"u32", i);
+        AppendNumber(m_Row, values[i]);
+        EndRow();
+    }
+}
+
+void FlatReportFormatter::AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    AddFieldUint32(name, value);
+}
+
+void FlatReportFormatter::AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount)
+{
+    static const wchar_t* const HEX_DIGITS = L"0123456789ABCDEF";
+    BeginRow(name, L"hex");
+    for(size_t i = 0; i < byteCount; ++i)
+    {
+        const uint8_t byte = *((const uint8_t*)data + i);
+        m_Row += HEX_DIGITS[byte >> 4];
+        m_Row += HEX_DIGITS[byte & 0xF];
+    }
+    EndRow();
+}
+
+void FlatReportFormatter::AddFieldVendorId(std::wstring_view name, uint32_t value)
+{
+    AddFieldUint32(name, value);
+}
+
+void FlatReportFormatter::AddFieldSubsystemId(std::wstring_view name, uint32_t value)
+{
+    AddFieldUint32(name, value);
+}
+
+void FlatReportFormatter::AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value)
+{
+    AddFieldUint64(name, value);
+}
+
+void FlatReportFormatter::AddFieldAMDVersion(std::wstring_view name, uint64_t value)
+{
+    AddFieldUint64(name, value);
+}
+
+void FlatReportFormatter::AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId,
+    uint32_t implementationId, const EnumItem* architecturePlusImplementationIDEnum)
+{
+    AddFieldUint32(name, implementationId);
+}
+
+void FlatReportFormatter::PushScope(std::wstring_view name)
+{
+    m_ScopeStack.push_back({ .PathLength = m_Path.length(), .ItemCount = 0 });
+    if(!m_Path.empty())
+        m_Path += PATH_SEPARATOR;
+    AppendEscaped(m_Path, name);
+}
+
+void FlatReportFormatter::BeginRow(std::wstring_view name, std::wstring_view type, size_t arrayIndex)
+{
+    assert(!name.empty());
+    m_Row.assign(m_Path);
+    if(!m_Row.empty())
+        m_Row += PATH_SEPARATOR;
+    AppendEscaped(m_Row, name);
+    if(arrayIndex != SIZE_MAX)
+    {
+        m_Row += L'[';
+        AppendNumber(m_Row, arrayIndex);
+        m_Row += L']';
+    }
+    m_Row += COLUMN_SEPARATOR;
+    m_Row += type;
+    m_Row += COLUMN_SEPARATOR;
+}
+
+void FlatReportFormatter::EndRow()
+{
+    // Not Printer::PrintNewLine, which flushes the output after each row.
+    m_Row += L'\n';
+    Printer::PrintString(m_Row);
+}
@@ -0,0 +1,72 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+#pragma once
+
+#include "ReportFormatter.hpp"
+
+// Prints one row "path<TAB>type<TAB>value" for each field, like
+// "Adapters[0]/D3D12_FEATURE_DATA_D3D12_OPTIONS/ResourceBindingTier<TAB>u32<TAB>3", to be loaded into tables without
+// parsing JSON. Names are those of the JSON report, and enums and flags are raw integers.
+// The path of the current scope is extended and truncated in place and each row is built in a buffer reused for all
+// of them, so printing a row doesn't allocate memory.
+class FlatReportFormatter final : public ReportFormatter
+{
+public:
+    FlatReportFormatter();
+    ~FlatReportFormatter();
+
+    void PushObject(std::wstring_view name) final;
+    void PushArray(std::wstring_view name, ARRAY_SUFFIX suffix = ARRAY_SUFFIX_SQUARE_BRACKETS) final;
+    void PushArrayItem() final;
+    void PopScope() final;
+    void PopAllScopes() final;
+
+    void AddFieldString(std::wstring_view name, std::wstring_view value) final;
+    void AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value) final;
+    void AddFieldBool(std::wstring_view name, bool value) final;
+    void AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit = {}) final;
+    void AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit = {}) final;
+    void AddFieldSize(std::wstring_view name, uint64_t value) final;
+    void AddFieldSizeKilobytes(std::wstring_view name, uint64_t value) final;
+    void AddFieldHex32(std::wstring_view name, uint32_t value) final;
+    void AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit = {}) final;
+    void AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit = {}) final;
+    void AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
+    void AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems) final;
+    void AddEnumArray(std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems) final;
+    void AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
+    void AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount) final;
+    void AddFieldVendorId(std::wstring_view name, uint32_t value) final;
+    void AddFieldSubsystemId(std::wstring_view name, uint32_t value) final;
+    void AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value) final;
+    void AddFieldAMDVersion(std::wstring_view name, uint64_t value) final;
+    void AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId, uint32_t implementationId,
+        const EnumItem* architecturePlusImplementationIDEnum) final;
+
+private:
+    struct ScopeInfo
+    {
+        // Length of m_Path before the scope was pushed.
+        size_t PathLength;
+        // Items pushed so far, used to index the next one.
+        size_t ItemCount;
+    };
+
+    std::wstring m_Path;
+    std::wstring m_Row;
+    std::vector<ScopeInfo> m_ScopeStack;
+
+    void PushScope(std::wstring_view name);
+    // Starts m_Row with the path of the field and its type, to be followed by the value appended by the caller.
+    // arrayIndex other than SIZE_MAX makes it a row of an item of the array field.
+    void BeginRow(std::wstring_view name, std::wstring_view type, size_t arrayIndex = SIZE_MAX);
+    void EndRow();
+};
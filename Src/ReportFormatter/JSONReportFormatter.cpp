@@ -9,6 +9,7 @@ For more information, see files README.md, LICENSE.txt.
 */
 #include "JSONReportFormatter.hpp"
 
+#include "Json.hpp"
 #include "Printer.hpp"
 
 JSONReportFormatter::JSONReportFormatter(FLAGS flags)
@@ -77,6 +78,13 @@ void JSONReportFormatter::PopScope()
     Printer::PrintString(scope.Type == ScopeType::Object ? L"}" : L"]");
 }
 
+void JSONReportFormatter::PopAllScopes()
+{
+    // The root object is closed by the destructor.
+    while(m_ScopeStack.size() > 1)
+        PopScope();
+}
+
 void JSONReportFormatter::AddFieldString(std::wstring_view name, std::wstring_view value)
 {
     assert(!name.empty());
@@ -274,37 +282,5 @@ void JSONReportFormatter::PrintNewLine()
 
 std::wstring JSONReportFormatter::EscapeString(std::wstring_view str)
 {
-    // Escapes string for JSON format
-    std::wstring escapedStr;
-    escapedStr.reserve(str.size() * 2); // Reserve enough space to avoid multiple allocations
-    for(wchar_t ch : str)
-    {
-        switch(ch)
-        {
-        case L'"':
-            escapedStr += L"\\\"";
-            break;
-        case L'\\':
-            escapedStr += L"\\\\";
-            break;
-        case L'\b':
-            escapedStr += L"\\b";
-            break;
-        case L'\f':
-            escapedStr += L"\\f";
-            break;
-        case L'\n':
-            escapedStr += L"\\n";
-            break;
-        case L'\r':
-            escapedStr += L"\\r";
-            break;
-        case L'\t':
-            escapedStr += L"\\t";
-            break;
-        default:
-            escapedStr += ch;
-        }
-    }
-    return escapedStr;
+    return EscapeJsonString(str);
 }
@@ -9,23 +9,49 @@ For more information, see files README.md, LICENSE.txt.
 */
 #include "ReportFormatter.hpp"
 
+#include "CallLogReportFormatter.hpp"
+#include "FlatReportFormatter.hpp"
 #include "JSONReportFormatter.hpp"
+#include "ReportSelection.hpp"
+#include "ReportStats.hpp"
+#include "SelectionReportFormatter.hpp"
+#include "StatsReportFormatter.hpp"
 #include "TextReportFormatter.hpp"
 
+// Shared by all threads, except those that render a report of their own with ReportFormatterThreadScope.
 static ReportFormatter* s_Instance = nullptr;
 static ReportFormatter::FLAGS s_Flags = ReportFormatter::FLAGS::FLAG_NONE;
+static thread_local ReportSink* s_ThreadInstance = nullptr;
+static thread_local ReportFormatter::FLAGS s_ThreadFlags = ReportFormatter::FLAGS::FLAG_NONE;
+// Wraps s_Instance between BeginCallLog and EndCallLog.
+static CallLogReportFormatter* s_CallLog = nullptr;
 
-void ReportFormatter::CreateInstance(FLAGS flags)
+static ReportFormatter* NewFormatter(ReportFormatter::FLAGS flags)
 {
-    assert(s_Instance == nullptr);
-    if((flags & FLAGS::FLAG_JSON) != FLAGS::FLAG_NONE)
+    if((flags & ReportFormatter::FLAGS::FLAG_FLAT) != ReportFormatter::FLAGS::FLAG_NONE)
+    {
+        return new FlatReportFormatter();
+    }
+    else if((flags & ReportFormatter::FLAGS::FLAG_JSON) != ReportFormatter::FLAGS::FLAG_NONE)
     {
-        s_Instance = new JSONReportFormatter(flags);
+        return new JSONReportFormatter(flags);
     }
     else
     {
-        s_Instance = new TextReportFormatter(flags);
+        return new TextReportFormatter(flags);
     }
+}
+
+void ReportFormatter::CreateInstance(FLAGS flags)
+{
+    assert(s_Instance == nullptr);
+    s_Instance = NewFormatter(flags);
+    // Reports rendered on other threads with ReportFormatterThreadScope are not the subject of the selection.
+    if(ReportSelection::IsEnabled())
+        s_Instance = new SelectionReportFormatter(std::unique_ptr<ReportFormatter>(s_Instance));
+    // Outside of the selection, so what is done for scopes left out is counted too.
+    if(ReportStats::IsEnabled())
+        s_Instance = new StatsReportFormatter(std::unique_ptr<ReportFormatter>(s_Instance));
     s_Flags = flags;
 }
 
@@ -34,20 +60,70 @@ void ReportFormatter::DestroyInstance()
     assert(s_Instance != nullptr);
     delete s_Instance;
     s_Instance = nullptr;
+    // Deleted with s_Instance if the report failed before EndCallLog.
+    s_CallLog = nullptr;
 }
 
-ReportFormatter& ReportFormatter::GetInstance()
+void ReportFormatter::CreateThreadInstance(FLAGS flags)
 {
+    assert(s_ThreadInstance == nullptr);
+    s_ThreadInstance = NewFormatter(flags);
+    s_ThreadFlags = flags;
+}
+
+void ReportFormatter::CreateThreadInstance(std::unique_ptr<ReportSink> sink)
+{
+    assert(s_ThreadInstance == nullptr);
+    if(ReportSelection::IsEnabled())
+        sink = std::make_unique<SelectionReportFormatter>(std::move(sink));
+    s_ThreadInstance = sink.release();
+    s_ThreadFlags = FLAGS::FLAG_JSON;
+}
+
+void ReportFormatter::DestroyThreadInstance()
+{
+    assert(s_ThreadInstance != nullptr);
+    delete s_ThreadInstance;
+    s_ThreadInstance = nullptr;
+}
+
+ReportSink& ReportFormatter::GetInstance()
+{
+    if(s_ThreadInstance != nullptr)
+        return *s_ThreadInstance;
     assert(s_Instance != nullptr);
     return *s_Instance;
 }
 
 ReportFormatter::FLAGS ReportFormatter::GetFlags()
 {
+    if(s_ThreadInstance != nullptr)
+        return s_ThreadFlags;
     assert(s_Instance != nullptr);
     return s_Flags;
 }
 
+void ReportFormatter::BeginCallLog()
+{
+    assert(s_Instance != nullptr && s_ThreadInstance == nullptr && s_CallLog == nullptr);
+    s_CallLog = new CallLogReportFormatter(std::unique_ptr<ReportFormatter>(s_Instance));
+    s_Instance = s_CallLog;
+}
+
+std::wstring ReportFormatter::TakeCallLog()
+{
+    assert(s_CallLog != nullptr);
+    return s_CallLog->TakeLog();
+}
+
+void ReportFormatter::EndCallLog()
+{
+    assert(s_CallLog != nullptr && s_Instance == s_CallLog);
+    s_Instance = s_CallLog->Release().release();
+    delete s_CallLog;
+    s_CallLog = nullptr;
+}
+
 ReportFormatter::FLAGS& operator|=(ReportFormatter::FLAGS& lhs, ReportFormatter::FLAGS rhs)
 {
     lhs = static_cast<ReportFormatter::FLAGS>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
@@ -10,66 +10,36 @@ For more information, see files README.md, LICENSE.txt.
 
 #pragma once
 
-struct EnumItem;
+#include "ReportSink.hpp"
 
-class ReportFormatter
+// Prints the report it receives as a sink. GetInstance returns the sink the probes report to.
+class ReportFormatter : public ReportSink
 {
 public:
     enum FLAGS : uint32_t
     {
         FLAG_NONE = 0,
         FLAG_JSON = 1 << 0,
-        FLAG_JSON_PRETTY_PRINT = 1 << 1
-    };
-
-    enum ARRAY_SUFFIX
-    {
-        ARRAY_SUFFIX_SQUARE_BRACKETS,
-        ARRAY_SUFFIX_NONE
+        FLAG_JSON_PRETTY_PRINT = 1 << 1,
+        // Used together with FLAG_JSON, which gives the names of the JSON report.
+        FLAG_FLAT = 1 << 2
     };
 
     static void CreateInstance(FLAGS flags);
     static void DestroyInstance();
-    static ReportFormatter& GetInstance();
+    // Instance used only by the calling thread, instead of the one shared by all threads.
+    static void CreateThreadInstance(FLAGS flags);
+    // Reports to the sink instead of a formatter, with the names and values of JSON, only on the calling thread.
+    // Unlike a formatter of the thread, it gets only what ReportSelection selects, like the shared instance.
+    static void CreateThreadInstance(std::unique_ptr<ReportSink> sink);
+    static void DestroyThreadInstance();
+    static ReportSink& GetInstance();
     static FLAGS GetFlags();
-
-    virtual ~ReportFormatter() = default;
-
-    virtual void PushObject(std::wstring_view name) = 0;
-    virtual void PushArray(std::wstring_view name, ARRAY_SUFFIX suffix = ARRAY_SUFFIX_SQUARE_BRACKETS) = 0;
-    virtual void PushArrayItem() = 0;
-    virtual void PopScope() = 0;
-
-    // Fields
-    // Strings
-    virtual void AddFieldString(std::wstring_view name, std::wstring_view value) = 0;
-    virtual void AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value) = 0;
-    // Booleans
-    virtual void AddFieldBool(std::wstring_view name, bool value) = 0;
-    // Integers
-    virtual void AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit = {}) = 0;
-    virtual void AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit = {}) = 0;
-    virtual void AddFieldSize(std::wstring_view name, uint64_t value) = 0;
-    virtual void AddFieldSizeKilobytes(std::wstring_view name, uint64_t value) = 0;
-    virtual void AddFieldHex32(std::wstring_view name, uint32_t value) = 0;
-    virtual void AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit = {}) = 0;
-    // Floats
-    virtual void AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit = {}) = 0;
-    // Enums
-    virtual void AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems) = 0;
-    virtual void AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems) = 0;
-    virtual void AddEnumArray(
-        std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems) = 0;
-    virtual void AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems) = 0;
-    // Binary data
-    virtual void AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount) = 0;
-    // Custom types
-    virtual void AddFieldVendorId(std::wstring_view name, uint32_t value) = 0;
-    virtual void AddFieldSubsystemId(std::wstring_view name, uint32_t value) = 0;
-    virtual void AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value) = 0;
-    virtual void AddFieldAMDVersion(std::wstring_view name, uint64_t value) = 0;
-    virtual void AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId,
-        uint32_t implementationId, const EnumItem* architecturePlusImplementationIDEnum) = 0;
+    // Logs the calls to the shared instance that change its state, until EndCallLog. See CallLogReportFormatter.
+    static void BeginCallLog();
+    // Returns the calls logged since BeginCallLog or the previous call.
+    static std::wstring TakeCallLog();
+    static void EndCallLog();
 };
 
 ReportFormatter::FLAGS& operator|=(ReportFormatter::FLAGS& lhs, ReportFormatter::FLAGS rhs);
@@ -88,6 +58,24 @@ public:
     }
 };
 
+class ReportFormatterThreadScope
+{
+public:
+    ReportFormatterThreadScope(ReportFormatter::FLAGS flags)
+    {
+        ReportFormatter::CreateThreadInstance(flags);
+    }
+    ReportFormatterThreadScope(std::unique_ptr<ReportSink> sink)
+    {
+        ReportFormatter::CreateThreadInstance(std::move(sink));
+    }
+
+    ~ReportFormatterThreadScope()
+    {
+        ReportFormatter::DestroyThreadInstance();
+    }
+};
+
 class ReportScopeObject
 {
 public:
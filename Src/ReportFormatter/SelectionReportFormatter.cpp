@@ -0,0 +1,211 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "SelectionReportFormatter.hpp"
+
+#include "ReportSelection.hpp"
+
+SelectionReportFormatter::SelectionReportFormatter(std::unique_ptr<ReportSink> formatter)
+    : m_Formatter(std::move(formatter))
+{
+}
+
+SelectionReportFormatter::~SelectionReportFormatter()
+{
+    assert(m_ScopeStack.empty());
+}
+
+void SelectionReportFormatter::PushObject(std::wstring_view name)
+{
+    PushScope(ScopeType::Object, name, ARRAY_SUFFIX_SQUARE_BRACKETS);
+}
+
+void SelectionReportFormatter::PushArray(std::wstring_view name, ARRAY_SUFFIX suffix)
+{
+    PushScope(ScopeType::Array, name, suffix);
+}
+
+void SelectionReportFormatter::PushArrayItem()
+{
+    assert(!m_ScopeStack.empty() && m_ScopeStack.back().Type == ScopeType::Array);
+    const std::wstring name = std::format(L"{}", m_ScopeStack.back().ItemCount++);
+    PushScope(ScopeType::ArrayItem, name, ARRAY_SUFFIX_SQUARE_BRACKETS);
+}
+
+void SelectionReportFormatter::PopScope()
+{
+    assert(!m_ScopeStack.empty());
+    if(m_ScopeStack.back().Passed)
+        m_Formatter->PopScope();
+    m_ScopeStack.pop_back();
+    ReportSelection::PopScope();
+}
+
+void SelectionReportFormatter::PopAllScopes()
+{
+    m_Formatter->PopAllScopes();
+    m_ScopeStack.clear();
+    ReportSelection::PopAllScopes();
+}
+
+void SelectionReportFormatter::AddFieldString(std::wstring_view name, std::wstring_view value)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldString(name, value);
+}
+
+void SelectionReportFormatter::AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldStringArray(name, value);
+}
+
+void SelectionReportFormatter::AddFieldBool(std::wstring_view name, bool value)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldBool(name, value);
+}
+
+void SelectionReportFormatter::AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldUint32(name, value, unit);
+}
+
+void SelectionReportFormatter::AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldUint64(name, value, unit);
+}
+
+void SelectionReportFormatter::AddFieldSize(std::wstring_view name, uint64_t value)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldSize(name, value);
+}
+
+void SelectionReportFormatter::AddFieldSizeKilobytes(std::wstring_view name, uint64_t value)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldSizeKilobytes(name, value);
+}
+
+void SelectionReportFormatter::AddFieldHex32(std::wstring_view name, uint32_t value)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldHex32(name, value);
+}
+
+void SelectionReportFormatter::AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldInt32(name, value, unit);
+}
+
+void SelectionReportFormatter::AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldFloat(name, value, unit);
+}
+
+void SelectionReportFormatter::AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldEnum(name, value, enumItems);
+}
+
+void SelectionReportFormatter::AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldEnumSigned(name, value, enumItems);
+}
+
+void SelectionReportFormatter::AddEnumArray(
+    std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddEnumArray(name, values, count, enumItems);
+}
+
+void SelectionReportFormatter::AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldFlags(name, value, enumItems);
+}
+
+void SelectionReportFormatter::AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldHexBytes(name, data, byteCount);
+}
+
+void SelectionReportFormatter::AddFieldVendorId(std::wstring_view name, uint32_t value)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldVendorId(name, value);
+}
+
+void SelectionReportFormatter::AddFieldSubsystemId(std::wstring_view name, uint32_t value)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldSubsystemId(name, value);
+}
+
+void SelectionReportFormatter::AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldMicrosoftVersion(name, value);
+}
+
+void SelectionReportFormatter::AddFieldAMDVersion(std::wstring_view name, uint64_t value)
+{
+    if(ReportSink* formatter = BeginField(name))
+        formatter->AddFieldAMDVersion(name, value);
+}
+
+void SelectionReportFormatter::AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId,
+    uint32_t implementationId, const EnumItem* architecturePlusImplementationIDEnum)
+{
+    if(ReportSink* formatter = BeginField(name))
+    {
+        formatter->AddFieldNvidiaImplementationID(
+            name, architectureId, implementationId, architecturePlusImplementationIDEnum);
+    }
+}
+
+void SelectionReportFormatter::PushScope(ScopeType type, std::wstring_view name, ARRAY_SUFFIX suffix)
+{
+    m_ScopeStack.push_back({ type, std::wstring(name), suffix });
+    ReportSelection::PushScope(name);
+}
+
+ReportSink* SelectionReportFormatter::BeginField(std::wstring_view name)
+{
+    if(!ReportSelection::IsFieldSelected(name))
+        return nullptr;
+    for(ScopeInfo& scope : m_ScopeStack)
+    {
+        if(scope.Passed)
+            continue;
+        switch(scope.Type)
+        {
+        case ScopeType::Object:
+            m_Formatter->PushObject(scope.Name);
+            break;
+        case ScopeType::Array:
+            m_Formatter->PushArray(scope.Name, scope.Suffix);
+            break;
+        case ScopeType::ArrayItem:
+            m_Formatter->PushArrayItem();
+            break;
+        }
+        scope.Passed = true;
+    }
+    return m_Formatter.get();
+}
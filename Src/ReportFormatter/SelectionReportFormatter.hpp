@@ -0,0 +1,74 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+
+#pragma once
+
+#include "ReportFormatter.hpp"
+
+// Passes to another formatter or sink only the fields selected by ReportSelection.
+// Scopes are passed only when a field inside them is, so nothing empty is printed.
+class SelectionReportFormatter final : public ReportFormatter
+{
+public:
+    SelectionReportFormatter(std::unique_ptr<ReportSink> formatter);
+    ~SelectionReportFormatter();
+
+    void PushObject(std::wstring_view name) final;
+    void PushArray(std::wstring_view name, ARRAY_SUFFIX suffix = ARRAY_SUFFIX_SQUARE_BRACKETS) final;
+    void PushArrayItem() final;
+    void PopScope() final;
+    void PopAllScopes() final;
+
+    void AddFieldString(std::wstring_view name, std::wstring_view value) final;
+    void AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value) final;
+    void AddFieldBool(std::wstring_view name, bool value) final;
+    void AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit = {}) final;
+    void AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit = {}) final;
+    void AddFieldSize(std::wstring_view name, uint64_t value) final;
+    void AddFieldSizeKilobytes(std::wstring_view name, uint64_t value) final;
+    void AddFieldHex32(std::wstring_view name, uint32_t value) final;
+    void AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit = {}) final;
+    void AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit = {}) final;
+    void AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
+    void AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems) final;
+    void AddEnumArray(std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems) final;
+    void AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems) final;
+    void AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount) final;
+    void AddFieldVendorId(std::wstring_view name, uint32_t value) final;
+    void AddFieldSubsystemId(std::wstring_view name, uint32_t value) final;
+    void AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value) final;
+    void AddFieldAMDVersion(std::wstring_view name, uint64_t value) final;
+    void AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId, uint32_t implementationId,
+        const EnumItem* architecturePlusImplementationIDEnum) final;
+
+private:
+    enum class ScopeType
+    {
+        Object,
+        Array,
+        ArrayItem
+    };
+    struct ScopeInfo
+    {
+        ScopeType Type;
+        std::wstring Name;
+        ARRAY_SUFFIX Suffix = ARRAY_SUFFIX_SQUARE_BRACKETS;
+        // Items pushed so far, used to name the next one.
+        size_t ItemCount = 0;
+        bool Passed = false;
+    };
+
+    std::unique_ptr<ReportSink> m_Formatter;
+    std::vector<ScopeInfo> m_ScopeStack;
+
+    void PushScope(ScopeType type, std::wstring_view name, ARRAY_SUFFIX suffix);
+    // Returns the formatter to add the field to, after passing it all scopes not passed yet, or null to skip it.
+    ReportSink* BeginField(std::wstring_view name);
+};
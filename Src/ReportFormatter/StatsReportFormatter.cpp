@@ -0,0 +1,152 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "StatsReportFormatter.hpp"
+
+#include "ReportStats.hpp"
+
+StatsReportFormatter::StatsReportFormatter(std::unique_ptr<ReportFormatter> formatter)
+    : m_Formatter(std::move(formatter))
+{
+}
+
+// Scopes are opened before they are printed and closed after, so their names and brackets are counted to them.
+
+void StatsReportFormatter::PushObject(std::wstring_view name)
+{
+    ReportStats::PushScope(name);
+    m_Formatter->PushObject(name);
+}
+
+void StatsReportFormatter::PushArray(std::wstring_view name, ARRAY_SUFFIX suffix)
+{
+    ReportStats::PushScope(name);
+    m_Formatter->PushArray(name, suffix);
+}
+
+void StatsReportFormatter::PushArrayItem()
+{
+    ReportStats::PushArrayItem();
+    m_Formatter->PushArrayItem();
+}
+
+void StatsReportFormatter::PopScope()
+{
+    m_Formatter->PopScope();
+    ReportStats::PopScope();
+}
+
+void StatsReportFormatter::PopAllScopes()
+{
+    m_Formatter->PopAllScopes();
+    ReportStats::PopAllScopes();
+}
+
+void StatsReportFormatter::AddFieldString(std::wstring_view name, std::wstring_view value)
+{
+    m_Formatter->AddFieldString(name, value);
+}
+
+void StatsReportFormatter::AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value)
+{
+    m_Formatter->AddFieldStringArray(name, value);
+}
+
+void StatsReportFormatter::AddFieldBool(std::wstring_view name, bool value)
+{
+    m_Formatter->AddFieldBool(name, value);
+}
+
+void StatsReportFormatter::AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit)
+{
+    m_Formatter->AddFieldUint32(name, value, unit);
+}
+
+void StatsReportFormatter::AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit)
+{
+    m_Formatter->AddFieldUint64(name, value, unit);
+}
+
+void StatsReportFormatter::AddFieldSize(std::wstring_view name, uint64_t value)
+{
+    m_Formatter->AddFieldSize(name, value);
+}
+
+void StatsReportFormatter::AddFieldSizeKilobytes(std::wstring_view name, uint64_t value)
+{
+    m_Formatter->AddFieldSizeKilobytes(name, value);
+}
+
+void StatsReportFormatter::AddFieldHex32(std::wstring_view name, uint32_t value)
+{
+    m_Formatter->AddFieldHex32(name, value);
+}
+
+void StatsReportFormatter::AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit)
+{
+    m_Formatter->AddFieldInt32(name, value, unit);
+}
+
+void StatsReportFormatter::AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit)
+{
+    m_Formatter->AddFieldFloat(name, value, unit);
+}
+
+void StatsReportFormatter::AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    m_Formatter->AddFieldEnum(name, value, enumItems);
+}
+
+void StatsReportFormatter::AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems)
+{
+    m_Formatter->AddFieldEnumSigned(name, value, enumItems);
+}
+
+void StatsReportFormatter::AddEnumArray(
+    std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems)
+{
+    m_Formatter->AddEnumArray(name, values, count, enumItems);
+}
+
+void StatsReportFormatter::AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    m_Formatter->AddFieldFlags(name, value, enumItems);
+}
+
+void StatsReportFormatter::AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount)
+{
+    m_Formatter->AddFieldHexBytes(name, data, byteCount);
+}
+
+void StatsReportFormatter::AddFieldVendorId(std::wstring_view name, uint32_t value)
+{
+    m_Formatter->AddFieldVendorId(name, value);
+}
+
+void StatsReportFormatter::AddFieldSubsystemId(std::wstring_view name, uint32_t value)
+{
+    m_Formatter->AddFieldSubsystemId(name, value);
+}
+
+void StatsReportFormatter::AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value)
+{
+    m_Formatter->AddFieldMicrosoftVersion(name, value);
+}
+
+void StatsReportFormatter::AddFieldAMDVersion(std::wstring_view name, uint64_t value)
+{
+    m_Formatter->AddFieldAMDVersion(name, value);
+}
+
+void StatsReportFormatter::AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId,
+    uint32_t implementationId, const EnumItem* architecturePlusImplementationIDEnum)
+{
+    m_Formatter->AddFieldNvidiaImplementationID(
+        name, architectureId, implementationId, architecturePlusImplementationIDEnum);
+}
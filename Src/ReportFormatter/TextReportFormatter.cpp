@@ -9,7 +9,7 @@ For more information, see files README.md, LICENSE.txt.
 */
 #include "TextReportFormatter.hpp"
 
-#include "Enums.hpp"
+#include "EnumsBase.hpp"
 #include "Printer.hpp"
 
 TextReportFormatter::TextReportFormatter(FLAGS flags)
@@ -100,6 +100,12 @@ void TextReportFormatter::PopScope()
     }
 }
 
+void TextReportFormatter::PopAllScopes()
+{
+    while(!m_ScopeStack.empty())
+        PopScope();
+}
+
 void TextReportFormatter::AddFieldString(std::wstring_view name, std::wstring_view value)
 {
     assert(!name.empty());
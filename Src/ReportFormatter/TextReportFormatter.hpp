@@ -22,6 +22,7 @@ public:
     void PushArray(std::wstring_view name, ARRAY_SUFFIX suffix = ARRAY_SUFFIX_SQUARE_BRACKETS);
     void PushArrayItem() final;
     void PopScope() final;
+    void PopAllScopes() final;
 
     void AddFieldString(std::wstring_view name, std::wstring_view value) final;
     void AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value) final;
@@ -0,0 +1,257 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "ReportRenderer.hpp"
+
+#include "Enums.hpp"
+#include "Json.hpp"
+#include "Printer.hpp"
+#include "Utils.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// Numbers of an array are rendered as values of an enum without any named items.
+static const EnumItem NO_ENUM_ITEMS[] = { { nullptr, 0 } };
+
+static const std::chrono::milliseconds POLL_INTERVAL = std::chrono::milliseconds(10);
+static const std::chrono::seconds PROGRESS_INTERVAL = std::chrono::seconds(1);
+
+struct RenderJob
+{
+    std::vector<std::filesystem::path> m_InputPaths;
+    std::filesystem::path m_OutputDirectory;
+    ReportFormatter::FLAGS m_Flags = ReportFormatter::FLAGS::FLAG_NONE;
+
+    // Every thread takes the next report not taken yet, so the threads stay busy until the end
+    // no matter how the sizes of the reports differ.
+    std::atomic<size_t> m_NextIndex = 0;
+    std::atomic<size_t> m_FinishedCount = 0;
+
+    std::mutex m_ErrorMutex;
+    std::vector<std::wstring> m_Errors;
+};
+
+static void RenderMembers(const JsonValue& object);
+
+static bool AreAllItemsOfType(const JsonValue& array, JsonValue::Type type)
+{
+    return std::all_of(
+        array.m_Items.begin(), array.m_Items.end(), [type](const JsonValue& item) { return item.m_Type == type; });
+}
+
+static bool IsUint32(const JsonValue& value)
+{
+    return value.m_Type == JsonValue::Type::Number &&
+        value.m_String.find_first_not_of(L"0123456789") == std::wstring::npos &&
+        std::stoull(value.m_String) <= UINT32_MAX;
+}
+
+static void RenderNumber(std::wstring_view name, const std::wstring& number)
+{
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    if(number.find_first_of(L".eE") != std::wstring::npos)
+    {
+        formatter.AddFieldFloat(name, std::stof(number));
+        return;
+    }
+    const int64_t value = std::stoll(number);
+    if(value < 0)
+        formatter.AddFieldInt32(name, int32_t(value));
+    else if(value <= int64_t(UINT32_MAX))
+        formatter.AddFieldUint32(name, uint32_t(value));
+    else
+        formatter.AddFieldUint64(name, uint64_t(value));
+}
+
+static void RenderArray(std::wstring_view name, const JsonValue& array)
+{
+    ReportSink& formatter = ReportFormatter::GetInstance();
+
+    // Arrays of strings and numbers are printed by the formatters with a single call.
+    if(!array.m_Items.empty() && AreAllItemsOfType(array, JsonValue::Type::String))
+    {
+        std::vector<std::wstring> strings;
+        for(const JsonValue& item : array.m_Items)
+            strings.push_back(item.m_String);
+        formatter.AddFieldStringArray(name, strings);
+        return;
+    }
+    if(!array.m_Items.empty() && std::all_of(array.m_Items.begin(), array.m_Items.end(), IsUint32))
+    {
+        std::vector<uint32_t> values;
+        for(const JsonValue& item : array.m_Items)
+            values.push_back(uint32_t(std::stoul(item.m_String)));
+        formatter.AddEnumArray(name, values.data(), values.size(), NO_ENUM_ITEMS);
+        return;
+    }
+
+    ReportScopeArray scope(name);
+    for(const JsonValue& item : array.m_Items)
+    {
+        if(!item.IsObject())
+            throw std::runtime_error("Unsupported item of an array.");
+        ReportScopeArrayItem itemScope;
+        RenderMembers(item);
+    }
+}
+
+static void RenderMember(std::wstring_view name, const JsonValue& value)
+{
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    switch(value.m_Type)
+    {
+    case JsonValue::Type::Bool:
+        formatter.AddFieldBool(name, value.m_Bool);
+        break;
+    case JsonValue::Type::Number:
+        RenderNumber(name, value.m_String);
+        break;
+    case JsonValue::Type::String:
+        // The formatters never print empty strings.
+        if(value.m_String.empty())
+            throw std::runtime_error("Unsupported empty string.");
+        formatter.AddFieldString(name, value.m_String);
+        break;
+    case JsonValue::Type::Array:
+        RenderArray(name, value);
+        break;
+    case JsonValue::Type::Object: {
+        ReportScopeObject scope(name);
+        RenderMembers(value);
+    }
+    break;
+    default:
+        throw std::runtime_error("Unsupported null value.");
+    }
+}
+
+static void RenderMembers(const JsonValue& object)
+{
+    for(const auto& [name, value] : object.m_Members)
+    {
+        if(name.empty())
+            throw std::runtime_error("Unsupported empty name.");
+        RenderMember(name, value);
+    }
+}
+
+static void RenderFile(
+    const std::filesystem::path& inputPath, const std::filesystem::path& outputPath, ReportFormatter::FLAGS flags)
+{
+    const JsonValue report = ParseJson(LoadTextFile(inputPath.wstring()));
+
+    // Written under a temporary name first, so the output is never left incomplete.
+    std::filesystem::path tempPath = outputPath;
+    tempPath += L".tmp";
+    try
+    {
+        {
+            PrinterThreadScope printerScope(true, tempPath.wstring());
+            ReportFormatterThreadScope formatterScope(flags);
+            RenderJsonReport(report);
+        }
+        std::filesystem::rename(tempPath, outputPath);
+    }
+    catch(...)
+    {
+        std::error_code ec;
+        std::filesystem::remove(tempPath, ec);
+        throw;
+    }
+}
+
+static void RenderWorker(RenderJob& job)
+{
+    for(size_t index = job.m_NextIndex++; index < job.m_InputPaths.size(); index = job.m_NextIndex++)
+    {
+        const std::filesystem::path& inputPath = job.m_InputPaths[index];
+        std::filesystem::path outputPath = job.m_OutputDirectory / inputPath.filename();
+        outputPath.replace_extension(L".json");
+        try
+        {
+            RenderFile(inputPath, outputPath, job.m_Flags);
+        }
+        catch(const std::exception& ex)
+        {
+            const std::wstring message = StrToWstr(ex.what(), CP_ACP);
+            std::lock_guard<std::mutex> lock(job.m_ErrorMutex);
+            job.m_Errors.push_back(std::format(L"{}: {}", inputPath.wstring(), message));
+        }
+        ++job.m_FinishedCount;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+void RenderJsonReport(const JsonValue& report)
+{
+    if(!report.IsObject())
+        throw std::runtime_error("The document is not a report.");
+    // Text reports can hold fields only inside objects, so the root may contain nothing else.
+    for(const auto& [name, value] : report.m_Members)
+    {
+        const bool isArrayOfObjects = value.IsArray() && AreAllItemsOfType(value, JsonValue::Type::Object);
+        if(name.empty() || !(value.IsObject() || isArrayOfObjects))
+            throw std::runtime_error("Unsupported field outside of an object.");
+    }
+    RenderMembers(report);
+}
+
+int RenderReportDirectory(
+    const std::wstring& inputDirectory, const std::wstring& outputDirectory, ReportFormatter::FLAGS flags)
+{
+    assert((flags & ReportFormatter::FLAGS::FLAG_JSON) != ReportFormatter::FLAGS::FLAG_NONE &&
+        (flags & ReportFormatter::FLAGS::FLAG_FLAT) == ReportFormatter::FLAGS::FLAG_NONE);
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    RenderJob job;
+    job.m_OutputDirectory = outputDirectory;
+    job.m_Flags = flags;
+    for(const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(inputDirectory))
+    {
+        if(entry.is_regular_file() && entry.path().extension() == L".json")
+            job.m_InputPaths.push_back(entry.path());
+    }
+    std::filesystem::create_directories(job.m_OutputDirectory);
+
+    const size_t reportCount = job.m_InputPaths.size();
+    const size_t threadCount =
+        std::clamp<size_t>(std::thread::hardware_concurrency(), 1, std::max<size_t>(reportCount, 1));
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < threadCount; ++i)
+        threads.emplace_back(RenderWorker, std::ref(job));
+
+    // Progress goes to the error output, so the summary is the only thing printed.
+    std::chrono::steady_clock::time_point progressTime = startTime;
+    for(size_t finishedCount = job.m_FinishedCount; finishedCount < reportCount; finishedCount = job.m_FinishedCount)
+    {
+        std::this_thread::sleep_for(POLL_INTERVAL);
+        if(std::chrono::steady_clock::now() - progressTime >= PROGRESS_INTERVAL)
+        {
+            ErrorPrinter::PrintFormat(
+                "Rendered {}/{} reports...\n", std::make_format_args(finishedCount, reportCount));
+            progressTime = std::chrono::steady_clock::now();
+        }
+    }
+    for(std::thread& thread : threads)
+        thread.join();
+
+    for(const std::wstring& error : job.m_Errors)
+        ErrorPrinter::PrintFormat(L"ERROR: {}\n", std::make_wformat_args(error));
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    const double reportsPerSecond = seconds > 0.0 ? double(reportCount) / seconds : 0.0;
+    const size_t failedCount = job.m_Errors.size();
+    Printer::PrintFormat(L"Rendered {} reports, {} failed, in {:.2f} s ({:.1f} reports/s) on {} threads.\n",
+        std::make_wformat_args(reportCount, failedCount, seconds, reportsPerSecond, threadCount));
+
+    return job.m_Errors.empty() ? PROGRAM_EXIT_SUCCESS : PROGRAM_EXIT_ERROR_EXCEPTION;
+}
@@ -0,0 +1,26 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+#include "ReportFormatter/ReportFormatter.hpp"
+
+struct JsonValue;
+
+// Renders a report read back from JSON through the current formatter again.
+// Types come from JSON, so enums, units and hexadecimal values are shown as plain numbers.
+// Throws if the document is not a report.
+void RenderJsonReport(const JsonValue& report);
+
+// Renders every JSON report in inputDirectory again as JSON, with the options of the formatter in flags, on all
+// hardware threads. Other formats would show enums, units and hexadecimal values as plain numbers, so flags must
+// select JSON. Each is written to outputDirectory with the same name, replacing the file at once.
+// A report that fails doesn't stop the others. Returns the exit code of the program.
+int RenderReportDirectory(
+    const std::wstring& inputDirectory, const std::wstring& outputDirectory, ReportFormatter::FLAGS flags);
@@ -0,0 +1,205 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "ReportSelection.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+struct PathName
+{
+    std::wstring_view m_Name;
+    std::wstring_view m_Alias;
+};
+
+struct PathScope
+{
+    std::wstring m_Name;
+    std::wstring m_Alias;
+};
+
+// Scopes of the report currently open, from the root.
+static std::vector<PathScope> g_Path;
+static std::wstring g_NextAlias;
+
+// If prefix is true, it's enough that some name starting with str could match.
+static bool MatchName(std::wstring_view pattern, std::wstring_view str, bool prefix)
+{
+    size_t patternIndex = 0;
+    size_t strIndex = 0;
+    // Position to come back to after a mismatch: the last '*' seen and the character it matched up to.
+    size_t starPatternIndex = SIZE_MAX;
+    size_t starStrIndex = 0;
+    while(strIndex < str.length())
+    {
+        if(patternIndex < pattern.length() && pattern[patternIndex] == L'*')
+        {
+            starPatternIndex = patternIndex++;
+            starStrIndex = strIndex;
+        }
+        else if(patternIndex < pattern.length() &&
+            (pattern[patternIndex] == L'?' || pattern[patternIndex] == str[strIndex]))
+        {
+            ++patternIndex;
+            ++strIndex;
+        }
+        else if(starPatternIndex != SIZE_MAX)
+        {
+            patternIndex = starPatternIndex + 1;
+            strIndex = ++starStrIndex;
+        }
+        else
+            return false;
+    }
+    // The rest of the pattern can match the characters following str.
+    if(prefix)
+        return true;
+    while(patternIndex < pattern.length() && pattern[patternIndex] == L'*')
+        ++patternIndex;
+    return patternIndex == pattern.length();
+}
+
+static bool MatchPathName(std::wstring_view pattern, const PathName& name, bool prefix)
+{
+    return MatchName(pattern, name.m_Name, prefix) ||
+        (!name.m_Alias.empty() && MatchName(pattern, name.m_Alias, prefix));
+}
+
+static PathName GetPathName(size_t index)
+{
+    return { g_Path[index].m_Name, g_Path[index].m_Alias };
+}
+
+// Whether the current path followed by name lies below a path selected by the pattern.
+static bool IsBelowPattern(const std::vector<std::wstring>& pattern, const PathName& name)
+{
+    if(pattern.size() > g_Path.size() + 1)
+        return false;
+    for(size_t i = 0; i < pattern.size(); ++i)
+    {
+        if(!MatchPathName(pattern[i], i < g_Path.size() ? GetPathName(i) : name, false))
+            return false;
+    }
+    return true;
+}
+
+// Whether the current path followed by name leads to a path selected by the pattern.
+static bool IsAbovePattern(const std::vector<std::wstring>& pattern, const PathName& name, bool namePrefix)
+{
+    if(pattern.size() <= g_Path.size())
+        return false;
+    for(size_t i = 0; i < g_Path.size(); ++i)
+    {
+        if(!MatchPathName(pattern[i], GetPathName(i), false))
+            return false;
+    }
+    return MatchPathName(pattern[g_Path.size()], name, namePrefix);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+std::vector<std::vector<std::wstring>> ReportSelection::s_Patterns;
+
+void ReportSelection::Add(std::wstring_view paths)
+{
+    while(true)
+    {
+        const size_t pathEnd = std::min(paths.find(L','), paths.length());
+        std::wstring_view path = paths.substr(0, pathEnd);
+        if(path.empty())
+            throw std::runtime_error("Empty path in --Select.");
+
+        std::vector<std::wstring>& pattern = s_Patterns.emplace_back();
+        while(true)
+        {
+            const size_t nameEnd = std::min(path.find(L'/'), path.length());
+            pattern.emplace_back(path.substr(0, nameEnd));
+            if(nameEnd == path.length())
+                break;
+            path.remove_prefix(nameEnd + 1);
+        }
+
+        if(pathEnd == paths.length())
+            break;
+        paths.remove_prefix(pathEnd + 1);
+    }
+}
+
+void ReportSelection::Clear()
+{
+    s_Patterns.clear();
+}
+
+bool ReportSelection::IsSelected(std::wstring_view name, std::wstring_view alias)
+{
+    if(!IsEnabled())
+        return true;
+    const PathName pathName = { name, alias };
+    for(const std::vector<std::wstring>& pattern : s_Patterns)
+    {
+        if(IsBelowPattern(pattern, pathName) || IsAbovePattern(pattern, pathName, false))
+            return true;
+    }
+    return false;
+}
+
+bool ReportSelection::IsPrefixSelected(std::wstring_view namePrefix)
+{
+    if(!IsEnabled())
+        return true;
+    for(const std::vector<std::wstring>& pattern : s_Patterns)
+    {
+        // Below a selected path, all names are selected.
+        if((pattern.size() <= g_Path.size() && IsBelowPattern(pattern, {})) ||
+            IsAbovePattern(pattern, { namePrefix }, true))
+            return true;
+    }
+    return false;
+}
+
+bool ReportSelection::IsFieldSelected(std::wstring_view name)
+{
+    if(!IsEnabled())
+        return true;
+    for(const std::vector<std::wstring>& pattern : s_Patterns)
+    {
+        if(IsBelowPattern(pattern, { name }))
+            return true;
+    }
+    return false;
+}
+
+void ReportSelection::PushScope(std::wstring_view name)
+{
+    g_Path.push_back({ std::wstring(name), std::move(g_NextAlias) });
+    g_NextAlias.clear();
+}
+
+void ReportSelection::PopScope()
+{
+    assert(!g_Path.empty());
+    g_Path.pop_back();
+}
+
+void ReportSelection::PopAllScopes()
+{
+    g_Path.clear();
+}
+
+ReportSelection::AliasScope::AliasScope(std::wstring_view alias)
+{
+    g_NextAlias = alias;
+}
+
+// Clears the alias if no scope was pushed.
+ReportSelection::AliasScope::~AliasScope()
+{
+    g_NextAlias.clear();
+}
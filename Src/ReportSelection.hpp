@@ -0,0 +1,58 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Parts of the report chosen with --Select, as paths of names from the JSON report separated by '/',
+// e.g. "Adapters/*/D3D12_FEATURE_DATA_D3D12_OPTIONS5/RaytracingTier". Items of arrays are named by their index.
+// In each name, '*' matches any number of characters and '?' matches one character.
+// A path selects everything below it.
+// Queries are checked with IsSelected before they are made, so those not selected cost nothing.
+// Without any paths, everything is selected.
+// A scope can also be matched by an alias, e.g. a format, which JSON names by its value, by the name of the format.
+class ReportSelection
+{
+public:
+    static bool IsEnabled()
+    {
+        return !s_Patterns.empty();
+    }
+    // Adds paths separated by ','. Throws on an empty path.
+    static void Add(std::wstring_view paths);
+    // Removes all paths, so everything is selected again.
+    static void Clear();
+
+    // Whether anything below the current scope of the report followed by name can be selected.
+    static bool IsSelected(std::wstring_view name, std::wstring_view alias = {});
+    // Like IsSelected, for all names that start with namePrefix, e.g. sections of one vendor-specific API.
+    static bool IsPrefixSelected(std::wstring_view namePrefix);
+    // Whether a field of the current scope is selected.
+    static bool IsFieldSelected(std::wstring_view name);
+    // Sections off by default are included by their option or, if paths are selected, if they are selected.
+    static bool IsOptionalSectionIncluded(bool option, std::wstring_view name)
+    {
+        return IsEnabled() ? IsSelected(name) : option;
+    }
+
+    // Maintained by the report formatter.
+    static void PushScope(std::wstring_view name);
+    static void PopScope();
+    static void PopAllScopes();
+
+    // Sets the alias of the next scope pushed.
+    class AliasScope
+    {
+    public:
+        AliasScope(std::wstring_view alias);
+        ~AliasScope();
+    };
+
+private:
+    static std::vector<std::vector<std::wstring>> s_Patterns;
+};
@@ -0,0 +1,64 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+struct EnumItem;
+
+// Receives the report from the probes: scopes and typed fields, in the order they are found.
+// Implemented by the formatters, which print it, and by ReportTreeBuilder, which keeps it in memory.
+class ReportSink
+{
+public:
+    enum ARRAY_SUFFIX
+    {
+        ARRAY_SUFFIX_SQUARE_BRACKETS,
+        ARRAY_SUFFIX_NONE
+    };
+
+    virtual ~ReportSink() = default;
+
+    virtual void PushObject(std::wstring_view name) = 0;
+    virtual void PushArray(std::wstring_view name, ARRAY_SUFFIX suffix = ARRAY_SUFFIX_SQUARE_BRACKETS) = 0;
+    virtual void PushArrayItem() = 0;
+    virtual void PopScope() = 0;
+    // Closes all scopes still open, leaving only the root of the report.
+    virtual void PopAllScopes() = 0;
+
+    // Fields
+    // Strings
+    virtual void AddFieldString(std::wstring_view name, std::wstring_view value) = 0;
+    virtual void AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value) = 0;
+    // Booleans
+    virtual void AddFieldBool(std::wstring_view name, bool value) = 0;
+    // Integers
+    virtual void AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit = {}) = 0;
+    virtual void AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit = {}) = 0;
+    virtual void AddFieldSize(std::wstring_view name, uint64_t value) = 0;
+    virtual void AddFieldSizeKilobytes(std::wstring_view name, uint64_t value) = 0;
+    virtual void AddFieldHex32(std::wstring_view name, uint32_t value) = 0;
+    virtual void AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit = {}) = 0;
+    // Floats
+    virtual void AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit = {}) = 0;
+    // Enums
+    virtual void AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems) = 0;
+    virtual void AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems) = 0;
+    virtual void AddEnumArray(
+        std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems) = 0;
+    virtual void AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems) = 0;
+    // Binary data
+    virtual void AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount) = 0;
+    // Custom types
+    virtual void AddFieldVendorId(std::wstring_view name, uint32_t value) = 0;
+    virtual void AddFieldSubsystemId(std::wstring_view name, uint32_t value) = 0;
+    virtual void AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value) = 0;
+    virtual void AddFieldAMDVersion(std::wstring_view name, uint64_t value) = 0;
+    virtual void AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId,
+        uint32_t implementationId, const EnumItem* architecturePlusImplementationIDEnum) = 0;
+};
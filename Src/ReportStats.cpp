@@ -0,0 +1,199 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "ReportStats.hpp"
+
+#include "Printer.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+struct ScopeStats
+{
+    // Names of the scopes it is nested in, like "Adapters / 0 / Formats".
+    std::wstring m_Path;
+    // Allocations and frees.
+    uint64_t m_HeapCallCount = 0;
+    uint64_t m_AllocatedBytes = 0;
+    uint64_t m_PeakLiveBytes = 0;
+    uint64_t m_OutputBytes = 0;
+};
+
+struct OpenScope
+{
+    size_t m_StatsIndex;
+    int64_t m_BaseLiveBytes;
+    // Items pushed so far, used to name the next one.
+    size_t m_ItemCount;
+};
+
+static const wchar_t* const SCOPE_SEPARATOR = L" / ";
+// Row of what is outside of all scopes, whose peak is that of the whole report.
+static const wchar_t* const REPORT_SCOPE_NAME = L"(report)";
+
+// In the order of first use, starting with the report.
+static std::vector<ScopeStats> g_Scopes;
+static std::unordered_map<std::wstring, size_t> g_ScopeIndices;
+// Starts with the report, so it is never empty. Reserved, so opening a scope doesn't allocate.
+static std::vector<OpenScope> g_OpenScopes;
+// Number of scopes open beyond MAX_SCOPE_DEPTH.
+static size_t g_IgnoredDepth = 0;
+// Usable size of blocks allocated minus those freed since enabled. Negative after freeing older ones.
+static int64_t g_LiveBytes = 0;
+
+static ScopeStats& GetCurrentScope()
+{
+    return g_Scopes[g_OpenScopes.back().m_StatsIndex];
+}
+
+// Call with counting disabled, as it allocates.
+static void OpenChildScope(std::wstring_view name)
+{
+    std::wstring path;
+    if(g_OpenScopes.size() > 1)
+    {
+        path = g_Scopes[g_OpenScopes.back().m_StatsIndex].m_Path;
+        path += SCOPE_SEPARATOR;
+    }
+    path += name;
+
+    auto [it, inserted] = g_ScopeIndices.emplace(std::move(path), g_Scopes.size());
+    if(inserted)
+        g_Scopes.emplace_back().m_Path = it->first;
+    g_OpenScopes.push_back({ it->second, g_LiveBytes, 0 });
+}
+
+static void PrintRow(const ScopeStats& scope, size_t pathWidth)
+{
+    ErrorPrinter::PrintString(std::format(L"{:<{}}  {:>10}  {:>14}  {:>14}  {:>12}\n", scope.m_Path, pathWidth,
+        scope.m_HeapCallCount, scope.m_AllocatedBytes, scope.m_PeakLiveBytes, scope.m_OutputBytes));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+thread_local bool ReportStats::s_Enabled = false;
+
+void ReportStats::Enable()
+{
+    assert(!s_Enabled);
+    g_Scopes.clear();
+    g_ScopeIndices.clear();
+    g_Scopes.emplace_back().m_Path = REPORT_SCOPE_NAME;
+    g_OpenScopes.clear();
+    g_OpenScopes.reserve(MAX_SCOPE_DEPTH + 1);
+    g_OpenScopes.push_back({ 0, 0, 0 });
+    g_IgnoredDepth = 0;
+    g_LiveBytes = 0;
+    s_Enabled = true;
+}
+
+void ReportStats::OnAllocate(size_t size, size_t usableSize)
+{
+    assert(s_Enabled);
+    ScopeStats& currentScope = GetCurrentScope();
+    ++currentScope.m_HeapCallCount;
+    currentScope.m_AllocatedBytes += size;
+
+    g_LiveBytes += int64_t(usableSize);
+    for(const OpenScope& openScope : g_OpenScopes)
+    {
+        if(g_LiveBytes > openScope.m_BaseLiveBytes)
+        {
+            ScopeStats& scope = g_Scopes[openScope.m_StatsIndex];
+            scope.m_PeakLiveBytes = std::max(scope.m_PeakLiveBytes, uint64_t(g_LiveBytes - openScope.m_BaseLiveBytes));
+        }
+    }
+}
+
+void ReportStats::OnFree(size_t usableSize)
+{
+    assert(s_Enabled);
+    ++GetCurrentScope().m_HeapCallCount;
+    g_LiveBytes -= int64_t(usableSize);
+}
+
+void ReportStats::AddOutput(size_t byteCount)
+{
+    if(s_Enabled)
+        GetCurrentScope().m_OutputBytes += byteCount;
+}
+
+void ReportStats::PushScope(std::wstring_view name)
+{
+    if(!s_Enabled)
+        return;
+    if(g_OpenScopes.size() > MAX_SCOPE_DEPTH)
+    {
+        ++g_IgnoredDepth;
+        return;
+    }
+    s_Enabled = false;
+    OpenChildScope(name);
+    s_Enabled = true;
+}
+
+void ReportStats::PushArrayItem()
+{
+    if(!s_Enabled)
+        return;
+    if(g_OpenScopes.size() > MAX_SCOPE_DEPTH)
+    {
+        ++g_IgnoredDepth;
+        return;
+    }
+    s_Enabled = false;
+    const std::wstring name = std::format(L"{}", g_OpenScopes.back().m_ItemCount++);
+    OpenChildScope(name);
+    s_Enabled = true;
+}
+
+void ReportStats::PopScope()
+{
+    if(!s_Enabled)
+        return;
+    if(g_IgnoredDepth > 0)
+    {
+        --g_IgnoredDepth;
+        return;
+    }
+    assert(g_OpenScopes.size() > 1);
+    g_OpenScopes.pop_back();
+}
+
+void ReportStats::PopAllScopes()
+{
+    if(!s_Enabled)
+        return;
+    g_OpenScopes.resize(1);
+    g_IgnoredDepth = 0;
+}
+
+void ReportStats::PrintSummary()
+{
+    s_Enabled = false;
+
+    ScopeStats total;
+    total.m_Path = L"Total";
+    total.m_PeakLiveBytes = g_Scopes.empty() ? 0 : g_Scopes[0].m_PeakLiveBytes;
+    size_t pathWidth = total.m_Path.length();
+    for(const ScopeStats& scope : g_Scopes)
+    {
+        total.m_HeapCallCount += scope.m_HeapCallCount;
+        total.m_AllocatedBytes += scope.m_AllocatedBytes;
+        total.m_OutputBytes += scope.m_OutputBytes;
+        pathWidth = std::max(pathWidth, scope.m_Path.length());
+    }
+
+    ErrorPrinter::PrintString(std::format(L"{:<{}}  {:>10}  {:>14}  {:>14}  {:>12}\n", L"Scope", pathWidth,
+        L"HeapCalls", L"AllocatedBytes", L"PeakLiveBytes", L"OutputBytes"));
+    for(const ScopeStats& scope : g_Scopes)
+        PrintRow(scope, pathWidth);
+    PrintRow(total, pathWidth);
+}
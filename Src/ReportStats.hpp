@@ -0,0 +1,48 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Heap allocations and output of the report attributed to its scopes, for --Stats.
+// The program calls OnAllocate and OnFree from its global operator new and delete, the printer calls AddOutput and
+// the formatter opens and closes the scopes. Only the thread that enabled it is counted.
+// Calls, bytes allocated and output are counted to the innermost scope only, so the rows add up to the total.
+// The peak is of the memory allocated while the scope was open, also by the scopes nested in it, above what was
+// allocated when it was opened. Scopes nested deeper than MAX_SCOPE_DEPTH are counted to their parent.
+class ReportStats
+{
+public:
+    static constexpr size_t MAX_SCOPE_DEPTH = 3;
+
+    static bool IsEnabled()
+    {
+        return s_Enabled;
+    }
+    // Forgets all that was counted so far.
+    static void Enable();
+
+    // size is the size requested, usableSize the size of the block actually allocated, which is also known when it
+    // is freed.
+    static void OnAllocate(size_t size, size_t usableSize);
+    static void OnFree(size_t usableSize);
+    static void AddOutput(size_t byteCount);
+
+    static void PushScope(std::wstring_view name);
+    // Named by its index in the array.
+    static void PushArrayItem();
+    static void PopScope();
+    static void PopAllScopes();
+
+    // Stops counting and prints the table of the scopes to the error output, so it doesn't mix with the report.
+    static void PrintSummary();
+
+private:
+    // Also cleared while it updates its own data, so the memory it allocates is not counted.
+    static thread_local bool s_Enabled;
+};
@@ -0,0 +1,374 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "ReportTree.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// wchar_t is UTF-16 on Windows, with characters above U+FFFF as surrogate pairs, and UTF-32 elsewhere.
+static void AppendUtf8(std::wstring_view str, std::vector<char>& out)
+{
+    for(size_t i = 0; i < str.size(); ++i)
+    {
+        uint32_t code = uint32_t(str[i]);
+        if(code >= 0xD800 && code < 0xDC00 && i + 1 < str.size() && uint32_t(str[i + 1]) >= 0xDC00 &&
+            uint32_t(str[i + 1]) < 0xE000)
+        {
+            code = 0x10000 + ((code - 0xD800) << 10) + (uint32_t(str[i + 1]) - 0xDC00);
+            ++i;
+        }
+
+        if(code < 0x80)
+            out.push_back(char(code));
+        else if(code < 0x800)
+        {
+            out.push_back(char(0xC0 | (code >> 6)));
+            out.push_back(char(0x80 | (code & 0x3F)));
+        }
+        else if(code < 0x10000)
+        {
+            out.push_back(char(0xE0 | (code >> 12)));
+            out.push_back(char(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(char(0x80 | (code & 0x3F)));
+        }
+        else
+        {
+            out.push_back(char(0xF0 | (code >> 18)));
+            out.push_back(char(0x80 | ((code >> 12) & 0x3F)));
+            out.push_back(char(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(char(0x80 | (code & 0x3F)));
+        }
+    }
+}
+
+// Escapes the same characters as EscapeJsonString.
+static void AppendJsonString(const char* str, std::string& out)
+{
+    out += '"';
+    for(; *str != '\0'; ++str)
+    {
+        switch(*str)
+        {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\b':
+            out += "\\b";
+            break;
+        case '\f':
+            out += "\\f";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            out += *str;
+        }
+    }
+    out += '"';
+}
+
+// Returns false if name is not a decimal index.
+static bool ParseIndex(std::string_view name, uint32_t& outIndex)
+{
+    if(name.empty() || name.length() > 9 || name.find_first_not_of("0123456789") != std::string_view::npos)
+        return false;
+    outIndex = 0;
+    for(char ch : name)
+        outIndex = outIndex * 10 + uint32_t(ch - '0');
+    return true;
+}
+
+uint32_t ReportTree::AddString(std::wstring_view str)
+{
+    if(str.empty())
+        return 0;
+    const uint32_t offset = uint32_t(m_Strings.size());
+    AppendUtf8(str, m_Strings);
+    m_Strings.push_back('\0');
+    return offset;
+}
+
+uint32_t ReportTree::AddNode(uint32_t parent, Type type, std::wstring_view name)
+{
+    const uint32_t index = uint32_t(m_Nodes.size());
+    m_Nodes.push_back({ .m_Type = type, .m_Name = AddString(name) });
+
+    Node& parentNode = m_Nodes[parent];
+    if(parentNode.m_LastChild != NO_NODE)
+        m_Nodes[parentNode.m_LastChild].m_NextSibling = index;
+    else
+        parentNode.m_FirstChild = index;
+    parentNode.m_LastChild = index;
+    return index;
+}
+
+void ReportTree::WriteJsonNode(uint32_t index, bool named, std::string& out) const
+{
+    const Node& node = m_Nodes[index];
+    if(named)
+    {
+        AppendJsonString(GetString(node.m_Name), out);
+        out += ':';
+    }
+
+    switch(node.m_Type)
+    {
+    case Type::Object:
+    case Type::Array:
+        out += node.m_Type == Type::Object ? '{' : '[';
+        for(uint32_t child = node.m_FirstChild; child != NO_NODE; child = m_Nodes[child].m_NextSibling)
+        {
+            if(child != node.m_FirstChild)
+                out += ',';
+            WriteJsonNode(child, node.m_Type == Type::Object, out);
+        }
+        out += node.m_Type == Type::Object ? '}' : ']';
+        break;
+    case Type::Bool:
+        out += node.m_Uint64 != 0 ? "true" : "false";
+        break;
+    case Type::Uint32:
+        out += std::to_string(node.m_Uint64);
+        break;
+    case Type::Int32:
+        out += std::to_string(node.m_Int32);
+        break;
+    case Type::Float:
+        out += std::format("{}", node.m_Float);
+        break;
+    case Type::Uint64:
+        out += '"';
+        out += std::to_string(node.m_Uint64);
+        out += '"';
+        break;
+    case Type::String:
+        AppendJsonString(GetString(node.m_String), out);
+        break;
+    default:
+        assert(0);
+    }
+}
+
+ReportTree::Node& ReportTreeBuilder::AddField(ReportTree::Type type, std::wstring_view name)
+{
+    assert(!name.empty());
+    return m_Tree.m_Nodes[m_Tree.AddNode(m_ScopeStack.back(), type, name)];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+ReportTree::ReportTree()
+    : m_Nodes(1)
+    , m_Strings(1, '\0')
+{
+}
+
+uint32_t ReportTree::Find(std::string_view path) const
+{
+    uint32_t index = 0;
+    for(size_t nameBegin = 0; nameBegin <= path.length();)
+    {
+        const size_t nameEnd = std::min(path.find('/', nameBegin), path.length());
+        const std::string_view name = path.substr(nameBegin, nameEnd - nameBegin);
+        nameBegin = nameEnd + 1;
+
+        const Node& node = m_Nodes[index];
+        uint32_t child = node.m_FirstChild;
+        if(node.m_Type == Type::Object)
+        {
+            while(child != NO_NODE && GetString(m_Nodes[child].m_Name) != name)
+                child = m_Nodes[child].m_NextSibling;
+        }
+        else if(uint32_t itemIndex = 0; node.m_Type == Type::Array && ParseIndex(name, itemIndex))
+        {
+            for(; child != NO_NODE && itemIndex > 0; --itemIndex)
+                child = m_Nodes[child].m_NextSibling;
+        }
+        else
+            child = NO_NODE;
+
+        if(child == NO_NODE)
+            return NO_NODE;
+        index = child;
+    }
+    return index;
+}
+
+std::string ReportTree::WriteJson() const
+{
+    std::string out;
+    out.reserve(m_Strings.size() + m_Nodes.size() * 8);
+    WriteJsonNode(0, false, out);
+    return out;
+}
+
+ReportTreeBuilder::ReportTreeBuilder(ReportTree& tree)
+    : m_Tree(tree)
+{
+    assert(tree.m_Nodes.size() == 1);
+    m_ScopeStack.push_back(0);
+}
+
+void ReportTreeBuilder::PushObject(std::wstring_view name)
+{
+    assert(!name.empty());
+    m_ScopeStack.push_back(m_Tree.AddNode(m_ScopeStack.back(), ReportTree::Type::Object, name));
+}
+
+void ReportTreeBuilder::PushArray(std::wstring_view name, ARRAY_SUFFIX suffix /* = ARRAY_SUFFIX_SQUARE_BRACKETS */)
+{
+    assert(!name.empty());
+    m_ScopeStack.push_back(m_Tree.AddNode(m_ScopeStack.back(), ReportTree::Type::Array, name));
+}
+
+void ReportTreeBuilder::PushArrayItem()
+{
+    assert(m_Tree.m_Nodes[m_ScopeStack.back()].m_Type == ReportTree::Type::Array);
+    m_ScopeStack.push_back(m_Tree.AddNode(m_ScopeStack.back(), ReportTree::Type::Object, {}));
+}
+
+void ReportTreeBuilder::PopScope()
+{
+    assert(m_ScopeStack.size() > 1);
+    m_ScopeStack.pop_back();
+}
+
+void ReportTreeBuilder::PopAllScopes()
+{
+    m_ScopeStack.resize(1);
+}
+
+void ReportTreeBuilder::AddFieldString(std::wstring_view name, std::wstring_view value)
+{
+    const uint32_t valueOffset = m_Tree.AddString(value);
+    AddField(ReportTree::Type::String, name).m_String = valueOffset;
+}
+
+void ReportTreeBuilder::AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value)
+{
+    assert(!name.empty());
+    const uint32_t array = m_Tree.AddNode(m_ScopeStack.back(), ReportTree::Type::Array, name);
+    for(const std::wstring& item : value)
+    {
+        const uint32_t valueOffset = m_Tree.AddString(item);
+        m_Tree.m_Nodes[m_Tree.AddNode(array, ReportTree::Type::String, {})].m_String = valueOffset;
+    }
+}
+
+void ReportTreeBuilder::AddFieldBool(std::wstring_view name, bool value)
+{
+    AddField(ReportTree::Type::Bool, name).m_Uint64 = value ? 1 : 0;
+}
+
+void ReportTreeBuilder::AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit /* = {}*/)
+{
+    AddField(ReportTree::Type::Uint32, name).m_Uint64 = value;
+}
+
+void ReportTreeBuilder::AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit /* = {}*/)
+{
+    AddField(ReportTree::Type::Uint64, name).m_Uint64 = value;
+}
+
+void ReportTreeBuilder::AddFieldSize(std::wstring_view name, uint64_t value)
+{
+    AddFieldUint64(name, value);
+}
+
+void ReportTreeBuilder::AddFieldSizeKilobytes(std::wstring_view name, uint64_t value)
+{
+    AddFieldUint64(name, value);
+}
+
+void ReportTreeBuilder::AddFieldHex32(std::wstring_view name, uint32_t value)
+{
+    AddFieldUint32(name, value);
+}
+
+void ReportTreeBuilder::AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit /* = {}*/)
+{
+    AddField(ReportTree::Type::Int32, name).m_Int32 = value;
+}
+
+void ReportTreeBuilder::AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit /* = {}*/)
+{
+    AddField(ReportTree::Type::Float, name).m_Float = value;
+}
+
+void ReportTreeBuilder::AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    AddFieldUint32(name, value);
+}
+
+void ReportTreeBuilder::AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems)
+{
+    AddFieldInt32(name, value);
+}
+
+void ReportTreeBuilder::AddEnumArray(
+    std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems)
+{
+    assert(!name.empty());
+    const uint32_t array = m_Tree.AddNode(m_ScopeStack.back(), ReportTree::Type::Array, name);
+    for(size_t i = 0; i < count; ++i)
+        m_Tree.m_Nodes[m_Tree.AddNode(array, ReportTree::Type::Uint32, {})].m_Uint64 = values[i];
+}
+
+void ReportTreeBuilder::AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems)
+{
+    AddFieldUint32(name, value);
+}
+
+void ReportTreeBuilder::AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount)
+{
+    std::wstring valStr;
+    for(size_t i = 0; i < byteCount; ++i)
+    {
+        valStr += std::format(L"{:02X}", *((const uint8_t*)data + i));
+    }
+    AddFieldString(name, valStr);
+}
+
+void ReportTreeBuilder::AddFieldVendorId(std::wstring_view name, uint32_t value)
+{
+    AddFieldUint32(name, value);
+}
+
+void ReportTreeBuilder::AddFieldSubsystemId(std::wstring_view name, uint32_t value)
+{
+    AddFieldUint32(name, value);
+}
+
+void ReportTreeBuilder::AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value)
+{
+    AddFieldUint64(name, value);
+}
+
+void ReportTreeBuilder::AddFieldAMDVersion(std::wstring_view name, uint64_t value)
+{
+    AddFieldUint64(name, value);
+}
+
+void ReportTreeBuilder::AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId,
+    uint32_t implementationId, const EnumItem* architecturePlusImplementationIDEnum)
+{
+    AddFieldUint32(name, implementationId);
+}
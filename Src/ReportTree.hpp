@@ -0,0 +1,117 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+#include "ReportSink.hpp"
+
+// Report kept in memory with the types of its fields, as built by ReportTreeBuilder.
+// All nodes are kept in one array and all names and strings in one buffer of UTF-8, so building it allocates
+// only when these grow, and strings returned by GetString stay valid until the tree is destroyed.
+class ReportTree
+{
+public:
+    static const uint32_t NO_NODE = UINT32_MAX;
+
+    enum class Type
+    {
+        Object,
+        Array,
+        Bool,
+        Uint32,
+        Int32,
+        Float,
+        // Written to JSON as a string, like the JSON report does, so no parser loses its precision.
+        Uint64,
+        String,
+    };
+
+    struct Node
+    {
+        Type m_Type = Type::Object;
+        // Offsets in the string buffer. Items of arrays have an empty name.
+        uint32_t m_Name = 0;
+        uint32_t m_String = 0;
+        uint32_t m_FirstChild = NO_NODE;
+        uint32_t m_LastChild = NO_NODE;
+        uint32_t m_NextSibling = NO_NODE;
+        // Value of Bool, Uint32 and Uint64.
+        uint64_t m_Uint64 = 0;
+        int32_t m_Int32 = 0;
+        float m_Float = 0.f;
+    };
+
+    // Creates the tree with only the root object.
+    ReportTree();
+
+    const Node& GetNode(uint32_t index) const { return m_Nodes[index]; }
+    // UTF-8, null-terminated.
+    const char* GetString(uint32_t offset) const { return m_Strings.data() + offset; }
+
+    // path is names of members and indices of array items separated by '/', e.g. "Adapters/0/DXGI_ADAPTER_DESC3".
+    // Returns NO_NODE if not found.
+    uint32_t Find(std::string_view path) const;
+    // Minimized JSON, UTF-8.
+    std::string WriteJson() const;
+
+private:
+    friend class ReportTreeBuilder;
+
+    std::vector<Node> m_Nodes;
+    // Starts with the empty string, so offset 0 is "".
+    std::vector<char> m_Strings;
+
+    uint32_t AddString(std::wstring_view str);
+    uint32_t AddNode(uint32_t parent, Type type, std::wstring_view name);
+    void WriteJsonNode(uint32_t index, bool named, std::string& out) const;
+};
+
+// Builds ReportTree from the report printed to it, with the same names and types of fields as the JSON report.
+class ReportTreeBuilder final : public ReportSink
+{
+public:
+    // The tree must be empty, just created.
+    explicit ReportTreeBuilder(ReportTree& tree);
+
+    void PushObject(std::wstring_view name) override;
+    void PushArray(std::wstring_view name, ARRAY_SUFFIX suffix = ARRAY_SUFFIX_SQUARE_BRACKETS) override;
+    void PushArrayItem() override;
+    void PopScope() override;
+    void PopAllScopes() override;
+
+    void AddFieldString(std::wstring_view name, std::wstring_view value) override;
+    void AddFieldStringArray(std::wstring_view name, const std::vector<std::wstring>& value) override;
+    void AddFieldBool(std::wstring_view name, bool value) override;
+    void AddFieldUint32(std::wstring_view name, uint32_t value, std::wstring_view unit = {}) override;
+    void AddFieldUint64(std::wstring_view name, uint64_t value, std::wstring_view unit = {}) override;
+    void AddFieldSize(std::wstring_view name, uint64_t value) override;
+    void AddFieldSizeKilobytes(std::wstring_view name, uint64_t value) override;
+    void AddFieldHex32(std::wstring_view name, uint32_t value) override;
+    void AddFieldInt32(std::wstring_view name, int32_t value, std::wstring_view unit = {}) override;
+    void AddFieldFloat(std::wstring_view name, float value, std::wstring_view unit = {}) override;
+    void AddFieldEnum(std::wstring_view name, uint32_t value, const EnumItem* enumItems) override;
+    void AddFieldEnumSigned(std::wstring_view name, int32_t value, const EnumItem* enumItems) override;
+    void AddEnumArray(
+        std::wstring_view name, const uint32_t* values, size_t count, const EnumItem* enumItems) override;
+    void AddFieldFlags(std::wstring_view name, uint32_t value, const EnumItem* enumItems) override;
+    void AddFieldHexBytes(std::wstring_view name, const void* data, size_t byteCount) override;
+    void AddFieldVendorId(std::wstring_view name, uint32_t value) override;
+    void AddFieldSubsystemId(std::wstring_view name, uint32_t value) override;
+    void AddFieldMicrosoftVersion(std::wstring_view name, uint64_t value) override;
+    void AddFieldAMDVersion(std::wstring_view name, uint64_t value) override;
+    void AddFieldNvidiaImplementationID(std::wstring_view name, uint32_t architectureId, uint32_t implementationId,
+        const EnumItem* architecturePlusImplementationIDEnum) override;
+
+private:
+    ReportTree& m_Tree;
+    // Open objects and arrays, starting with the root.
+    std::vector<uint32_t> m_ScopeStack;
+
+    ReportTree::Node& AddField(ReportTree::Type type, std::wstring_view name);
+};
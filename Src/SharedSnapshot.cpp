@@ -0,0 +1,84 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "SharedSnapshot.hpp"
+
+#include "Utils.hpp"
+
+#ifndef _WIN32
+    #include <cerrno>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+namespace SharedSnapshot
+{
+
+    std::unique_ptr<Mapping> CreateMapping(const std::wstring& name, uint64_t size)
+    {
+#ifdef _WIN32
+        const HANDLE mapping = CreateFileMappingW(
+            INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, DWORD(size >> 32), DWORD(size), name.c_str());
+        const bool alreadyExists = mapping != NULL && GetLastError() == ERROR_ALREADY_EXISTS;
+        void* const address =
+            mapping != NULL && !alreadyExists ? MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0) : nullptr;
+        if(address != nullptr)
+            return std::make_unique<WindowsMapping>(mapping, address, size);
+        if(mapping != NULL)
+            CloseHandle(mapping);
+#else
+        std::string posixName = GetPosixMappingName(name.c_str());
+        const int file = shm_open(posixName.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+        const bool alreadyExists = file == -1 && errno == EEXIST;
+        if(file != -1)
+        {
+            // Extending the object fills it with zeros.
+            void* const address = ftruncate(file, off_t(size)) == 0
+                ? mmap(nullptr, size_t(size), PROT_READ | PROT_WRITE, MAP_SHARED, file, 0)
+                : MAP_FAILED;
+            if(address != MAP_FAILED)
+                return std::make_unique<PosixMapping>(file, address, size, std::move(posixName), true);
+            close(file);
+            shm_unlink(posixName.c_str());
+        }
+#endif
+        if(alreadyExists)
+        {
+            throw std::runtime_error(
+                std::format("Shared memory {} is already used by another process.", WstrToStr(name.c_str(), CP_ACP)));
+        }
+        throw std::runtime_error("Could not create the shared memory.");
+    }
+
+    Writer::Writer(const std::wstring& name, uint64_t capacity) :
+        m_Mapping(CreateMapping(name, sizeof(Header) + capacity))
+    {
+        m_Header = static_cast<Header*>(m_Mapping->GetAddress());
+        // New section is zeroed, so sequence is 0 and readers see no snapshot until the first Write.
+        memcpy(m_Header->m_Magic, MAGIC, sizeof(MAGIC));
+        m_Header->m_Version = VERSION;
+        m_Header->m_Capacity = capacity;
+    }
+
+    void Writer::Write(std::string_view data)
+    {
+        if(data.size() > m_Header->m_Capacity)
+            throw std::runtime_error("The report doesn't fit in the shared memory.");
+
+        const uint64_t sequence = m_Header->m_Sequence.load(std::memory_order_relaxed);
+        m_Header->m_Sequence.store(sequence + 1, std::memory_order_relaxed);
+        // Readers that see any of the new data also see the odd sequence.
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(reinterpret_cast<char*>(m_Header + 1), data.data(), data.size());
+        m_Header->m_DataSize.store(data.size(), std::memory_order_relaxed);
+        m_Header->m_Sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+} // namespace SharedSnapshot
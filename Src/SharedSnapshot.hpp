@@ -0,0 +1,275 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Self-contained, so other programs can include this file alone to read snapshots published by --Publish.
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// Report published by --Publish in a named shared-memory section, so other processes can read it
+// without launching D3d12info or parsing its output from a pipe.
+//
+// Layout: Header, followed by m_Capacity bytes of space for the data, which is the report in minimized JSON, UTF-8.
+// The writer updates it under a sequence lock: readers retry when the data changed while they were copying it,
+// so they never block the writer and the writer never waits for them.
+namespace SharedSnapshot
+{
+
+    static const char MAGIC[8] = { 'D', '3', 'D', '1', '2', 'S', 'N', 'P' };
+    static const uint32_t VERSION = 1;
+
+    struct Header
+    {
+        char m_Magic[8];
+        uint32_t m_Version;
+        uint32_t m_Reserved;
+        uint64_t m_Capacity;
+        // Odd while the writer changes the data. 0 until the first snapshot is written.
+        std::atomic<uint64_t> m_Sequence;
+        std::atomic<uint64_t> m_DataSize;
+    };
+    static_assert(sizeof(Header) == 40);
+
+    // Named shared memory mapped into this process. Unmapped when destroyed.
+    class Mapping
+    {
+    public:
+        virtual ~Mapping() = default;
+        virtual void* GetAddress() const = 0;
+        // Number of bytes that can be accessed at the address.
+        virtual uint64_t GetSize() const = 0;
+    };
+
+#ifdef _WIN32
+
+    // File mapping object backed by the paging file, named in the session namespace.
+    class WindowsMapping : public Mapping
+    {
+    public:
+        WindowsMapping(HANDLE mapping, void* address, uint64_t size) :
+            m_Mapping(mapping),
+            m_Address(address),
+            m_Size(size)
+        {
+        }
+        ~WindowsMapping()
+        {
+            UnmapViewOfFile(m_Address);
+            CloseHandle(m_Mapping);
+        }
+        WindowsMapping(const WindowsMapping&) = delete;
+        WindowsMapping& operator=(const WindowsMapping&) = delete;
+
+        void* GetAddress() const override
+        {
+            return m_Address;
+        }
+        uint64_t GetSize() const override
+        {
+            return m_Size;
+        }
+
+    private:
+        HANDLE m_Mapping;
+        void* m_Address;
+        uint64_t m_Size;
+    };
+
+#else
+
+    // POSIX shared memory object. The one that created it also removes its name.
+    class PosixMapping : public Mapping
+    {
+    public:
+        // Name is the one given to shm_open. If ownsName, it's passed to shm_unlink when destroyed.
+        PosixMapping(int file, void* address, uint64_t size, std::string name, bool ownsName) :
+            m_File(file),
+            m_Address(address),
+            m_Size(size),
+            m_Name(std::move(name)),
+            m_OwnsName(ownsName)
+        {
+        }
+        ~PosixMapping()
+        {
+            munmap(m_Address, size_t(m_Size));
+            close(m_File);
+            if(m_OwnsName)
+                shm_unlink(m_Name.c_str());
+        }
+        PosixMapping(const PosixMapping&) = delete;
+        PosixMapping& operator=(const PosixMapping&) = delete;
+
+        void* GetAddress() const override
+        {
+            return m_Address;
+        }
+        uint64_t GetSize() const override
+        {
+            return m_Size;
+        }
+
+    private:
+        int m_File;
+        void* m_Address;
+        uint64_t m_Size;
+        std::string m_Name;
+        bool m_OwnsName;
+    };
+
+    // Returns the name for shm_open: "/" followed by the name, which must be ASCII without '/'.
+    inline std::string GetPosixMappingName(const wchar_t* name)
+    {
+        std::string result = "/";
+        for(; *name != L'\0'; ++name)
+        {
+            if(*name <= L' ' || *name > L'~' || *name == L'/')
+                throw std::runtime_error("Invalid shared memory name.");
+            result += char(*name);
+        }
+        return result;
+    }
+
+#endif
+
+    // Maps an existing section for reading. Returns null if there is no such section.
+    inline std::unique_ptr<const Mapping> OpenMapping(const wchar_t* name)
+    {
+#ifdef _WIN32
+        const HANDLE mapping = OpenFileMappingW(FILE_MAP_READ, FALSE, name);
+        if(mapping == NULL)
+            return nullptr;
+        void* const address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        MEMORY_BASIC_INFORMATION memoryInfo = {};
+        if(address == nullptr || VirtualQuery(address, &memoryInfo, sizeof(memoryInfo)) == 0)
+        {
+            if(address != nullptr)
+                UnmapViewOfFile(address);
+            CloseHandle(mapping);
+            return nullptr;
+        }
+        return std::make_unique<WindowsMapping>(mapping, address, memoryInfo.RegionSize);
+#else
+        std::string posixName = GetPosixMappingName(name);
+        const int file = shm_open(posixName.c_str(), O_RDONLY, 0);
+        if(file == -1)
+            return nullptr;
+        struct stat fileStat = {};
+        void* address = MAP_FAILED;
+        if(fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+            address = mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_SHARED, file, 0);
+        if(address == MAP_FAILED)
+        {
+            close(file);
+            return nullptr;
+        }
+        return std::make_unique<PosixMapping>(file, address, uint64_t(fileStat.st_size), std::move(posixName), false);
+#endif
+    }
+
+    // Creates a new, zeroed section of the given size and maps it for writing.
+    // Throws on failure, also if the name is already used.
+    std::unique_ptr<Mapping> CreateMapping(const std::wstring& name, uint64_t size);
+
+    // Creates the section and writes snapshots into it. The section exists as long as this object does.
+    class Writer
+    {
+    public:
+        // Leaves space for data of up to capacity bytes. Throws on failure, also if the name is already used.
+        Writer(const std::wstring& name, uint64_t capacity);
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        uint64_t GetCapacity() const
+        {
+            return m_Header->m_Capacity;
+        }
+        // Throws if the data is larger than the capacity.
+        void Write(std::string_view data);
+
+    private:
+        std::unique_ptr<Mapping> m_Mapping;
+        Header* m_Header = nullptr;
+    };
+
+    // Maps a section created by Writer, possibly in another process.
+    class Reader
+    {
+    public:
+        // Throws std::runtime_error if there is no such section or it holds no snapshot of this version.
+        explicit Reader(const wchar_t* name) :
+            m_Mapping(OpenMapping(name))
+        {
+            if(m_Mapping != nullptr)
+                m_Header = static_cast<const Header*>(m_Mapping->GetAddress());
+            if(m_Header == nullptr || m_Mapping->GetSize() < sizeof(Header) ||
+                memcmp(m_Header->m_Magic, MAGIC, sizeof(MAGIC)) != 0 || m_Header->m_Version != VERSION ||
+                m_Header->m_Capacity > m_Mapping->GetSize() - sizeof(Header))
+            {
+                throw std::runtime_error("Could not open the shared snapshot.");
+            }
+        }
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        // Copies the newest snapshot to outData. Returns false if none was written yet.
+        // outSequence, if not null, receives a number that increases with each snapshot.
+        bool Read(std::string& outData, uint64_t* outSequence = nullptr) const
+        {
+            const char* const data = reinterpret_cast<const char*>(m_Header + 1);
+            while(true)
+            {
+                const uint64_t sequence = m_Header->m_Sequence.load(std::memory_order_acquire);
+                if(sequence == 0)
+                    return false;
+                if((sequence & 1) != 0)
+                {
+#ifdef _WIN32
+                    YieldProcessor();
+#else
+                    std::this_thread::yield();
+#endif
+                    continue;
+                }
+                // Size is checked, as it may be torn by the writer, which is detected only after copying.
+                const uint64_t dataSize = m_Header->m_DataSize.load(std::memory_order_relaxed);
+                if(dataSize <= m_Header->m_Capacity)
+                    outData.assign(data, size_t(dataSize));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if(dataSize <= m_Header->m_Capacity &&
+                    m_Header->m_Sequence.load(std::memory_order_relaxed) == sequence)
+                {
+                    if(outSequence)
+                        *outSequence = sequence / 2;
+                    return true;
+                }
+            }
+        }
+
+    private:
+        std::unique_ptr<const Mapping> m_Mapping;
+        const Header* m_Header = nullptr;
+    };
+
+} // namespace SharedSnapshot
@@ -19,31 +19,29 @@ For more information, see files README.md, LICENSE.txt.
 ////////////////////////////////////////////////////////////////////////////////
 // PUBLIC
 
-void PrintOsVersionInfo()
+std::wstring GetOsVersionString()
 {
-    ReportScopeObject scope(L"OS Info");
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
     HMODULE m = GetModuleHandle(L"ntdll.dll");
     if(!m)
-    {
-        formatter.AddFieldString(L"Windows version", L"Unknown");
-        return;
-    }
+        return L"Unknown";
 
     typedef int32_t(WINAPI * RtlGetVersionFunc)(OSVERSIONINFOEX*);
     RtlGetVersionFunc RtlGetVersion = (RtlGetVersionFunc)GetProcAddress(m, "RtlGetVersion");
     if(!RtlGetVersion)
-    {
-        formatter.AddFieldString(L"Windows version", L"Unknown");
-        return;
-    }
+        return L"Unknown";
 
     OSVERSIONINFOEX osVersionInfo = { sizeof(osVersionInfo) };
     // Documentation says it always returns success.
     RtlGetVersion(&osVersionInfo);
 
-    formatter.AddFieldString(L"Windows version", std::format(L"{}.{}.{}", osVersionInfo.dwMajorVersion,
-                                                     osVersionInfo.dwMinorVersion, osVersionInfo.dwBuildNumber));
+    return std::format(
+        L"{}.{}.{}", osVersionInfo.dwMajorVersion, osVersionInfo.dwMinorVersion, osVersionInfo.dwBuildNumber);
+}
+
+void PrintOsVersionInfo()
+{
+    ReportScopeObject scope(L"OS Info");
+    ReportFormatter::GetInstance().AddFieldString(L"Windows version", GetOsVersionString());
 }
 
 void PrintSystemMemoryInfo()
@@ -57,7 +55,7 @@ void PrintSystemMemoryInfo()
 
     if(MEMORYSTATUSEX memStatEx = { sizeof(MEMORYSTATUSEX) }; GlobalMemoryStatusEx(&memStatEx))
     {
-        ReportFormatter& formatter = ReportFormatter::GetInstance();
+        ReportSink& formatter = ReportFormatter::GetInstance();
         formatter.AddFieldSize(L"MEMORYSTATUSEX::ullTotalPhys", memStatEx.ullTotalPhys);
         formatter.AddFieldSize(L"MEMORYSTATUSEX::ullTotalPageFile", memStatEx.ullTotalPageFile);
         formatter.AddFieldSize(L"MEMORYSTATUSEX::ullTotalVirtual", memStatEx.ullTotalVirtual);
@@ -9,5 +9,6 @@ For more information, see files README.md, LICENSE.txt.
 */
 #pragma once
 
+std::wstring GetOsVersionString();
 void PrintOsVersionInfo();
 void PrintSystemMemoryInfo();
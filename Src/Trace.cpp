@@ -0,0 +1,119 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Trace.hpp"
+
+#include "Json.hpp"
+#include "Printer.hpp"
+#include "Utils.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// Spans are recorded only for coarse phases of the program, so this is plenty.
+static const uint32_t MAX_EVENT_COUNT = 4096;
+
+static std::unique_ptr<Trace::Event[]> g_Events;
+static std::atomic<uint32_t> g_EventCount;
+static std::chrono::steady_clock::time_point g_StartTime;
+
+static double ToMicroseconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+bool Trace::s_Enabled = false;
+
+void Trace::Enable()
+{
+    assert(!s_Enabled);
+    g_Events = std::make_unique<Event[]>(MAX_EVENT_COUNT);
+    g_StartTime = std::chrono::steady_clock::now();
+    s_Enabled = true;
+}
+
+Trace::Event* Trace::BeginEvent(std::wstring_view name)
+{
+    const uint32_t index = g_EventCount.fetch_add(1, std::memory_order_relaxed);
+    if(index >= MAX_EVENT_COUNT)
+        return nullptr;
+
+    Event& event = g_Events[index];
+    const size_t nameLength = std::min(name.length(), Event::MAX_NAME_LENGTH);
+    name.copy(event.m_Name, nameLength);
+    event.m_Name[nameLength] = L'\0';
+    event.m_ThreadId = GetCurrentThreadId();
+    event.m_BeginTime = std::chrono::steady_clock::now();
+    return &event;
+}
+
+void Trace::EndEvent(Event* event)
+{
+    event->m_EndTime = std::chrono::steady_clock::now();
+    event->m_Finished.store(true, std::memory_order_release);
+}
+
+void Trace::WriteFile(const std::wstring& filePath)
+{
+    assert(s_Enabled);
+
+    const uint32_t eventCount = std::min(g_EventCount.load(std::memory_order_relaxed), MAX_EVENT_COUNT);
+    const DWORD processId = GetCurrentProcessId();
+
+    std::wstring json = L"{\"traceEvents\":[";
+    bool first = true;
+    for(uint32_t i = 0; i < eventCount; ++i)
+    {
+        const Event& event = g_Events[i];
+        // Spans still open, e.g. after an error, have no duration to show.
+        if(!event.m_Finished.load(std::memory_order_acquire))
+            continue;
+        if(!first)
+            json += L',';
+        first = false;
+        json += std::format(L"\n{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":{},\"tid\":{}}}",
+            EscapeJsonString(event.m_Name), ToMicroseconds(event.m_BeginTime - g_StartTime),
+            ToMicroseconds(event.m_EndTime - event.m_BeginTime), processId, event.m_ThreadId);
+    }
+    json += L"\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    const std::string utf8 = WstrToStr(json.c_str(), CP_UTF8);
+    std::ofstream file(std::filesystem::path(filePath), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!file.write(utf8.data(), std::streamsize(utf8.size())))
+        throw std::runtime_error("Could not write the trace file.");
+
+    if(const uint32_t droppedCount = g_EventCount.load(std::memory_order_relaxed) - eventCount; droppedCount > 0)
+        ErrorPrinter::PrintFormat("WARNING: Trace is full, {} spans were not recorded.\n",
+            std::make_format_args(droppedCount));
+}
+
+TraceScope::TraceScope(const std::wstring& filePath)
+    : m_FilePath(filePath)
+{
+    if(!m_FilePath.empty())
+        Trace::Enable();
+}
+
+TraceScope::~TraceScope()
+{
+    if(m_FilePath.empty())
+        return;
+    try
+    {
+        Trace::WriteFile(m_FilePath);
+    }
+    catch(const std::exception& ex)
+    {
+        const char* errorMessage = ex.what();
+        ErrorPrinter::PrintFormat("ERROR: {}\n", std::make_format_args(errorMessage));
+    }
+}
@@ -0,0 +1,74 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Records spans of the program's execution phases and writes them as trace events in JSON format,
+// to be opened in chrome://tracing or Perfetto.
+// All events are preallocated when enabled and a span only reserves its slot with one atomic increment,
+// so recording doesn't take locks or allocate memory.
+class Trace
+{
+public:
+    struct Event
+    {
+        static constexpr size_t MAX_NAME_LENGTH = 63;
+
+        wchar_t m_Name[MAX_NAME_LENGTH + 1];
+        uint32_t m_ThreadId;
+        std::chrono::steady_clock::time_point m_BeginTime;
+        std::chrono::steady_clock::time_point m_EndTime;
+        std::atomic<bool> m_Finished;
+    };
+
+    static bool IsEnabled()
+    {
+        return s_Enabled;
+    }
+    static void Enable();
+
+    // Returns null if the trace is not enabled or there is no more space for events.
+    static Event* BeginEvent(std::wstring_view name);
+    static void EndEvent(Event* event);
+
+    // Writes all finished events to the file. Throws on failure.
+    static void WriteFile(const std::wstring& filePath);
+
+private:
+    static bool s_Enabled;
+};
+
+// Measures the time from construction to destruction as one span of the trace.
+class TraceSpan
+{
+public:
+    TraceSpan(std::wstring_view name)
+        : m_Event(Trace::IsEnabled() ? Trace::BeginEvent(name) : nullptr)
+    {
+    }
+    ~TraceSpan()
+    {
+        if(m_Event)
+            Trace::EndEvent(m_Event);
+    }
+
+private:
+    Trace::Event* const m_Event;
+};
+
+// Enables the trace if filePath is not empty and writes it to that file when destroyed.
+class TraceScope
+{
+public:
+    TraceScope(const std::wstring& filePath);
+    ~TraceScope();
+
+private:
+    const std::wstring m_FilePath;
+};
@@ -71,6 +71,74 @@ wstring GuidToStr(const GUID& guid)
     return { str };
 }
 
+wstring LuidToStr(LUID value)
+{
+    wchar_t s[64];
+    swprintf_s(s, L"%08X-%08X", (uint32_t)value.HighPart, (uint32_t)value.LowPart);
+    return wstring{ s };
+}
+
+wstring LoadTextFile(const std::wstring& filePath)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if(!file)
+    {
+        std::string narrowPath = WstrToStr(filePath.c_str(), CP_ACP);
+        throw std::runtime_error(std::format("Could not open {} for reading.", narrowPath));
+    }
+    file.seekg(0, std::ios::end);
+    std::string bytes(size_t(file.tellg()), '\0');
+    file.seekg(0, std::ios::beg);
+    file.read(bytes.data(), bytes.size());
+
+    // Output redirected to a file by PowerShell is UTF-16 LE, other files are expected to be UTF-8.
+    if(bytes.size() >= 2 && uint8_t(bytes[0]) == 0xFF && uint8_t(bytes[1]) == 0xFE)
+        return std::wstring((const wchar_t*)(bytes.data() + 2), (bytes.size() - 2) / sizeof(wchar_t));
+    if(bytes.starts_with("\xEF\xBB\xBF"))
+        return StrToWstr(bytes.c_str() + 3, CP_UTF8);
+    return StrToWstr(bytes.c_str(), CP_UTF8);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// class CtrlCScope
+
+// Signaled by Ctrl+C or Ctrl+Break.
+static HANDLE g_CtrlCEvent = NULL;
+
+static BOOL WINAPI CtrlCHandler(DWORD ctrlType)
+{
+    if(ctrlType != CTRL_C_EVENT && ctrlType != CTRL_BREAK_EVENT)
+        return FALSE;
+    SetEvent(g_CtrlCEvent);
+    return TRUE;
+}
+
+CtrlCScope::CtrlCScope()
+{
+    assert(g_CtrlCEvent == NULL);
+    g_CtrlCEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    SetConsoleCtrlHandler(CtrlCHandler, TRUE);
+}
+
+CtrlCScope::~CtrlCScope()
+{
+    SetConsoleCtrlHandler(CtrlCHandler, FALSE);
+    CloseHandle(g_CtrlCEvent);
+    g_CtrlCEvent = NULL;
+}
+
+bool CtrlCScope::Wait(std::chrono::milliseconds time)
+{
+    return WaitForSingleObject(g_CtrlCEvent, DWORD(time.count())) == WAIT_OBJECT_0;
+}
+
+bool CtrlCScope::Wait(HANDLE event, std::chrono::milliseconds time)
+{
+    // When both are signaled, the first one is returned, so Ctrl+C wins.
+    const HANDLE events[] = { g_CtrlCEvent, event };
+    return WaitForMultipleObjects(2, events, FALSE, DWORD(time.count())) == WAIT_OBJECT_0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // class CmdLineParser
 
@@ -27,6 +27,24 @@ wstring StrToWstr(const char* str, uint32_t codePage);
 string WstrToStr(const wchar_t* str, uint32_t codePage);
 
 wstring GuidToStr(const GUID& guid);
+// Like "00000000-0000A1B2", used as a key of the adapter.
+wstring LuidToStr(LUID value);
+
+// Throws on failure.
+wstring LoadTextFile(const std::wstring& filePath);
+
+// While it exists, Ctrl+C and Ctrl+Break don't terminate the program, but stop it waiting in Wait, so modes running
+// until stopped, like --Monitor, can finish their output. Only one can exist at a time.
+class CtrlCScope
+{
+public:
+    CtrlCScope();
+    ~CtrlCScope();
+    // Returns true if Ctrl+C or Ctrl+Break was pressed, before or during the wait.
+    bool Wait(std::chrono::milliseconds time);
+    // Like Wait, but also returns false early when the event is signaled.
+    bool Wait(HANDLE event, std::chrono::milliseconds time);
+};
 
 class CmdLineParser
 {
@@ -0,0 +1,175 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "VendorApis.hpp"
+
+#include "AgsData.hpp"
+#include "AmdDeviceInfoData.hpp"
+#include "NvApiData.hpp"
+#include "ProbeTimings.hpp"
+#include "VulkanData.hpp"
+#include "Watchdog.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+template<typename T>
+static std::future<void> StartInitializing(std::unique_ptr<T>& outObject)
+{
+    return std::async(std::launch::async, [&outObject]() {
+        ProbeScope probeScope(L"Initialization");
+        outObject = std::make_unique<T>();
+    });
+}
+
+// Waits for initialization started by StartInitializing, if any, or initializes the object now.
+template<typename T>
+static T* WaitForObject(std::unique_ptr<T>& object, std::future<void>& ready)
+{
+    if(ready.valid())
+    {
+        WatchdogWait watchdogWait;
+        ready.get(); // Rethrows exception from the background thread.
+    }
+    if(!object)
+        object = std::make_unique<T>();
+    return object.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+bool IsVendorApiApplicable(VendorApi api, uint32_t vendorId, bool softwareAdapter, bool forceVendorApi)
+{
+    if(forceVendorApi)
+        return true;
+    switch(api)
+    {
+    case VendorApi::NvApi:
+        return vendorId == VENDOR_ID_NVIDIA;
+    case VendorApi::Ags:
+    case VendorApi::AmdDeviceInfo:
+        return vendorId == VENDOR_ID_AMD;
+    case VendorApi::IntelGpuDetect:
+        return vendorId == VENDOR_ID_INTEL;
+    case VendorApi::Vulkan:
+        // Software adapters like WARP have no Vulkan driver.
+        return !softwareAdapter;
+    default:
+        assert(0);
+        return false;
+    }
+}
+
+bool IsVendorApiRequired(VendorApi api, uint32_t vendorId, bool softwareAdapter, bool forceVendorApi)
+{
+    // Creating a Vulkan instance loads the drivers of all vendors, so it's not done only for Intel, whose driver is
+    // described by Intel GPU Detect. Once it's created for another adapter, Intel adapters are described too.
+    if(api == VendorApi::Vulkan && vendorId == VENDOR_ID_INTEL && !forceVendorApi)
+        return false;
+    return IsVendorApiApplicable(api, vendorId, softwareAdapter, forceVendorApi);
+}
+
+// Defined here, where the classes of the APIs are complete.
+VendorApis::VendorApis() = default;
+VendorApis::~VendorApis() = default;
+
+void VendorApis::SetOptions(bool enabled, bool forceVendorApi)
+{
+    m_Enabled = enabled;
+    m_ForceVendorApi = forceVendorApi;
+    m_ApplicableToAnyAdapter = {};
+}
+
+void VendorApis::AddPresentAdapter(uint32_t vendorId, bool softwareAdapter)
+{
+    for(size_t i = 0; i < m_ApplicableToAnyAdapter.size(); ++i)
+    {
+        if(m_Enabled && IsVendorApiRequired(VendorApi(i), vendorId, softwareAdapter, m_ForceVendorApi))
+            m_ApplicableToAnyAdapter[i] = true;
+    }
+}
+
+bool VendorApis::IsApplicableToAnyAdapter(VendorApi api) const
+{
+    return m_ApplicableToAnyAdapter[size_t(api)];
+}
+
+bool VendorApis::IsApplicable(VendorApi api, uint32_t vendorId, bool softwareAdapter) const
+{
+    if(api == VendorApi::Vulkan && !IsApplicableToAnyAdapter(VendorApi::Vulkan))
+        return false;
+    return m_Enabled && IsVendorApiApplicable(api, vendorId, softwareAdapter, m_ForceVendorApi);
+}
+
+void VendorApis::StartInitialization()
+{
+#if USE_NVAPI
+    if(IsApplicableToAnyAdapter(VendorApi::NvApi) && !m_NvApi)
+        m_NvApiReady = StartInitializing(m_NvApi);
+#endif
+#if USE_AGS
+    if(IsApplicableToAnyAdapter(VendorApi::Ags) && !m_Ags)
+        m_AgsReady = StartInitializing(m_Ags);
+#endif
+    // AMD device_info is only a static table, there is nothing to initialize in advance.
+#if USE_VULKAN
+    if(IsApplicableToAnyAdapter(VendorApi::Vulkan) && !m_Vulkan)
+        m_VulkanReady = StartInitializing(m_Vulkan);
+#endif
+}
+
+NvAPI_Inititalize_RAII* VendorApis::GetNvApi()
+{
+#if USE_NVAPI
+    if(!m_Enabled)
+        return nullptr;
+    NvAPI_Inititalize_RAII* const nvApi = WaitForObject(m_NvApi, m_NvApiReady);
+    return nvApi->IsInitialized() ? nvApi : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+AGS_Initialize_RAII* VendorApis::GetAgs()
+{
+#if USE_AGS
+    if(!m_Enabled)
+        return nullptr;
+    AGS_Initialize_RAII* const ags = WaitForObject(m_Ags, m_AgsReady);
+    return ags->IsInitialized() ? ags : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+AmdDeviceInfo_Initialize_RAII* VendorApis::GetAmdDeviceInfo()
+{
+#if USE_AMD_DEVICE_INFO
+    if(!m_Enabled)
+        return nullptr;
+    if(!m_AmdDeviceInfo)
+        m_AmdDeviceInfo = std::make_unique<AmdDeviceInfo_Initialize_RAII>();
+    return m_AmdDeviceInfo.get();
+#else
+    return nullptr;
+#endif
+}
+
+Vulkan_Initialize_RAII* VendorApis::GetVulkan()
+{
+#if USE_VULKAN
+    if(!m_Enabled)
+        return nullptr;
+    Vulkan_Initialize_RAII* const vk = WaitForObject(m_Vulkan, m_VulkanReady);
+    return vk->IsInitialized() ? vk : nullptr;
+#else
+    return nullptr;
+#endif
+}
@@ -0,0 +1,90 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+class NvAPI_Inititalize_RAII;
+class AGS_Initialize_RAII;
+class AmdDeviceInfo_Initialize_RAII;
+class Vulkan_Initialize_RAII;
+
+// VendorIDs used for deciding whether to use Vendor specific APIs with each device
+enum VENDOR_ID
+{
+    VENDOR_ID_AMD = 0x1002,
+    VENDOR_ID_NVIDIA = 0x10de,
+    VENDOR_ID_INTEL = 0x8086
+};
+
+enum class VendorApi
+{
+    NvApi,
+    Ags,
+    AmdDeviceInfo,
+    Vulkan,
+    IntelGpuDetect,
+    Count
+};
+
+// Decides whether a vendor-specific API should be queried about an adapter.
+// It depends only on its parameters, so it can be checked with made-up adapters.
+bool IsVendorApiApplicable(VendorApi api, uint32_t vendorId, bool softwareAdapter, bool forceVendorApi);
+// Decides whether an adapter present in the system is a reason to initialize a vendor-specific API.
+// Same as IsVendorApiApplicable, except Intel adapters alone don't initialize Vulkan.
+bool IsVendorApiRequired(VendorApi api, uint32_t vendorId, bool softwareAdapter, bool forceVendorApi);
+
+// Initializes each vendor-specific API on its first use,
+// so libraries of vendors that have no adapter in the system are never loaded.
+// APIs applicable to adapters present can be initialized in advance on background threads.
+// Initialized APIs are kept until it's destroyed, so reports printed one after another, e.g. by --Batch, share them.
+class VendorApis
+{
+public:
+    // Disabled until SetOptions is called.
+    VendorApis();
+    ~VendorApis();
+
+    // If enabled is false, getters return null and no API is initialized.
+    // Forgets the adapters added so far, so call it before AddPresentAdapter.
+    void SetOptions(bool enabled, bool forceVendorApi);
+
+    // Call for each adapter present in the system before IsApplicableToAnyAdapter.
+    void AddPresentAdapter(uint32_t vendorId, bool softwareAdapter);
+    // True if the API is initialized for the system, because an adapter present requires it.
+    bool IsApplicableToAnyAdapter(VendorApi api) const;
+    // Vulkan is applicable to an adapter only if it is initialized for the system.
+    bool IsApplicable(VendorApi api, uint32_t vendorId, bool softwareAdapter) const;
+
+    // Starts initializing every API applicable to any adapter present, each on its own thread.
+    // Call after AddPresentAdapter. Getters below then wait only for the API they return.
+    void StartInitialization();
+
+    // These initialize the API on the first call, unless it was started by StartInitialization.
+    // They return null if vendor APIs are disabled or the API failed to initialize.
+    NvAPI_Inititalize_RAII* GetNvApi();
+    AGS_Initialize_RAII* GetAgs();
+    AmdDeviceInfo_Initialize_RAII* GetAmdDeviceInfo();
+    Vulkan_Initialize_RAII* GetVulkan();
+
+private:
+    bool m_Enabled = false;
+    bool m_ForceVendorApi = false;
+    std::array<bool, size_t(VendorApi::Count)> m_ApplicableToAnyAdapter = {};
+
+    // Destroyed in the opposite order.
+    std::unique_ptr<NvAPI_Inititalize_RAII> m_NvApi;
+    std::unique_ptr<AGS_Initialize_RAII> m_Ags;
+    std::unique_ptr<AmdDeviceInfo_Initialize_RAII> m_AmdDeviceInfo;
+    std::unique_ptr<Vulkan_Initialize_RAII> m_Vulkan;
+
+    // Declared after the objects, so destroying them waits for background initialization to finish first.
+    std::future<void> m_NvApiReady;
+    std::future<void> m_AgsReady;
+    std::future<void> m_VulkanReady;
+};
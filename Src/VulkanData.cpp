@@ -10,7 +10,9 @@ For more information, see files README.md, LICENSE.txt.
 #include "VulkanData.hpp"
 
 #include "Enums.hpp"
+#include "ProbeTimings.hpp"
 #include "ReportFormatter/ReportFormatter.hpp"
+#include "Trace.hpp"
 #include "Utils.hpp"
 
 // Macro set by Cmake.
@@ -122,6 +124,7 @@ void Vulkan_Initialize_RAII::PrintStaticParams()
 
 Vulkan_Initialize_RAII::Vulkan_Initialize_RAII()
 {
+    TraceSpan traceSpan(L"Vulkan_Initialize_RAII");
     g_VulkanModule = LoadLibrary(L"vulkan-1.dll");
     if(!g_VulkanModule)
         return;
@@ -146,21 +149,29 @@ Vulkan_Initialize_RAII::Vulkan_Initialize_RAII()
         .apiVersion = VK_API_VERSION_1_2 };
     const VkInstanceCreateInfo instanceCreateInfo = { .sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
         .pApplicationInfo = &appInfo };
-    if(g_vkCreateInstance(&instanceCreateInfo, nullptr, &g_vkInstance) != VK_SUCCESS)
+    auto createInstance = [&]() {
+        return ProbeCall(
+            L"vkCreateInstance", [&]() { return g_vkCreateInstance(&instanceCreateInfo, nullptr, &g_vkInstance); });
+    };
+    if(createInstance() != VK_SUCCESS)
     {
         appInfo.apiVersion = VK_API_VERSION_1_1;
-        if(g_vkCreateInstance(&instanceCreateInfo, nullptr, &g_vkInstance) != VK_SUCCESS)
+        if(createInstance() != VK_SUCCESS)
             return;
     }
     g_ApiVersion = appInfo.apiVersion;
 
     uint32_t physDeviceCount = 0;
-    if(g_vkEnumeratePhysicalDevices(g_vkInstance, &physDeviceCount, nullptr) != VK_SUCCESS)
+    auto enumeratePhysicalDevices = [&](VkPhysicalDevice* physDevices) {
+        return ProbeCall(L"vkEnumeratePhysicalDevices",
+            [&]() { return g_vkEnumeratePhysicalDevices(g_vkInstance, &physDeviceCount, physDevices); });
+    };
+    if(enumeratePhysicalDevices(nullptr) != VK_SUCCESS)
         return;
     if(physDeviceCount)
     {
         g_PhysicalDevices.resize(physDeviceCount);
-        if(g_vkEnumeratePhysicalDevices(g_vkInstance, &physDeviceCount, g_PhysicalDevices.data()) != VK_SUCCESS)
+        if(enumeratePhysicalDevices(g_PhysicalDevices.data()) != VK_SUCCESS)
             return;
     }
 
@@ -174,6 +185,7 @@ Vulkan_Initialize_RAII::Vulkan_Initialize_RAII()
         if(g_ApiVersion >= VK_API_VERSION_1_2)
             AddToPnextChain(
                 &g_PhysicalDeviceProperties[i].properties2, &g_PhysicalDeviceProperties[i].vulkan12Properties);
+        ProbeTimer timer(L"vkGetPhysicalDeviceProperties2");
         g_vkGetPhysicalDeviceProperties2(g_PhysicalDevices[i], &g_PhysicalDeviceProperties[i].properties2);
     }
 
@@ -183,13 +195,16 @@ Vulkan_Initialize_RAII::Vulkan_Initialize_RAII()
 Vulkan_Initialize_RAII::~Vulkan_Initialize_RAII()
 {
     if(g_vkInstance)
+    {
+        ProbeTimer timer(L"vkDestroyInstance");
         g_vkDestroyInstance(g_vkInstance, nullptr);
+    }
 }
 
 void Vulkan_Initialize_RAII::PrintData(const DXGI_ADAPTER_DESC& adapterDesc)
 {
     assert(IsInitialized());
-    ReportFormatter& formatter = ReportFormatter::GetInstance();
+    ReportSink& formatter = ReportFormatter::GetInstance();
 
     size_t physDevIndex = SIZE_MAX;
     if(!FindPhysicalDevice(adapterDesc, physDevIndex))
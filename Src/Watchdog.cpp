@@ -0,0 +1,235 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Watchdog.hpp"
+
+#include "Printer.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+struct ActiveProbe
+{
+    const wchar_t* m_Name = nullptr;
+    Watchdog::Clock::time_point m_Deadline;
+};
+
+static const std::chrono::milliseconds POLL_INTERVAL = std::chrono::milliseconds(10);
+// How long the watchdog waits for the main thread to give up the report after a deadline expired.
+static const std::chrono::seconds REPORT_TAKE_OVER_TIMEOUT = std::chrono::seconds(1);
+
+static void TerminateCurrentProcess(int exitCode)
+{
+    // Threads stuck in a driver can't be joined, so the process is terminated without unwinding.
+    TerminateProcess(GetCurrentProcess(), UINT(exitCode));
+}
+
+static Watchdog::TerminateFunc g_TerminateFunc = TerminateCurrentProcess;
+
+// Held by the main thread whenever it may use the report formatter.
+static std::timed_mutex g_ReportMutex;
+static std::thread::id g_MainThreadId;
+// How many times the main thread gave up the report without taking it back. Used only by the main thread.
+static uint32_t g_ReportYieldDepth = 0;
+
+// Guards the variables below.
+static std::mutex g_StateMutex;
+static std::condition_variable g_StopCondition;
+static bool g_StopRequested = false;
+static Watchdog::Clock::time_point g_RunDeadline;
+static Watchdog::Clock::duration g_RunTimeout;
+static Watchdog::Clock::duration g_ProbeTimeout;
+// Points to g_ThreadProbe of every thread that is inside a probe, in the order they entered.
+static std::vector<const ActiveProbe*> g_ActiveProbes;
+
+static thread_local ActiveProbe g_ThreadProbe;
+// Probes can be nested, e.g. a vendor function called while a group of probes is measured.
+static thread_local uint32_t g_ThreadProbeDepth = 0;
+
+static std::thread g_Thread;
+
+static void YieldReport()
+{
+    if(std::this_thread::get_id() == g_MainThreadId && g_ReportYieldDepth++ == 0)
+        g_ReportMutex.unlock();
+}
+
+static void ReclaimReport()
+{
+    // If the watchdog took the report over, this blocks until the process is terminated.
+    if(std::this_thread::get_id() == g_MainThreadId && --g_ReportYieldDepth == 0)
+        g_ReportMutex.lock();
+}
+
+static uint32_t ToMilliseconds(Watchdog::Clock::duration duration)
+{
+    return uint32_t(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+}
+
+// Called with g_StateMutex locked. Returns only if the program finished in the meantime or g_TerminateFunc returned.
+static void TakeOverReport(std::unique_lock<std::mutex>& stateLock, const wchar_t* probeName, bool runDeadline)
+{
+    // The main thread gives up the report only between its fields, so it is left in a consistent state.
+    stateLock.unlock();
+    const bool reportTaken = g_ReportMutex.try_lock_for(REPORT_TAKE_OVER_TIMEOUT);
+    stateLock.lock();
+    if(g_StopRequested)
+    {
+        if(reportTaken)
+            g_ReportMutex.unlock();
+        return;
+    }
+
+    const std::wstring_view deadlineName = runDeadline ? L"Run" : L"Probe";
+    const uint32_t timeout = ToMilliseconds(runDeadline ? g_RunTimeout : g_ProbeTimeout);
+
+    // The main thread hangs outside of any probe, holding the report, so it is left unfinished.
+    if(!reportTaken)
+    {
+        ErrorPrinter::PrintFormat(L"ERROR: {} deadline of {} ms expired. The report could not be completed.\n",
+            std::make_wformat_args(deadlineName, timeout));
+        g_TerminateFunc(PROGRAM_EXIT_ERROR_TIMEOUT);
+        return;
+    }
+
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    formatter.PopAllScopes();
+    {
+        ReportScopeObject scope(L"Watchdog");
+        formatter.AddFieldString(L"Deadline", deadlineName);
+        formatter.AddFieldUint32(L"Timeout", timeout, L"ms");
+        if(probeName)
+            formatter.AddFieldString(L"TimedOutProbe", probeName);
+    }
+    ReportFormatter::DestroyInstance();
+    Printer::Release();
+
+    if(probeName)
+        ErrorPrinter::PrintFormat(L"ERROR: {} deadline of {} ms expired in {}.\n",
+            std::make_wformat_args(deadlineName, timeout, probeName));
+    else
+        ErrorPrinter::PrintFormat(L"ERROR: {} deadline of {} ms expired.\n",
+            std::make_wformat_args(deadlineName, timeout));
+
+    g_TerminateFunc(PROGRAM_EXIT_ERROR_TIMEOUT);
+    g_ReportMutex.unlock();
+}
+
+static void WatchdogThreadMain()
+{
+    std::unique_lock<std::mutex> stateLock(g_StateMutex);
+    while(!g_StopRequested)
+    {
+        const Watchdog::Clock::time_point now = Watchdog::Clock::now();
+        for(const ActiveProbe* probe : g_ActiveProbes)
+        {
+            if(now >= probe->m_Deadline)
+            {
+                TakeOverReport(stateLock, probe->m_Name, false);
+                return;
+            }
+        }
+        if(now >= g_RunDeadline)
+        {
+            TakeOverReport(stateLock, g_ActiveProbes.empty() ? nullptr : g_ActiveProbes.front()->m_Name, true);
+            return;
+        }
+        g_StopCondition.wait_for(stateLock, POLL_INTERVAL);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+bool Watchdog::s_Enabled = false;
+
+void Watchdog::Start(Clock::duration runTimeout, Clock::duration probeTimeout)
+{
+    assert(!s_Enabled);
+    const Clock::time_point now = Clock::now();
+    g_MainThreadId = std::this_thread::get_id();
+    g_RunTimeout = runTimeout;
+    g_ProbeTimeout = probeTimeout;
+    g_RunDeadline = runTimeout > Clock::duration::zero() ? now + runTimeout : Clock::time_point::max();
+    g_StopRequested = false;
+    g_ReportMutex.lock();
+    s_Enabled = true;
+    g_Thread = std::thread(WatchdogThreadMain);
+}
+
+void Watchdog::Stop()
+{
+    assert(s_Enabled);
+    assert(g_ReportYieldDepth == 0);
+    {
+        std::lock_guard<std::mutex> stateLock(g_StateMutex);
+        g_StopRequested = true;
+    }
+    g_StopCondition.notify_one();
+    // The watchdog may be just waiting for the report.
+    g_ReportMutex.unlock();
+    g_Thread.join();
+    s_Enabled = false;
+}
+
+void Watchdog::SetTerminateFunc(TerminateFunc func)
+{
+    assert(!s_Enabled);
+    g_TerminateFunc = func ? func : TerminateCurrentProcess;
+}
+
+void Watchdog::BeginProbe(const wchar_t* probeName)
+{
+    if(g_ThreadProbeDepth++ == 0)
+    {
+        g_ThreadProbe.m_Name = probeName;
+        g_ThreadProbe.m_Deadline =
+            g_ProbeTimeout > Clock::duration::zero() ? Clock::now() + g_ProbeTimeout : Clock::time_point::max();
+        std::lock_guard<std::mutex> stateLock(g_StateMutex);
+        g_ActiveProbes.push_back(&g_ThreadProbe);
+    }
+    YieldReport();
+}
+
+void Watchdog::EndProbe()
+{
+    assert(g_ThreadProbeDepth > 0);
+    if(--g_ThreadProbeDepth == 0)
+    {
+        std::lock_guard<std::mutex> stateLock(g_StateMutex);
+        g_ActiveProbes.erase(std::find(g_ActiveProbes.begin(), g_ActiveProbes.end(), &g_ThreadProbe));
+    }
+    ReclaimReport();
+}
+
+void Watchdog::BeginWait()
+{
+    YieldReport();
+}
+
+void Watchdog::EndWait()
+{
+    ReclaimReport();
+}
+
+WatchdogScope::WatchdogScope(Watchdog::Clock::duration runTimeout, Watchdog::Clock::duration probeTimeout)
+{
+    if(runTimeout > Watchdog::Clock::duration::zero() || probeTimeout > Watchdog::Clock::duration::zero())
+    {
+        Watchdog::Start(runTimeout, probeTimeout);
+        m_Started = true;
+    }
+}
+
+WatchdogScope::~WatchdogScope()
+{
+    if(m_Started)
+        Watchdog::Stop();
+}
@@ -0,0 +1,77 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Guards against drivers and vendor libraries that hang, using a background thread.
+// While it is enabled, the main thread owns the report and gives it up only while it is inside a probe
+// or waiting for another thread. When a probe or the whole run exceeds its deadline, the watchdog takes
+// the report over, closes all its open scopes, marks the probe that timed out and terminates the program
+// with PROGRAM_EXIT_ERROR_TIMEOUT, so the partial report is still complete JSON. If the main thread doesn't give the
+// report up in time, e.g. because it hangs outside of any probe, the program is terminated without closing it.
+class Watchdog
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    // Ends the program with the exit code, without unwinding.
+    using TerminateFunc = void (*)(int exitCode);
+
+    static bool IsEnabled()
+    {
+        return s_Enabled;
+    }
+    // Call on the main thread, after the report formatter is created. Zero means no deadline.
+    static void Start(Clock::duration runTimeout, Clock::duration probeTimeout);
+    // Call on the main thread, before the report formatter is destroyed.
+    static void Stop();
+    // Replaces the function that terminates the process, e.g. for tests, where it returns instead. The report is then
+    // given back to the main thread, which can only stop the watchdog.
+    static void SetTerminateFunc(TerminateFunc func);
+
+    // Called by ProbeTimer. Probes can be issued from multiple threads.
+    static void BeginProbe(const wchar_t* probeName);
+    static void EndProbe();
+    // Call on the main thread around waiting for another thread, which may be inside a probe.
+    static void BeginWait();
+    static void EndWait();
+
+private:
+    static bool s_Enabled;
+};
+
+// Enables the watchdog if any timeout is not zero, for the time it exists.
+class WatchdogScope
+{
+public:
+    WatchdogScope(Watchdog::Clock::duration runTimeout, Watchdog::Clock::duration probeTimeout);
+    ~WatchdogScope();
+
+private:
+    bool m_Started = false;
+};
+
+// Lets the watchdog take the report over while the main thread waits for another thread.
+class WatchdogWait
+{
+public:
+    WatchdogWait()
+        : m_Enabled(Watchdog::IsEnabled())
+    {
+        if(m_Enabled)
+            Watchdog::BeginWait();
+    }
+    ~WatchdogWait()
+    {
+        if(m_Enabled)
+            Watchdog::EndWait();
+    }
+
+private:
+    const bool m_Enabled;
+};
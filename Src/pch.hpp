@@ -31,10 +31,17 @@ For more information, see files README.md, LICENSE.txt.
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <exception>
+#include <filesystem>
 #include <format>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <set>
@@ -42,6 +49,7 @@ For more information, see files README.md, LICENSE.txt.
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -67,3 +75,4 @@ static const int PROGRAM_EXIT_ERROR_COMMAND_LINE = -2;
 static const int PROGRAM_EXIT_ERROR_EXCEPTION = -3;
 static const int PROGRAM_EXIT_ERROR_SEH_EXCEPTION = -4;
 static const int PROGRAM_EXIT_ERROR_D3D12 = -5;
+static const int PROGRAM_EXIT_ERROR_TIMEOUT = -6;
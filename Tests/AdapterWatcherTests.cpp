@@ -0,0 +1,171 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "AdapterWatcher.hpp"
+#include "Printer.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static WatchedAdapter MakeAdapter(uint64_t luid, uint32_t deviceId, uint64_t umdVersion, std::wstring description)
+{
+    WatchedAdapter adapter;
+    adapter.m_Luid = luid;
+    adapter.m_VendorId = 0x10DE;
+    adapter.m_DeviceId = deviceId;
+    adapter.m_UMDVersion = umdVersion;
+    adapter.m_Description = std::move(description);
+    return adapter;
+}
+
+// Gives the adapters of each step of the script in turn, a step after each wait, and stops after the last one.
+class ScriptedAdapterSource : public AdapterWatcher::Source
+{
+public:
+    ScriptedAdapterSource(std::vector<std::vector<WatchedAdapter>> steps)
+        : m_Steps(std::move(steps))
+    {
+    }
+
+    std::vector<WatchedAdapter> GetAdapters() override
+    {
+        return m_Steps[m_StepIndex];
+    }
+    bool WaitForChange() override
+    {
+        ++m_WaitCount;
+        if(m_StepIndex + 1 == m_Steps.size())
+            return false;
+        ++m_StepIndex;
+        return true;
+    }
+    size_t GetWaitCount() const { return m_WaitCount; }
+
+private:
+    const std::vector<std::vector<WatchedAdapter>> m_Steps;
+    size_t m_StepIndex = 0;
+    size_t m_WaitCount = 0;
+};
+
+// Lines printed, without the time at which each was printed.
+static std::vector<std::wstring> SplitChangeLines(std::wstring_view text)
+{
+    static const std::wstring_view CHANGE_PREFIX = L"\",\"Change\"";
+
+    std::vector<std::wstring> lines;
+    while(!text.empty())
+    {
+        const size_t lineEnd = text.find(L'\n');
+        const std::wstring_view line = text.substr(0, lineEnd);
+        CHECK(line.starts_with(L"{\"Time\":\""));
+        const size_t changeIndex = line.find(CHANGE_PREFIX);
+        CHECK(changeIndex != std::wstring_view::npos);
+        if(changeIndex != std::wstring_view::npos)
+            lines.emplace_back(line.substr(changeIndex + CHANGE_PREFIX.size()));
+        text = lineEnd != std::wstring_view::npos ? text.substr(lineEnd + 1) : std::wstring_view();
+    }
+    return lines;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+TEST(AdapterWatcher_FindChanges)
+{
+    const WatchedAdapter gpuA = MakeAdapter(0x100000001, 1, 5, L"A");
+    const WatchedAdapter gpuB = MakeAdapter(2, 2, 5, L"B");
+    const WatchedAdapter gpuC = MakeAdapter(3, 3, 5, L"C");
+    WatchedAdapter gpuBUpdated = gpuB;
+    gpuBUpdated.m_UMDVersion = 6;
+
+    CHECK(FindAdapterChanges({ gpuA, gpuB }, { gpuA, gpuB }).empty());
+    // Only moved to another index.
+    CHECK(FindAdapterChanges({ gpuA, gpuB }, { gpuB, gpuA }).empty());
+
+    const std::vector<AdapterChange> changes = FindAdapterChanges({ gpuA, gpuB, gpuC }, { gpuC, gpuBUpdated });
+    CHECK(changes.size() == 2);
+    CHECK(changes[0].m_Type == AdapterChangeType::Removed && changes[0].m_Index == 0);
+    CHECK(changes[1].m_Type == AdapterChangeType::Changed && changes[1].m_Index == 1);
+
+    const std::vector<AdapterChange> addedChanges = FindAdapterChanges({ gpuB }, { gpuA, gpuB, gpuC });
+    CHECK(addedChanges.size() == 2);
+    CHECK(addedChanges[0].m_Type == AdapterChangeType::Added && addedChanges[0].m_Index == 0);
+    CHECK(addedChanges[1].m_Type == AdapterChangeType::Added && addedChanges[1].m_Index == 2);
+
+    // Same LUID, but another device, like after the adapter was replaced.
+    WatchedAdapter gpuAReplaced = gpuA;
+    gpuAReplaced.m_DeviceId = 7;
+    gpuAReplaced.m_Description = L"A2";
+    const std::vector<AdapterChange> replacedChanges = FindAdapterChanges({ gpuA }, { gpuAReplaced });
+    CHECK(replacedChanges.size() == 1 && replacedChanges[0].m_Type == AdapterChangeType::Changed);
+}
+
+TEST(AdapterWatcher_Run)
+{
+    const WatchedAdapter gpuA = MakeAdapter(0x100000001, 1, 5, L"GPU \"A\"");
+    const WatchedAdapter gpuB = MakeAdapter(2, 2, 5, L"GPU B");
+    WatchedAdapter gpuBUpdated = gpuB;
+    gpuBUpdated.m_UMDVersion = 6;
+
+    // Driver of B is updated, then A is removed, then nothing changes, and A comes back.
+    ScriptedAdapterSource source({ { gpuA, gpuB }, { gpuA, gpuBUpdated }, { gpuBUpdated }, { gpuBUpdated },
+        { gpuBUpdated, gpuA } });
+    std::vector<uint32_t> reportedIndices;
+    AdapterWatcher watcher(source, [&](uint32_t adapterIndex, const WatchedAdapter& adapter) {
+        reportedIndices.push_back(adapterIndex);
+        if(adapter.m_UMDVersion == 6)
+            throw std::runtime_error("Device lost.");
+        return std::format(L"{{\"DeviceId\":{}}}", adapter.m_DeviceId);
+    });
+
+    PrinterScope printerScope(false, {});
+    Printer::BeginCapture(false);
+    watcher.Run();
+    const std::vector<std::wstring> lines = SplitChangeLines(Printer::EndCapture());
+
+    CHECK(source.GetWaitCount() == 5);
+    CHECK(reportedIndices == std::vector<uint32_t>({ 0, 1, 1, 1 }));
+    CHECK(lines.size() == 5);
+    if(lines.size() == 5)
+    {
+        CHECK(lines[0] == L":\"Added\",\"Adapter\":0,\"AdapterLuid\":\"00000001-00000001\",\"Description\":\"GPU "
+                          L"\\\"A\\\"\",\"VendorId\":4318,\"DeviceId\":1,\"SubSysId\":0,\"Revision\":0,"
+                          L"\"UMDVersion\":5,\"Report\":{\"DeviceId\":1}}");
+        CHECK(lines[1] == L":\"Added\",\"Adapter\":1,\"AdapterLuid\":\"00000000-00000002\",\"Description\":\"GPU B\","
+                          L"\"VendorId\":4318,\"DeviceId\":2,\"SubSysId\":0,\"Revision\":0,\"UMDVersion\":5,"
+                          L"\"Report\":{\"DeviceId\":2}}");
+        // A failure to get the report goes into the line, and watching goes on.
+        CHECK(lines[2] == L":\"Changed\",\"Adapter\":1,\"AdapterLuid\":\"00000000-00000002\",\"Description\":\"GPU B\","
+                          L"\"VendorId\":4318,\"DeviceId\":2,\"SubSysId\":0,\"Revision\":0,\"UMDVersion\":6,"
+                          L"\"Error\":\"Device lost.\"}");
+        // Removed adapters have no index and no report.
+        CHECK(lines[3] == L":\"Removed\",\"AdapterLuid\":\"00000001-00000001\",\"Description\":\"GPU \\\"A\\\"\","
+                          L"\"VendorId\":4318,\"DeviceId\":1,\"SubSysId\":0,\"Revision\":0,\"UMDVersion\":5}");
+        CHECK(lines[4] == L":\"Added\",\"Adapter\":1,\"AdapterLuid\":\"00000001-00000001\",\"Description\":\"GPU "
+                          L"\\\"A\\\"\",\"VendorId\":4318,\"DeviceId\":1,\"SubSysId\":0,\"Revision\":0,"
+                          L"\"UMDVersion\":5,\"Report\":{\"DeviceId\":1}}");
+    }
+}
+
+TEST(AdapterWatcher_Update)
+{
+    const WatchedAdapter gpuA = MakeAdapter(1, 1, 5, L"A");
+    ScriptedAdapterSource source({ { gpuA }, { gpuA } });
+    AdapterWatcher watcher(source, [](uint32_t adapterIndex, const WatchedAdapter& adapter) { return L"{}"; });
+
+    PrinterScope printerScope(false, {});
+    Printer::BeginCapture(false);
+    CHECK(watcher.Update() == 1);
+    CHECK(source.WaitForChange());
+    // Nothing changed, so nothing is printed.
+    CHECK(watcher.Update() == 0);
+    CHECK(SplitChangeLines(Printer::EndCapture()).size() == 1);
+}
@@ -0,0 +1,143 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "CapabilityArchive.hpp"
+#include "DeviceCapture.hpp"
+
+using namespace CapabilityArchive;
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static const char* const KEY = "PC/Adapter 0";
+static const char* const CALL_NAME = "CheckFeatureSupport 0/00000000";
+
+// Offsets in the file written by WriteArchive.
+static const uint64_t RECORD_OFFSET = sizeof(Header);
+static const uint64_t CALL_OFFSET = RECORD_OFFSET + sizeof(RecordHeader) + 16;
+
+static CapturedCall MakeCall(const wchar_t* name, HRESULT result, std::vector<char> output)
+{
+    return { .m_Name = name, .m_Result = result, .m_Output = std::move(output) };
+}
+
+// Writes a new archive with a single record with the key and a single call.
+static std::wstring WriteArchive()
+{
+    const std::wstring filePath = (GetTestDirectory() / "Archive.bin").wstring();
+    std::filesystem::remove(std::filesystem::path(filePath));
+    Append(filePath, L"PC/Adapter 0", { MakeCall(L"CheckFeatureSupport 0/00000000", S_OK, { 1, 2, 3 }) });
+    return filePath;
+}
+
+template<typename T>
+static void PatchFile(const std::wstring& filePath, uint64_t offset, const T& value)
+{
+    std::fstream file(std::filesystem::path(filePath), std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(std::streamoff(offset));
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    CHECK(file.good());
+}
+
+// Returns true if reading the calls of the archive written by WriteArchive throws.
+static bool ReadingThrows(const std::wstring& filePath)
+{
+    try
+    {
+        Reader reader(filePath);
+        if(const RecordHeader* const record = reader.FindRecord(KEY))
+            reader.ForEachCall(record, [](const Call& call) {});
+    }
+    catch(const std::runtime_error&)
+    {
+        return true;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+TEST(CapabilityArchive_MakeKey)
+{
+    CHECK(MakeKey(L"Adapter 0").ends_with(L"/Adapter 0"));
+}
+
+TEST(CapabilityArchive_AppendAndFind)
+{
+    const std::wstring filePath = WriteArchive();
+    Append(filePath, L"PC/Adapter 1", { MakeCall(L"A", E_FAIL, {}) });
+    // Newer record with the same key hides the older one.
+    Append(filePath, L"PC/Adapter 0",
+        { MakeCall(L"CheckFeatureSupport 0/00000000", S_OK, { 4, 5 }), MakeCall(L"GetDesc1/00", S_OK, { 6 }) });
+
+    Reader reader(filePath);
+    CHECK(reader.FindRecord("PC/Adapter 2") == nullptr);
+
+    const RecordHeader* const record = reader.FindRecord(KEY);
+    CHECK(record != nullptr && record->m_CallCount == 2);
+    if(record == nullptr)
+        return;
+    Call call;
+    CHECK(reader.FindCall(record, CALL_NAME, call));
+    CHECK(call.m_Result == S_OK && call.m_OutputSize == 2);
+    CHECK(call.m_OutputSize == 2 && memcmp(call.m_Output, "\x04\x05", 2) == 0);
+    CHECK(!reader.FindCall(record, "Missing", call));
+
+    std::vector<std::string> names;
+    reader.ForEachCall(record, [&](const Call& call) { names.push_back(std::string(call.m_Name)); });
+    CHECK(names == std::vector<std::string>({ CALL_NAME, "GetDesc1/00" }));
+
+    const RecordHeader* const otherRecord = reader.FindRecord("PC/Adapter 1");
+    CHECK(otherRecord != nullptr && reader.FindCall(otherRecord, "A", call) && call.m_Result == E_FAIL);
+}
+
+TEST(CapabilityArchive_DamagedSizes)
+{
+    const std::wstring filePath = WriteArchive();
+    CHECK(!ReadingThrows(filePath));
+
+    PatchFile(filePath, RECORD_OFFSET + offsetof(RecordHeader, m_KeySize), uint32_t(0xFFFFFFF0));
+    CHECK(ReadingThrows(filePath));
+
+    WriteArchive();
+    PatchFile(filePath, RECORD_OFFSET + offsetof(RecordHeader, m_RecordSize), uint64_t(0xFFFFFFFFFFFF));
+    CHECK(ReadingThrows(filePath));
+
+    WriteArchive();
+    PatchFile(filePath, CALL_OFFSET + offsetof(CallHeader, m_NameSize), uint32_t(0x10000));
+    CHECK(ReadingThrows(filePath));
+
+    WriteArchive();
+    PatchFile(filePath, CALL_OFFSET + offsetof(CallHeader, m_OutputSize), uint32_t(0xFFFFFFFF));
+    CHECK(ReadingThrows(filePath));
+
+    WriteArchive();
+    PatchFile(filePath, RECORD_OFFSET + offsetof(RecordHeader, m_CallCount), uint32_t(2));
+    CHECK(ReadingThrows(filePath));
+}
+
+TEST(CapabilityArchive_DamagedOffsets)
+{
+    const std::wstring filePath = WriteArchive();
+    // Every bucket points to a misaligned record.
+    for(uint32_t i = 0; i < BUCKET_COUNT; ++i)
+        PatchFile(filePath, offsetof(Header, m_BucketRecordOffsets) + i * sizeof(uint64_t), RECORD_OFFSET + 4);
+    CHECK(ReadingThrows(filePath));
+
+    // The record is cut off.
+    WriteArchive();
+    std::filesystem::resize_file(std::filesystem::path(filePath), CALL_OFFSET + sizeof(CallHeader));
+    CHECK(ReadingThrows(filePath));
+
+    std::filesystem::resize_file(std::filesystem::path(filePath), sizeof(Header) - 1);
+    CHECK(ReadingThrows(filePath));
+}
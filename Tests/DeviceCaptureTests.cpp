@@ -0,0 +1,130 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "DeviceCapture.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// Shaped like D3D12_FEATURE_DATA_FEATURE_LEVELS: a count and a pointer as the input, a value as the output.
+struct MaxQuery
+{
+    uint32_t m_Count;
+    const uint32_t* m_Values;
+    uint32_t m_Max;
+};
+
+// Padding is part of the call too, so it's zeroed.
+static MaxQuery MakeQuery(const std::vector<uint32_t>& values)
+{
+    MaxQuery query;
+    memset(&query, 0, sizeof(query));
+    query.m_Count = uint32_t(values.size());
+    query.m_Values = values.data();
+    return query;
+}
+
+static std::vector<CapturePointer> GetPointers(const MaxQuery& query)
+{
+    const CapturePointer values = { .m_Offset = offsetof(MaxQuery, m_Values),
+        .m_Input = query.m_Values,
+        .m_InputSize = query.m_Count * sizeof(uint32_t) };
+    return { values };
+}
+
+// Queries the maximum of the values through the capture, counting real calls in callCount.
+static HRESULT QueryMax(MaxQuery& query, uint32_t& callCount)
+{
+    return CaptureCall(L"Max", &query, sizeof(query), [&]() {
+        ++callCount;
+        query.m_Max = *std::max_element(query.m_Values, query.m_Values + query.m_Count);
+        return S_OK;
+    }, GetPointers(query));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+TEST(PointersNotRecorded)
+{
+    DeviceCaptureScope captureScope(L"", L"", true);
+    DeviceCapture::SetAdapter(L"Adapter 0");
+    uint32_t callCount = 0;
+
+    // Arrays at different addresses with the same values make the same call.
+    const std::vector<uint32_t> values1 = { 3, 7, 5 };
+    const std::vector<uint32_t> values2 = values1;
+    MaxQuery query1 = MakeQuery(values1);
+    MaxQuery query2 = MakeQuery(values2);
+    CHECK(SUCCEEDED(QueryMax(query1, callCount)));
+    CHECK(SUCCEEDED(QueryMax(query2, callCount)));
+    CHECK(callCount == 2);
+    CHECK(query1.m_Max == 7 && query2.m_Max == 7);
+
+    const std::vector<CapturedCall> calls = DeviceCapture::GetAdapterCalls(L"Adapter 0");
+    CHECK(calls.size() == 1);
+    if(calls.size() == 1)
+    {
+        // Name is followed by the structure with a null pointer, then the array.
+        CHECK(calls[0].m_Name.starts_with(L"Max/03000000"));
+        CHECK(calls[0].m_Name.ends_with(L"/030000000700000005000000"));
+        CHECK(calls[0].m_Name.find(L"0000000000000000") != std::wstring::npos);
+        CHECK(calls[0].m_Output.size() == sizeof(MaxQuery));
+        const void* recordedPointer = &query1;
+        if(calls[0].m_Output.size() == sizeof(MaxQuery))
+            memcpy(&recordedPointer, calls[0].m_Output.data() + offsetof(MaxQuery, m_Values), sizeof(void*));
+        CHECK(recordedPointer == nullptr);
+    }
+}
+
+TEST(RecordAndReplay)
+{
+    const std::wstring filePath = (GetTestDirectory() / "Capture.bin").wstring();
+    const std::vector<uint32_t> recordedValues = { 3, 7, 5 };
+    {
+        DeviceCaptureScope captureScope(filePath, L"", false);
+        DeviceCapture::SetAdapter(L"Adapter 1");
+        uint32_t callCount = 0;
+        MaxQuery query = MakeQuery(recordedValues);
+        CHECK(SUCCEEDED(QueryMax(query, callCount)));
+        DeviceCapture::SetAdapter(L"WARP");
+        uint32_t zero = 0;
+        CHECK(SUCCEEDED(CaptureCall(L"Zero", &zero, sizeof(zero), []() { return S_OK; })));
+    }
+    CHECK(!DeviceCapture::IsRecording());
+
+    DeviceCaptureScope captureScope(L"", filePath, false);
+    CHECK(DeviceCapture::IsReplaying());
+    CHECK(DeviceCapture::GetAdapterNames() == std::vector<std::wstring>({ L"Adapter 1", L"WARP" }));
+    DeviceCapture::SetAdapter(L"Adapter 1");
+
+    // Answered from the capture, with the pointer of the caller kept.
+    uint32_t callCount = 0;
+    const std::vector<uint32_t> values = recordedValues;
+    MaxQuery query = MakeQuery(values);
+    CHECK(QueryMax(query, callCount) == S_OK);
+    CHECK(callCount == 0);
+    CHECK(query.m_Max == 7);
+    CHECK(query.m_Values == values.data());
+
+    // Different values pointed to make a call missing from the capture.
+    const std::vector<uint32_t> otherValues = { 3, 7, 6 };
+    MaxQuery otherQuery = MakeQuery(otherValues);
+    CHECK(QueryMax(otherQuery, callCount) == E_FAIL);
+    CHECK(callCount == 0);
+    CHECK(otherQuery.m_Max == 0 && otherQuery.m_Values == otherValues.data());
+
+    // Calls belong to their adapter.
+    uint32_t zero = 0;
+    CHECK(DeviceCapture::ReplayCall(L"Zero", &zero, sizeof(zero)) == E_FAIL);
+    DeviceCapture::SetAdapter(L"WARP");
+    CHECK(DeviceCapture::ReplayCall(L"Zero", &zero, sizeof(zero)) == S_OK);
+}
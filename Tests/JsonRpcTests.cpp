@@ -0,0 +1,135 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "JsonRpc.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// Stands in for the D3D12 devices of the program: the report tells the options it was printed with.
+class FakeDeviceReportSource : public JsonRpcReportSource
+{
+public:
+    std::vector<std::wstring> m_PrintedOptions;
+    // Video memory usage, changing with every report.
+    uint32_t m_Usage = 100;
+
+    std::wstring PrintReport(const std::wstring& options) override
+    {
+        m_PrintedOptions.push_back(options);
+        if(options.find(L"--Fail") != std::wstring::npos)
+            throw std::runtime_error("Device removed.");
+        return std::format(L"{{\"Options\":\"{}\",\"Usage\":{}}}", EscapeJsonString(options), m_Usage++);
+    }
+};
+
+// Parses the response and returns its error code, or 0 if it has a result.
+static int GetErrorCode(const std::wstring& response)
+{
+    const JsonValue message = ParseJson(response);
+    const JsonValue* error = message.FindMember(L"error");
+    if(error == nullptr)
+        return 0;
+    const JsonValue* code = error->FindMember(L"code");
+    return code != nullptr ? std::stoi(code->m_String) : 1;
+}
+
+static std::wstring GetResultMember(const std::wstring& response, std::wstring_view name)
+{
+    const JsonValue message = ParseJson(response);
+    const JsonValue* result = message.FindMember(L"result");
+    const JsonValue* member = result != nullptr ? result->FindMember(name) : nullptr;
+    return member != nullptr ? member->m_String : std::wstring();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+TEST(JsonRpc_ReportOptions)
+{
+    FakeDeviceReportSource source;
+    JsonRpcServer server(source);
+    const std::wstring response = server.HandleLine(
+        R"({"jsonrpc":"2.0","id":1,"method":"report","params":{"adapter":1,"select":"Adapters/*/DXGI_ADAPTER_DESC*"}})");
+    CHECK(GetErrorCode(response) == 0);
+    CHECK(GetResultMember(response, L"Options") == L"--Adapter=1 \"--Select=Adapters/*/DXGI_ADAPTER_DESC*\" ");
+    CHECK(source.m_PrintedOptions.size() == 1);
+}
+
+TEST(JsonRpc_ReportFromMemory)
+{
+    FakeDeviceReportSource source;
+    JsonRpcServer server(source);
+    const std::string request = R"({"jsonrpc":"2.0","id":1,"method":"report","params":{"adapter":0}})";
+    const std::wstring response1 = server.HandleLine(request);
+    const std::wstring response2 = server.HandleLine(request);
+    CHECK(response1 == response2);
+    CHECK(source.m_PrintedOptions.size() == 1);
+
+    // Video memory changes, so it's printed every time.
+    const std::string videoMemoryRequest = R"({"jsonrpc":"2.0","id":2,"method":"videoMemory","params":{"adapter":0}})";
+    const std::wstring response3 = server.HandleLine(videoMemoryRequest);
+    const std::wstring response4 = server.HandleLine(videoMemoryRequest);
+    CHECK(GetResultMember(response3, L"Usage") != GetResultMember(response4, L"Usage"));
+    CHECK(source.m_PrintedOptions.size() == 3);
+}
+
+TEST(JsonRpc_InvalidSelect)
+{
+    FakeDeviceReportSource source;
+    JsonRpcServer server(source);
+    // Quotes would end the quoted option and add another one.
+    CHECK(GetErrorCode(server.HandleLine(
+              R"({"jsonrpc":"2.0","id":1,"method":"report","params":{"select":"A\" --OutputFile=C:\\x.txt \""}})")) ==
+        JSON_RPC_ERROR_INVALID_PARAMS);
+    // Backslash before the closing quote would escape it.
+    CHECK(GetErrorCode(server.HandleLine(R"({"jsonrpc":"2.0","id":2,"method":"report","params":{"select":"A\\"}})")) ==
+        JSON_RPC_ERROR_INVALID_PARAMS);
+    CHECK(GetErrorCode(server.HandleLine(R"({"jsonrpc":"2.0","id":3,"method":"report","params":{"select":1}})")) ==
+        JSON_RPC_ERROR_INVALID_PARAMS);
+    CHECK(GetErrorCode(server.HandleLine(R"({"jsonrpc":"2.0","id":4,"method":"report","params":{"adapter":"0 -x"}})")) ==
+        JSON_RPC_ERROR_INVALID_PARAMS);
+    CHECK(source.m_PrintedOptions.empty());
+}
+
+TEST(JsonRpc_Errors)
+{
+    FakeDeviceReportSource source;
+    JsonRpcServer server(source);
+
+    const std::wstring parseError = server.HandleLine("{\"jsonrpc\":");
+    CHECK(GetErrorCode(parseError) == JSON_RPC_ERROR_PARSE);
+    CHECK(ParseJson(parseError).FindMember(L"id")->m_Type == JsonValue::Type::Null);
+
+    CHECK(GetErrorCode(server.HandleLine(R"({"jsonrpc":"2.0","id":1,"method":"unknown"})")) ==
+        JSON_RPC_ERROR_METHOD_NOT_FOUND);
+    CHECK(GetErrorCode(server.HandleLine(R"({"jsonrpc":"2.0","id":2,"method":"videoMemory","params":{}})")) ==
+        JSON_RPC_ERROR_INVALID_PARAMS);
+    // Failures of printing are errors of the server, and are not kept in memory.
+    const std::string failingRequest = R"({"jsonrpc":"2.0","id":3,"method":"report","params":{"options":"--Fail"}})";
+    CHECK(GetErrorCode(server.HandleLine(failingRequest)) == JSON_RPC_ERROR_SERVER);
+    CHECK(GetErrorCode(server.HandleLine(failingRequest)) == JSON_RPC_ERROR_SERVER);
+    CHECK(source.m_PrintedOptions.size() == 2);
+}
+
+TEST(JsonRpc_NotificationsAndShutdown)
+{
+    FakeDeviceReportSource source;
+    JsonRpcServer server(source);
+    CHECK(server.HandleLine(" \r").empty());
+    CHECK(server.HandleLine(R"({"jsonrpc":"2.0","method":"report"})").empty());
+    CHECK(source.m_PrintedOptions.size() == 1);
+
+    CHECK(!server.IsShutDown());
+    const std::wstring response = server.HandleLine(R"({"jsonrpc":"2.0","id":"last","method":"shutdown"})");
+    CHECK(response == L"{\"jsonrpc\":\"2.0\",\"id\":\"last\",\"result\":null}");
+    CHECK(server.IsShutDown());
+}
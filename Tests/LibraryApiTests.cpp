@@ -0,0 +1,210 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "D3d12infoApi.h"
+#include "Json.hpp"
+#include "Main.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+#include "ReportSelection.hpp"
+#include "ReportTree.hpp"
+#include "Utils.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static const size_t FAKE_ADAPTER_COUNT = 2;
+static uint32_t g_ReleaseCount = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+// Stand in for the D3D12 devices of the program in Main.cpp: a fake device prints its probes the way they are
+// printed, through ReportFormatter::GetInstance(), so the library builds the report from what the probes print.
+
+void PrintLibraryReport(const wchar_t* options, std::unique_ptr<ReportSink> sink)
+{
+    const std::wstring_view optionsView = options;
+    if(optionsView.find(L"-o ") != std::wstring_view::npos)
+        throw std::invalid_argument("Invalid options.");
+    if(optionsView.find(L"--Fail") != std::wstring_view::npos)
+        throw std::runtime_error("Device removed.");
+
+    ReportSelection::Clear();
+    if(const size_t select = optionsView.find(L"--Select="); select != std::wstring_view::npos)
+        ReportSelection::Add(optionsView.substr(select + wcslen(L"--Select=")));
+
+    ReportFormatterThreadScope formatterScope(std::move(sink));
+    ReportSink& formatter = ReportFormatter::GetInstance();
+    {
+        ReportScopeObject scope(L"D3d12info");
+        formatter.AddFieldString(L"Version", L"1.0 \"fake\"");
+    }
+    ReportScopeArray scopeArray(L"Adapters", ReportSink::ARRAY_SUFFIX_NONE);
+    for(uint32_t adapterIndex = 0; adapterIndex < FAKE_ADAPTER_COUNT; ++adapterIndex)
+    {
+        ReportScopeArrayItem scopeItem;
+        {
+            ReportScopeObject scope(L"DXGI_ADAPTER_DESC3");
+            formatter.AddFieldString(L"Description", std::format(L"Fake GPU é中 {}", adapterIndex));
+            formatter.AddFieldVendorId(L"VendorId", 0x10DE);
+            formatter.AddFieldSize(L"DedicatedVideoMemory", 0x200000000ull);
+            formatter.AddFieldStringArray(L"Extensions", { L"A", L"B" });
+        }
+        {
+            ReportScopeObject scope(L"D3D12_FEATURE_DATA_D3D12_OPTIONS5");
+            formatter.AddFieldBool(L"SRVOnlyTiledResourceTier3", true);
+            formatter.AddFieldEnum(L"RaytracingTier", 11, nullptr);
+            formatter.AddFieldInt32(L"DepthBias", -1);
+            formatter.AddFieldFloat(L"Ratio", 0.5f);
+            const uint8_t bytes[] = { 0xAB, 0x01 };
+            formatter.AddFieldHexBytes(L"Data", bytes, sizeof(bytes));
+        }
+    }
+}
+
+std::vector<D3d12infoAdapter> GetLibraryAdapters()
+{
+    std::vector<D3d12infoAdapter> adapters(FAKE_ADAPTER_COUNT);
+    for(size_t i = 0; i < adapters.size(); ++i)
+    {
+        adapters[i].VendorId = 0x10DE;
+        adapters[i].DeviceId = uint32_t(i);
+    }
+    return adapters;
+}
+
+void ReleaseLibraryState()
+{
+    ++g_ReleaseCount;
+}
+
+TEST(ReportTree_Build)
+{
+    ReportTree tree;
+    {
+        ReportTreeBuilder builder(tree);
+        builder.PushObject(L"A");
+        builder.AddFieldUint32(L"X", 1);
+        builder.PushArray(L"Items");
+        builder.PushArrayItem();
+        builder.AddFieldString(L"S", L"\U0001F600\n");
+        builder.PopAllScopes();
+        builder.AddEnumArray(L"Enums", std::array<uint32_t, 2>{ 3, 4 }.data(), 2, nullptr);
+    }
+    CHECK(tree.WriteJson() == "{\"A\":{\"X\":1,\"Items\":[{\"S\":\"\xF0\x9F\x98\x80\\n\"}]},\"Enums\":[3,4]}");
+    CHECK(tree.Find("A/Items/0/S") != ReportTree::NO_NODE);
+    CHECK(tree.Find("Enums/1") != ReportTree::NO_NODE);
+    CHECK(tree.GetNode(tree.Find("Enums/1")).m_Uint64 == 4);
+    CHECK(tree.Find("Enums/2") == ReportTree::NO_NODE);
+    CHECK(tree.Find("A/X/Y") == ReportTree::NO_NODE);
+    CHECK(tree.Find("A/Items/x") == ReportTree::NO_NODE);
+    CHECK(tree.Find("A/") == ReportTree::NO_NODE);
+    CHECK(tree.Find("") == ReportTree::NO_NODE);
+}
+
+TEST(LibraryApi_ReportValues)
+{
+    D3d12infoReport* report = nullptr;
+    CHECK(D3d12info_CreateReport(nullptr, &report) == D3D12INFO_SUCCESS);
+    CHECK(report != nullptr);
+
+    uint64_t value = 0;
+    CHECK(D3d12info_GetReportUint64(report, "Adapters/1/D3D12_FEATURE_DATA_D3D12_OPTIONS5/RaytracingTier", &value) ==
+        D3D12INFO_SUCCESS);
+    CHECK(value == 11);
+    CHECK(D3d12info_GetReportUint64(report, "Adapters/0/D3D12_FEATURE_DATA_D3D12_OPTIONS5/SRVOnlyTiledResourceTier3",
+              &value) == D3D12INFO_SUCCESS);
+    CHECK(value == 1);
+    // 64-bit numbers are strings in the JSON, but numbers here.
+    CHECK(D3d12info_GetReportUint64(report, "Adapters/0/DXGI_ADAPTER_DESC3/DedicatedVideoMemory", &value) ==
+        D3D12INFO_SUCCESS);
+    CHECK(value == 0x200000000ull);
+    CHECK(D3d12info_GetReportUint64(report, "Adapters/0/D3D12_FEATURE_DATA_D3D12_OPTIONS5/DepthBias", &value) ==
+        D3D12INFO_ERROR_INVALID_ARGUMENT);
+    CHECK(D3d12info_GetReportUint64(report, "Adapters/0/D3D12_FEATURE_DATA_D3D12_OPTIONS5/Ratio", &value) ==
+        D3D12INFO_ERROR_INVALID_ARGUMENT);
+    CHECK(D3d12info_GetReportUint64(report, "Adapters/0/DXGI_ADAPTER_DESC3", &value) ==
+        D3D12INFO_ERROR_INVALID_ARGUMENT);
+    CHECK(D3d12info_GetReportUint64(report, "Adapters/2/DXGI_ADAPTER_DESC3/VendorId", &value) ==
+        D3D12INFO_ERROR_NOT_FOUND);
+    CHECK(D3d12info_GetReportUint64(report, "Adapters/0/Missing", &value) == D3D12INFO_ERROR_NOT_FOUND);
+
+    const char* str = nullptr;
+    CHECK(D3d12info_GetReportString(report, "Adapters/1/DXGI_ADAPTER_DESC3/Description", &str) ==
+        D3D12INFO_SUCCESS);
+    CHECK(str != nullptr && strcmp(str, "Fake GPU \xC3\xA9\xE4\xB8\xAD 1") == 0);
+    CHECK(D3d12info_GetReportString(report, "Adapters/0/DXGI_ADAPTER_DESC3/Extensions/1", &str) ==
+        D3D12INFO_SUCCESS);
+    CHECK(str != nullptr && strcmp(str, "B") == 0);
+    CHECK(D3d12info_GetReportString(report, "Adapters/0/D3D12_FEATURE_DATA_D3D12_OPTIONS5/Data", &str) ==
+        D3D12INFO_SUCCESS);
+    CHECK(str != nullptr && strcmp(str, "AB01") == 0);
+    CHECK(D3d12info_GetReportString(report, "Adapters/0/DXGI_ADAPTER_DESC3/VendorId", &str) ==
+        D3D12INFO_ERROR_INVALID_ARGUMENT);
+
+    D3d12info_DestroyReport(report);
+}
+
+TEST(LibraryApi_ReportJson)
+{
+    D3d12infoReport* report = nullptr;
+    CHECK(D3d12info_CreateReport(L"--Select=D3d12info", &report) == D3D12INFO_SUCCESS);
+    const char* json = D3d12info_GetReportJson(report);
+    CHECK(json != nullptr && strcmp(json, "{\"D3d12info\":{\"Version\":\"1.0 \\\"fake\\\"\"}}") == 0);
+    // Written once.
+    CHECK(D3d12info_GetReportJson(report) == json);
+    D3d12info_DestroyReport(report);
+    ReportSelection::Clear();
+
+    CHECK(D3d12info_CreateReport(L"", &report) == D3D12INFO_SUCCESS);
+    const JsonValue root = ParseJson(StrToWstr(D3d12info_GetReportJson(report), CP_UTF8));
+    const JsonValue* adapters = root.FindMember(L"Adapters");
+    CHECK(adapters != nullptr && adapters->IsArray() && adapters->m_Items.size() == FAKE_ADAPTER_COUNT);
+    const JsonValue* memory = adapters->m_Items[0].FindMember(L"DXGI_ADAPTER_DESC3")->FindMember(
+        L"DedicatedVideoMemory");
+    CHECK(memory != nullptr && memory->m_Type == JsonValue::Type::String && memory->m_String == L"8589934592");
+    D3d12info_DestroyReport(report);
+}
+
+TEST(LibraryApi_Errors)
+{
+    D3d12infoReport* report = nullptr;
+    CHECK(D3d12info_CreateReport(L"-o report.json", &report) == D3D12INFO_ERROR_INVALID_ARGUMENT);
+    CHECK(report == nullptr);
+    CHECK(D3d12info_CreateReport(L"--Fail", &report) == D3D12INFO_ERROR_FAILED);
+    CHECK(report == nullptr);
+    CHECK(D3d12info_CreateReport(L"", nullptr) == D3D12INFO_ERROR_INVALID_ARGUMENT);
+
+    uint64_t value = 0;
+    const char* str = nullptr;
+    CHECK(D3d12info_GetReportUint64(nullptr, "Adapters", &value) == D3D12INFO_ERROR_INVALID_ARGUMENT);
+    CHECK(D3d12info_GetReportString(nullptr, "Adapters", &str) == D3D12INFO_ERROR_INVALID_ARGUMENT);
+    CHECK(D3d12info_GetReportJson(nullptr) == nullptr);
+}
+
+TEST(LibraryApi_Adapters)
+{
+    uint32_t count = 0;
+    CHECK(D3d12info_GetAdapters(nullptr, &count) == D3D12INFO_SUCCESS);
+    CHECK(count == FAKE_ADAPTER_COUNT);
+
+    D3d12infoAdapter adapters[FAKE_ADAPTER_COUNT] = {};
+    count = 1;
+    CHECK(D3d12info_GetAdapters(adapters, &count) == D3D12INFO_INCOMPLETE);
+    CHECK(count == 1 && adapters[0].VendorId == 0x10DE && adapters[1].VendorId == 0);
+    count = FAKE_ADAPTER_COUNT;
+    CHECK(D3d12info_GetAdapters(adapters, &count) == D3D12INFO_SUCCESS);
+    CHECK(count == FAKE_ADAPTER_COUNT && adapters[1].DeviceId == 1);
+
+    const uint32_t releaseCount = g_ReleaseCount;
+    D3d12info_Shutdown();
+    CHECK(g_ReleaseCount == releaseCount + 1);
+}
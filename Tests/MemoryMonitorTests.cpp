@@ -0,0 +1,163 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "MemoryMonitor.hpp"
+#include "Printer.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+#include "ReportSelection.hpp"
+#include "ReportTree.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static const uint64_t MEBIBYTE = 1024 * 1024;
+static const uint64_t FAKE_BUDGET = 8192 * MEBIBYTE;
+static const uint64_t HUGE_USAGE = UINT64_MAX - 1000;
+
+// Stands in for IDXGIAdapter3::QueryVideoMemoryInfo of adapters 0 and 2. Usage of the local segment group goes through
+// 1..100 MiB, except once a value near the top of the range instead of 100 MiB, so the percentiles stay the same.
+// Adapter 2 has no non-local segment group.
+static bool QueryFakeAdapter(uint32_t adapterIndex, uint32_t segmentGroup, VideoMemoryInfo& outInfo, uint64_t tick)
+{
+    if(adapterIndex == 2 && segmentGroup == 1)
+        return false;
+    outInfo.m_Budget = FAKE_BUDGET;
+    outInfo.m_CurrentUsage = segmentGroup == 0 ? (tick % 100 + 1) * MEBIBYTE : 0;
+    if(adapterIndex == 0 && segmentGroup == 0 && tick == 12399)
+        outInfo.m_CurrentUsage = HUGE_USAGE;
+    outInfo.m_AvailableForReservation = FAKE_BUDGET / 2;
+    outInfo.m_CurrentReservation = tick;
+    return true;
+}
+
+static uint64_t GetUint64(const ReportTree& tree, std::string_view path)
+{
+    const uint32_t index = tree.Find(path);
+    CHECK(index != ReportTree::NO_NODE);
+    return index != ReportTree::NO_NODE ? tree.GetNode(index).m_Uint64 : 0;
+}
+
+static bool IsNear(uint64_t value, uint64_t expected)
+{
+    const uint64_t difference = value > expected ? value - expected : expected - value;
+    return difference <= expected / 128;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+TEST(MemoryMonitor_Summary)
+{
+    static const uint64_t TICK_COUNT = 20000;
+
+    uint64_t tick = 0;
+    MemoryMonitor monitor(
+        { 0, 2 },
+        [&](uint32_t adapterIndex, uint32_t segmentGroup, VideoMemoryInfo& outInfo) {
+            return QueryFakeAdapter(adapterIndex, segmentGroup, outInfo, tick);
+        },
+        std::chrono::milliseconds(1), true);
+
+    PrinterScope printerScope(false, {});
+    Printer::BeginCapture(false);
+    for(; tick < TICK_COUNT; ++tick)
+    {
+        monitor.Tick(std::chrono::microseconds(tick * 1000));
+        // Less often than the ring buffer fills up.
+        if(tick % 1000 == 999)
+            monitor.WriteSamples();
+    }
+    monitor.WriteSamples();
+    const std::wstring samples = Printer::EndCapture();
+    CHECK(std::count(samples.begin(), samples.end(), L'\n') == TICK_COUNT * 3);
+    CHECK(samples.starts_with(L"{\"TimeMs\":0.000,\"Adapter\":0,\"SegmentGroup\":\"DXGI_MEMORY_SEGMENT_GROUP_LOCAL\","
+                              L"\"Budget\":8589934592,\"CurrentUsage\":1048576,"));
+
+    ReportTree tree;
+    ReportSelection::Clear();
+    {
+        ReportFormatterThreadScope formatterScope(std::make_unique<ReportTreeBuilder>(tree));
+        monitor.PrintSummary();
+    }
+    CHECK(GetUint64(tree, "MemoryMonitor/TickCount") == TICK_COUNT);
+    CHECK(GetUint64(tree, "MemoryMonitor/DroppedSampleCount") == 0);
+
+    const std::string local0 = "MemoryMonitor/Adapters/0/DXGI_MEMORY_SEGMENT_GROUP_LOCAL/";
+    CHECK(GetUint64(tree, "MemoryMonitor/Adapters/0/Adapter") == 0);
+    CHECK(GetUint64(tree, local0 + "CurrentUsage/Min") == MEBIBYTE);
+    CHECK(GetUint64(tree, local0 + "CurrentUsage/Max") == HUGE_USAGE);
+    CHECK(IsNear(GetUint64(tree, local0 + "CurrentUsage/P50"), 50 * MEBIBYTE));
+    CHECK(IsNear(GetUint64(tree, local0 + "CurrentUsage/P95"), 95 * MEBIBYTE));
+    CHECK(IsNear(GetUint64(tree, local0 + "CurrentUsage/P99"), 99 * MEBIBYTE));
+    // Values that are all the same are exact.
+    CHECK(GetUint64(tree, local0 + "Budget/P50") == FAKE_BUDGET);
+    CHECK(GetUint64(tree, local0 + "Budget/P99") == FAKE_BUDGET);
+    // Small values have a bucket each.
+    CHECK(GetUint64(tree, local0 + "CurrentReservation/Min") == 0);
+    CHECK(GetUint64(tree, local0 + "CurrentReservation/Max") == TICK_COUNT - 1);
+    CHECK(IsNear(GetUint64(tree, local0 + "CurrentReservation/P50"), TICK_COUNT / 2));
+
+    CHECK(GetUint64(tree, "MemoryMonitor/Adapters/0/DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL/CurrentUsage/P99") == 0);
+    CHECK(GetUint64(tree, "MemoryMonitor/Adapters/1/Adapter") == 2);
+    CHECK(GetUint64(tree, "MemoryMonitor/Adapters/1/DXGI_MEMORY_SEGMENT_GROUP_LOCAL/CurrentUsage/Max") ==
+        100 * MEBIBYTE);
+    CHECK(tree.Find("MemoryMonitor/Adapters/1/DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL") == ReportTree::NO_NODE);
+}
+
+TEST(MemoryMonitor_DroppedSamples)
+{
+    MemoryMonitor monitor(
+        { 0 },
+        [](uint32_t adapterIndex, uint32_t segmentGroup, VideoMemoryInfo& outInfo) {
+            return QueryFakeAdapter(adapterIndex, segmentGroup, outInfo, 0);
+        },
+        std::chrono::milliseconds(1), false);
+
+    // Without the writer, the ring buffer fills up and the samples that don't fit are counted.
+    static const uint64_t TICK_COUNT = 10000;
+    PrinterScope printerScope(false, {});
+    for(uint64_t tick = 0; tick < TICK_COUNT; ++tick)
+        monitor.Tick(std::chrono::microseconds(tick * 1000));
+    Printer::BeginCapture(false);
+    monitor.WriteSamples();
+    const std::wstring samples = Printer::EndCapture();
+    const size_t writtenCount = std::count(samples.begin(), samples.end(), L'\n');
+    CHECK(writtenCount > 0 && writtenCount < TICK_COUNT * 2);
+
+    ReportTree tree;
+    ReportSelection::Clear();
+    {
+        ReportFormatterThreadScope formatterScope(std::make_unique<ReportTreeBuilder>(tree));
+        monitor.PrintSummary();
+    }
+    CHECK(GetUint64(tree, "MemoryMonitor/DroppedSampleCount") == TICK_COUNT * 2 - writtenCount);
+}
+
+TEST(MemoryMonitor_Run)
+{
+    MemoryMonitor monitor(
+        { 1 },
+        [](uint32_t adapterIndex, uint32_t segmentGroup, VideoMemoryInfo& outInfo) {
+            return QueryFakeAdapter(adapterIndex, segmentGroup, outInfo, 7);
+        },
+        std::chrono::milliseconds(1), false);
+
+    PrinterScope printerScope(false, {});
+    // The test CtrlCScope stops after the first tick, and the writer thread writes its samples before it ends.
+    Printer::BeginCapture(false);
+    monitor.Run();
+    const std::wstring samples = Printer::EndCapture();
+    CHECK(samples.starts_with(L"TimeMs,Adapter,SegmentGroup,Budget,CurrentUsage,AvailableForReservation,"
+                              L"CurrentReservation\n"));
+    CHECK(samples.find(L",1,DXGI_MEMORY_SEGMENT_GROUP_LOCAL,8589934592,8388608,4294967296,7\n") !=
+        std::wstring::npos);
+    CHECK(samples.ends_with(L",1,DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL,8589934592,0,4294967296,7\n"));
+}
@@ -0,0 +1,139 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "NvApiMonitor.hpp"
+#include "Printer.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// Stands in for NVAPI of the GPUs of adapters 0 and 3. Counters of adapter 0 grow by a fixed amount each sample, except
+// the driver restarts at sample 3. Adapter 3 fails its first sample and doesn't report clocks.
+static bool SampleFakeGpu(uint32_t adapterIndex, uint64_t sample, NvGpuCounters& outCounters)
+{
+    if(adapterIndex == 3)
+    {
+        if(sample == 0)
+            return false;
+        outCounters.m_EvictionCount = sample * 10;
+        return true;
+    }
+    const uint64_t sinceStart = sample >= 3 ? sample - 3 : sample + 100;
+    outCounters.m_CurAvailableDedicatedVideoMemory = 1000 - sample;
+    outCounters.m_EvictionsSize = sinceStart * 4096;
+    outCounters.m_EvictionCount = sinceStart * 2;
+    outCounters.m_PromotionsSize = sinceStart * 8192;
+    outCounters.m_PromotionCount = sinceStart;
+    outCounters.m_GraphicsClockKHz = 1500000;
+    outCounters.m_MemoryClockKHz = 7000000;
+    outCounters.m_PerformanceState = 0;
+    return true;
+}
+
+static std::wstring RunFakeMonitor(bool json, uint64_t sampleCount)
+{
+    uint64_t sample = 0;
+    NvApiMonitor monitor(
+        { 0, 3 },
+        [&](uint32_t adapterIndex, NvGpuCounters& outCounters) {
+            return SampleFakeGpu(adapterIndex, sample, outCounters);
+        },
+        std::chrono::milliseconds(100), json);
+    Printer::BeginCapture(false);
+    for(; sample < sampleCount; ++sample)
+        monitor.Tick(std::chrono::milliseconds(sample * 100));
+    return Printer::EndCapture();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+TEST(NvApiMonitor_CountersDelta)
+{
+    NvGpuCounters prev;
+    prev.m_CurAvailableDedicatedVideoMemory = 500;
+    prev.m_EvictionsSize = 1000;
+    prev.m_EvictionCount = 10;
+    prev.m_PromotionsSize = 2000;
+    prev.m_PromotionCount = 20;
+    prev.m_GraphicsClockKHz = 100;
+
+    NvGpuCounters curr = prev;
+    curr.m_CurAvailableDedicatedVideoMemory = 400;
+    curr.m_EvictionsSize = 1500;
+    curr.m_EvictionCount = 10;
+    curr.m_PromotionsSize = 2001;
+    curr.m_PromotionCount = 25;
+    curr.m_MemoryClockKHz = 200;
+
+    const NvGpuCounters delta = GetNvGpuCountersDelta(prev, curr);
+    CHECK(delta.m_EvictionsSize == 500);
+    CHECK(delta.m_EvictionCount == 0);
+    CHECK(delta.m_PromotionsSize == 1);
+    CHECK(delta.m_PromotionCount == 5);
+    // Current values are taken as they are.
+    CHECK(delta.m_CurAvailableDedicatedVideoMemory == 400);
+    CHECK(delta.m_GraphicsClockKHz == 100);
+    CHECK(delta.m_MemoryClockKHz == 200);
+    CHECK(delta.m_PerformanceState == NvGpuCounters::UNKNOWN);
+
+    // Lower than before: the driver restarted, so the counters grew from 0.
+    const NvGpuCounters resetDelta = GetNvGpuCountersDelta(curr, prev);
+    CHECK(resetDelta.m_EvictionsSize == 1000);
+    CHECK(resetDelta.m_EvictionCount == 0);
+    CHECK(resetDelta.m_PromotionsSize == 2000);
+    CHECK(resetDelta.m_PromotionCount == 20);
+}
+
+TEST(NvApiMonitor_TickCsv)
+{
+    PrinterScope printerScope(false, {});
+    // The first successful sample of each GPU prints nothing, it's only the base for the deltas.
+    CHECK(RunFakeMonitor(false, 5) == L"100,0,4096,2,8192,1,999,1500000,7000000,0\n"
+                                      L"200,0,4096,2,8192,1,998,1500000,7000000,0\n"
+                                      L"200,3,0,10,0,0,0,,,\n"
+                                      L"300,0,0,0,0,0,997,1500000,7000000,0\n"
+                                      L"300,3,0,10,0,0,0,,,\n"
+                                      L"400,0,4096,2,8192,1,996,1500000,7000000,0\n"
+                                      L"400,3,0,10,0,0,0,,,\n");
+}
+
+TEST(NvApiMonitor_TickJson)
+{
+    PrinterScope printerScope(false, {});
+    CHECK(RunFakeMonitor(true, 3) ==
+        L"{\"TimeMs\":100,\"Adapter\":0,\"EvictionsSize\":4096,\"EvictionCount\":2,\"PromotionsSize\":8192,"
+        L"\"PromotionCount\":1,\"CurAvailableDedicatedVideoMemory\":999,\"GraphicsClockKHz\":1500000,"
+        L"\"MemoryClockKHz\":7000000,\"PerformanceState\":0}\n"
+        L"{\"TimeMs\":200,\"Adapter\":0,\"EvictionsSize\":4096,\"EvictionCount\":2,\"PromotionsSize\":8192,"
+        L"\"PromotionCount\":1,\"CurAvailableDedicatedVideoMemory\":998,\"GraphicsClockKHz\":1500000,"
+        L"\"MemoryClockKHz\":7000000,\"PerformanceState\":0}\n"
+        // Unknown values are omitted.
+        L"{\"TimeMs\":200,\"Adapter\":3,\"EvictionsSize\":0,\"EvictionCount\":10,\"PromotionsSize\":0,"
+        L"\"PromotionCount\":0,\"CurAvailableDedicatedVideoMemory\":0}\n");
+}
+
+TEST(NvApiMonitor_Run)
+{
+    PrinterScope printerScope(false, {});
+    NvApiMonitor monitor(
+        { 0 },
+        [](uint32_t adapterIndex, NvGpuCounters& outCounters) {
+            return SampleFakeGpu(adapterIndex, 1, outCounters);
+        },
+        std::chrono::milliseconds(100), false);
+    // The test CtrlCScope stops after the first tick, which is only the base for the deltas.
+    Printer::BeginCapture(false);
+    monitor.Run();
+    CHECK(Printer::EndCapture() == L"TimeMs,Adapter,EvictionsSize,EvictionCount,PromotionsSize,PromotionCount,"
+                                   L"CurAvailableDedicatedVideoMemory,GraphicsClockKHz,MemoryClockKHz,"
+                                   L"PerformanceState\n");
+}
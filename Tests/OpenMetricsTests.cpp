@@ -0,0 +1,186 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "OpenMetrics.hpp"
+#include "Utils.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static std::vector<OpenMetricsExporter::Adapter> MakeFakeAdapters()
+{
+    std::vector<OpenMetricsExporter::Adapter> adapters(2);
+    adapters[0].m_Index = 0;
+    adapters[0].m_Description = L"Fake \"GPU\" \\ 1\n";
+    adapters[0].m_VendorId = 0x10DE;
+    adapters[0].m_DeviceId = 0x2684;
+    adapters[0].m_SubSysId = 0x16F31043;
+    adapters[0].m_Revision = 0xA1;
+    adapters[0].m_DedicatedVideoMemory = 25390809088;
+    adapters[0].m_SharedSystemMemory = 34359738368;
+    adapters[0].m_DriverVersion = (32ull << 48) | (0ull << 32) | (15ull << 16) | 6094;
+    adapters[1].m_Index = 2;
+    adapters[1].m_Description = L"Microsoft Basic Render Driver";
+    adapters[1].m_VendorId = 0x1414;
+    adapters[1].m_DeviceId = 0x8C;
+    adapters[1].m_Software = true;
+    return adapters;
+}
+
+// Stands in for IDXGIAdapter3::QueryVideoMemoryInfo. Usage grows with each query. Adapter 2 has no non-local segment
+// group.
+static MemoryMonitor::QueryFunc MakeFakeQueryFunc(uint64_t& queryCount)
+{
+    return [&queryCount](uint32_t adapterIndex, uint32_t segmentGroup, VideoMemoryInfo& outInfo) {
+        if(adapterIndex == 2 && segmentGroup == 1)
+            return false;
+        ++queryCount;
+        outInfo.m_Budget = 1000 + adapterIndex * 10 + segmentGroup;
+        outInfo.m_CurrentUsage = queryCount;
+        outInfo.m_AvailableForReservation = UINT64_MAX;
+        outInfo.m_CurrentReservation = 0;
+        return true;
+    };
+}
+
+// Sends a request to the server on localhost and returns the whole response.
+static std::string SendHttpRequest(uint16_t port, std::string_view request)
+{
+    const int client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    std::string response;
+    if(connect(client, (const sockaddr*)&address, sizeof(address)) == 0 &&
+        send(client, request.data(), request.size(), MSG_NOSIGNAL) == ssize_t(request.size()))
+    {
+        char buffer[1024];
+        ssize_t size;
+        while((size = recv(client, buffer, sizeof(buffer), 0)) > 0)
+            response.append(buffer, size_t(size));
+    }
+    close(client);
+    return response;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+TEST(OpenMetrics_Render)
+{
+    uint64_t queryCount = 0;
+    OpenMetricsExporter exporter(MakeFakeAdapters(), MakeFakeQueryFunc(queryCount));
+
+    const std::string first = std::string(exporter.Render());
+    CHECK(queryCount == 3);
+    CHECK(first.starts_with(std::format("# TYPE d3d12info_build info\n"
+                                        "# HELP d3d12info_build Version of D3d12info.\n"
+                                        "d3d12info_build_info{{version=\"{}\"}} 1\n",
+        WstrToStr(PROGRAM_VERSION, CP_UTF8))));
+    CHECK(first.find("d3d12info_adapter_info{adapter=\"0\",description=\"Fake \\\"GPU\\\" \\\\ 1\\n\","
+                     "vendor_id=\"0x10DE\",device_id=\"0x2684\",subsys_id=\"0x16F31043\",revision=\"0xA1\","
+                     "driver_version=\"32.0.15.6094\",software=\"false\"} 1\n") != std::string::npos);
+    CHECK(first.find("d3d12info_adapter_info{adapter=\"2\",description=\"Microsoft Basic Render Driver\","
+                     "vendor_id=\"0x1414\",device_id=\"0x008C\",subsys_id=\"0x00000000\",revision=\"0x0\","
+                     "driver_version=\"\",software=\"true\"} 1\n") != std::string::npos);
+    CHECK(first.find("# TYPE d3d12info_adapter_dedicated_video_memory_bytes gauge\n"
+                     "# UNIT d3d12info_adapter_dedicated_video_memory_bytes bytes\n"
+                     "# HELP d3d12info_adapter_dedicated_video_memory_bytes DXGI_ADAPTER_DESC1::DedicatedVideoMemory.\n"
+                     "d3d12info_adapter_dedicated_video_memory_bytes{adapter=\"0\"} 25390809088\n"
+                     "d3d12info_adapter_dedicated_video_memory_bytes{adapter=\"2\"} 0\n") != std::string::npos);
+    // Segment groups that couldn't be queried have no samples.
+    CHECK(first.find("d3d12info_video_memory_budget_bytes{adapter=\"0\",segment_group=\"local\"} 1000\n"
+                     "d3d12info_video_memory_budget_bytes{adapter=\"0\",segment_group=\"non_local\"} 1001\n"
+                     "d3d12info_video_memory_budget_bytes{adapter=\"2\",segment_group=\"local\"} 1020\n"
+                     "# TYPE") != std::string::npos);
+    CHECK(first.find("d3d12info_video_memory_available_for_reservation_bytes{adapter=\"2\",segment_group=\"local\"} "
+                     "18446744073709551615\n") != std::string::npos);
+    CHECK(first.ends_with("d3d12info_video_memory_current_reservation_bytes{adapter=\"2\",segment_group=\"local\"} 0\n"
+                          "# EOF\n"));
+
+    // Each render queries again, into the same buffer, which was reserved for the longest values.
+    const std::string_view second = exporter.Render();
+    CHECK(queryCount == 6);
+    CHECK(second.find("d3d12info_video_memory_current_usage_bytes{adapter=\"0\",segment_group=\"local\"} 4\n") !=
+        std::string::npos);
+    const char* const secondData = second.data();
+    CHECK(exporter.Render().data() == secondData);
+}
+
+TEST(OpenMetrics_Server)
+{
+    uint64_t queryCount = 0;
+    OpenMetricsExporter exporter(MakeFakeAdapters(), MakeFakeQueryFunc(queryCount));
+    OpenMetricsServer server(0);
+    CHECK(server.GetPort() != 0);
+
+    std::string response;
+    std::thread client([&]() {
+        response = SendHttpRequest(server.GetPort(), "GET /metrics HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n");
+    });
+    server.AnswerRequest(exporter);
+    client.join();
+
+    const size_t headerEnd = response.find("\r\n\r\n");
+    CHECK(headerEnd != std::string::npos);
+    const std::string_view header = std::string_view(response).substr(0, headerEnd + 4);
+    const std::string_view body = std::string_view(response).substr(headerEnd + 4);
+    CHECK(header == std::format("HTTP/1.1 200 OK\r\nContent-Type: {}\r\nContent-Length: {}\r\n"
+                                "Connection: close\r\n\r\n",
+                        OpenMetricsExporter::CONTENT_TYPE, body.size()));
+    CHECK(queryCount == 3);
+    CHECK(body.starts_with("# TYPE d3d12info_build info\n"));
+    CHECK(body.ends_with("\n# EOF\n"));
+
+    // A request that doesn't end before the receive timeout is closed without an answer.
+    client = std::thread([&]() {
+        response = SendHttpRequest(server.GetPort(), "GET /metrics HTTP/1.1\r\n");
+    });
+    server.AnswerRequest(exporter);
+    client.join();
+    CHECK(response.empty());
+    CHECK(queryCount == 3);
+}
+
+TEST(OpenMetrics_WriteFile)
+{
+    uint64_t queryCount = 0;
+    OpenMetricsExporter exporter(MakeFakeAdapters(), MakeFakeQueryFunc(queryCount));
+    const std::filesystem::path filePath = GetTestDirectory() / "metrics.txt";
+
+    // Replaces the file, and leaves no temporary file behind.
+    for(uint64_t i = 0; i < 2; ++i)
+        WriteOpenMetricsFile(exporter, filePath.wstring());
+    std::ifstream file(filePath, std::ios::binary);
+    const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    CHECK(text.find("d3d12info_video_memory_current_usage_bytes{adapter=\"0\",segment_group=\"local\"} 4\n") !=
+        std::string::npos);
+    CHECK(text.ends_with("# EOF\n"));
+    CHECK(std::distance(std::filesystem::directory_iterator(GetTestDirectory()), {}) == 1);
+
+
+    bool writeThrown = false;
+    try
+    {
+        WriteOpenMetricsFile(exporter, (GetTestDirectory() / "Missing" / "metrics.txt").wstring());
+    }
+    catch(const std::runtime_error&)
+    {
+        writeThrown = true;
+    }
+    CHECK(writeThrown);
+}
@@ -0,0 +1,101 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "RawFeatureData.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// Stands for a D3D12_FEATURE_DATA_* structure as this version of the program knows it.
+struct FakeFeatureData
+{
+    uint32_t m_A;
+    uint32_t m_B;
+};
+
+static const uint32_t FAKE_FEATURE_ID = 1000;
+
+static std::vector<char> MakeBytes(std::initializer_list<uint32_t> values)
+{
+    std::vector<char> result(values.size() * sizeof(uint32_t));
+    memcpy(result.data(), values.begin(), result.size());
+    return result;
+}
+
+static FakeFeatureData DecodeFakeFeatureData(const RawFeatureData::Record& record, std::vector<char>& outExtraData)
+{
+    const std::vector<char> data = RawFeatureData::FitRecordData(record, sizeof(FakeFeatureData), outExtraData);
+    CHECK(data.size() == sizeof(FakeFeatureData));
+    FakeFeatureData result;
+    memcpy(&result, data.data(), sizeof(result));
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// TESTS
+
+// Recording can be started only once in the process, so all sizes are checked in one test.
+TEST(RawFeatureData_RoundTripDifferentSizes)
+{
+    // Written by this version, an older one that knew only m_A, and a newer one that knows one more member.
+    const std::vector<char> equalBytes = MakeBytes({ 1, 2 });
+    const std::vector<char> smallerBytes = MakeBytes({ 3 });
+    const std::vector<char> largerBytes = MakeBytes({ 4, 5, 6 });
+
+    const std::wstring filePath = (GetTestDirectory() / "Raw.bin").wstring();
+    RawFeatureData::StartRecording();
+    RawFeatureData::AddRecord(RawFeatureData::ADAPTER_RECORD_ID, "Adapter", 7);
+    RawFeatureData::AddRecord(FAKE_FEATURE_ID, equalBytes.data(), equalBytes.size());
+    RawFeatureData::AddRecord(FAKE_FEATURE_ID, smallerBytes.data(), smallerBytes.size());
+    RawFeatureData::AddRecord(FAKE_FEATURE_ID, largerBytes.data(), largerBytes.size());
+    RawFeatureData::SaveFile(filePath);
+
+    const std::vector<RawFeatureData::Record> records = RawFeatureData::LoadFile(filePath);
+    CHECK(records.size() == 4);
+    if(records.size() != 4)
+        return;
+    CHECK(records[0].m_Id == RawFeatureData::ADAPTER_RECORD_ID);
+    CHECK(std::string(records[0].m_Data.begin(), records[0].m_Data.end()) == "Adapter");
+    CHECK(records[1].m_Id == FAKE_FEATURE_ID && records[1].m_Data == equalBytes);
+    CHECK(records[2].m_Id == FAKE_FEATURE_ID && records[2].m_Data == smallerBytes);
+    CHECK(records[3].m_Id == FAKE_FEATURE_ID && records[3].m_Data == largerBytes);
+
+    std::vector<char> extraData;
+    FakeFeatureData equal = DecodeFakeFeatureData(records[1], extraData);
+    CHECK(equal.m_A == 1 && equal.m_B == 2);
+    CHECK(extraData.empty());
+
+    // The member missing in the record is zero.
+    FakeFeatureData smaller = DecodeFakeFeatureData(records[2], extraData);
+    CHECK(smaller.m_A == 3 && smaller.m_B == 0);
+    CHECK(extraData.empty());
+
+    // The member unknown to this version is left undecoded.
+    FakeFeatureData larger = DecodeFakeFeatureData(records[3], extraData);
+    CHECK(larger.m_A == 4 && larger.m_B == 5);
+    CHECK(extraData == MakeBytes({ 6 }));
+}
+
+TEST(RawFeatureData_LoadInvalidFile)
+{
+    const std::filesystem::path filePath = GetTestDirectory() / "Invalid.bin";
+    std::ofstream(filePath, std::ios::out | std::ios::binary) << "NOT A RAW FILE";
+    bool thrown = false;
+    try
+    {
+        RawFeatureData::LoadFile(filePath.wstring());
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
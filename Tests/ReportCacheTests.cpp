@@ -0,0 +1,315 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "Printer.hpp"
+#include "ReportCache.hpp"
+#include "ReportFormatter/CallLogReportFormatter.hpp"
+#include "ReportFormatter/JSONReportFormatter.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static ReportCacheKey MakeKey()
+{
+    ReportCacheKey key;
+    key.ProgramVersion = 0x03120000;
+    key.AgilitySDKVersion = 619;
+    key.OSVersion = L"10.0.26100";
+    key.Options = L"--JSON";
+    key.Adapters.push_back({ .LuidLowPart = 0x1234, .LuidHighPart = 0, .VendorId = 0x10DE, .DeviceId = 0x2684,
+        .SubSysId = 0x889D1043, .Revision = 0xA1, .UMDVersion = 0x0020001E000F1234 });
+    return key;
+}
+
+static ReportFragment MakeFragment()
+{
+    ReportFragment fragment;
+    fragment.Segments.push_back({ L"{\"A\": 1,", L"FA\n", L"SystemMemory" });
+    fragment.Segments.push_back({ L"\"B\": 2}", L"FB\n", {} });
+    return fragment;
+}
+
+static bool AreFragmentsEqual(const ReportFragment& lhs, const ReportFragment& rhs)
+{
+    if(lhs.Segments.size() != rhs.Segments.size())
+        return false;
+    for(size_t i = 0; i < lhs.Segments.size(); ++i)
+    {
+        const ReportFragment::Segment& l = lhs.Segments[i];
+        const ReportFragment::Segment& r = rhs.Segments[i];
+        if(l.Text != r.Text || l.CallLog != r.CallLog || l.VolatileSection != r.VolatileSection)
+            return false;
+    }
+    return true;
+}
+
+static std::vector<std::filesystem::path> GetCacheFiles(const std::filesystem::path& directory)
+{
+    std::vector<std::filesystem::path> result;
+    for(const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory))
+        result.push_back(entry.path());
+    return result;
+}
+
+// Stands in for the program printing a report, with the sections that change from run to run marked the same way as
+// VolatileSectionScope does, when recorder is not null.
+class ReportRecorder
+{
+public:
+    ReportRecorder(CallLogReportFormatter& formatter)
+        : m_Formatter(formatter)
+    {
+        Printer::BeginCapture();
+    }
+
+    void BeginVolatileSection(std::wstring id)
+    {
+        std::wstring text = Printer::EndCapture();
+        m_Fragment.Segments.push_back({ std::move(text), m_Formatter.TakeLog(), std::move(id) });
+    }
+    void EndVolatileSection()
+    {
+        m_Formatter.TakeLog();
+        Printer::BeginCapture();
+    }
+
+    ReportFragment Finish()
+    {
+        std::wstring text = Printer::EndCapture();
+        m_Fragment.Segments.push_back({ std::move(text), m_Formatter.TakeLog(), {} });
+        return std::move(m_Fragment);
+    }
+
+private:
+    CallLogReportFormatter& m_Formatter;
+    ReportFragment m_Fragment;
+};
+
+static void PrintSystemMemory(ReportFormatter& formatter, uint64_t freeMemory)
+{
+    formatter.PushObject(L"System memory");
+    formatter.AddFieldSize(L"AvailablePhys", freeMemory);
+    formatter.PopScope();
+}
+
+static void PrintVideoMemory(ReportFormatter& formatter, uint64_t freeMemory)
+{
+    formatter.PushArray(L"DXGI_QUERY_VIDEO_MEMORY_INFO");
+    formatter.PushArrayItem();
+    formatter.AddFieldSize(L"Budget", freeMemory);
+    formatter.PopScope();
+    formatter.PopScope();
+}
+
+static void PrintTestReport(ReportFormatter& formatter, uint64_t freeMemory, ReportRecorder* recorder)
+{
+    formatter.PushObject(L"System Info");
+    formatter.AddFieldString(L"OS", L"Windows");
+    if(recorder)
+        recorder->BeginVolatileSection(L"SystemMemory");
+    PrintSystemMemory(formatter, freeMemory);
+    if(recorder)
+        recorder->EndVolatileSection();
+    formatter.AddFieldBool(L"DXGI_FEATURE_PRESENT_ALLOW_TEARING", true);
+    formatter.PopScope();
+
+    formatter.PushArray(L"Adapters");
+    formatter.PushArrayItem();
+    formatter.AddFieldString(L"Description", L"Test Adapter");
+    if(recorder)
+        recorder->BeginVolatileSection(L"VideoMemory 0000000000001234");
+    PrintVideoMemory(formatter, freeMemory);
+    if(recorder)
+        recorder->EndVolatileSection();
+    formatter.AddFieldUint32(L"FeatureLevel", 0xC200);
+    formatter.PopScope();
+    formatter.PopAllScopes();
+}
+
+static std::wstring PrintFreshReport(uint64_t freeMemory)
+{
+    Printer::BeginCapture(false);
+    {
+        JSONReportFormatter formatter(ReportFormatter::FLAG_JSON_PRETTY_PRINT);
+        PrintTestReport(formatter, freeMemory, nullptr);
+    }
+    return Printer::EndCapture();
+}
+
+static ReportFragment RecordReport(uint64_t freeMemory)
+{
+    ReportFragment fragment;
+    Printer::BeginCapture(false);
+    {
+        CallLogReportFormatter formatter(
+            std::make_unique<JSONReportFormatter>(ReportFormatter::FLAG_JSON_PRETTY_PRINT));
+        ReportRecorder recorder(formatter);
+        PrintTestReport(formatter, freeMemory, &recorder);
+        fragment = recorder.Finish();
+    }
+    Printer::EndCapture();
+    return fragment;
+}
+
+// Does the same as PrintCachedReport in Main.cpp.
+static std::wstring PrintCachedReport(const ReportFragment& fragment, uint64_t freeMemory)
+{
+    Printer::BeginCapture(false);
+    {
+        JSONReportFormatter formatter(ReportFormatter::FLAG_JSON_PRETTY_PRINT);
+        for(const ReportFragment::Segment& segment : fragment.Segments)
+        {
+            Printer::PrintString(segment.Text);
+            Printer::BeginCapture(false);
+            CallLogReportFormatter::Replay(formatter, segment.CallLog);
+            Printer::EndCapture();
+
+            if(segment.VolatileSection == L"SystemMemory")
+                PrintSystemMemory(formatter, freeMemory);
+            else if(segment.VolatileSection.starts_with(L"VideoMemory "))
+                PrintVideoMemory(formatter, freeMemory);
+            else
+                CHECK(segment.VolatileSection.empty());
+        }
+    }
+    return Printer::EndCapture();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// TESTS
+
+TEST(ReportCache_KeyToString)
+{
+    const ReportCacheKey key = MakeKey();
+    CHECK(key.ToString() == L"ProgramVersion=03120000;AgilitySDKVersion=619;OSVersion=10.0.26100;Options=--JSON;"
+                            L"Adapter=00000000-00001234,10DE,2684,889D1043,A1,0020001E000F1234");
+
+    ReportCacheKey otherKey = key;
+    otherKey.Adapters[0].UMDVersion = 0x0020001E000F1235;
+    CHECK(otherKey.ToString() != key.ToString());
+    otherKey = key;
+    otherKey.Options = L"--JSON --MinimizeJson";
+    CHECK(otherKey.ToString() != key.ToString());
+}
+
+TEST(ReportCache_StoreLoad)
+{
+    const ReportCache cache(GetTestDirectory() / "Cache");
+    const ReportCacheKey key = MakeKey();
+    ReportFragment fragment;
+    CHECK(!cache.Load(key, fragment));
+
+    cache.Store(key, MakeFragment());
+    CHECK(GetCacheFiles(cache.GetDirectory()).size() == 1);
+    CHECK(cache.Load(key, fragment));
+    CHECK(AreFragmentsEqual(fragment, MakeFragment()));
+
+    // Storing again replaces the entry.
+    ReportFragment otherFragment = MakeFragment();
+    otherFragment.Segments[1].Text = L"\"B\": 3}";
+    cache.Store(key, otherFragment);
+    CHECK(GetCacheFiles(cache.GetDirectory()).size() == 1);
+    CHECK(cache.Load(key, fragment));
+    CHECK(AreFragmentsEqual(fragment, otherFragment));
+}
+
+TEST(ReportCache_KeyMismatch)
+{
+    const ReportCache cache(GetTestDirectory() / "Cache");
+    const ReportCacheKey key = MakeKey();
+    cache.Store(key, MakeFragment());
+
+    ReportCacheKey otherKey = key;
+    otherKey.Adapters[0].UMDVersion = 0;
+    ReportFragment fragment;
+    CHECK(!cache.Load(otherKey, fragment));
+    CHECK(fragment.Segments.empty());
+
+    // The same file name, as if the hashes collided, must not make a different key match.
+    const std::vector<std::filesystem::path> files = GetCacheFiles(cache.GetDirectory());
+    CHECK(files.size() == 1);
+    cache.Store(otherKey, MakeFragment());
+    for(const std::filesystem::path& path : GetCacheFiles(cache.GetDirectory()))
+    {
+        if(path != files[0])
+            std::filesystem::rename(path, files[0]);
+    }
+    CHECK(!cache.Load(key, fragment));
+}
+
+TEST(ReportCache_DamagedFile)
+{
+    const ReportCache cache(GetTestDirectory() / "Cache");
+    const ReportCacheKey key = MakeKey();
+    cache.Store(key, MakeFragment());
+    const std::vector<std::filesystem::path> files = GetCacheFiles(cache.GetDirectory());
+    CHECK(files.size() == 1);
+    const std::uintmax_t fileSize = std::filesystem::file_size(files[0]);
+
+    // Every truncation must be rejected.
+    for(std::uintmax_t size = 0; size < fileSize; ++size)
+    {
+        cache.Store(key, MakeFragment());
+        std::filesystem::resize_file(files[0], size);
+        ReportFragment fragment;
+        CHECK(!cache.Load(key, fragment));
+    }
+
+    // A huge segment count.
+    cache.Store(key, MakeFragment());
+    {
+        std::fstream file(files[0], std::ios::in | std::ios::out | std::ios::binary);
+        // Magic, version, key length and key.
+        file.seekp(8 + 4 + 8 + key.ToString().length() * sizeof(wchar_t));
+        const uint64_t segmentCount = UINT64_MAX;
+        file.write(reinterpret_cast<const char*>(&segmentCount), sizeof(segmentCount));
+    }
+    ReportFragment fragment;
+    CHECK(!cache.Load(key, fragment));
+}
+
+TEST(ReportCache_Clear)
+{
+    const ReportCache cache(GetTestDirectory() / "Cache");
+    CHECK(cache.Clear() == 0);
+
+    ReportCacheKey key = MakeKey();
+    cache.Store(key, MakeFragment());
+    key.Options = L"--Text";
+    cache.Store(key, MakeFragment());
+    // Other files in the directory are left alone.
+    std::ofstream(cache.GetDirectory() / "Other.txt") << "Other";
+
+    CHECK(cache.Clear() == 2);
+    ReportFragment fragment;
+    CHECK(!cache.Load(key, fragment));
+    CHECK(GetCacheFiles(cache.GetDirectory()).size() == 1);
+}
+
+TEST(ReportCache_VolatileSectionsPrintedAgain)
+{
+    PrinterScope printerScope(false, {});
+
+    const ReportCache cache(GetTestDirectory() / "Cache");
+    const ReportCacheKey key = MakeKey();
+    cache.Store(key, RecordReport(1000));
+
+    ReportFragment fragment;
+    CHECK(cache.Load(key, fragment));
+    // The text before, between and after the two volatile sections.
+    CHECK(fragment.Segments.size() == 3);
+    for(const ReportFragment::Segment& segment : fragment.Segments)
+        CHECK(segment.Text.find(L"1000") == std::wstring::npos);
+
+    const std::wstring cachedReport = PrintCachedReport(fragment, 2000);
+    CHECK(cachedReport == PrintFreshReport(2000));
+    CHECK(cachedReport.find(L"2000") != std::wstring::npos);
+}
@@ -0,0 +1,153 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "Printer.hpp"
+#include "ReportFormatter/JSONReportFormatter.hpp"
+#include "ReportFormatter/StatsReportFormatter.hpp"
+#include "ReportStats.hpp"
+
+#include <sstream>
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// HeapCalls, AllocatedBytes, PeakLiveBytes, OutputBytes.
+using StatsRow = std::array<uint64_t, 4>;
+
+// Prints the summary and returns its rows by scope.
+static std::unordered_map<std::wstring, StatsRow> GetSummaryRows()
+{
+    std::wostringstream errorStream;
+    std::wstreambuf* const prevErrorBuffer = std::wcerr.rdbuf(errorStream.rdbuf());
+    ReportStats::PrintSummary();
+    std::wcerr.rdbuf(prevErrorBuffer);
+
+    std::unordered_map<std::wstring, StatsRow> rows;
+    std::wistringstream summary(errorStream.str());
+    std::wstring line;
+    std::getline(summary, line);
+    CHECK(line.starts_with(L"Scope ") && line.ends_with(L"  HeapCalls  AllocatedBytes   PeakLiveBytes   OutputBytes"));
+    while(std::getline(summary, line))
+    {
+        // Scopes have spaces in their paths, so the numbers are taken from the end.
+        StatsRow row;
+        size_t end = line.length();
+        for(size_t i = row.size(); i-- > 0;)
+        {
+            const size_t begin = line.find_last_of(L' ', end - 1) + 1;
+            row[i] = std::stoull(line.substr(begin, end - begin));
+            end = line.find_last_not_of(L' ', begin - 1) + 1;
+        }
+        rows[line.substr(0, end)] = row;
+    }
+    return rows;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+TEST(ReportStats_Scopes)
+{
+    PrinterScope printerScope(true, (GetTestDirectory() / "Report.txt").wstring());
+    ReportStats::Enable();
+
+    ReportStats::OnAllocate(10, 16);
+    ReportStats::PushScope(L"Adapters");
+    {
+        ReportStats::PushArrayItem();
+        ReportStats::OnAllocate(100, 112);
+        {
+            ReportStats::PushScope(L"Formats");
+            // Deeper than MAX_SCOPE_DEPTH, so counted to Formats.
+            ReportStats::PushScope(L"Deep");
+            ReportStats::OnAllocate(50, 64);
+            Printer::PrintString(L"12345");
+            ReportStats::PopScope();
+            ReportStats::OnFree(64);
+            ReportStats::PopScope();
+        }
+        ReportStats::OnFree(112);
+        ReportStats::PopScope();
+
+        // Frees a block allocated before the scope was opened.
+        ReportStats::PushArrayItem();
+        Printer::PrintString(L"abc");
+        ReportStats::OnFree(16);
+        ReportStats::PopScope();
+    }
+    ReportStats::PopScope();
+
+    // Scopes of the same path are counted to the same row, like the same adapter in another report.
+    ReportStats::PushScope(L"Adapters");
+    ReportStats::PushArrayItem();
+    ReportStats::OnAllocate(8, 16);
+    ReportStats::PopAllScopes();
+    ReportStats::OnFree(16);
+
+    const std::unordered_map<std::wstring, StatsRow> rows = GetSummaryRows();
+    CHECK(!ReportStats::IsEnabled());
+    CHECK(rows.size() == 6);
+    CHECK(rows.at(L"(report)") == StatsRow({ 2, 10, 192, 0 }));
+    CHECK(rows.at(L"Adapters") == StatsRow({ 0, 0, 176, 0 }));
+    CHECK(rows.at(L"Adapters / 0") == StatsRow({ 3, 108, 176, 0 }));
+    CHECK(rows.at(L"Adapters / 0 / Formats") == StatsRow({ 2, 50, 64, 5 }));
+    CHECK(rows.at(L"Adapters / 1") == StatsRow({ 1, 0, 0, 3 }));
+    // The peak of the whole report is the peak of the report row.
+    CHECK(rows.at(L"Total") == StatsRow({ 8, 168, 192, 8 }));
+}
+
+TEST(ReportStats_Formatter)
+{
+    const std::filesystem::path filePath = GetTestDirectory() / "Report.json";
+    std::unordered_map<std::wstring, StatsRow> rows;
+    {
+        PrinterScope printerScope(true, filePath.wstring());
+        ReportStats::Enable();
+        {
+            StatsReportFormatter formatter(std::make_unique<JSONReportFormatter>(ReportFormatter::FLAG_NONE));
+            formatter.PushObject(L"Header");
+            formatter.AddFieldString(L"Version", L"1.0");
+            formatter.PopScope();
+            formatter.PushArray(L"Adapters");
+            for(uint32_t i = 0; i < 2; ++i)
+            {
+                formatter.PushArrayItem();
+                formatter.AddFieldUint32(L"VendorId", 0x10DE);
+                formatter.PopScope();
+            }
+            formatter.PopAllScopes();
+        }
+        rows = GetSummaryRows();
+    }
+
+    // The scopes of the formatter become the rows, and their output is counted to them.
+    CHECK(rows.size() == 6);
+    CHECK(rows.contains(L"Header") && rows.contains(L"Adapters") && rows.contains(L"Adapters / 0") &&
+          rows.contains(L"Adapters / 1"));
+    uint64_t outputBytes = 0;
+    for(const auto& [path, row] : rows)
+        outputBytes += path != L"Total" ? row[3] : 0;
+    CHECK(outputBytes == rows.at(L"Total")[3]);
+    CHECK(outputBytes == std::filesystem::file_size(filePath));
+}
+
+TEST(ReportStats_Disabled)
+{
+    // Nothing is counted before it's enabled again.
+    CHECK(!ReportStats::IsEnabled());
+    ReportStats::PushScope(L"Ignored");
+    ReportStats::AddOutput(100);
+    ReportStats::PopScope();
+    ReportStats::Enable();
+    const std::unordered_map<std::wstring, StatsRow> rows = GetSummaryRows();
+    CHECK(rows.size() == 2);
+    CHECK(rows.at(L"(report)") == StatsRow({ 0, 0, 0, 0 }));
+}
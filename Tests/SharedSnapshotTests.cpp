@@ -0,0 +1,146 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "SharedSnapshot.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+// Unique for the process, so tests running at the same time don't share the section.
+static std::wstring GetSnapshotName(const wchar_t* testName)
+{
+    return std::format(L"D3d12infoTests_{}_{}", testName, uint64_t(getpid()));
+}
+
+// Data of each snapshot written by the concurrent test: the same character repeated, with length depending on it.
+static std::string MakeSnapshotData(uint32_t index)
+{
+    const char c = char('a' + index % 26);
+    return std::string(size_t(1000 + (c - 'a') * 100), c);
+}
+
+static bool IsSnapshotDataValid(const std::string& data)
+{
+    return !data.empty() && data[0] >= 'a' && data[0] <= 'z' && data == MakeSnapshotData(uint32_t(data[0] - 'a'));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+TEST(SharedSnapshot_WriteAndRead)
+{
+    const std::wstring name = GetSnapshotName(L"WriteAndRead");
+    {
+        SharedSnapshot::Writer writer(name, 64);
+        CHECK(writer.GetCapacity() == 64);
+
+        SharedSnapshot::Reader reader(name.c_str());
+        std::string data;
+        uint64_t sequence = 0;
+        CHECK(!reader.Read(data, &sequence));
+
+        writer.Write("{\"Adapters\":[]}");
+        CHECK(reader.Read(data, &sequence));
+        CHECK(data == "{\"Adapters\":[]}");
+        CHECK(sequence == 1);
+
+        writer.Write("{}");
+        CHECK(reader.Read(data, &sequence));
+        CHECK(data == "{}");
+        CHECK(sequence == 2);
+
+        bool tooLargeThrown = false;
+        try
+        {
+            writer.Write(std::string(65, ' '));
+        }
+        catch(const std::runtime_error&)
+        {
+            tooLargeThrown = true;
+        }
+        CHECK(tooLargeThrown);
+        // Last snapshot stays readable.
+        CHECK(reader.Read(data, &sequence));
+        CHECK(data == "{}");
+    }
+
+    // Section is removed together with the writer.
+    bool openThrown = false;
+    try
+    {
+        SharedSnapshot::Reader reader(name.c_str());
+    }
+    catch(const std::runtime_error&)
+    {
+        openThrown = true;
+    }
+    CHECK(openThrown);
+}
+
+TEST(SharedSnapshot_NameUsed)
+{
+    const std::wstring name = GetSnapshotName(L"NameUsed");
+    SharedSnapshot::Writer writer(name, 64);
+    bool createThrown = false;
+    try
+    {
+        SharedSnapshot::Writer otherWriter(name, 64);
+    }
+    catch(const std::runtime_error&)
+    {
+        createThrown = true;
+    }
+    CHECK(createThrown);
+
+    // Failed writer leaves the section of the first one.
+    writer.Write("{}");
+    SharedSnapshot::Reader reader(name.c_str());
+    std::string data;
+    CHECK(reader.Read(data));
+    CHECK(data == "{}");
+}
+
+TEST(SharedSnapshot_ConcurrentReads)
+{
+    static const uint32_t WRITE_COUNT = 20000;
+
+    const std::wstring name = GetSnapshotName(L"ConcurrentReads");
+    SharedSnapshot::Writer writer(name, MakeSnapshotData(25).size());
+    writer.Write(MakeSnapshotData(0));
+
+    std::atomic<bool> writing = true;
+    std::thread writerThread([&]() {
+        for(uint32_t i = 1; i < WRITE_COUNT; ++i)
+            writer.Write(MakeSnapshotData(i));
+        writing = false;
+    });
+
+    SharedSnapshot::Reader reader(name.c_str());
+    std::string data;
+    uint64_t sequence = 0;
+    uint64_t lastSequence = 0;
+    bool allValid = true;
+    bool sequenceIncreasing = true;
+    do
+    {
+        CHECK(reader.Read(data, &sequence));
+        allValid = allValid && IsSnapshotDataValid(data);
+        sequenceIncreasing = sequenceIncreasing && sequence >= lastSequence;
+        lastSequence = sequence;
+    } while(writing);
+    writerThread.join();
+
+    CHECK(allValid);
+    CHECK(sequenceIncreasing);
+    CHECK(reader.Read(data, &sequence));
+    CHECK(data == MakeSnapshotData(WRITE_COUNT - 1));
+    CHECK(sequence == WRITE_COUNT);
+}
@@ -0,0 +1,91 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Stands in for Src/pch.hpp when the portable parts of the program are built for the tests on other platforms than
+// Windows. Declares only what those parts need from Windows headers.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <cwctype>
+
+using std::string;
+using std::wstring;
+
+typedef void* HANDLE;
+typedef int BOOL;
+typedef unsigned int UINT;
+typedef int32_t HRESULT;
+
+static const HRESULT S_OK = 0;
+static const HRESULT E_FAIL = HRESULT(0x80004005);
+#define SUCCEEDED(hr) (HRESULT(hr) >= 0)
+#define FAILED(hr) (HRESULT(hr) < 0)
+
+struct GUID
+{
+    uint32_t Data1;
+    uint16_t Data2;
+    uint16_t Data3;
+    uint8_t Data4[8];
+};
+
+struct LUID
+{
+    uint32_t LowPart;
+    int32_t HighPart;
+};
+
+#define ARRAYSIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+HANDLE GetCurrentProcess();
+BOOL TerminateProcess(HANDLE process, UINT exitCode);
+
+static const uint32_t CP_ACP = 0;
+static const uint32_t CP_UTF8 = 65001;
+
+static const int PROGRAM_EXIT_SUCCESS = 0;
+static const int PROGRAM_EXIT_ERROR_INIT = -1;
+static const int PROGRAM_EXIT_ERROR_COMMAND_LINE = -2;
+static const int PROGRAM_EXIT_ERROR_EXCEPTION = -3;
+static const int PROGRAM_EXIT_ERROR_SEH_EXCEPTION = -4;
+static const int PROGRAM_EXIT_ERROR_D3D12 = -5;
+static const int PROGRAM_EXIT_ERROR_TIMEOUT = -6;
@@ -0,0 +1,70 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+// Replacements for the functions and constants that the portable parts of the program use, but which are defined in source files
+// that need Windows. Good enough for the tests, which use only ASCII text.
+
+#include "Trace.hpp"
+#include "Utils.hpp"
+
+const wchar_t* const PROGRAM_VERSION = L"0.0.0";
+
+wstring StrToWstr(const char* str, uint32_t codePage)
+{
+    return wstring(str, str + strlen(str));
+}
+
+string WstrToStr(const wchar_t* str, uint32_t codePage)
+{
+    string result;
+    for(; *str != L'\0'; ++str)
+        result += char(*str);
+    return result;
+}
+
+HANDLE GetCurrentProcess()
+{
+    return nullptr;
+}
+
+BOOL TerminateProcess(HANDLE process, UINT exitCode)
+{
+    fflush(nullptr);
+    std::_Exit(int(exitCode));
+}
+
+// Acts as if Ctrl+C was pressed before the first wait, so loops stop after one iteration.
+CtrlCScope::CtrlCScope()
+{
+}
+
+CtrlCScope::~CtrlCScope()
+{
+}
+
+bool CtrlCScope::Wait(std::chrono::milliseconds time)
+{
+    return true;
+}
+
+bool CtrlCScope::Wait(HANDLE event, std::chrono::milliseconds time)
+{
+    return true;
+}
+
+bool Trace::s_Enabled = false;
+
+Trace::Event* Trace::BeginEvent(std::wstring_view name)
+{
+    return nullptr;
+}
+
+void Trace::EndEvent(Event* event)
+{
+}
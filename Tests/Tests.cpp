@@ -0,0 +1,92 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+struct Test
+{
+    const char* m_Name;
+    void (*m_Func)();
+};
+
+static std::vector<Test>& GetTests()
+{
+    static std::vector<Test> tests;
+    return tests;
+}
+
+static uint32_t g_FailureCount = 0;
+static std::filesystem::path g_TestDirectory;
+
+////////////////////////////////////////////////////////////////////////////////
+// PUBLIC
+
+TestRegistration::TestRegistration(const char* name, void (*func)())
+{
+    GetTests().push_back({ name, func });
+}
+
+void ReportCheckFailure(const char* expr, const char* file, int line)
+{
+    std::cerr << file << "(" << line << "): CHECK(" << expr << ") failed" << std::endl;
+    ++g_FailureCount;
+}
+
+std::filesystem::path GetTestDirectory()
+{
+    std::filesystem::create_directories(g_TestDirectory);
+    return g_TestDirectory;
+}
+
+// Runs all tests, or only the one named by the first argument.
+int main(int argc, char** argv)
+{
+    uint32_t failedTestCount = 0;
+    uint32_t testCount = 0;
+    for(const Test& test : GetTests())
+    {
+        if(argc > 1 && strcmp(argv[1], test.m_Name) != 0)
+            continue;
+        ++testCount;
+
+        g_TestDirectory = std::filesystem::temp_directory_path() / "D3d12infoTests" / test.m_Name;
+        std::filesystem::remove_all(g_TestDirectory);
+
+        const uint32_t failureCountBefore = g_FailureCount;
+        try
+        {
+            test.m_Func();
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << test.m_Name << ": exception: " << ex.what() << std::endl;
+            ++g_FailureCount;
+        }
+        std::filesystem::remove_all(g_TestDirectory);
+
+        if(g_FailureCount != failureCountBefore)
+        {
+            std::cerr << test.m_Name << ": FAILED" << std::endl;
+            ++failedTestCount;
+        }
+        else
+            std::cout << test.m_Name << ": passed" << std::endl;
+    }
+
+    if(testCount == 0)
+    {
+        std::cerr << "No tests found." << std::endl;
+        return 1;
+    }
+    std::cout << (testCount - failedTestCount) << "/" << testCount << " tests passed." << std::endl;
+    return failedTestCount == 0 ? 0 : 1;
+}
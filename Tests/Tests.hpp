@@ -0,0 +1,36 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#pragma once
+
+// Minimal test framework. A test is a function defined with TEST, checking its results with CHECK.
+// A failed CHECK is reported and the test continues. An exception thrown out of a test fails it.
+
+class TestRegistration
+{
+public:
+    TestRegistration(const char* name, void (*func)());
+};
+
+void ReportCheckFailure(const char* expr, const char* file, int line);
+
+#define TEST(name) \
+    static void Test_##name(); \
+    static TestRegistration g_Test_##name##_Registration(#name, Test_##name); \
+    static void Test_##name()
+
+#define CHECK(expr) \
+    do \
+    { \
+        if(!(expr)) \
+            ReportCheckFailure(#expr, __FILE__, __LINE__); \
+    } while(false)
+
+// Returns a directory for the files of the test, empty and removed after the test.
+std::filesystem::path GetTestDirectory();
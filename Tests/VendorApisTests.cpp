@@ -0,0 +1,163 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "VendorApis.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+static const uint32_t VENDOR_ID_MICROSOFT = 0x1414;
+static const uint32_t VENDOR_ID_QUALCOMM = 0x5143;
+
+struct FakeAdapter
+{
+    uint32_t m_VendorId;
+    bool m_SoftwareAdapter;
+};
+
+static const FakeAdapter INTEL_ADAPTER = { VENDOR_ID_INTEL, false };
+static const FakeAdapter NVIDIA_ADAPTER = { VENDOR_ID_NVIDIA, false };
+static const FakeAdapter AMD_ADAPTER = { VENDOR_ID_AMD, false };
+static const FakeAdapter QUALCOMM_ADAPTER = { VENDOR_ID_QUALCOMM, false };
+static const FakeAdapter WARP_ADAPTER = { VENDOR_ID_MICROSOFT, true };
+
+// Returns the APIs applicable to any of the adapters, as a string of their indices in VendorApi, for easy comparison.
+static std::string GetApplicableApis(const std::vector<FakeAdapter>& adapters, bool enabled, bool forceVendorApi)
+{
+    VendorApis vendorApis;
+    vendorApis.SetOptions(enabled, forceVendorApi);
+    for(const FakeAdapter& adapter : adapters)
+        vendorApis.AddPresentAdapter(adapter.m_VendorId, adapter.m_SoftwareAdapter);
+
+    std::string result;
+    for(size_t i = 0; i < size_t(VendorApi::Count); ++i)
+    {
+        if(vendorApis.IsApplicableToAnyAdapter(VendorApi(i)))
+            result += char('0' + i);
+    }
+    return result;
+}
+
+static std::string MakeApis(std::initializer_list<VendorApi> apis)
+{
+    std::string result;
+    for(VendorApi api : apis)
+        result += char('0' + size_t(api));
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// TESTS
+
+TEST(VendorApis_IsVendorApiApplicable)
+{
+    CHECK(IsVendorApiApplicable(VendorApi::NvApi, VENDOR_ID_NVIDIA, false, false));
+    CHECK(!IsVendorApiApplicable(VendorApi::NvApi, VENDOR_ID_AMD, false, false));
+    CHECK(IsVendorApiApplicable(VendorApi::Ags, VENDOR_ID_AMD, false, false));
+    CHECK(IsVendorApiApplicable(VendorApi::AmdDeviceInfo, VENDOR_ID_AMD, false, false));
+    CHECK(!IsVendorApiApplicable(VendorApi::Ags, VENDOR_ID_INTEL, false, false));
+    CHECK(IsVendorApiApplicable(VendorApi::IntelGpuDetect, VENDOR_ID_INTEL, false, false));
+    CHECK(!IsVendorApiApplicable(VendorApi::IntelGpuDetect, VENDOR_ID_NVIDIA, false, false));
+
+    CHECK(IsVendorApiApplicable(VendorApi::Vulkan, VENDOR_ID_NVIDIA, false, false));
+    CHECK(IsVendorApiApplicable(VendorApi::Vulkan, VENDOR_ID_AMD, false, false));
+    CHECK(IsVendorApiApplicable(VendorApi::Vulkan, VENDOR_ID_QUALCOMM, false, false));
+    CHECK(IsVendorApiApplicable(VendorApi::Vulkan, VENDOR_ID_INTEL, false, false));
+    CHECK(!IsVendorApiApplicable(VendorApi::Vulkan, VENDOR_ID_MICROSOFT, true, false));
+
+    for(size_t i = 0; i < size_t(VendorApi::Count); ++i)
+    {
+        CHECK(IsVendorApiApplicable(VendorApi(i), VENDOR_ID_INTEL, false, true));
+        CHECK(IsVendorApiApplicable(VendorApi(i), VENDOR_ID_MICROSOFT, true, true));
+    }
+}
+
+TEST(VendorApis_IsVendorApiRequired)
+{
+    CHECK(IsVendorApiRequired(VendorApi::NvApi, VENDOR_ID_NVIDIA, false, false));
+    CHECK(IsVendorApiRequired(VendorApi::IntelGpuDetect, VENDOR_ID_INTEL, false, false));
+    CHECK(IsVendorApiRequired(VendorApi::Vulkan, VENDOR_ID_NVIDIA, false, false));
+    CHECK(IsVendorApiRequired(VendorApi::Vulkan, VENDOR_ID_QUALCOMM, false, false));
+    CHECK(!IsVendorApiRequired(VendorApi::Vulkan, VENDOR_ID_INTEL, false, false));
+    CHECK(!IsVendorApiRequired(VendorApi::Vulkan, VENDOR_ID_MICROSOFT, true, false));
+    CHECK(IsVendorApiRequired(VendorApi::Vulkan, VENDOR_ID_INTEL, false, true));
+}
+
+TEST(VendorApis_IntelOnlySystem)
+{
+    // Neither nvapi64.dll, amd_ags_x64.dll, nor the Vulkan loader.
+    CHECK(GetApplicableApis({ INTEL_ADAPTER, WARP_ADAPTER }, true, false) == MakeApis({ VendorApi::IntelGpuDetect }));
+}
+
+TEST(VendorApis_MixedSystem)
+{
+    CHECK(GetApplicableApis({ INTEL_ADAPTER, NVIDIA_ADAPTER }, true, false) ==
+          MakeApis({ VendorApi::IntelGpuDetect, VendorApi::NvApi, VendorApi::Vulkan }));
+    CHECK(GetApplicableApis({ AMD_ADAPTER, WARP_ADAPTER }, true, false) ==
+          MakeApis({ VendorApi::Ags, VendorApi::AmdDeviceInfo, VendorApi::Vulkan }));
+    CHECK(GetApplicableApis({ QUALCOMM_ADAPTER }, true, false) == MakeApis({ VendorApi::Vulkan }));
+    CHECK(GetApplicableApis({ WARP_ADAPTER }, true, false).empty());
+}
+
+TEST(VendorApis_VulkanForIntelAdapter)
+{
+    // With another adapter initializing Vulkan, the Intel adapter is described by it too.
+    VendorApis vendorApis;
+    vendorApis.SetOptions(true, false);
+    vendorApis.AddPresentAdapter(INTEL_ADAPTER.m_VendorId, INTEL_ADAPTER.m_SoftwareAdapter);
+    vendorApis.AddPresentAdapter(NVIDIA_ADAPTER.m_VendorId, NVIDIA_ADAPTER.m_SoftwareAdapter);
+    CHECK(vendorApis.IsApplicable(VendorApi::Vulkan, VENDOR_ID_INTEL, false));
+    CHECK(vendorApis.IsApplicable(VendorApi::Vulkan, VENDOR_ID_NVIDIA, false));
+    CHECK(!vendorApis.IsApplicable(VendorApi::Vulkan, VENDOR_ID_MICROSOFT, true));
+
+    // Alone, it doesn't load the Vulkan loader.
+    vendorApis.SetOptions(true, false);
+    vendorApis.AddPresentAdapter(INTEL_ADAPTER.m_VendorId, INTEL_ADAPTER.m_SoftwareAdapter);
+    vendorApis.AddPresentAdapter(WARP_ADAPTER.m_VendorId, WARP_ADAPTER.m_SoftwareAdapter);
+    CHECK(!vendorApis.IsApplicable(VendorApi::Vulkan, VENDOR_ID_INTEL, false));
+    CHECK(vendorApis.IsApplicable(VendorApi::IntelGpuDetect, VENDOR_ID_INTEL, false));
+
+    // --ForceVendorAPI
+    vendorApis.SetOptions(true, true);
+    vendorApis.AddPresentAdapter(INTEL_ADAPTER.m_VendorId, INTEL_ADAPTER.m_SoftwareAdapter);
+    CHECK(vendorApis.IsApplicable(VendorApi::Vulkan, VENDOR_ID_INTEL, false));
+}
+
+TEST(VendorApis_Options)
+{
+    // --PureD3D12
+    CHECK(GetApplicableApis({ INTEL_ADAPTER, NVIDIA_ADAPTER, AMD_ADAPTER }, false, false).empty());
+    CHECK(GetApplicableApis({ INTEL_ADAPTER }, false, true).empty());
+    // --ForceVendorAPI
+    CHECK(GetApplicableApis({ WARP_ADAPTER }, true, true) ==
+          MakeApis({ VendorApi::NvApi, VendorApi::Ags, VendorApi::AmdDeviceInfo, VendorApi::Vulkan,
+              VendorApi::IntelGpuDetect }));
+    // No adapters at all.
+    CHECK(GetApplicableApis({}, true, true).empty());
+}
+
+TEST(VendorApis_SetOptionsForgetsAdapters)
+{
+    VendorApis vendorApis;
+    vendorApis.SetOptions(true, false);
+    vendorApis.AddPresentAdapter(VENDOR_ID_NVIDIA, false);
+    CHECK(vendorApis.IsApplicableToAnyAdapter(VendorApi::NvApi));
+    vendorApis.SetOptions(true, false);
+    CHECK(!vendorApis.IsApplicableToAnyAdapter(VendorApi::NvApi));
+    vendorApis.AddPresentAdapter(VENDOR_ID_INTEL, false);
+    CHECK(!vendorApis.IsApplicableToAnyAdapter(VendorApi::NvApi));
+    CHECK(vendorApis.IsApplicable(VendorApi::NvApi, VENDOR_ID_NVIDIA, false));
+    // Built without the vendor libraries, there is nothing to initialize.
+    vendorApis.StartInitialization();
+    CHECK(vendorApis.GetNvApi() == nullptr);
+    CHECK(vendorApis.GetVulkan() == nullptr);
+}
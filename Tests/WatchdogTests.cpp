@@ -0,0 +1,168 @@
+/*
+This file is part of D3d12info project:
+https://github.com/sawickiap/D3d12info
+
+Copyright (c) 2018-2026 Adam Sawicki, https://asawicki.info
+License: MIT
+
+For more information, see files README.md, LICENSE.txt.
+*/
+#include "Tests.hpp"
+
+#include "Json.hpp"
+#include "Printer.hpp"
+#include "ProbeTimings.hpp"
+#include "ReportFormatter/ReportFormatter.hpp"
+#include "Watchdog.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// PRIVATE
+
+using namespace std::chrono_literals;
+
+// Long enough for the watchdog to notice an expired deadline and to give up waiting for the report.
+static const std::chrono::seconds MAX_TAKE_OVER_TIME = 10s;
+
+static std::mutex g_TerminateMutex;
+static std::condition_variable g_TerminateCondition;
+static std::optional<int> g_TerminateExitCode;
+
+static void FakeTerminate(int exitCode)
+{
+    std::lock_guard<std::mutex> lock(g_TerminateMutex);
+    g_TerminateExitCode = exitCode;
+    g_TerminateCondition.notify_all();
+}
+
+// Stands in for a hanging driver or main thread, returning when the watchdog terminated the program or maxTime passed.
+static void WaitForTerminate(std::chrono::milliseconds maxTime)
+{
+    std::unique_lock<std::mutex> lock(g_TerminateMutex);
+    g_TerminateCondition.wait_for(lock, maxTime, []() { return g_TerminateExitCode.has_value(); });
+}
+
+// Prints the beginning of a JSON report to a file and starts the watchdog with the fake terminate function.
+class WatchdogTest
+{
+public:
+    WatchdogTest(std::chrono::milliseconds runTimeout, std::chrono::milliseconds probeTimeout)
+        : m_ReportPath(GetTestDirectory() / "Report.json")
+    {
+        g_TerminateExitCode.reset();
+        Watchdog::SetTerminateFunc(FakeTerminate);
+
+        CHECK(Printer::Initialize(true, m_ReportPath.wstring()));
+        ReportFormatter::CreateInstance(ReportFormatter::FLAG_JSON);
+        ReportFormatter::GetInstance().PushObject(L"System Info");
+        ReportFormatter::GetInstance().AddFieldString(L"OS", L"Windows");
+        Watchdog::Start(runTimeout, probeTimeout);
+    }
+    ~WatchdogTest()
+    {
+        Watchdog::SetTerminateFunc(nullptr);
+    }
+
+    // Call on the main thread, like the program does at the end of the report.
+    void Finish()
+    {
+        Watchdog::Stop();
+        // If the watchdog took the report over, it has already closed it.
+        if(!m_ReportTakenOver)
+        {
+            ReportFormatter::DestroyInstance();
+            Printer::Release();
+        }
+    }
+    void SetReportTakenOver()
+    {
+        m_ReportTakenOver = true;
+    }
+
+    std::wstring LoadReport() const
+    {
+        std::ifstream file(m_ReportPath);
+        const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return std::wstring(text.begin(), text.end());
+    }
+
+private:
+    const std::filesystem::path m_ReportPath;
+    bool m_ReportTakenOver = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// TESTS
+
+TEST(Watchdog_ProbeTimeout)
+{
+    WatchdogTest test(0ms, 50ms);
+    {
+        ProbeTimer timer(L"FakeHangingProbe");
+        WaitForTerminate(MAX_TAKE_OVER_TIME);
+    }
+    test.SetReportTakenOver();
+    test.Finish();
+
+    CHECK(g_TerminateExitCode == PROGRAM_EXIT_ERROR_TIMEOUT);
+    // Closed at the point of the probe, so it's still complete JSON.
+    const JsonValue report = ParseJson(test.LoadReport());
+    const JsonValue* systemInfo = report.FindMember(L"System Info");
+    CHECK(systemInfo && systemInfo->FindMember(L"OS"));
+    const JsonValue* watchdog = report.FindMember(L"Watchdog");
+    CHECK(watchdog != nullptr);
+    if(watchdog)
+    {
+        const JsonValue* deadline = watchdog->FindMember(L"Deadline");
+        CHECK(deadline && deadline->m_String == L"Probe");
+        const JsonValue* probe = watchdog->FindMember(L"TimedOutProbe");
+        CHECK(probe && probe->m_String == L"FakeHangingProbe");
+    }
+}
+
+TEST(Watchdog_RunTimeoutInsideWait)
+{
+    WatchdogTest test(50ms, 0ms);
+    {
+        WatchdogWait watchdogWait;
+        WaitForTerminate(MAX_TAKE_OVER_TIME);
+    }
+    test.SetReportTakenOver();
+    test.Finish();
+
+    CHECK(g_TerminateExitCode == PROGRAM_EXIT_ERROR_TIMEOUT);
+    const JsonValue report = ParseJson(test.LoadReport());
+    const JsonValue* watchdog = report.FindMember(L"Watchdog");
+    CHECK(watchdog && !watchdog->FindMember(L"TimedOutProbe"));
+}
+
+// The main thread hangs while it holds the report, outside of any probe, so the watchdog can't take the report over,
+// but it must still terminate the program.
+TEST(Watchdog_RunTimeoutOutsideProbe)
+{
+    WatchdogTest test(50ms, 0ms);
+    WaitForTerminate(MAX_TAKE_OVER_TIME);
+    ReportFormatter::GetInstance().PopAllScopes();
+    test.Finish();
+
+    CHECK(g_TerminateExitCode == PROGRAM_EXIT_ERROR_TIMEOUT);
+    // Left as it was, without the watchdog section.
+    const std::wstring report = test.LoadReport();
+    CHECK(report.find(L"\"OS\"") != std::wstring::npos);
+    CHECK(report.find(L"Watchdog") == std::wstring::npos);
+}
+
+TEST(Watchdog_FinishedInTime)
+{
+    WatchdogTest test(10000ms, 10000ms);
+    {
+        ProbeTimer timer(L"FakeProbe");
+        std::this_thread::sleep_for(10ms);
+    }
+    ReportFormatter::GetInstance().AddFieldBool(L"Done", true);
+    ReportFormatter::GetInstance().PopScope();
+    test.Finish();
+
+    CHECK(!g_TerminateExitCode.has_value());
+    const JsonValue report = ParseJson(test.LoadReport());
+    CHECK(report.FindMember(L"System Info") && !report.FindMember(L"Watchdog"));
+}